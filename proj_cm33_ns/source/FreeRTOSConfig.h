@@ -109,11 +109,35 @@ when application makefile has VFP_SELECT configured as softfloat */
 #define configUSE_MALLOC_FAILED_HOOK            1
 #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
 
-/* Run time and task stats gathering related definitions. */
+/* Run time and task stats gathering related definitions.
+ * Set configGENERATE_RUN_TIME_STATS to 1 to charge the CPU time of every task
+ * and print it with the statistics of the low power task (see cpu_stats.c).
+ * The run time counter is the LPTimer used for tickless idle, so it keeps
+ * counting in deep sleep.
+ */
 #define configGENERATE_RUN_TIME_STATS           0
 #define configUSE_TRACE_FACILITY                1
 #define configUSE_STATS_FORMATTING_FUNCTIONS    0
 
+#if (configGENERATE_RUN_TIME_STATS == 1) && (defined (__ICCARM__) || (__GNUC__))
+extern uint32_t app_timestamp_ticks(void);
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()        app_timestamp_ticks()
+#endif
+
+/* Set TRACE_LOG_TASK_SWITCHES to 1 to record every task switch in the
+ * power-state timeline enabled with TRACE_LOG_ENABLE in lowpower_task.h (see
+ * trace_log.h). The task is identified by its FreeRTOS task number.
+ */
+#define TRACE_LOG_TASK_SWITCHES                 0
+
+#if (TRACE_LOG_TASK_SWITCHES == 1) && (defined (__ICCARM__) || (__GNUC__))
+#include "trace_log.h"
+#define traceTASK_SWITCHED_IN()                 trace_log_record( \
+                                                TRACE_EVENT_TASK_SWITCH, \
+                                                pxCurrentTCB->uxTCBNumber)
+#endif
+
 /* Co-routine related definitions. */
 #define configUSE_CO_ROUTINES                   0
 #define configMAX_CO_ROUTINE_PRIORITIES         1
@@ -0,0 +1,150 @@
+/*******************************************************************************
+* File Name:   app_timestamp.c
+*
+* Description: This file contains the timestamp source shared by the
+* instrumentation modules of the application. Timestamps are read from the
+* LPTimer (MCWDT) counter set up for the RTOS tickless idle mode, so they stay
+* valid across deep sleep.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "app_timestamp.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define US_PER_SEC                  (1000000UL)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+
+/* LPTimer object passed to the RTOS tickless idle implementation */
+static mtb_hal_lptimer_t *timestamp_lptimer = NULL;
+
+/* Frequency of CLK_LF that clocks the LPTimer */
+static uint32_t timestamp_tick_hz = 0U;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: app_timestamp_init
+********************************************************************************
+* Summary:
+*  Selects the LPTimer used as the timestamp source. Must be called after the
+*  LPTimer has been set up.
+*
+* Parameters:
+*  mtb_hal_lptimer_t *lptimer: LPTimer HAL object.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void app_timestamp_init(mtb_hal_lptimer_t *lptimer)
+{
+    timestamp_tick_hz = Cy_SysClk_ClkLfGetFrequency();
+    timestamp_lptimer = lptimer;
+}
+
+/*******************************************************************************
+* Function Name: app_timestamp_ticks
+********************************************************************************
+* Summary:
+*  Returns the current LPTimer count. Can be called from interrupt context and
+*  from SysPm callbacks. Returns 0 until app_timestamp_init() has been called.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: LPTimer count, in CLK_LF cycles.
+*
+*******************************************************************************/
+uint32_t app_timestamp_ticks(void)
+{
+    return (NULL != timestamp_lptimer) ?
+            mtb_hal_lptimer_read(timestamp_lptimer) : 0U;
+}
+
+/*******************************************************************************
+* Function Name: app_timestamp_tick_hz
+********************************************************************************
+* Summary:
+*  Returns the frequency of the timestamp counter.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: Counter frequency, in Hz.
+*
+*******************************************************************************/
+uint32_t app_timestamp_tick_hz(void)
+{
+    return timestamp_tick_hz;
+}
+
+/*******************************************************************************
+* Function Name: app_timestamp_ticks_to_us
+********************************************************************************
+* Summary:
+*  Converts a number of LPTimer counts to microseconds.
+*
+* Parameters:
+*  uint32_t ticks: Number of LPTimer counts.
+*
+* Return:
+*  uint32_t: Duration in microseconds, saturated to UINT32_MAX.
+*
+*******************************************************************************/
+uint32_t app_timestamp_ticks_to_us(uint32_t ticks)
+{
+    uint64_t us;
+
+    if (0U == timestamp_tick_hz)
+    {
+        return 0U;
+    }
+
+    us = ((uint64_t)ticks * US_PER_SEC) / timestamp_tick_hz;
+
+    return (us > UINT32_MAX) ? UINT32_MAX : (uint32_t)us;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,72 @@
+/******************************************************************************
+* File Name: app_timestamp.h
+*
+* Description: This file is the public interface of app_timestamp.c. It provides
+* timestamps derived from the LPTimer used by the RTOS tickless idle mode, which
+* keeps counting while the device is in deep sleep.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef APP_TIMESTAMP_H_
+#define APP_TIMESTAMP_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+#include "cybsp.h"
+#include "mtb_hal.h"
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void app_timestamp_init(mtb_hal_lptimer_t *lptimer);
+uint32_t app_timestamp_ticks(void);
+uint32_t app_timestamp_tick_hz(void);
+uint32_t app_timestamp_ticks_to_us(uint32_t ticks);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* APP_TIMESTAMP_H_ */
+
+
+/* [] END OF FILE */
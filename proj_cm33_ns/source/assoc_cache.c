@@ -0,0 +1,428 @@
+/*******************************************************************************
+* File Name:   assoc_cache.c
+*
+* Description: This file contains the encoding of the association cache record
+* used by the fast reconnect path and the functions to load, save and validate
+* it. The record is a versioned little-endian structure protected by a CRC-32.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "assoc_cache.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define ASSOC_CACHE_MAGIC               (0x43435341UL)  /* "ASCC" */
+#define ASSOC_CACHE_HEADER_SIZE         (8U)
+#define ASSOC_CACHE_CRC_SIZE            (4U)
+#define CRC32_POLYNOMIAL                (0xEDB88320UL)
+#define ERASED_BYTE_FLASH               (0xFFU)
+#define ERASED_BYTE_ZERO                (0x00U)
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: put_u32 / get_u32
+********************************************************************************
+* Summary:
+*  Write and read a 32-bit value in little-endian byte order.
+*******************************************************************************/
+static uint8_t *put_u32(uint8_t *buffer, uint32_t value)
+{
+    buffer[0] = (uint8_t)(value);
+    buffer[1] = (uint8_t)(value >> 8U);
+    buffer[2] = (uint8_t)(value >> 16U);
+    buffer[3] = (uint8_t)(value >> 24U);
+
+    return buffer + sizeof(uint32_t);
+}
+
+static uint32_t get_u32(const uint8_t *buffer)
+{
+    return (uint32_t)buffer[0] | ((uint32_t)buffer[1] << 8U) |
+           ((uint32_t)buffer[2] << 16U) | ((uint32_t)buffer[3] << 24U);
+}
+
+/*******************************************************************************
+* Function Name: is_erased
+********************************************************************************
+* Summary:
+*  Returns true if the buffer holds only erased bytes.
+*******************************************************************************/
+static bool is_erased(const uint8_t *buffer, size_t len, uint8_t erased)
+{
+    for (size_t i = 0U; i < len; i++)
+    {
+        if (buffer[i] != erased)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: assoc_cache_crc32
+********************************************************************************
+* Summary:
+*  Computes the CRC-32 (IEEE 802.3) of a buffer. The bitwise implementation
+*  avoids a lookup table since the record is only checked at boot.
+*
+* Parameters:
+*  const uint8_t *data: Data to checksum.
+*  size_t len: Number of bytes.
+*
+* Return:
+*  uint32_t: CRC-32 of the data.
+*
+*******************************************************************************/
+uint32_t assoc_cache_crc32(const uint8_t *data, size_t len)
+{
+    uint32_t crc = 0xFFFFFFFFUL;
+
+    for (size_t i = 0U; i < len; i++)
+    {
+        crc ^= data[i];
+
+        for (uint32_t bit = 0U; bit < 8U; bit++)
+        {
+            crc = (0U != (crc & 1U)) ? ((crc >> 1U) ^ CRC32_POLYNOMIAL) :
+                    (crc >> 1U);
+        }
+    }
+
+    return ~crc;
+}
+
+/*******************************************************************************
+* Function Name: assoc_cache_encode
+********************************************************************************
+* Summary:
+*  Encodes a record in ASSOC_CACHE_RECORD_SIZE bytes: magic (4 bytes),
+*  version (1 byte), reserved (1 byte), payload length (2 bytes), payload and
+*  CRC-32 of everything before it.
+*
+* Parameters:
+*  const assoc_cache_record_t *record: Record to encode.
+*  uint8_t *buffer: Destination buffer.
+*  size_t size: Size of the destination buffer.
+*
+* Return:
+*  size_t: Number of bytes written, 0 if the buffer is too small.
+*
+*******************************************************************************/
+size_t assoc_cache_encode(const assoc_cache_record_t *record, uint8_t *buffer,
+        size_t size)
+{
+    uint8_t *pos = buffer;
+
+    if (size < ASSOC_CACHE_RECORD_SIZE)
+    {
+        return 0U;
+    }
+
+    memset(buffer, 0, ASSOC_CACHE_RECORD_SIZE);
+
+    pos = put_u32(pos, ASSOC_CACHE_MAGIC);
+    *pos++ = ASSOC_CACHE_RECORD_VERSION;
+    *pos++ = 0U;
+    *pos++ = (uint8_t)(ASSOC_CACHE_PAYLOAD_SIZE);
+    *pos++ = (uint8_t)(ASSOC_CACHE_PAYLOAD_SIZE >> 8U);
+
+    *pos++ = (record->ssid_len > ASSOC_CACHE_SSID_MAX_LEN) ?
+            ASSOC_CACHE_SSID_MAX_LEN : record->ssid_len;
+    memcpy(pos, record->ssid, ASSOC_CACHE_SSID_MAX_LEN);
+    pos += ASSOC_CACHE_SSID_MAX_LEN;
+    pos = put_u32(pos, record->security);
+    pos = put_u32(pos, record->credential_check);
+    memcpy(pos, record->bssid, ASSOC_CACHE_BSSID_LEN);
+    pos += ASSOC_CACHE_BSSID_LEN;
+    *pos++ = record->channel;
+    *pos++ = record->band;
+    *pos++ = record->pmk_valid ? 1U : 0U;
+    memcpy(pos, record->pmk, ASSOC_CACHE_PMK_LEN);
+    pos += ASSOC_CACHE_PMK_LEN;
+    *pos++ = record->ip_valid ? 1U : 0U;
+    pos = put_u32(pos, record->ip_address);
+    pos = put_u32(pos, record->netmask);
+    pos = put_u32(pos, record->gateway);
+
+    pos = put_u32(pos, assoc_cache_crc32(buffer, (size_t)(pos - buffer)));
+
+    return (size_t)(pos - buffer);
+}
+
+/*******************************************************************************
+* Function Name: assoc_cache_decode
+********************************************************************************
+* Summary:
+*  Decodes and validates a record written by assoc_cache_encode().
+*
+* Parameters:
+*  const uint8_t *buffer: Encoded record.
+*  size_t len: Number of bytes in the buffer.
+*  assoc_cache_record_t *record: Filled with the decoded record.
+*
+* Return:
+*  assoc_cache_status_t: ASSOC_CACHE_OK if the record is valid.
+*
+*******************************************************************************/
+assoc_cache_status_t assoc_cache_decode(const uint8_t *buffer, size_t len,
+        assoc_cache_record_t *record)
+{
+    const uint8_t *pos = buffer;
+    size_t crc_offset = ASSOC_CACHE_HEADER_SIZE + ASSOC_CACHE_PAYLOAD_SIZE;
+    uint32_t payload_len;
+
+    memset(record, 0, sizeof(assoc_cache_record_t));
+
+    if (len < ASSOC_CACHE_RECORD_SIZE)
+    {
+        return ASSOC_CACHE_BAD_FORMAT;
+    }
+
+    if (is_erased(buffer, ASSOC_CACHE_RECORD_SIZE, ERASED_BYTE_FLASH) ||
+        is_erased(buffer, ASSOC_CACHE_RECORD_SIZE, ERASED_BYTE_ZERO))
+    {
+        return ASSOC_CACHE_EMPTY;
+    }
+
+    payload_len = (uint32_t)buffer[6] | ((uint32_t)buffer[7] << 8U);
+
+    if ((ASSOC_CACHE_MAGIC != get_u32(buffer)) ||
+        (ASSOC_CACHE_RECORD_VERSION != buffer[4]) ||
+        (ASSOC_CACHE_PAYLOAD_SIZE != payload_len))
+    {
+        return ASSOC_CACHE_BAD_FORMAT;
+    }
+
+    if (assoc_cache_crc32(buffer, crc_offset) != get_u32(&buffer[crc_offset]))
+    {
+        return ASSOC_CACHE_BAD_CRC;
+    }
+
+    pos += ASSOC_CACHE_HEADER_SIZE;
+
+    record->ssid_len = *pos++;
+    if (record->ssid_len > ASSOC_CACHE_SSID_MAX_LEN)
+    {
+        return ASSOC_CACHE_BAD_FORMAT;
+    }
+    memcpy(record->ssid, pos, ASSOC_CACHE_SSID_MAX_LEN);
+    pos += ASSOC_CACHE_SSID_MAX_LEN;
+    record->security = get_u32(pos);
+    pos += sizeof(uint32_t);
+    record->credential_check = get_u32(pos);
+    pos += sizeof(uint32_t);
+    memcpy(record->bssid, pos, ASSOC_CACHE_BSSID_LEN);
+    pos += ASSOC_CACHE_BSSID_LEN;
+    record->channel = *pos++;
+    record->band = *pos++;
+    record->pmk_valid = (0U != *pos++);
+    memcpy(record->pmk, pos, ASSOC_CACHE_PMK_LEN);
+    pos += ASSOC_CACHE_PMK_LEN;
+    record->ip_valid = (0U != *pos++);
+    record->ip_address = get_u32(pos);
+    pos += sizeof(uint32_t);
+    record->netmask = get_u32(pos);
+    pos += sizeof(uint32_t);
+    record->gateway = get_u32(pos);
+
+    return ASSOC_CACHE_OK;
+}
+
+/*******************************************************************************
+* Function Name: assoc_cache_load
+********************************************************************************
+* Summary:
+*  Reads and decodes the record held by the storage.
+*
+* Parameters:
+*  const assoc_cache_storage_t *storage: Storage to read.
+*  assoc_cache_record_t *record: Filled with the decoded record.
+*
+* Return:
+*  assoc_cache_status_t: ASSOC_CACHE_OK if a valid record was read.
+*
+*******************************************************************************/
+assoc_cache_status_t assoc_cache_load(const assoc_cache_storage_t *storage,
+        assoc_cache_record_t *record)
+{
+    uint8_t buffer[ASSOC_CACHE_RECORD_SIZE];
+
+    if (!storage->read(storage->context, buffer, sizeof(buffer)))
+    {
+        memset(record, 0, sizeof(assoc_cache_record_t));
+        return ASSOC_CACHE_STORAGE_ERROR;
+    }
+
+    return assoc_cache_decode(buffer, sizeof(buffer), record);
+}
+
+/*******************************************************************************
+* Function Name: assoc_cache_save
+********************************************************************************
+* Summary:
+*  Encodes a record and writes it to the storage. The storage is not written
+*  when it already holds the same encoded record, so that saving after every
+*  reconnect or roam does not wear the non-volatile memory.
+*
+* Parameters:
+*  const assoc_cache_storage_t *storage: Storage to write.
+*  const assoc_cache_record_t *record: Record to save.
+*
+* Return:
+*  bool: true if the storage holds the record.
+*
+*******************************************************************************/
+bool assoc_cache_save(const assoc_cache_storage_t *storage,
+        const assoc_cache_record_t *record)
+{
+    uint8_t buffer[ASSOC_CACHE_RECORD_SIZE];
+    uint8_t stored[ASSOC_CACHE_RECORD_SIZE];
+    size_t len = assoc_cache_encode(record, buffer, sizeof(buffer));
+    bool same;
+
+    if (0U == len)
+    {
+        return false;
+    }
+
+    same = storage->read(storage->context, stored, len) &&
+            (0 == memcmp(stored, buffer, len));
+    memset(stored, 0, sizeof(stored));
+
+    return same || storage->write(storage->context, buffer, len);
+}
+
+/*******************************************************************************
+* Function Name: assoc_cache_invalidate
+********************************************************************************
+* Summary:
+*  Erases the record so that the next connection takes the full path.
+*
+* Parameters:
+*  const assoc_cache_storage_t *storage: Storage to erase.
+*
+* Return:
+*  bool: true if the record was erased.
+*
+*******************************************************************************/
+bool assoc_cache_invalidate(const assoc_cache_storage_t *storage)
+{
+    return storage->erase(storage->context);
+}
+
+/*******************************************************************************
+* Function Name: assoc_cache_matches
+********************************************************************************
+* Summary:
+*  Checks that a record was saved for the configured network. A change of
+*  SSID, security type or passphrase invalidates the cached BSSID and PMK.
+*
+* Parameters:
+*  const assoc_cache_record_t *record: Decoded record.
+*  const uint8_t *ssid: Configured SSID.
+*  size_t ssid_len: Length of the configured SSID.
+*  uint32_t security: Configured security type.
+*  const uint8_t *passphrase: Configured passphrase.
+*  size_t passphrase_len: Length of the configured passphrase.
+*
+* Return:
+*  bool: true if the record can be used for a fast reconnect.
+*
+*******************************************************************************/
+bool assoc_cache_matches(const assoc_cache_record_t *record,
+        const uint8_t *ssid, size_t ssid_len, uint32_t security,
+        const uint8_t *passphrase, size_t passphrase_len)
+{
+    return (ssid_len == record->ssid_len) &&
+           (0 == memcmp(ssid, record->ssid, ssid_len)) &&
+           (security == record->security) &&
+           (assoc_cache_crc32(passphrase, passphrase_len) ==
+                   record->credential_check);
+}
+
+/*******************************************************************************
+* Function Name: assoc_cache_reuse_pmk
+********************************************************************************
+* Summary:
+*  Copies the PMK of the stored record if it was derived for the same network
+*  and passphrase, so that saving a new record for the same credentials does
+*  not repeat the PBKDF2 derivation.
+*
+* Parameters:
+*  const assoc_cache_storage_t *storage: Storage holding the previous record.
+*  const uint8_t *ssid: Configured SSID.
+*  size_t ssid_len: Length of the configured SSID.
+*  uint32_t security: Configured security type.
+*  const uint8_t *passphrase: Configured passphrase.
+*  size_t passphrase_len: Length of the configured passphrase.
+*  uint8_t *pmk: Filled with ASSOC_CACHE_PMK_LEN bytes if the PMK is reused.
+*
+* Return:
+*  bool: true if the stored PMK was copied.
+*
+*******************************************************************************/
+bool assoc_cache_reuse_pmk(const assoc_cache_storage_t *storage,
+        const uint8_t *ssid, size_t ssid_len, uint32_t security,
+        const uint8_t *passphrase, size_t passphrase_len, uint8_t *pmk)
+{
+    assoc_cache_record_t record;
+    bool reused;
+
+    reused = (ASSOC_CACHE_OK == assoc_cache_load(storage, &record)) &&
+             record.pmk_valid &&
+             assoc_cache_matches(&record, ssid, ssid_len, security,
+                     passphrase, passphrase_len);
+
+    if (reused)
+    {
+        memcpy(pmk, record.pmk, ASSOC_CACHE_PMK_LEN);
+    }
+
+    /* Do not leave a copy of the PMK on the stack */
+    memset(&record, 0, sizeof(record));
+
+    return reused;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,150 @@
+/******************************************************************************
+* File Name: assoc_cache.h
+*
+* Description: This file is the public interface of assoc_cache.c. It contains
+* the association cache record persisted across resets for the fast reconnect
+* path, its versioned binary encoding and the storage interface used to read and
+* write it.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef ASSOC_CACHE_H_
+#define ASSOC_CACHE_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+/* This module has no device dependencies so that the record codec and the
+ * fallback decisions can also be built for the host machine with a
+ * file-backed store.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+#define ASSOC_CACHE_RECORD_VERSION      (1U)
+
+#define ASSOC_CACHE_SSID_MAX_LEN        (32U)
+#define ASSOC_CACHE_BSSID_LEN           (6U)
+#define ASSOC_CACHE_PMK_LEN             (32U)
+
+/* Size in bytes of an encoded record: 8 bytes of header, the payload and a
+ * 4-byte CRC-32.
+ */
+#define ASSOC_CACHE_PAYLOAD_SIZE        (1U + ASSOC_CACHE_SSID_MAX_LEN + 4U + \
+                                         4U + ASSOC_CACHE_BSSID_LEN + 2U + \
+                                         1U + ASSOC_CACHE_PMK_LEN + 1U + 12U)
+#define ASSOC_CACHE_RECORD_SIZE         (8U + ASSOC_CACHE_PAYLOAD_SIZE + 4U)
+
+/*******************************************************************************
+* Enumerations
+*******************************************************************************/
+/* Result of decoding or loading a record */
+typedef enum
+{
+    ASSOC_CACHE_OK = 0,
+    ASSOC_CACHE_EMPTY,          /* No record was ever written */
+    ASSOC_CACHE_BAD_FORMAT,     /* Unknown magic, version or length */
+    ASSOC_CACHE_BAD_CRC,        /* Record corrupted */
+    ASSOC_CACHE_STORAGE_ERROR   /* Storage could not be read */
+} assoc_cache_status_t;
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Association parameters of the last successful connection */
+typedef struct
+{
+    uint8_t  ssid_len;
+    uint8_t  ssid[ASSOC_CACHE_SSID_MAX_LEN];
+    uint32_t security;              /* cy_wcm_security_t of the connection */
+    uint32_t credential_check;      /* CRC-32 of the passphrase */
+    uint8_t  bssid[ASSOC_CACHE_BSSID_LEN];
+    uint8_t  channel;
+    uint8_t  band;                  /* cy_wcm_wifi_band_t of the connection */
+    bool     pmk_valid;
+    uint8_t  pmk[ASSOC_CACHE_PMK_LEN];
+    bool     ip_valid;
+    uint32_t ip_address;            /* IPv4 lease, network byte order */
+    uint32_t netmask;
+    uint32_t gateway;
+} assoc_cache_record_t;
+
+/* Non-volatile storage holding one encoded record */
+typedef struct
+{
+    bool (*read)(void *context, uint8_t *buffer, size_t size);
+    bool (*write)(void *context, const uint8_t *buffer, size_t size);
+    bool (*erase)(void *context);
+    void *context;
+} assoc_cache_storage_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+uint32_t assoc_cache_crc32(const uint8_t *data, size_t len);
+size_t assoc_cache_encode(const assoc_cache_record_t *record, uint8_t *buffer,
+        size_t size);
+assoc_cache_status_t assoc_cache_decode(const uint8_t *buffer, size_t len,
+        assoc_cache_record_t *record);
+assoc_cache_status_t assoc_cache_load(const assoc_cache_storage_t *storage,
+        assoc_cache_record_t *record);
+bool assoc_cache_save(const assoc_cache_storage_t *storage,
+        const assoc_cache_record_t *record);
+bool assoc_cache_invalidate(const assoc_cache_storage_t *storage);
+bool assoc_cache_matches(const assoc_cache_record_t *record,
+        const uint8_t *ssid, size_t ssid_len, uint32_t security,
+        const uint8_t *passphrase, size_t passphrase_len);
+bool assoc_cache_reuse_pmk(const assoc_cache_storage_t *storage,
+        const uint8_t *ssid, size_t ssid_len, uint32_t security,
+        const uint8_t *passphrase, size_t passphrase_len, uint8_t *pmk);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* ASSOC_CACHE_H_ */
+
+
+/* [] END OF FILE */
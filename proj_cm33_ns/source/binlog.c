@@ -0,0 +1,294 @@
+/*******************************************************************************
+* File Name:   binlog.c
+*
+* Description: This file contains the binary log. Messages are recorded in a
+* lock-free ring as the address of their format string, a timestamp and their
+* raw arguments, which can be done from any task or interrupt in a few tens of
+* cycles. The ring is drained in bulk by the application when the system is
+* awake, and the text is rebuilt on the host by tools/binlog_decode.py from the
+* format strings of the ELF file.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "binlog.h"
+
+#include <stdatomic.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BINLOG_SLOT_MASK                (BINLOG_SLOTS - 1U)
+#define BINLOG_LEVEL_SHIFT              (8U)
+#define BINLOG_NARGS_MASK               (0xFFU)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Recorded message. The format address is written last and is 0 while the
+ * message is being recorded, so the reader never sees a partial message.
+ */
+typedef struct
+{
+    atomic_uintptr_t fmt;
+    uint32_t timestamp;
+    uint32_t level_nargs;
+    uint32_t args[BINLOG_MAX_ARGS];
+} binlog_slot_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Writers reserve slots by advancing head with a compare-and-swap. The single
+ * reader advances tail.
+ */
+static binlog_slot_t binlog_slots[BINLOG_SLOTS];
+static atomic_uint_fast32_t binlog_head;
+static atomic_uint_fast32_t binlog_tail;
+static atomic_uint_fast32_t binlog_dropped;
+static binlog_timestamp_fn_t binlog_timestamp;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: put_u32
+********************************************************************************
+* Summary:
+*  Writes a 32-bit value in little-endian byte order and updates the
+*  checksum of the frame.
+*******************************************************************************/
+static uint8_t *put_u32(uint8_t *buffer, uint32_t value, uint8_t *checksum)
+{
+    for (uint32_t i = 0U; i < sizeof(uint32_t); i++)
+    {
+        buffer[i] = (uint8_t)(value >> (8U * i));
+        *checksum ^= buffer[i];
+    }
+
+    return buffer + sizeof(uint32_t);
+}
+
+/*******************************************************************************
+* Function Name: encode_frame
+********************************************************************************
+* Summary:
+*  Encodes a message in the frame format described in binlog.h.
+*
+* Return:
+*  uint32_t: Size of the frame.
+*******************************************************************************/
+static uint32_t encode_frame(uint8_t *frame, uint32_t fmt, uint32_t timestamp,
+        uint32_t level, uint32_t nargs, const uint32_t *args)
+{
+    uint8_t checksum = 0U;
+    uint8_t *pos = &frame[2];
+
+    pos = put_u32(pos, fmt, &checksum);
+    pos = put_u32(pos, timestamp, &checksum);
+    *pos = (uint8_t)level;
+    checksum ^= *pos++;
+    *pos = (uint8_t)nargs;
+    checksum ^= *pos++;
+
+    for (uint32_t i = 0U; i < nargs; i++)
+    {
+        pos = put_u32(pos, args[i], &checksum);
+    }
+
+    *pos++ = checksum;
+
+    frame[0] = BINLOG_FRAME_SYNC;
+    frame[1] = (uint8_t)(pos - &frame[2]);
+
+    return (uint32_t)(pos - frame);
+}
+
+/*******************************************************************************
+* Function Name: binlog_init
+********************************************************************************
+* Summary:
+*  Empties the ring and sets the source of the message timestamps.
+*
+* Parameters:
+*  binlog_timestamp_fn_t timestamp: Returns the current time. Can be NULL.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void binlog_init(binlog_timestamp_fn_t timestamp)
+{
+    for (uint32_t i = 0U; i < BINLOG_SLOTS; i++)
+    {
+        atomic_store_explicit(&binlog_slots[i].fmt, 0U, memory_order_relaxed);
+    }
+
+    atomic_store_explicit(&binlog_head, 0U, memory_order_relaxed);
+    atomic_store_explicit(&binlog_tail, 0U, memory_order_relaxed);
+    atomic_store_explicit(&binlog_dropped, 0U, memory_order_relaxed);
+    binlog_timestamp = timestamp;
+}
+
+/*******************************************************************************
+* Function Name: binlog_write
+********************************************************************************
+* Summary:
+*  Records a message. Lock-free, so it can be called from any task or
+*  interrupt. Use the BINLOG macro rather than calling it directly.
+*
+* Parameters:
+*  uint32_t level: BINLOG_LEVEL_INFO or BINLOG_LEVEL_ERROR.
+*  const char *fmt: Format string. Must be a string literal.
+*  uint32_t nargs: Number of arguments.
+*  const uint32_t *args: Arguments.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void binlog_write(uint32_t level, const char *fmt, uint32_t nargs,
+        const uint32_t *args)
+{
+    uint_fast32_t head = atomic_load_explicit(&binlog_head,
+            memory_order_relaxed);
+    binlog_slot_t *slot;
+
+    /* Reserve a slot, or drop the message if the ring is full */
+    do
+    {
+        if ((uint32_t)(head - atomic_load_explicit(&binlog_tail,
+                memory_order_acquire)) >= BINLOG_SLOTS)
+        {
+            atomic_fetch_add_explicit(&binlog_dropped, 1U,
+                    memory_order_relaxed);
+            return;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&binlog_head, &head,
+            head + 1U, memory_order_relaxed, memory_order_relaxed));
+
+    slot = &binlog_slots[head & BINLOG_SLOT_MASK];
+
+    if (nargs > BINLOG_MAX_ARGS)
+    {
+        nargs = BINLOG_MAX_ARGS;
+    }
+
+    slot->timestamp = (NULL != binlog_timestamp) ? binlog_timestamp() : 0U;
+    slot->level_nargs = (level << BINLOG_LEVEL_SHIFT) | nargs;
+
+    for (uint32_t i = 0U; i < nargs; i++)
+    {
+        slot->args[i] = args[i];
+    }
+
+    /* Publish the message */
+    atomic_store_explicit(&slot->fmt, (uintptr_t)fmt, memory_order_release);
+}
+
+/*******************************************************************************
+* Function Name: binlog_drain
+********************************************************************************
+* Summary:
+*  Writes the recorded messages to the output, oldest first, and frees their
+*  slots. Stops at a message that is still being recorded. If messages were
+*  dropped, a frame reporting their number is written last. Must only be
+*  called from one task.
+*
+* Parameters:
+*  binlog_output_fn_t output: Sink of the frames.
+*
+* Return:
+*  uint32_t: Number of messages written.
+*
+*******************************************************************************/
+uint32_t binlog_drain(binlog_output_fn_t output)
+{
+    uint8_t frame[BINLOG_FRAME_MAX_SIZE];
+    uint_fast32_t tail = atomic_load_explicit(&binlog_tail,
+            memory_order_relaxed);
+    uint32_t count = 0U;
+    uint32_t dropped;
+    binlog_slot_t *slot;
+    uintptr_t fmt;
+
+    while (tail != atomic_load_explicit(&binlog_head, memory_order_acquire))
+    {
+        slot = &binlog_slots[tail & BINLOG_SLOT_MASK];
+        fmt = atomic_load_explicit(&slot->fmt, memory_order_acquire);
+
+        if (0U == fmt)
+        {
+            break;
+        }
+
+        output(frame, encode_frame(frame, (uint32_t)fmt, slot->timestamp,
+                slot->level_nargs >> BINLOG_LEVEL_SHIFT,
+                slot->level_nargs & BINLOG_NARGS_MASK, slot->args));
+
+        atomic_store_explicit(&slot->fmt, 0U, memory_order_relaxed);
+        tail++;
+        atomic_store_explicit(&binlog_tail, tail, memory_order_release);
+        count++;
+    }
+
+    dropped = (uint32_t)atomic_exchange_explicit(&binlog_dropped, 0U,
+            memory_order_relaxed);
+
+    if (0U != dropped)
+    {
+        output(frame, encode_frame(frame, 0U,
+                (NULL != binlog_timestamp) ? binlog_timestamp() : 0U,
+                BINLOG_LEVEL_ERROR, 1U, &dropped));
+    }
+
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: binlog_pending
+********************************************************************************
+* Summary:
+*  Returns the number of messages recorded and not drained yet.
+*
+*******************************************************************************/
+uint32_t binlog_pending(void)
+{
+    return (uint32_t)(atomic_load_explicit(&binlog_head, memory_order_acquire)
+            - atomic_load_explicit(&binlog_tail, memory_order_acquire));
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,164 @@
+/******************************************************************************
+* File Name: binlog.h
+*
+* Description: This file is the public interface of binlog.c. It contains the
+* macros that record a log message as the address of its format string and its
+* raw arguments, and the function that drains the recorded messages in bulk.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef BINLOG_H_
+#define BINLOG_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+/* This module has no device dependencies so that it can also be built for the
+ * host machine.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+/* Number of messages the ring holds. Must be a power of two. Messages logged
+ * while the ring is full are dropped and counted.
+ */
+#define BINLOG_SLOTS                    (64U)
+
+/* Maximum number of arguments of a message */
+#define BINLOG_MAX_ARGS                 (8U)
+
+#define BINLOG_LEVEL_INFO               (0U)
+#define BINLOG_LEVEL_ERROR              (1U)
+
+/* Frame written for every message by binlog_drain():
+ *   BINLOG_FRAME_SYNC, length of the rest of the frame (1 byte),
+ *   format string address (4 bytes), timestamp (4 bytes), level (1 byte),
+ *   number of arguments (1 byte), arguments (4 bytes each), and the XOR of
+ *   all the previous bytes after the length (1 byte).
+ * All values are little-endian. The sync byte is not a printable character,
+ * so frames can be interleaved with text on the same UART. A message with a
+ * format address of 0 reports the number of dropped messages in its argument.
+ */
+#define BINLOG_FRAME_SYNC               (0xA5U)
+#define BINLOG_FRAME_MAX_SIZE           (2U + 4U + 4U + 1U + 1U + \
+                                         (4U * BINLOG_MAX_ARGS) + 1U)
+
+/* Records a message with up to BINLOG_MAX_ARGS integer or pointer arguments.
+ * Usage: BINLOG(BINLOG_LEVEL_INFO, "value %lu\n", (unsigned long)value);
+ * The format string must be a string literal and '%s' arguments must point
+ * to constant strings, since only addresses are recorded. The strings are
+ * resolved from the ELF file by the decoder.
+ */
+#define BINLOG(level, ...)              BINLOG_CAT(BINLOG_, \
+                                            BINLOG_COUNT(__VA_ARGS__)) \
+                                            ((level), __VA_ARGS__)
+#define BINLOG_INFO(...)                BINLOG(BINLOG_LEVEL_INFO, __VA_ARGS__)
+#define BINLOG_ERROR(...)               BINLOG(BINLOG_LEVEL_ERROR, __VA_ARGS__)
+
+/* Helpers of the BINLOG macro: count the arguments including the format
+ * string, and record every argument as a 32-bit value.
+ */
+#define BINLOG_CAT(a, b)                BINLOG_CAT_(a, b)
+#define BINLOG_CAT_(a, b)               a##b
+#define BINLOG_COUNT(...)               BINLOG_COUNT_(__VA_ARGS__, \
+                                            9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define BINLOG_COUNT_(_1, _2, _3, _4, _5, _6, _7, _8, _9, n, ...) n
+#define BINLOG_U32(x)                   ((uint32_t)(uintptr_t)(x))
+
+#define BINLOG_1(level, fmt) \
+    binlog_write((level), (fmt), 0U, NULL)
+#define BINLOG_2(level, fmt, a) \
+    binlog_write((level), (fmt), 1U, (const uint32_t[]){ BINLOG_U32(a) })
+#define BINLOG_3(level, fmt, a, b) \
+    binlog_write((level), (fmt), 2U, (const uint32_t[]){ BINLOG_U32(a), \
+            BINLOG_U32(b) })
+#define BINLOG_4(level, fmt, a, b, c) \
+    binlog_write((level), (fmt), 3U, (const uint32_t[]){ BINLOG_U32(a), \
+            BINLOG_U32(b), BINLOG_U32(c) })
+#define BINLOG_5(level, fmt, a, b, c, d) \
+    binlog_write((level), (fmt), 4U, (const uint32_t[]){ BINLOG_U32(a), \
+            BINLOG_U32(b), BINLOG_U32(c), BINLOG_U32(d) })
+#define BINLOG_6(level, fmt, a, b, c, d, e) \
+    binlog_write((level), (fmt), 5U, (const uint32_t[]){ BINLOG_U32(a), \
+            BINLOG_U32(b), BINLOG_U32(c), BINLOG_U32(d), BINLOG_U32(e) })
+#define BINLOG_7(level, fmt, a, b, c, d, e, f) \
+    binlog_write((level), (fmt), 6U, (const uint32_t[]){ BINLOG_U32(a), \
+            BINLOG_U32(b), BINLOG_U32(c), BINLOG_U32(d), BINLOG_U32(e), \
+            BINLOG_U32(f) })
+#define BINLOG_8(level, fmt, a, b, c, d, e, f, g) \
+    binlog_write((level), (fmt), 7U, (const uint32_t[]){ BINLOG_U32(a), \
+            BINLOG_U32(b), BINLOG_U32(c), BINLOG_U32(d), BINLOG_U32(e), \
+            BINLOG_U32(f), BINLOG_U32(g) })
+#define BINLOG_9(level, fmt, a, b, c, d, e, f, g, h) \
+    binlog_write((level), (fmt), 8U, (const uint32_t[]){ BINLOG_U32(a), \
+            BINLOG_U32(b), BINLOG_U32(c), BINLOG_U32(d), BINLOG_U32(e), \
+            BINLOG_U32(f), BINLOG_U32(g), BINLOG_U32(h) })
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Source of the message timestamps */
+typedef uint32_t (*binlog_timestamp_fn_t)(void);
+
+/* Sink of the frames written by binlog_drain() */
+typedef void (*binlog_output_fn_t)(const uint8_t *data, uint32_t size);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void binlog_init(binlog_timestamp_fn_t timestamp);
+void binlog_write(uint32_t level, const char *fmt, uint32_t nargs,
+        const uint32_t *args);
+uint32_t binlog_drain(binlog_output_fn_t output);
+uint32_t binlog_pending(void);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* BINLOG_H_ */
+
+
+/* [] END OF FILE */
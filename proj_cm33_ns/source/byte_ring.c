@@ -0,0 +1,189 @@
+/*******************************************************************************
+* File Name:   byte_ring.c
+*
+* Description: This file contains a byte ring buffer with one producer and one
+* consumer.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "byte_ring.h"
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <string.h>
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: byte_ring_init
+********************************************************************************
+* Summary:
+*  Initializes an empty ring over a buffer.
+*
+* Parameters:
+*  byte_ring_t *ring: Ring to initialize.
+*  uint8_t *buffer: Storage of the ring.
+*  uint32_t size: Size of the buffer. Must be a power of two.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void byte_ring_init(byte_ring_t *ring, uint8_t *buffer, uint32_t size)
+{
+    ring->buffer = buffer;
+    ring->size = size;
+    ring->head = 0U;
+    ring->tail = 0U;
+}
+
+/*******************************************************************************
+* Function Name: byte_ring_used
+********************************************************************************
+* Summary:
+*  Returns the number of bytes in the ring.
+*
+*******************************************************************************/
+uint32_t byte_ring_used(const byte_ring_t *ring)
+{
+    return ring->head - ring->tail;
+}
+
+/*******************************************************************************
+* Function Name: byte_ring_free
+********************************************************************************
+* Summary:
+*  Returns the number of bytes that can be written to the ring.
+*
+*******************************************************************************/
+uint32_t byte_ring_free(const byte_ring_t *ring)
+{
+    return ring->size - byte_ring_used(ring);
+}
+
+/*******************************************************************************
+* Function Name: byte_ring_write
+********************************************************************************
+* Summary:
+*  Copies as many bytes as fit into the ring. Called by the producer only.
+*
+* Parameters:
+*  byte_ring_t *ring: Ring to write.
+*  const uint8_t *data: Bytes to write.
+*  uint32_t len: Number of bytes.
+*
+* Return:
+*  uint32_t: Number of bytes written.
+*
+*******************************************************************************/
+uint32_t byte_ring_write(byte_ring_t *ring, const uint8_t *data, uint32_t len)
+{
+    uint32_t head = ring->head;
+    uint32_t offset = head & (ring->size - 1U);
+    uint32_t first;
+
+    if (len > byte_ring_free(ring))
+    {
+        len = byte_ring_free(ring);
+    }
+
+    first = ring->size - offset;
+    if (first > len)
+    {
+        first = len;
+    }
+
+    memcpy(&ring->buffer[offset], data, first);
+    memcpy(ring->buffer, &data[first], len - first);
+
+    /* Publish the bytes once they are copied. The producer and the consumer
+     * run on the same core, so a compiler barrier is enough.
+     */
+    atomic_signal_fence(memory_order_release);
+    ring->head = head + len;
+
+    return len;
+}
+
+/*******************************************************************************
+* Function Name: byte_ring_peek
+********************************************************************************
+* Summary:
+*  Returns the oldest bytes of the ring that are contiguous in the buffer.
+*  Called by the consumer only.
+*
+* Parameters:
+*  const byte_ring_t *ring: Ring to read.
+*  const uint8_t **data: Set to the oldest byte.
+*
+* Return:
+*  uint32_t: Number of contiguous bytes at *data.
+*
+*******************************************************************************/
+uint32_t byte_ring_peek(const byte_ring_t *ring, const uint8_t **data)
+{
+    uint32_t offset = ring->tail & (ring->size - 1U);
+    uint32_t used = byte_ring_used(ring);
+    uint32_t contiguous = ring->size - offset;
+
+    atomic_signal_fence(memory_order_acquire);
+    *data = &ring->buffer[offset];
+
+    return (used < contiguous) ? used : contiguous;
+}
+
+/*******************************************************************************
+* Function Name: byte_ring_consume
+********************************************************************************
+* Summary:
+*  Removes bytes returned by byte_ring_peek(). Called by the consumer only.
+*
+* Parameters:
+*  byte_ring_t *ring: Ring to update.
+*  uint32_t len: Number of bytes to remove.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void byte_ring_consume(byte_ring_t *ring, uint32_t len)
+{
+    ring->tail += len;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,92 @@
+/******************************************************************************
+* File Name: byte_ring.h
+*
+* Description: This file is the public interface of byte_ring.c. It contains a
+* byte ring buffer with one producer and one consumer, used to queue the debug
+* UART output for the TX interrupt.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef BYTE_RING_H_
+#define BYTE_RING_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+/* This module has no device dependencies so that it can also be built for the
+ * host machine.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Ring buffer. The size must be a power of two. The indices run freely and
+ * are only written by the producer (head) and the consumer (tail), so the
+ * producer and the consumer can run in different contexts without a lock.
+ */
+typedef struct
+{
+    uint8_t *buffer;
+    uint32_t size;
+    volatile uint32_t head;
+    volatile uint32_t tail;
+} byte_ring_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void byte_ring_init(byte_ring_t *ring, uint8_t *buffer, uint32_t size);
+uint32_t byte_ring_write(byte_ring_t *ring, const uint8_t *data, uint32_t len);
+uint32_t byte_ring_peek(const byte_ring_t *ring, const uint8_t **data);
+void byte_ring_consume(byte_ring_t *ring, uint32_t len);
+uint32_t byte_ring_used(const byte_ring_t *ring);
+uint32_t byte_ring_free(const byte_ring_t *ring);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* BYTE_RING_H_ */
+
+
+/* [] END OF FILE */
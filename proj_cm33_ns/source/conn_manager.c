@@ -0,0 +1,279 @@
+/*******************************************************************************
+* File Name:   conn_manager.c
+*
+* Description: This file contains the connection state machine. Failed
+* connection attempts are retried after a delay that doubles up to a maximum and
+* is randomized so that devices restarting together do not retry in lockstep. A
+* lost link restarts the attempts.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "conn_manager.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define PERCENT                         (100U)
+#define BACKOFF_MULTIPLIER              (2U)
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: next_random
+********************************************************************************
+* Summary:
+*  Returns the next value of a xorshift32 generator. Good enough to spread
+*  the retries, and deterministic for a given seed.
+*******************************************************************************/
+static uint32_t next_random(conn_manager_t *manager)
+{
+    uint32_t x = manager->random;
+
+    x ^= x << 13U;
+    x ^= x >> 17U;
+    x ^= x << 5U;
+    manager->random = x;
+
+    return x;
+}
+
+/*******************************************************************************
+* Function Name: jittered_delay
+********************************************************************************
+* Summary:
+*  Returns the delay randomized uniformly by +/- jitter_percent.
+*******************************************************************************/
+static uint32_t jittered_delay(conn_manager_t *manager, uint32_t delay_ms)
+{
+    uint32_t jitter_ms = (uint32_t)(((uint64_t)delay_ms *
+            manager->config.jitter_percent) / PERCENT);
+
+    if (0U == jitter_ms)
+    {
+        return delay_ms;
+    }
+
+    return (delay_ms - jitter_ms) +
+            (next_random(manager) % ((2U * jitter_ms) + 1U));
+}
+
+/*******************************************************************************
+* Function Name: conn_manager_init
+********************************************************************************
+* Summary:
+*  Initializes the state machine in the disconnected state.
+*
+* Parameters:
+*  conn_manager_t *manager: State machine to initialize.
+*  const conn_manager_config_t *config: Backoff parameters.
+*  uint32_t seed: Seed of the jitter. Use a value unique to the device.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void conn_manager_init(conn_manager_t *manager,
+        const conn_manager_config_t *config, uint32_t seed)
+{
+    memset(manager, 0, sizeof(conn_manager_t));
+    manager->config = *config;
+    manager->state = CONN_STATE_DISCONNECTED;
+    manager->delay_ms = config->initial_delay_ms;
+
+    /* xorshift32 never leaves the zero state */
+    manager->random = (0U != seed) ? seed : 1U;
+}
+
+/*******************************************************************************
+* Function Name: conn_manager_next
+********************************************************************************
+* Summary:
+*  Returns the next action to take. An attempt is requested when the
+*  manager is disconnected or when the backoff delay has elapsed, and the
+*  manager then waits for the result of the attempt.
+*
+* Parameters:
+*  conn_manager_t *manager: State machine.
+*  uint32_t now_ms: Current time, in milliseconds.
+*  uint32_t *wait_ms: Set to the remaining delay for CONN_ACTION_WAIT.
+*
+* Return:
+*  conn_action_t: Action to take.
+*
+*******************************************************************************/
+conn_action_t conn_manager_next(conn_manager_t *manager, uint32_t now_ms,
+        uint32_t *wait_ms)
+{
+    *wait_ms = 0U;
+
+    if (CONN_STATE_BACKOFF == manager->state)
+    {
+        /* Signed difference so that the clock can wrap */
+        if ((int32_t)(manager->retry_at_ms - now_ms) > 0)
+        {
+            *wait_ms = manager->retry_at_ms - now_ms;
+            return CONN_ACTION_WAIT;
+        }
+
+        manager->state = CONN_STATE_DISCONNECTED;
+    }
+
+    if (CONN_STATE_DISCONNECTED != manager->state)
+    {
+        return CONN_ACTION_NONE;
+    }
+
+    manager->state = CONN_STATE_CONNECTING;
+    manager->attempts++;
+    manager->total_attempts++;
+
+    return CONN_ACTION_CONNECT;
+}
+
+/*******************************************************************************
+* Function Name: conn_manager_result
+********************************************************************************
+* Summary:
+*  Reports the result of the attempt requested by conn_manager_next(). A
+*  success resets the backoff. A failure schedules the next attempt after the
+*  current delay, randomized, and doubles the delay up to max_delay_ms.
+*
+* Parameters:
+*  conn_manager_t *manager: State machine.
+*  bool connected: true if the attempt succeeded.
+*  uint32_t now_ms: Current time, in milliseconds.
+*
+* Return:
+*  uint32_t: Delay before the next attempt, 0 if connected.
+*
+*******************************************************************************/
+uint32_t conn_manager_result(conn_manager_t *manager, bool connected,
+        uint32_t now_ms)
+{
+    uint32_t delay_ms;
+
+    if (CONN_STATE_CONNECTING != manager->state)
+    {
+        return 0U;
+    }
+
+    if (connected)
+    {
+        manager->state = CONN_STATE_CONNECTED;
+        manager->delay_ms = manager->config.initial_delay_ms;
+        return 0U;
+    }
+
+    manager->total_failures++;
+    delay_ms = jittered_delay(manager, manager->delay_ms);
+    manager->retry_at_ms = now_ms + delay_ms;
+    manager->state = CONN_STATE_BACKOFF;
+
+    if (manager->delay_ms > (manager->config.max_delay_ms / BACKOFF_MULTIPLIER))
+    {
+        manager->delay_ms = manager->config.max_delay_ms;
+    }
+    else
+    {
+        manager->delay_ms *= BACKOFF_MULTIPLIER;
+    }
+
+    return delay_ms;
+}
+
+/*******************************************************************************
+* Function Name: conn_manager_link_lost
+********************************************************************************
+* Summary:
+*  Reports that the connection to the AP was lost. The first rejoin attempt
+*  is requested immediately.
+*
+* Parameters:
+*  conn_manager_t *manager: State machine.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void conn_manager_link_lost(conn_manager_t *manager)
+{
+    if (CONN_STATE_CONNECTED == manager->state)
+    {
+        manager->state = CONN_STATE_DISCONNECTED;
+        manager->attempts = 0U;
+        manager->link_losses++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: conn_manager_state
+********************************************************************************
+* Summary:
+*  Returns the state of the connection.
+*
+*******************************************************************************/
+conn_state_t conn_manager_state(const conn_manager_t *manager)
+{
+    return manager->state;
+}
+
+/*******************************************************************************
+* Function Name: conn_manager_state_name
+********************************************************************************
+* Summary:
+*  Returns a printable name of a state.
+*
+*******************************************************************************/
+const char *conn_manager_state_name(conn_state_t state)
+{
+    static const char * const names[] =
+    {
+        [CONN_STATE_DISCONNECTED]   = "disconnected",
+        [CONN_STATE_CONNECTING]     = "connecting",
+        [CONN_STATE_BACKOFF]        = "backoff",
+        [CONN_STATE_CONNECTED]      = "connected"
+    };
+
+    return ((uint32_t)state < (sizeof(names) / sizeof(names[0]))) ?
+            names[state] : "unknown";
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,123 @@
+/******************************************************************************
+* File Name: conn_manager.h
+*
+* Description: This file is the public interface of conn_manager.c. It contains
+* the connection state machine that schedules the Wi-Fi connection attempts with
+* an exponential backoff and rejoins the AP when the link is lost.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef CONN_MANAGER_H_
+#define CONN_MANAGER_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+/* This module has no device dependencies so that it can also be built for the
+ * host machine and driven with a simulated clock.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Enumerations
+*******************************************************************************/
+/* State of the connection to the AP */
+typedef enum
+{
+    CONN_STATE_DISCONNECTED = 0,    /* Next attempt can start immediately */
+    CONN_STATE_CONNECTING,          /* Attempt in progress */
+    CONN_STATE_BACKOFF,             /* Waiting before the next attempt */
+    CONN_STATE_CONNECTED
+} conn_state_t;
+
+/* Action requested from the caller by conn_manager_next() */
+typedef enum
+{
+    CONN_ACTION_NONE = 0,           /* Connected or attempt in progress */
+    CONN_ACTION_CONNECT,            /* Start a connection attempt */
+    CONN_ACTION_WAIT                /* Sleep for the returned delay */
+} conn_action_t;
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    uint32_t initial_delay_ms;      /* Delay after the first failure */
+    uint32_t max_delay_ms;          /* Upper bound of the delay */
+    uint32_t jitter_percent;        /* Randomization of every delay */
+} conn_manager_config_t;
+
+typedef struct
+{
+    conn_manager_config_t config;
+    conn_state_t state;
+    uint32_t delay_ms;              /* Delay before jitter of the next backoff */
+    uint32_t retry_at_ms;
+    uint32_t random;
+    uint32_t attempts;              /* Attempts since the last connection */
+    uint32_t total_attempts;
+    uint32_t total_failures;
+    uint32_t link_losses;
+} conn_manager_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void conn_manager_init(conn_manager_t *manager,
+        const conn_manager_config_t *config, uint32_t seed);
+conn_action_t conn_manager_next(conn_manager_t *manager, uint32_t now_ms,
+        uint32_t *wait_ms);
+uint32_t conn_manager_result(conn_manager_t *manager, bool connected,
+        uint32_t now_ms);
+void conn_manager_link_lost(conn_manager_t *manager);
+conn_state_t conn_manager_state(const conn_manager_t *manager);
+const char *conn_manager_state_name(conn_state_t state);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* CONN_MANAGER_H_ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,198 @@
+/*******************************************************************************
+* File Name:   cpu_stats.c
+*
+* Description: This file reports the CPU time of every task from the FreeRTOS
+* run time statistics: the time per network stack resume over the last report
+* period and the share of the CPU, over the last period and as a rolling
+* average. The run time counter is the LPTimer, so the time spent in deep sleep
+* is charged to the idle task.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "cpu_stats.h"
+
+#include "lowpower_task.h"
+#include "app_timestamp.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define PERMILLE                        (1000U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Run time of a task at the previous report */
+typedef struct
+{
+    TaskHandle_t handle;
+    uint32_t run_time;
+    uint32_t rolling_permille;
+} cpu_stats_entry_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static TaskStatus_t task_status[CPU_STATS_MAX_TASKS];
+static cpu_stats_entry_t entries[CPU_STATS_MAX_TASKS];
+static uint32_t entry_count;
+static uint32_t last_total_run_time;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: find_entry
+********************************************************************************
+* Summary:
+*  Returns the entry of a task at the previous report.
+*
+* Parameters:
+*  TaskHandle_t handle: Task handle.
+*
+* Return:
+*  const cpu_stats_entry_t *: Entry of the task, NULL for a new task.
+*
+*******************************************************************************/
+static const cpu_stats_entry_t *find_entry(TaskHandle_t handle)
+{
+    for (uint32_t i = 0U; i < entry_count; i++)
+    {
+        if (entries[i].handle == handle)
+        {
+            return &entries[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: cpu_stats_report
+********************************************************************************
+* Summary:
+*  Prints, for every task, the CPU time since the previous report divided by
+*  the number of wake events in that period, its share of the period and its
+*  rolling share. The run time counter ticks at CLK_LF, so a single time slice
+*  is only resolved to about 30 us; the averages over many wake events are
+*  not biased by it.
+*
+* Parameters:
+*  uint32_t wakes: Number of wake events since the previous report.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void cpu_stats_report(uint32_t wakes)
+{
+    cpu_stats_entry_t current[CPU_STATS_MAX_TASKS];
+    uint32_t total_run_time;
+    uint32_t period;
+    UBaseType_t count;
+
+    count = uxTaskGetSystemState(task_status, CPU_STATS_MAX_TASKS,
+            &total_run_time);
+
+    if (0U == count)
+    {
+        APP_INFO(("CPU time: more than %lu tasks, not reported\n",
+                (unsigned long)CPU_STATS_MAX_TASKS));
+        return;
+    }
+
+    period = total_run_time - last_total_run_time;
+    last_total_run_time = total_run_time;
+
+    APP_INFO(("CPU time over %lu ms and %lu wakes:\n",
+            (unsigned long)(app_timestamp_ticks_to_us(period) / 1000U),
+            (unsigned long)wakes));
+
+    for (UBaseType_t i = 0U; i < count; i++)
+    {
+        const cpu_stats_entry_t *previous = find_entry(task_status[i].xHandle);
+        uint32_t delta = task_status[i].ulRunTimeCounter;
+        uint32_t delta_us;
+        uint32_t permille = 0U;
+        uint32_t rolling;
+
+        if (NULL != previous)
+        {
+            delta -= previous->run_time;
+        }
+
+        if (0U != period)
+        {
+            permille = (uint32_t)(((uint64_t)delta * PERMILLE) / period);
+        }
+
+        /* Exponentially weighted average of the share over the periods */
+        if (NULL == previous)
+        {
+            rolling = permille;
+        }
+        else
+        {
+            rolling = (uint32_t)((int32_t)previous->rolling_permille +
+                    (((int32_t)permille - (int32_t)previous->rolling_permille) /
+                    (int32_t)(1UL << CPU_STATS_ROLLING_SHIFT)));
+        }
+
+        current[i].handle = task_status[i].xHandle;
+        current[i].run_time = task_status[i].ulRunTimeCounter;
+        current[i].rolling_permille = rolling;
+
+        delta_us = app_timestamp_ticks_to_us(delta);
+
+        APP_INFO_TEXT(("  %-16s: %lu us/wake, %lu.%lu%% "
+                "(rolling %lu.%lu%%)\n", task_status[i].pcTaskName,
+                (unsigned long)((0U != wakes) ? (delta_us / wakes) : delta_us),
+                (unsigned long)(permille / 10U),
+                (unsigned long)(permille % 10U),
+                (unsigned long)(rolling / 10U),
+                (unsigned long)(rolling % 10U)));
+    }
+
+    /* Tasks deleted since the previous report are dropped */
+    for (UBaseType_t i = 0U; i < count; i++)
+    {
+        entries[i] = current[i];
+    }
+    entry_count = count;
+}
+
+
+/* [] END OF FILE */
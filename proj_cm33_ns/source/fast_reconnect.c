@@ -0,0 +1,504 @@
+/*******************************************************************************
+* File Name:   fast_reconnect.c
+*
+* Description: This file contains the fast reconnect path. The BSSID, band,
+* channel, pairwise master key and IP lease of the last connection are persisted
+* in RRAM and used on the next boot for a directed join that skips the scan and
+* the passphrase hashing, falling back to the full connection when the cache
+* does not match.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "fast_reconnect.h"
+
+#include <string.h>
+
+#include "lowpower_task.h"
+#include "assoc_cache.h"
+
+/* Wi-Fi Connection Manager (WCM) header file. */
+#include "cy_wcm.h"
+
+/* Mbed TLS header files used to derive the pairwise master key */
+#include "mbedtls/version.h"
+#include "mbedtls/md.h"
+#include "mbedtls/pkcs5.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* WPA/WPA2-PSK pairwise master key derivation (IEEE 802.11i) */
+#define PMK_PBKDF2_ITERATIONS           (4096U)
+
+/* Highest channel number of the 2.4 GHz band */
+#define MAX_2_4GHZ_CHANNEL              (14U)
+
+#define HEX_DIGITS_PER_BYTE             (2U)
+#define RRAM_WRITE_UNIT                 (16U)
+
+/* Size of the RRAM area reserved for the record, rounded up to the write
+ * unit of the RRAM.
+ */
+#define ASSOC_CACHE_NVM_SIZE            (((ASSOC_CACHE_RECORD_SIZE + \
+                                           RRAM_WRITE_UNIT - 1U) / \
+                                           RRAM_WRITE_UNIT) * RRAM_WRITE_UNIT)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static bool rram_read(void *context, uint8_t *buffer, size_t size);
+static bool rram_write(void *context, const uint8_t *buffer, size_t size);
+static bool rram_erase(void *context);
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const assoc_cache_storage_t rram_storage =
+{
+    .read       = rram_read,
+    .write      = rram_write,
+    .erase      = rram_erase,
+    .context    = NULL
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: rram_read
+********************************************************************************
+* Summary:
+*  Reads the association cache area of the RRAM.
+*
+* Parameters:
+*  void *context: Unused.
+*  uint8_t *buffer: Destination buffer.
+*  size_t size: Number of bytes to read.
+*
+* Return:
+*  bool: true if the RRAM was read.
+*
+*******************************************************************************/
+static bool rram_read(void *context, uint8_t *buffer, size_t size)
+{
+    CY_UNUSED_PARAMETER(context);
+
+    return (size <= ASSOC_CACHE_NVM_SIZE) &&
+           (CY_RRAM_SUCCESS == Cy_RRAM_NvmReadByteArray(RRAMC0,
+                   ASSOC_CACHE_NVM_ADDR, buffer, (uint32_t)size));
+}
+
+/*******************************************************************************
+* Function Name: rram_write
+********************************************************************************
+* Summary:
+*  Writes a record to the association cache area of the RRAM. The record is
+*  padded with zeros to a whole number of RRAM write units.
+*
+* Parameters:
+*  void *context: Unused.
+*  const uint8_t *buffer: Encoded record.
+*  size_t size: Size of the encoded record.
+*
+* Return:
+*  bool: true if the RRAM was written.
+*
+*******************************************************************************/
+static bool rram_write(void *context, const uint8_t *buffer, size_t size)
+{
+    uint8_t block[ASSOC_CACHE_NVM_SIZE];
+
+    CY_UNUSED_PARAMETER(context);
+
+    if (size > sizeof(block))
+    {
+        return false;
+    }
+
+    memset(block, 0, sizeof(block));
+    memcpy(block, buffer, size);
+
+    return (CY_RRAM_SUCCESS == Cy_RRAM_NvmWriteByteArray(RRAMC0,
+            ASSOC_CACHE_NVM_ADDR, block, sizeof(block)));
+}
+
+/*******************************************************************************
+* Function Name: rram_erase
+********************************************************************************
+* Summary:
+*  Clears the association cache area of the RRAM. A cleared area is decoded
+*  as an empty cache.
+*
+* Parameters:
+*  void *context: Unused.
+*
+* Return:
+*  bool: true if the RRAM was written.
+*
+*******************************************************************************/
+static bool rram_erase(void *context)
+{
+    uint8_t block[ASSOC_CACHE_NVM_SIZE];
+
+    CY_UNUSED_PARAMETER(context);
+
+    memset(block, 0, sizeof(block));
+
+    return (CY_RRAM_SUCCESS == Cy_RRAM_NvmWriteByteArray(RRAMC0,
+            ASSOC_CACHE_NVM_ADDR, block, sizeof(block)));
+}
+
+/*******************************************************************************
+* Function Name: is_psk_security
+********************************************************************************
+* Summary:
+*  Returns true if the security type authenticates with a PMK derived from
+*  the passphrase. WPA3-SAE and enterprise networks cannot reuse a cached PMK.
+*
+*******************************************************************************/
+static bool is_psk_security(cy_wcm_security_t security)
+{
+    switch (security)
+    {
+        case CY_WCM_SECURITY_WPA_TKIP_PSK:
+        case CY_WCM_SECURITY_WPA_AES_PSK:
+        case CY_WCM_SECURITY_WPA_MIXED_PSK:
+        case CY_WCM_SECURITY_WPA2_AES_PSK:
+        case CY_WCM_SECURITY_WPA2_TKIP_PSK:
+        case CY_WCM_SECURITY_WPA2_MIXED_PSK:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+/*******************************************************************************
+* Function Name: derive_pmk
+********************************************************************************
+* Summary:
+*  Derives the WPA/WPA2 pairwise master key from the passphrase and the SSID
+*  with PBKDF2-HMAC-SHA1. This is the computation the fast reconnect path
+*  saves on every boot.
+*
+* Parameters:
+*  const cy_wcm_connect_params_t *connect_param: Credentials of the AP.
+*  uint8_t *pmk: Filled with ASSOC_CACHE_PMK_LEN bytes.
+*
+* Return:
+*  bool: true if the key was derived.
+*
+*******************************************************************************/
+static bool derive_pmk(const cy_wcm_connect_params_t *connect_param,
+        uint8_t *pmk)
+{
+#if defined(MBEDTLS_PKCS5_C)
+    const uint8_t *ssid = connect_param->ap_credentials.SSID;
+    const uint8_t *password = connect_param->ap_credentials.password;
+    int ret;
+
+#if (MBEDTLS_VERSION_NUMBER >= 0x03030000)
+    ret = mbedtls_pkcs5_pbkdf2_hmac_ext(MBEDTLS_MD_SHA1, password,
+            strlen((const char *)password), ssid, strlen((const char *)ssid),
+            PMK_PBKDF2_ITERATIONS, ASSOC_CACHE_PMK_LEN, pmk);
+#else
+    mbedtls_md_context_t md_context;
+
+    mbedtls_md_init(&md_context);
+    ret = mbedtls_md_setup(&md_context,
+            mbedtls_md_info_from_type(MBEDTLS_MD_SHA1), 1);
+
+    if (0 == ret)
+    {
+        ret = mbedtls_pkcs5_pbkdf2_hmac(&md_context, password,
+                strlen((const char *)password), ssid,
+                strlen((const char *)ssid), PMK_PBKDF2_ITERATIONS,
+                ASSOC_CACHE_PMK_LEN, pmk);
+    }
+
+    mbedtls_md_free(&md_context);
+#endif /* (MBEDTLS_VERSION_NUMBER >= 0x03030000) */
+
+    return (0 == ret);
+#else
+    CY_UNUSED_PARAMETER(connect_param);
+    CY_UNUSED_PARAMETER(pmk);
+
+    /* PBKDF2 is not enabled in the Mbed TLS configuration. The join uses the
+     * passphrase and only the scan is skipped.
+     */
+    return false;
+#endif /* defined(MBEDTLS_PKCS5_C) */
+}
+
+/*******************************************************************************
+* Function Name: pmk_to_hex
+********************************************************************************
+* Summary:
+*  Encodes the PMK as the 64 hexadecimal digit key accepted in place of the
+*  passphrase. The WLAN firmware uses such a key as the PMK directly.
+*
+*******************************************************************************/
+static void pmk_to_hex(const uint8_t *pmk, cy_wcm_passphrase_t password)
+{
+    static const char hex_digits[] = "0123456789abcdef";
+
+    memset(password, 0, sizeof(cy_wcm_passphrase_t));
+
+    for (uint32_t i = 0U; i < ASSOC_CACHE_PMK_LEN; i++)
+    {
+        password[HEX_DIGITS_PER_BYTE * i] = (uint8_t)hex_digits[pmk[i] >> 4U];
+        password[(HEX_DIGITS_PER_BYTE * i) + 1U] =
+                (uint8_t)hex_digits[pmk[i] & 0x0FU];
+    }
+}
+
+/*******************************************************************************
+* Function Name: credentials_match
+********************************************************************************
+* Summary:
+*  Checks that the cached record was saved for the configured credentials.
+*
+*******************************************************************************/
+static bool credentials_match(const assoc_cache_record_t *record,
+        const cy_wcm_connect_params_t *connect_param)
+{
+    const uint8_t *ssid = connect_param->ap_credentials.SSID;
+    const uint8_t *password = connect_param->ap_credentials.password;
+
+    return assoc_cache_matches(record, ssid, strlen((const char *)ssid),
+            (uint32_t)connect_param->ap_credentials.security, password,
+            strlen((const char *)password));
+}
+
+/*******************************************************************************
+* Function Name: fast_reconnect_connect
+********************************************************************************
+* Summary:
+*  Joins the AP with the association parameters cached by the previous
+*  connection. The join is directed to the cached BSSID on the cached band and
+*  authenticates with the cached PMK, which skips the scan and the passphrase
+*  hashing. The cache is invalidated if it does not match the credentials or
+*  if the join fails, so that the caller falls back to the full connection.
+*
+* Parameters:
+*  const cy_wcm_connect_params_t *connect_param: Credentials of the AP.
+*  cy_wcm_ip_address_t *ip_address: Filled with the assigned IP address.
+*
+* Return:
+*  bool: true if the device is connected to the AP.
+*
+*******************************************************************************/
+bool fast_reconnect_connect(const cy_wcm_connect_params_t *connect_param,
+        cy_wcm_ip_address_t *ip_address)
+{
+    static cy_wcm_connect_params_t directed_param;
+    assoc_cache_record_t record;
+    assoc_cache_status_t status;
+    cy_rslt_t result;
+#if (FAST_RECONNECT_REUSE_IP == 1U)
+    static cy_wcm_ip_setting_t static_ip;
+#endif /* (FAST_RECONNECT_REUSE_IP == 1U) */
+
+    status = assoc_cache_load(&rram_storage, &record);
+
+    if (ASSOC_CACHE_OK != status)
+    {
+        APP_INFO(("No valid association cache (status %d).\n", (int)status));
+        return false;
+    }
+
+    if (!credentials_match(&record, connect_param))
+    {
+        APP_INFO(("Association cache does not match the credentials.\n"));
+        fast_reconnect_invalidate();
+        return false;
+    }
+
+    memcpy(&directed_param, connect_param, sizeof(cy_wcm_connect_params_t));
+    memcpy(directed_param.BSSID, record.bssid, ASSOC_CACHE_BSSID_LEN);
+    directed_param.band = (cy_wcm_wifi_band_t)record.band;
+
+    if (record.pmk_valid)
+    {
+        pmk_to_hex(record.pmk, directed_param.ap_credentials.password);
+    }
+
+#if (FAST_RECONNECT_REUSE_IP == 1U)
+    /* Reuse the previous lease instead of running DHCP */
+    if (record.ip_valid)
+    {
+        memset(&static_ip, 0, sizeof(static_ip));
+        static_ip.ip_address.version = CY_WCM_IP_VER_V4;
+        static_ip.ip_address.ip.v4 = record.ip_address;
+        static_ip.netmask.version = CY_WCM_IP_VER_V4;
+        static_ip.netmask.ip.v4 = record.netmask;
+        static_ip.gateway.version = CY_WCM_IP_VER_V4;
+        static_ip.gateway.ip.v4 = record.gateway;
+        directed_param.static_ip_settings = &static_ip;
+    }
+#endif /* (FAST_RECONNECT_REUSE_IP == 1U) */
+
+    APP_INFO(("Fast reconnect to %02x:%02x:%02x:%02x:%02x:%02x on channel %u\n",
+            record.bssid[0], record.bssid[1], record.bssid[2],
+            record.bssid[3], record.bssid[4], record.bssid[5],
+            (unsigned int)record.channel));
+
+    result = cy_wcm_connect_ap(&directed_param, ip_address);
+
+    /* Do not keep a copy of the PMK in RAM */
+    memset(&directed_param, 0, sizeof(directed_param));
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        ERR_INFO(("Fast reconnect failed with error code %d.\n", (int)result));
+        fast_reconnect_invalidate();
+        return false;
+    }
+
+    /* Keep the cached lease current when it was renewed by DHCP */
+    if ((CY_WCM_IP_VER_V4 == ip_address->version) &&
+        ((!record.ip_valid) || (record.ip_address != ip_address->ip.v4)))
+    {
+        fast_reconnect_save(connect_param, ip_address);
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: fast_reconnect_save
+********************************************************************************
+* Summary:
+*  Saves the association parameters of the current connection to the cache.
+*  Must be called once the device is connected to the AP.
+*
+* Parameters:
+*  const cy_wcm_connect_params_t *connect_param: Credentials of the AP.
+*  const cy_wcm_ip_address_t *ip_address: Assigned IP address.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void fast_reconnect_save(const cy_wcm_connect_params_t *connect_param,
+        const cy_wcm_ip_address_t *ip_address)
+{
+    assoc_cache_record_t record;
+    cy_wcm_associated_ap_info_t ap_info;
+    cy_wcm_ip_address_t address;
+    const uint8_t *ssid = connect_param->ap_credentials.SSID;
+    const uint8_t *password = connect_param->ap_credentials.password;
+    size_t ssid_len = strlen((const char *)ssid);
+
+    if ((CY_RSLT_SUCCESS != cy_wcm_get_associated_ap_info(&ap_info)) ||
+        (ssid_len > ASSOC_CACHE_SSID_MAX_LEN))
+    {
+        return;
+    }
+
+    memset(&record, 0, sizeof(record));
+    record.ssid_len = (uint8_t)ssid_len;
+    memcpy(record.ssid, ssid, ssid_len);
+    record.security = (uint32_t)connect_param->ap_credentials.security;
+    record.credential_check = assoc_cache_crc32(password,
+            strlen((const char *)password));
+    memcpy(record.bssid, ap_info.BSSID, ASSOC_CACHE_BSSID_LEN);
+    record.channel = (uint8_t)ap_info.channel;
+    record.band = (uint8_t)((ap_info.channel > MAX_2_4GHZ_CHANNEL) ?
+            CY_WCM_WIFI_BAND_5GHZ : CY_WCM_WIFI_BAND_2_4GHZ);
+
+    /* The PMK only depends on the SSID and the passphrase: reuse the one of
+     * the stored record rather than running PBKDF2 again on every save.
+     */
+    if (is_psk_security(connect_param->ap_credentials.security))
+    {
+        record.pmk_valid = assoc_cache_reuse_pmk(&rram_storage, ssid,
+                ssid_len, record.security, password,
+                strlen((const char *)password), record.pmk) ||
+                derive_pmk(connect_param, record.pmk);
+    }
+
+    if (CY_WCM_IP_VER_V4 == ip_address->version)
+    {
+        record.ip_valid = true;
+        record.ip_address = ip_address->ip.v4;
+
+        if (CY_RSLT_SUCCESS == cy_wcm_get_ip_netmask(
+                CY_WCM_INTERFACE_TYPE_STA, &address))
+        {
+            record.netmask = address.ip.v4;
+        }
+
+        if (CY_RSLT_SUCCESS == cy_wcm_get_gateway_ip_address(
+                CY_WCM_INTERFACE_TYPE_STA, &address))
+        {
+            record.gateway = address.ip.v4;
+        }
+    }
+
+    if (!assoc_cache_save(&rram_storage, &record))
+    {
+        ERR_INFO(("Failed to save the association cache.\n"));
+    }
+
+    memset(&record, 0, sizeof(record));
+}
+
+/*******************************************************************************
+* Function Name: fast_reconnect_invalidate
+********************************************************************************
+* Summary:
+*  Clears the association cache so that the next connection takes the full
+*  path.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void fast_reconnect_invalidate(void)
+{
+    if (!assoc_cache_invalidate(&rram_storage))
+    {
+        ERR_INFO(("Failed to clear the association cache.\n"));
+    }
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,399 @@
+/*******************************************************************************
+* File Name:   idle_governor.c
+*
+* Description: This file contains the idle governor. It predicts the length of
+* the next idle period from the time to the next RTOS timeout and the recent
+* idle periods, and selects staying awake, CPU sleep or system deep sleep to
+* spend the least energy over the period, given the measured overhead of
+* entering and exiting each mode.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "idle_governor.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define PJ_PER_NJ                       (1000U)
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: timeout_bucket
+********************************************************************************
+* Summary:
+*  Returns the bucket of the time to the next RTOS timeout.
+*
+* Parameters:
+*  uint32_t expected_us: Time to the next RTOS timeout.
+*
+* Return:
+*  uint32_t: Bucket index.
+*
+*******************************************************************************/
+static uint32_t timeout_bucket(uint32_t expected_us)
+{
+    uint32_t bucket = 0U;
+    uint32_t limit = IDLE_GOVERNOR_BUCKET0_US;
+
+    while ((bucket < (IDLE_GOVERNOR_BUCKETS - 1U)) && (expected_us >= limit))
+    {
+        bucket++;
+        limit <<= 1U;
+    }
+
+    return bucket;
+}
+
+/*******************************************************************************
+* Function Name: typical_idle
+********************************************************************************
+* Summary:
+*  Returns the typical idle period of the history of a bucket: its average
+*  when the periods are close to each other. Otherwise the longest periods
+*  are discarded one at a time, as long as three quarters of the history
+*  remain, until the rest is close enough.
+*
+* Parameters:
+*  const idle_governor_t *governor: Governor state.
+*  uint32_t bucket: Bucket of the time to the next RTOS timeout.
+*  uint32_t *typical_us: Filled with the typical idle period.
+*
+* Return:
+*  bool: true if the history has a typical value.
+*
+*******************************************************************************/
+static bool typical_idle(const idle_governor_t *governor, uint32_t bucket,
+        uint32_t *typical_us)
+{
+    const uint32_t *history = governor->history_us[bucket];
+    uint32_t threshold = UINT32_MAX;
+
+    if (governor->history_count[bucket] < IDLE_GOVERNOR_HISTORY)
+    {
+        return false;
+    }
+
+    for (uint32_t pass = 0U; pass <= IDLE_GOVERNOR_OUTLIER_PASSES; pass++)
+    {
+        uint64_t sum = 0U;
+        uint64_t variance = 0U;
+        uint64_t average;
+        uint32_t longest = 0U;
+        uint32_t count = 0U;
+
+        for (uint32_t i = 0U; i < IDLE_GOVERNOR_HISTORY; i++)
+        {
+            uint32_t value = history[i];
+
+            if (value <= threshold)
+            {
+                sum += value;
+                count++;
+                longest = (value > longest) ? value : longest;
+            }
+        }
+
+        if ((count * 4U) < (IDLE_GOVERNOR_HISTORY * 3U))
+        {
+            return false;
+        }
+
+        average = sum / count;
+
+        for (uint32_t i = 0U; i < IDLE_GOVERNOR_HISTORY; i++)
+        {
+            uint32_t value = history[i];
+
+            if (value <= threshold)
+            {
+                int64_t diff = (int64_t)value - (int64_t)average;
+
+                variance += (uint64_t)(diff * diff);
+            }
+        }
+        variance /= count;
+
+        if ((variance <= ((uint64_t)IDLE_GOVERNOR_SPREAD_FLOOR_US *
+                IDLE_GOVERNOR_SPREAD_FLOOR_US)) ||
+            ((variance <= (UINT64_MAX / (IDLE_GOVERNOR_SPREAD_RATIO *
+                IDLE_GOVERNOR_SPREAD_RATIO))) &&
+            ((variance * IDLE_GOVERNOR_SPREAD_RATIO *
+                IDLE_GOVERNOR_SPREAD_RATIO) <= (average * average))))
+        {
+            *typical_us = (uint32_t)average;
+            return true;
+        }
+
+        threshold = longest - 1U;
+    }
+
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: idle_governor_init
+********************************************************************************
+* Summary:
+*  Initializes the governor with an empty history and the overheads of the
+*  configuration.
+*
+* Parameters:
+*  idle_governor_t *governor: Governor state.
+*  const idle_governor_config_t *config: Cost model.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void idle_governor_init(idle_governor_t *governor,
+        const idle_governor_config_t *config)
+{
+    memset(governor, 0, sizeof(idle_governor_t));
+
+    governor->config = *config;
+    memcpy(governor->overhead_us, config->overhead_us,
+            sizeof(governor->overhead_us));
+
+    for (uint32_t bucket = 0U; bucket < IDLE_GOVERNOR_BUCKETS; bucket++)
+    {
+        governor->ratio[bucket] = IDLE_GOVERNOR_RATIO_ONE;
+    }
+}
+
+/*******************************************************************************
+* Function Name: idle_governor_predict
+********************************************************************************
+* Summary:
+*  Predicts the length of the next idle period. The RTOS wakes up at the next
+*  timeout at the latest, but interrupts such as received packets often end
+*  the period earlier. The time to the timeout is scaled by the ratio learnt
+*  for similar timeouts, and the typical recent period that started with a
+*  similar timeout is used when shorter.
+*
+* Parameters:
+*  const idle_governor_t *governor: Governor state.
+*  uint32_t expected_us: Time to the next RTOS timeout.
+*
+* Return:
+*  uint32_t: Predicted idle period, in microseconds.
+*
+*******************************************************************************/
+uint32_t idle_governor_predict(const idle_governor_t *governor,
+        uint32_t expected_us)
+{
+    uint32_t bucket = timeout_bucket(expected_us);
+    uint32_t predicted_us;
+    uint32_t typical_us;
+
+    predicted_us = (uint32_t)(((uint64_t)expected_us *
+            governor->ratio[bucket]) / IDLE_GOVERNOR_RATIO_ONE);
+
+    if (typical_idle(governor, bucket, &typical_us) &&
+            (typical_us < predicted_us))
+    {
+        predicted_us = typical_us;
+    }
+
+    return predicted_us;
+}
+
+/*******************************************************************************
+* Function Name: idle_governor_energy_nj
+********************************************************************************
+* Summary:
+*  Returns the energy spent over an idle period in the given mode: the CPU is
+*  active for the overhead of the mode and in the mode for the rest of the
+*  period. A period shorter than the overhead still pays the full overhead.
+*
+* Parameters:
+*  const idle_governor_t *governor: Governor state.
+*  power_model_state_t state: Power mode.
+*  uint32_t idle_us: Length of the idle period.
+*
+* Return:
+*  uint64_t: Energy, in nanojoules.
+*
+*******************************************************************************/
+uint64_t idle_governor_energy_nj(const idle_governor_t *governor,
+        power_model_state_t state, uint32_t idle_us)
+{
+    uint32_t overhead_us = governor->overhead_us[state];
+    uint32_t residency_us = (idle_us > overhead_us) ?
+            (idle_us - overhead_us) : 0U;
+    uint64_t energy_pj;
+
+    /* uW x us = pJ */
+    energy_pj = ((uint64_t)overhead_us *
+            governor->config.power_uw[POWER_MODEL_STATE_ACTIVE]) +
+            ((uint64_t)residency_us * governor->config.power_uw[state]);
+
+    return energy_pj / PJ_PER_NJ;
+}
+
+/*******************************************************************************
+* Function Name: idle_governor_select
+********************************************************************************
+* Summary:
+*  Selects the power mode that spends the least energy over the predicted
+*  idle period. On equal energy, the shallower mode is selected.
+*
+* Parameters:
+*  idle_governor_t *governor: Governor state.
+*  uint32_t expected_us: Time to the next RTOS timeout.
+*
+* Return:
+*  power_model_state_t: Selected mode.
+*
+*******************************************************************************/
+power_model_state_t idle_governor_select(idle_governor_t *governor,
+        uint32_t expected_us)
+{
+    uint32_t predicted_us = idle_governor_predict(governor, expected_us);
+    power_model_state_t selected = POWER_MODEL_STATE_ACTIVE;
+    uint64_t lowest = idle_governor_energy_nj(governor, selected,
+            predicted_us);
+
+    for (uint32_t state = (uint32_t)POWER_MODEL_STATE_SLEEP;
+            state < (uint32_t)POWER_MODEL_STATE_COUNT; state++)
+    {
+        uint64_t energy = idle_governor_energy_nj(governor,
+                (power_model_state_t)state, predicted_us);
+
+        if (energy < lowest)
+        {
+            lowest = energy;
+            selected = (power_model_state_t)state;
+        }
+    }
+
+    if (POWER_MODEL_STATE_ACTIVE == selected)
+    {
+        governor->awake_streak++;
+        if (governor->awake_streak > IDLE_GOVERNOR_MAX_AWAKE_STREAK)
+        {
+            selected = POWER_MODEL_STATE_SLEEP;
+        }
+    }
+
+    if (POWER_MODEL_STATE_ACTIVE != selected)
+    {
+        governor->awake_streak = 0U;
+    }
+
+    governor->decisions[selected]++;
+
+    return selected;
+}
+
+/*******************************************************************************
+* Function Name: idle_governor_record_idle
+********************************************************************************
+* Summary:
+*  Adds the measured length of an idle period to the history of its timeout
+*  bucket and updates the ratio learnt for the bucket.
+*
+* Parameters:
+*  idle_governor_t *governor: Governor state.
+*  uint32_t expected_us: Time to the next RTOS timeout at the start of the
+*   period.
+*  uint32_t idle_us: Length of the idle period.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void idle_governor_record_idle(idle_governor_t *governor,
+        uint32_t expected_us, uint32_t idle_us)
+{
+    uint32_t bucket = timeout_bucket(expected_us);
+    uint32_t measured = IDLE_GOVERNOR_RATIO_ONE;
+    int32_t average = (int32_t)governor->ratio[bucket];
+
+    /* The overhead of the mode can make the period slightly longer */
+    if ((0U != expected_us) && (idle_us < expected_us))
+    {
+        measured = (uint32_t)(((uint64_t)idle_us * IDLE_GOVERNOR_RATIO_ONE) /
+                expected_us);
+    }
+
+    average += ((int32_t)measured - average) /
+            (int32_t)(1UL << IDLE_GOVERNOR_RATIO_SHIFT);
+    governor->ratio[bucket] = (uint32_t)average;
+
+    governor->history_us[bucket][governor->history_next[bucket]] = idle_us;
+    governor->history_next[bucket] = (governor->history_next[bucket] + 1U) %
+            IDLE_GOVERNOR_HISTORY;
+
+    if (governor->history_count[bucket] < IDLE_GOVERNOR_HISTORY)
+    {
+        governor->history_count[bucket]++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: idle_governor_record_overhead
+********************************************************************************
+* Summary:
+*  Updates the average overhead of a mode with a measured entry and exit
+*  time.
+*
+* Parameters:
+*  idle_governor_t *governor: Governor state.
+*  power_model_state_t state: Mode that was entered.
+*  uint32_t overhead_us: Time spent active to enter and exit the mode.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void idle_governor_record_overhead(idle_governor_t *governor,
+        power_model_state_t state, uint32_t overhead_us)
+{
+    int32_t average = (int32_t)governor->overhead_us[state];
+
+    average += ((int32_t)overhead_us - average) /
+            (int32_t)(1UL << IDLE_GOVERNOR_OVERHEAD_SHIFT);
+
+    governor->overhead_us[state] = (uint32_t)average;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,154 @@
+/******************************************************************************
+* File Name: idle_governor.h
+*
+* Description: This file is the public interface of idle_governor.c, which
+* predicts the length of the next idle period and selects the power mode that
+* spends the least energy over it.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef IDLE_GOVERNOR_H_
+#define IDLE_GOVERNOR_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+/* This module has no device dependencies so that it can also be built for the
+ * host machine and driven with recorded idle traces.
+ */
+#include <stdint.h>
+
+#include "power_model.h"
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+/* The ratio of the measured idle period to the time to the next RTOS timeout
+ * is learnt separately for timeouts shorter than IDLE_GOVERNOR_BUCKET0_US and
+ * in [IDLE_GOVERNOR_BUCKET0_US << (n - 1), IDLE_GOVERNOR_BUCKET0_US << n) for
+ * bucket n. The last bucket holds all the longer timeouts. The ratio is in
+ * 1/IDLE_GOVERNOR_RATIO_ONE units, and a new period has a weight of
+ * 1/(1 << IDLE_GOVERNOR_RATIO_SHIFT) in it.
+ */
+#define IDLE_GOVERNOR_BUCKETS               (8U)
+#define IDLE_GOVERNOR_BUCKET0_US            (1000U)
+#define IDLE_GOVERNOR_RATIO_ONE             (1024U)
+#define IDLE_GOVERNOR_RATIO_SHIFT           (3U)
+
+/* Number of past idle periods of each bucket the typical idle period is
+ * computed from.
+ */
+#define IDLE_GOVERNOR_HISTORY               (8U)
+
+/* Number of times the longest remaining idle period is discarded when the
+ * history is too spread to give a typical value.
+ */
+#define IDLE_GOVERNOR_OUTLIER_PASSES        (2U)
+
+/* The history gives a typical value when the standard deviation is at most
+ * 1/IDLE_GOVERNOR_SPREAD_RATIO of the average, or below
+ * IDLE_GOVERNOR_SPREAD_FLOOR_US.
+ */
+#define IDLE_GOVERNOR_SPREAD_RATIO          (6U)
+#define IDLE_GOVERNOR_SPREAD_FLOOR_US       (20U)
+
+/* Weight of a new measurement in the average mode overhead, as a power of
+ * two: 3 gives it a weight of 1/8.
+ */
+#define IDLE_GOVERNOR_OVERHEAD_SHIFT        (3U)
+
+/* Staying awake is not measured, so after this many consecutive decisions to
+ * stay awake the CPU sleep mode is used to refresh the history.
+ */
+#define IDLE_GOVERNOR_MAX_AWAKE_STREAK      (8U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Cost model of the power modes. POWER_MODEL_STATE_ACTIVE stands for staying
+ * awake in the idle task.
+ */
+typedef struct
+{
+    /* Power drawn in each mode */
+    uint32_t power_uw[POWER_MODEL_STATE_COUNT];
+
+    /* Time spent active to enter and exit each mode before it is measured */
+    uint32_t overhead_us[POWER_MODEL_STATE_COUNT];
+} idle_governor_config_t;
+
+/* Governor state */
+typedef struct
+{
+    idle_governor_config_t config;
+    uint32_t overhead_us[POWER_MODEL_STATE_COUNT];
+    uint32_t ratio[IDLE_GOVERNOR_BUCKETS];
+    uint32_t history_us[IDLE_GOVERNOR_BUCKETS][IDLE_GOVERNOR_HISTORY];
+    uint32_t history_count[IDLE_GOVERNOR_BUCKETS];
+    uint32_t history_next[IDLE_GOVERNOR_BUCKETS];
+    uint32_t awake_streak;
+    uint32_t decisions[POWER_MODEL_STATE_COUNT];
+} idle_governor_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void idle_governor_init(idle_governor_t *governor,
+        const idle_governor_config_t *config);
+uint32_t idle_governor_predict(const idle_governor_t *governor,
+        uint32_t expected_us);
+uint64_t idle_governor_energy_nj(const idle_governor_t *governor,
+        power_model_state_t state, uint32_t idle_us);
+power_model_state_t idle_governor_select(idle_governor_t *governor,
+        uint32_t expected_us);
+void idle_governor_record_idle(idle_governor_t *governor,
+        uint32_t expected_us, uint32_t idle_us);
+void idle_governor_record_overhead(idle_governor_t *governor,
+        power_model_state_t state, uint32_t overhead_us);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* IDLE_GOVERNOR_H_ */
+
+
+/* [] END OF FILE */
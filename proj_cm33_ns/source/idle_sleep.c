@@ -0,0 +1,297 @@
+/*******************************************************************************
+* File Name:   idle_sleep.c
+*
+* Description: This file replaces the default tickless idle implementation of
+* the RTOS abstraction. For every idle period, the idle governor selects staying
+* awake, CPU sleep or system deep sleep, and the time spent in the SysPm
+* callbacks around each transition is measured to update the cost of the modes.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "idle_sleep.h"
+
+#include "lowpower_task.h"
+#include "app_timestamp.h"
+#include "power_stats.h"
+#include "power_model.h"
+#include "idle_governor.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define US_PER_MS                       (1000U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Idle period recorded for tools/idle_trace_replay.c */
+typedef struct
+{
+    uint32_t expected_us;
+    uint32_t idle_us;
+} idle_trace_entry_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* LPTimer object passed to the RTOS tickless idle implementation */
+static mtb_hal_lptimer_t *idle_lptimer = NULL;
+
+static idle_governor_t idle_governor;
+
+#if (IDLE_TRACE_ENABLE == 1U)
+static idle_trace_entry_t idle_trace[IDLE_TRACE_LENGTH];
+static uint32_t idle_trace_count;
+#endif /* (IDLE_TRACE_ENABLE == 1U) */
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: idle_sleep_init
+********************************************************************************
+* Summary:
+*  Initializes the idle governor with the power table of the energy model.
+*  Must be called after app_timestamp_init() and power_stats_init(). Until
+*  then the RTOS does not suppress the tick.
+*
+* Parameters:
+*  mtb_hal_lptimer_t *lptimer: LPTimer used for tickless idle.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void idle_sleep_init(mtb_hal_lptimer_t *lptimer)
+{
+    idle_governor_config_t config =
+    {
+        .overhead_us =
+        {
+            [POWER_MODEL_STATE_ACTIVE]      = 0U,
+            [POWER_MODEL_STATE_SLEEP]       = IDLE_SLEEP_OVERHEAD_US,
+            [POWER_MODEL_STATE_DEEPSLEEP]   = IDLE_DEEPSLEEP_OVERHEAD_US
+        }
+    };
+
+    for (uint32_t state = 0U; state < (uint32_t)POWER_MODEL_STATE_COUNT;
+            state++)
+    {
+        config.power_uw[state] = power_model_default_table.mcu_uw[state];
+    }
+
+    idle_governor_init(&idle_governor, &config);
+    idle_lptimer = lptimer;
+}
+
+#if (IDLE_GOVERNOR_ENABLE == 1U)
+/*******************************************************************************
+* Function Name: vApplicationSleep
+********************************************************************************
+* Summary:
+*  Called by the RTOS idle task with the time to the next timeout. Enters the
+*  mode selected by the idle governor with the tick suppressed, then steps the
+*  tick by the time slept. The time from the call to the last SysPm callback
+*  and from the first SysPm callback to the return is the overhead of the
+*  mode. Falls back to CPU sleep when deep sleep is refused.
+*
+* Parameters:
+*  TickType_t expected_idle_ticks: Ticks to the next RTOS timeout.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void vApplicationSleep(TickType_t expected_idle_ticks)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+    uint32_t expected_ms = pdTICKS_TO_MS(expected_idle_ticks);
+    uint32_t expected_us;
+    power_stats_transition_t before;
+    power_stats_transition_t after;
+    power_model_state_t state;
+    uint32_t actual_ms = 0U;
+    uint32_t start;
+    uint32_t end;
+    cy_rslt_t result;
+
+    if ((NULL == idle_lptimer) ||
+            (eAbortSleep == eTaskConfirmSleepModeStatus()))
+    {
+        Cy_SysLib_ExitCriticalSection(interrupt_state);
+        return;
+    }
+
+    /* portMAX_DELAY idles exceed the microsecond range; saturate them */
+    expected_us = (expected_ms > (UINT32_MAX / US_PER_MS)) ?
+            UINT32_MAX : (expected_ms * US_PER_MS);
+
+    state = idle_governor_select(&idle_governor, expected_us);
+
+#if (CY_CFG_PWR_SYS_IDLE_MODE != CY_CFG_PWR_MODE_DEEPSLEEP)
+    if (POWER_MODEL_STATE_DEEPSLEEP == state)
+    {
+        state = POWER_MODEL_STATE_SLEEP;
+    }
+#endif /* (CY_CFG_PWR_SYS_IDLE_MODE != CY_CFG_PWR_MODE_DEEPSLEEP) */
+
+    if (POWER_MODEL_STATE_ACTIVE == state)
+    {
+        /* Return to the idle loop with the tick running */
+        Cy_SysLib_ExitCriticalSection(interrupt_state);
+        return;
+    }
+
+    power_stats_get_transition(&before);
+    start = app_timestamp_ticks();
+    result = mtb_hal_syspm_tickless_sleep_deepsleep(idle_lptimer, expected_ms,
+            &actual_ms, (POWER_MODEL_STATE_DEEPSLEEP == state));
+
+    if ((CY_RSLT_SUCCESS != result) &&
+            (POWER_MODEL_STATE_DEEPSLEEP == state))
+    {
+        state = POWER_MODEL_STATE_SLEEP;
+        power_stats_get_transition(&before);
+        start = app_timestamp_ticks();
+        result = mtb_hal_syspm_tickless_sleep_deepsleep(idle_lptimer,
+                expected_ms, &actual_ms, false);
+    }
+
+    end = app_timestamp_ticks();
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        uint32_t idle_us = app_timestamp_ticks_to_us(end - start);
+
+        vTaskStepTick(pdMS_TO_TICKS(actual_ms));
+
+        power_stats_get_transition(&after);
+        if (after.count != before.count)
+        {
+            idle_governor_record_overhead(&idle_governor, state,
+                    app_timestamp_ticks_to_us((after.enter_ticks - start) +
+                    (end - after.exit_ticks)));
+        }
+
+        idle_governor_record_idle(&idle_governor, expected_us, idle_us);
+
+#if (IDLE_TRACE_ENABLE == 1U)
+        if (idle_trace_count < IDLE_TRACE_LENGTH)
+        {
+            idle_trace[idle_trace_count].expected_us = expected_us;
+            idle_trace[idle_trace_count].idle_us = idle_us;
+            idle_trace_count++;
+        }
+#endif /* (IDLE_TRACE_ENABLE == 1U) */
+    }
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+#endif /* (IDLE_GOVERNOR_ENABLE == 1U) */
+
+/*******************************************************************************
+* Function Name: idle_sleep_report
+********************************************************************************
+* Summary:
+*  Prints the number of idle periods spent in each mode and the measured
+*  overhead of the modes.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void idle_sleep_report(void)
+{
+    idle_governor_t governor;
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    governor = idle_governor;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+    APP_INFO(("Idle governor: %lu awake, %lu sleep (%lu us overhead), "
+            "%lu deep sleep (%lu us overhead)\n",
+            (unsigned long)governor.decisions[POWER_MODEL_STATE_ACTIVE],
+            (unsigned long)governor.decisions[POWER_MODEL_STATE_SLEEP],
+            (unsigned long)governor.overhead_us[POWER_MODEL_STATE_SLEEP],
+            (unsigned long)governor.decisions[POWER_MODEL_STATE_DEEPSLEEP],
+            (unsigned long)governor.overhead_us[POWER_MODEL_STATE_DEEPSLEEP]));
+}
+
+/*******************************************************************************
+* Function Name: idle_sleep_dump_trace
+********************************************************************************
+* Summary:
+*  Prints the recorded idle periods, one "idle,<expected_us>,<idle_us>" line
+*  per period, and starts a new recording. Replay the output with
+*  tools/idle_trace_replay.c.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void idle_sleep_dump_trace(void)
+{
+#if (IDLE_TRACE_ENABLE == 1U)
+    static idle_trace_entry_t trace[IDLE_TRACE_LENGTH];
+    uint32_t count;
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    count = idle_trace_count;
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        trace[i] = idle_trace[i];
+    }
+    idle_trace_count = 0U;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        APP_INFO(("idle,%lu,%lu\n", (unsigned long)trace[i].expected_us,
+                (unsigned long)trace[i].idle_us));
+    }
+#endif /* (IDLE_TRACE_ENABLE == 1U) */
+}
+
+
+/* [] END OF FILE */
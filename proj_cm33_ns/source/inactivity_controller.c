@@ -0,0 +1,376 @@
+/*******************************************************************************
+* File Name:   inactivity_controller.c
+*
+* Description: This file contains the online controller that selects the network
+* inactivity window passed to wait_net_suspend(). It keeps a decaying histogram
+* of the inter-packet gaps and, for every candidate window, computes the
+* expected energy per gap (staying awake versus suspending and resuming the
+* network stack) and the expected latency added to the received packets.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "inactivity_controller.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define US_PER_MS                       (1000U)
+#define NJ_PER_UJ                       (1000U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+
+/* Windows evaluated by the controller, in ascending order */
+static const uint32_t candidate_windows_ms[] =
+{
+    20U, 30U, 50U, 75U, 100U, 150U, 200U, 300U, 500U, 750U, 1000U, 1500U, 2000U
+};
+
+#define CANDIDATE_WINDOW_COUNT  (sizeof(candidate_windows_ms) / \
+                                 sizeof(candidate_windows_ms[0]))
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: gap_bin_lower_ms
+********************************************************************************
+* Summary:
+*  Returns the shortest gap counted in a bin.
+*******************************************************************************/
+static uint32_t gap_bin_lower_ms(uint32_t bin)
+{
+    return (0U == bin) ? 0U : (INACTIVITY_GAP_BIN0_MS << (bin - 1U));
+}
+
+/*******************************************************************************
+* Function Name: gap_bin_representative_ms
+********************************************************************************
+* Summary:
+*  Returns the gap used for all the samples counted in a bin.
+*******************************************************************************/
+static uint32_t gap_bin_representative_ms(uint32_t bin)
+{
+    if (0U == bin)
+    {
+        return INACTIVITY_GAP_BIN0_MS / 2U;
+    }
+    else if ((INACTIVITY_GAP_BINS - 1U) == bin)
+    {
+        return gap_bin_lower_ms(bin) * 2U;
+    }
+    else
+    {
+        return (gap_bin_lower_ms(bin) * 3U) / 2U;
+    }
+}
+
+/*******************************************************************************
+* Function Name: evaluate_window
+********************************************************************************
+* Summary:
+*  Returns the expected delay added to every received packet with the given
+*  window, in microseconds, and the expected energy of the observed gaps.
+*******************************************************************************/
+static uint32_t evaluate_window(const inactivity_controller_t *controller,
+        uint32_t window_ms, uint64_t total_weight, uint64_t *energy_nj)
+{
+    const inactivity_controller_config_t *config = &controller->config;
+    uint64_t suspended_weight = 0U;
+
+    *energy_nj = 0U;
+
+    for (uint32_t bin = 0U; bin < INACTIVITY_GAP_BINS; bin++)
+    {
+        uint64_t weight = controller->gap_weight[bin];
+        uint64_t gap = gap_bin_representative_ms(bin);
+        uint64_t gap_energy_nj;
+
+        if (gap < window_ms)
+        {
+            gap_energy_nj = gap * config->awake_uw;
+        }
+        else
+        {
+            gap_energy_nj = ((uint64_t)window_ms * config->awake_uw) +
+                    ((uint64_t)config->suspend_resume_uj * NJ_PER_UJ) +
+                    ((gap - window_ms) * config->suspended_uw);
+            suspended_weight += weight;
+        }
+
+        *energy_nj += weight * gap_energy_nj;
+    }
+
+    return (uint32_t)((suspended_weight * config->resume_latency_ms *
+            US_PER_MS) / total_weight);
+}
+
+/*******************************************************************************
+* Function Name: record_decision
+********************************************************************************
+* Summary:
+*  Keeps a window change in the report, dropping the oldest one when full.
+*******************************************************************************/
+static void record_decision(inactivity_controller_t *controller,
+        uint32_t timestamp_ms, uint32_t window_ms, uint32_t latency_us)
+{
+    inactivity_decision_t *decision;
+
+    if (INACTIVITY_HISTORY_LEN == controller->history_count)
+    {
+        memmove(&controller->history[0], &controller->history[1],
+                (INACTIVITY_HISTORY_LEN - 1U) * sizeof(inactivity_decision_t));
+        controller->history_count--;
+    }
+
+    decision = &controller->history[controller->history_count];
+    decision->timestamp_ms = timestamp_ms;
+    decision->window_ms = window_ms;
+    decision->expected_latency_us = latency_us;
+    controller->history_count++;
+}
+
+/*******************************************************************************
+* Function Name: inactivity_controller_init
+********************************************************************************
+* Summary:
+*  Clears the gap histogram and starts with the default window.
+*
+* Parameters:
+*  inactivity_controller_t *controller: Controller to initialize.
+*  const inactivity_controller_config_t *config: Cost model and constraints.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void inactivity_controller_init(inactivity_controller_t *controller,
+        const inactivity_controller_config_t *config)
+{
+    memset(controller, 0, sizeof(inactivity_controller_t));
+    controller->config = *config;
+    controller->window_ms = config->default_window_ms;
+}
+
+/*******************************************************************************
+* Function Name: inactivity_controller_observe
+********************************************************************************
+* Summary:
+*  Counts an inter-packet gap. Every INACTIVITY_DECAY_PERIOD gaps, all the
+*  weights are halved so that older traffic is progressively forgotten.
+*
+* Parameters:
+*  inactivity_controller_t *controller: Controller to update.
+*  uint32_t gap_ms: Time since the previous packet, in milliseconds.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void inactivity_controller_observe(inactivity_controller_t *controller,
+        uint32_t gap_ms)
+{
+    uint32_t bin = 0U;
+
+    while (((bin + 1U) < INACTIVITY_GAP_BINS) &&
+           (gap_ms >= gap_bin_lower_ms(bin + 1U)))
+    {
+        bin++;
+    }
+
+    controller->gap_weight[bin] += INACTIVITY_GAP_WEIGHT;
+    controller->samples++;
+
+    if (0U == (controller->samples % INACTIVITY_DECAY_PERIOD))
+    {
+        for (bin = 0U; bin < INACTIVITY_GAP_BINS; bin++)
+        {
+            controller->gap_weight[bin] /= 2U;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: inactivity_controller_select
+********************************************************************************
+* Summary:
+*  Selects the window for the next call to wait_net_suspend(). For a gap g
+*  and a window W, the network stack stays resumed for g if g < W; otherwise
+*  it stays resumed for W, is suspended for g - W and pays one suspend/resume
+*  cycle, and the packet ending the gap is delayed by the resume latency. The
+*  selected window is the one with the lowest expected energy whose expected
+*  added latency per packet fits the budget. If no window fits, the default
+*  window is used rather than the longest one, which would keep the network
+*  stack resumed after every packet. The default window is also kept until
+*  INACTIVITY_MIN_SAMPLES gaps have been observed.
+*
+* Parameters:
+*  inactivity_controller_t *controller: Controller to update.
+*  uint32_t timestamp_ms: Current time, used in the report.
+*
+* Return:
+*  uint32_t: Selected window, in milliseconds.
+*
+*******************************************************************************/
+uint32_t inactivity_controller_select(inactivity_controller_t *controller,
+        uint32_t timestamp_ms)
+{
+    const inactivity_controller_config_t *config = &controller->config;
+    uint64_t total_weight = 0U;
+    uint64_t best_energy = UINT64_MAX;
+    uint32_t best_window = 0U;
+    uint32_t best_latency_us = 0U;
+    uint32_t window_ms;
+    uint32_t latency_us;
+
+    for (uint32_t bin = 0U; bin < INACTIVITY_GAP_BINS; bin++)
+    {
+        total_weight += controller->gap_weight[bin];
+    }
+
+    if ((controller->samples < INACTIVITY_MIN_SAMPLES) || (0U == total_weight))
+    {
+        window_ms = config->default_window_ms;
+        latency_us = 0U;
+    }
+    else
+    {
+        for (uint32_t i = 0U; i < CANDIDATE_WINDOW_COUNT; i++)
+        {
+            uint32_t candidate = candidate_windows_ms[i];
+            uint64_t energy_nj;
+
+            if ((candidate < config->min_window_ms) ||
+                (candidate > config->max_window_ms))
+            {
+                continue;
+            }
+
+            latency_us = evaluate_window(controller, candidate, total_weight,
+                    &energy_nj);
+
+            if ((latency_us <= config->max_added_latency_us) &&
+                (energy_nj < best_energy))
+            {
+                best_energy = energy_nj;
+                best_window = candidate;
+                best_latency_us = latency_us;
+            }
+        }
+
+        if (0U != best_window)
+        {
+            window_ms = best_window;
+            latency_us = best_latency_us;
+        }
+        else
+        {
+            window_ms = config->default_window_ms;
+            latency_us = evaluate_window(controller, window_ms, total_weight,
+                    &best_energy);
+        }
+    }
+
+    if ((window_ms != controller->window_ms) ||
+        (0U == controller->history_count))
+    {
+        record_decision(controller, timestamp_ms, window_ms, latency_us);
+    }
+
+    controller->window_ms = window_ms;
+
+    return window_ms;
+}
+
+/*******************************************************************************
+* Function Name: inactivity_controller_interval
+********************************************************************************
+* Summary:
+*  Returns the monitoring interval to pass to wait_net_suspend() with the
+*  given window.
+*
+* Parameters:
+*  uint32_t window_ms: Inactivity window, in milliseconds.
+*
+* Return:
+*  uint32_t: Monitoring interval, in milliseconds.
+*
+*******************************************************************************/
+uint32_t inactivity_controller_interval(uint32_t window_ms)
+{
+    return (window_ms * INACTIVITY_INTERVAL_RATIO_NUM) /
+            INACTIVITY_INTERVAL_RATIO_DEN;
+}
+
+/*******************************************************************************
+* Function Name: inactivity_controller_history
+********************************************************************************
+* Summary:
+*  Copies the last window changes, oldest first.
+*
+* Parameters:
+*  const inactivity_controller_t *controller: Controller to read.
+*  inactivity_decision_t *history: Destination array.
+*  uint32_t max_entries: Number of entries in the destination array.
+*
+* Return:
+*  uint32_t: Number of entries copied.
+*
+*******************************************************************************/
+uint32_t inactivity_controller_history(const inactivity_controller_t *controller,
+        inactivity_decision_t *history, uint32_t max_entries)
+{
+    uint32_t count = controller->history_count;
+    uint32_t first = 0U;
+
+    if (count > max_entries)
+    {
+        first = count - max_entries;
+        count = max_entries;
+    }
+
+    memcpy(history, &controller->history[first],
+            count * sizeof(inactivity_decision_t));
+
+    return count;
+}
+
+
+/* [] END OF FILE */
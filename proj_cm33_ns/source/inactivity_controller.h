@@ -0,0 +1,147 @@
+/******************************************************************************
+* File Name: inactivity_controller.h
+*
+* Description: This file is the public interface of inactivity_controller.c. It
+* contains the controller that learns the inter-packet gap distribution of the
+* link and selects the network inactivity window that minimizes the expected
+* energy within a latency budget.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef INACTIVITY_CONTROLLER_H_
+#define INACTIVITY_CONTROLLER_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+/* This module has no device dependencies so that it can also be built for the
+ * host machine and driven with synthetic traces.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+/* Number of inter-packet gap bins. Bin 0 holds the gaps shorter than
+ * INACTIVITY_GAP_BIN0_MS and bin n the gaps in
+ * [INACTIVITY_GAP_BIN0_MS << (n - 1), INACTIVITY_GAP_BIN0_MS << n). The last
+ * bin holds all the longer gaps.
+ */
+#define INACTIVITY_GAP_BINS                 (14U)
+#define INACTIVITY_GAP_BIN0_MS              (8U)
+
+/* Weight added to a bin for every gap, and number of gaps after which all
+ * the weights are halved so that the distribution follows the link.
+ */
+#define INACTIVITY_GAP_WEIGHT               (16U)
+#define INACTIVITY_DECAY_PERIOD             (64U)
+
+/* Number of gaps to observe before the window is adapted */
+#define INACTIVITY_MIN_SAMPLES              (32U)
+
+/* Number of window changes kept in the report */
+#define INACTIVITY_HISTORY_LEN              (8U)
+
+/* The monitoring interval passed to wait_net_suspend() is the window scaled
+ * by this ratio, as with the default 300 ms interval and 200 ms window.
+ */
+#define INACTIVITY_INTERVAL_RATIO_NUM       (3U)
+#define INACTIVITY_INTERVAL_RATIO_DEN       (2U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Cost model and constraints of the controller */
+typedef struct
+{
+    uint32_t default_window_ms;     /* Window used until enough samples */
+    uint32_t min_window_ms;
+    uint32_t max_window_ms;
+    uint32_t awake_uw;              /* Power with the network stack resumed */
+    uint32_t suspended_uw;          /* Power with the network stack suspended */
+    uint32_t suspend_resume_uj;     /* Energy of one suspend/resume cycle */
+    uint32_t resume_latency_ms;     /* Delay added to a packet that resumes
+                                     * the network stack */
+    uint32_t max_added_latency_us;  /* Budget for the average delay added to
+                                     * every received packet */
+} inactivity_controller_config_t;
+
+/* Window change kept in the report */
+typedef struct
+{
+    uint32_t timestamp_ms;
+    uint32_t window_ms;
+    uint32_t expected_latency_us;
+} inactivity_decision_t;
+
+/* Controller state */
+typedef struct
+{
+    inactivity_controller_config_t config;
+    uint32_t gap_weight[INACTIVITY_GAP_BINS];
+    uint32_t samples;
+    uint32_t window_ms;
+    inactivity_decision_t history[INACTIVITY_HISTORY_LEN];
+    uint32_t history_count;
+} inactivity_controller_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void inactivity_controller_init(inactivity_controller_t *controller,
+        const inactivity_controller_config_t *config);
+void inactivity_controller_observe(inactivity_controller_t *controller,
+        uint32_t gap_ms);
+uint32_t inactivity_controller_select(inactivity_controller_t *controller,
+        uint32_t timestamp_ms);
+uint32_t inactivity_controller_interval(uint32_t window_ms);
+uint32_t inactivity_controller_history(const inactivity_controller_t *controller,
+        inactivity_decision_t *history, uint32_t max_entries);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* INACTIVITY_CONTROLLER_H_ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,415 @@
+/*******************************************************************************
+* File Name:   ka_offload.c
+*
+* Description: This file contains the ARP and TCP keep-alive offloads. Before
+* the network stack is suspended, the WLAN firmware is given the IPv4 address of
+* the host to answer ARP requests, and the sequence numbers of the connection
+* registered by the application to send its TCP keep-alives. When the network
+* stack resumes, the host takes both back and checks the connection against the
+* status reported by the firmware.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "ka_offload.h"
+#include "tko_handoff.h"
+
+#include "lowpower_task.h"
+
+/* Wi-Fi connection manager header files */
+#include "cy_wcm.h"
+
+/* Wi-Fi Host Driver (WHD) header files */
+#include "whd_wifi_api.h"
+
+/* lwIP header files */
+#include "lwip/sockets.h"
+#include "lwip/tcpip.h"
+#include "lwip/priv/tcp_priv.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* ARP offload features: answer the ARP requests for the host addresses */
+#define ARP_OL_AGENT                    (0x00000001UL)
+#define ARP_OL_PEER_AUTO_REPLY          (0x00000008UL)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static tko_handoff_t handoff;
+
+/* Connection registered by the application */
+static bool watching;
+static uint16_t watch_local_port;
+static uint16_t watch_remote_port;
+static uint32_t watch_remote_addr;
+
+/* Offloads active while the network stack is suspended */
+static whd_interface_t offload_ifp;
+static bool arp_offloaded;
+static uint32_t arp_offloads;
+static uint32_t tko_skipped;
+static uint32_t offload_errors;
+
+static const char * const reclaim_names[TKO_RECLAIM_COUNT] =
+{
+    "ok", "stale", "broken", "desync"
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: ka_offload_init
+********************************************************************************
+* Summary:
+*  Clears the handoff state and the counters.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ka_offload_init(void)
+{
+    tko_handoff_init(&handoff);
+}
+
+/*******************************************************************************
+* Function Name: ka_offload_watch_socket
+********************************************************************************
+* Summary:
+*  Registers the connected TCP socket whose keep-alives are offloaded. Call
+*  it again after every reconnection of the socket.
+*
+* Parameters:
+*  int sock: Connected lwIP TCP socket.
+*
+* Return:
+*  bool: false if the socket is not connected.
+*
+*******************************************************************************/
+bool ka_offload_watch_socket(int sock)
+{
+    struct sockaddr_in local;
+    struct sockaddr_in remote;
+    socklen_t len = sizeof(local);
+
+    if ((0 != lwip_getsockname(sock, (struct sockaddr *)&local, &len)) ||
+        ((len = sizeof(remote)), (0 != lwip_getpeername(sock,
+                (struct sockaddr *)&remote, &len))))
+    {
+        return false;
+    }
+
+    LOCK_TCPIP_CORE();
+    watch_local_port = lwip_ntohs(local.sin_port);
+    watch_remote_port = lwip_ntohs(remote.sin_port);
+    watch_remote_addr = remote.sin_addr.s_addr;
+    watching = true;
+    UNLOCK_TCPIP_CORE();
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: find_pcb
+********************************************************************************
+* Summary:
+*  Returns the lwIP control block of the registered connection, or NULL if
+*  it is closed. Called with the lwIP core locked.
+*******************************************************************************/
+static struct tcp_pcb *find_pcb(void)
+{
+    if (!watching)
+    {
+        return NULL;
+    }
+
+    for (struct tcp_pcb *pcb = tcp_active_pcbs; NULL != pcb; pcb = pcb->next)
+    {
+        if ((pcb->local_port == watch_local_port) &&
+            (pcb->remote_port == watch_remote_port) &&
+            (ip_2_ip4(&pcb->remote_ip)->addr == watch_remote_addr))
+        {
+            return pcb;
+        }
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: read_conn
+********************************************************************************
+* Summary:
+*  Copies the state of a connection from its lwIP control block. Called with
+*  the lwIP core locked.
+*******************************************************************************/
+static void read_conn(const struct tcp_pcb *pcb, tko_conn_t *conn)
+{
+    uint32_t rcv_wnd = pcb->rcv_ann_wnd;
+
+    memset(conn, 0, sizeof(tko_conn_t));
+    memcpy(conn->local_ip, &ip_2_ip4(&pcb->local_ip)->addr, 4U);
+    memcpy(conn->remote_ip, &ip_2_ip4(&pcb->remote_ip)->addr, 4U);
+    conn->local_port = pcb->local_port;
+    conn->remote_port = pcb->remote_port;
+    conn->snd_nxt = pcb->snd_nxt;
+    conn->rcv_nxt = pcb->rcv_nxt;
+    conn->rcv_wnd = (uint16_t)((rcv_wnd > UINT16_MAX) ? UINT16_MAX : rcv_wnd);
+}
+
+/*******************************************************************************
+* Function Name: offload_tko
+********************************************************************************
+* Summary:
+*  Hands the registered connection to the firmware. A connection with data
+*  not yet sent or acknowledged is left to lwIP, since its retransmissions
+*  would not match the sequence numbers given to the firmware.
+*******************************************************************************/
+static void offload_tko(whd_interface_t ifp)
+{
+    static uint8_t iovar[TKO_CONNECT_IOVAR_LEN];
+    whd_tko_retry_t retry =
+    {
+        .tko_interval       = KA_OFFLOAD_INTERVAL_S,
+        .tko_retry_count    = KA_OFFLOAD_RETRY_COUNT,
+        .tko_retry_interval = KA_OFFLOAD_RETRY_INTERVAL_S
+    };
+    struct tcp_pcb *pcb;
+    tko_conn_t conn;
+    bool idle = false;
+
+    LOCK_TCPIP_CORE();
+    pcb = find_pcb();
+    if ((NULL != pcb) && (ESTABLISHED == pcb->state) &&
+        (NULL == pcb->unsent) && (NULL == pcb->unacked))
+    {
+        read_conn(pcb, &conn);
+        idle = true;
+    }
+    UNLOCK_TCPIP_CORE();
+
+    if (!idle)
+    {
+        tko_skipped += watching ? 1U : 0U;
+        return;
+    }
+
+    if ((WHD_SUCCESS != whd_tko_param(ifp, &retry, 1U)) ||
+        (WHD_SUCCESS != whd_wifi_set_iovar_buffer(ifp, "tko", iovar,
+                tko_build_connect_iovar(&conn, KA_OFFLOAD_TKO_INDEX, iovar,
+                sizeof(iovar)))) ||
+        (WHD_SUCCESS != whd_tko_toggle(ifp, WHD_TRUE)))
+    {
+        offload_errors++;
+        return;
+    }
+
+    tko_handoff_begin(&handoff, &conn);
+}
+
+/*******************************************************************************
+* Function Name: ka_offload_suspend
+********************************************************************************
+* Summary:
+*  Enables the ARP offload for the IPv4 address of the host and, if the
+*  registered connection is idle, the TCP keep-alive offload. Called by the
+*  low power task before it waits for the network stack to be suspended.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ka_offload_suspend(void)
+{
+    uint32_t host_ip = 0U;
+
+    if (CY_RSLT_SUCCESS != cy_wcm_get_whd_interface(CY_WCM_INTERFACE_TYPE_STA,
+            &offload_ifp))
+    {
+        offload_ifp = NULL;
+        return;
+    }
+
+    LOCK_TCPIP_CORE();
+    if (NULL != netif_default)
+    {
+        host_ip = netif_ip4_addr(netif_default)->addr;
+    }
+    UNLOCK_TCPIP_CORE();
+
+    if (0U != host_ip)
+    {
+        if ((WHD_SUCCESS == whd_arp_hostip_list_clear(offload_ifp)) &&
+            (WHD_SUCCESS == whd_arp_hostip_list_add(offload_ifp, &host_ip,
+                    1U)) &&
+            (WHD_SUCCESS == whd_arp_features_set(offload_ifp,
+                    ARP_OL_AGENT | ARP_OL_PEER_AUTO_REPLY)) &&
+            (WHD_SUCCESS == whd_arp_arpoe_set(offload_ifp, 1U)))
+        {
+            arp_offloaded = true;
+            arp_offloads++;
+        }
+        else
+        {
+            offload_errors++;
+        }
+    }
+
+    offload_tko(offload_ifp);
+}
+
+/*******************************************************************************
+* Function Name: ka_offload_resume
+********************************************************************************
+* Summary:
+*  Takes the ARP replies and the TCP keep-alives back from the firmware.
+*  lwIP keeps its sequence numbers, which the keep-alives of the firmware do
+*  not consume, and its keep-alive timer is restarted since the firmware
+*  kept the connection alive. The connection is aborted if the peer stopped
+*  answering or disagrees on the sequence numbers, so that the application
+*  reconnects. Called by the low power task when the network stack resumes.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ka_offload_resume(void)
+{
+    whd_tko_status_t status;
+    struct tcp_pcb *pcb;
+    tko_conn_t conn;
+    tko_reclaim_t result;
+
+    if (NULL == offload_ifp)
+    {
+        return;
+    }
+
+    if (arp_offloaded)
+    {
+        (void)whd_arp_arpoe_set(offload_ifp, 0U);
+        arp_offloaded = false;
+    }
+
+    if (!handoff.active)
+    {
+        return;
+    }
+
+    memset(&status, 0, sizeof(status));
+    if (WHD_SUCCESS != whd_tko_get_status(offload_ifp, &status))
+    {
+        status.status[KA_OFFLOAD_TKO_INDEX] = TKO_STATUS_UNAVAILABLE;
+    }
+    (void)whd_tko_toggle(offload_ifp, WHD_FALSE);
+
+    LOCK_TCPIP_CORE();
+    pcb = find_pcb();
+    if (NULL == pcb)
+    {
+        /* Closed by the application while offloaded */
+        handoff.active = false;
+        UNLOCK_TCPIP_CORE();
+        return;
+    }
+
+    read_conn(pcb, &conn);
+    result = tko_handoff_reclaim(&handoff, &conn,
+            status.status[KA_OFFLOAD_TKO_INDEX]);
+
+    if ((TKO_RECLAIM_BROKEN == result) || (TKO_RECLAIM_DESYNC == result))
+    {
+        tcp_abort(pcb);
+        watching = false;
+    }
+    else
+    {
+        pcb->keep_cnt_sent = 0U;
+        pcb->tmr = tcp_ticks;
+    }
+    UNLOCK_TCPIP_CORE();
+
+    if (TKO_RECLAIM_OK != result)
+    {
+        APP_INFO(("TCP keep-alive offload: connection %s\n",
+                reclaim_names[result]));
+    }
+}
+
+/*******************************************************************************
+* Function Name: ka_offload_report
+********************************************************************************
+* Summary:
+*  Prints the offload counters.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ka_offload_report(void)
+{
+    APP_INFO(("Offloads: ARP %lu, TCP keep-alive %lu (%lu skipped), "
+            "%lu errors\n",
+            (unsigned long)arp_offloads,
+            (unsigned long)handoff.handoffs,
+            (unsigned long)tko_skipped,
+            (unsigned long)offload_errors));
+    APP_INFO(("TCP keep-alive reclaims: %lu ok, %lu stale, %lu broken, "
+            "%lu desync\n",
+            (unsigned long)handoff.reclaims[TKO_RECLAIM_OK],
+            (unsigned long)handoff.reclaims[TKO_RECLAIM_STALE],
+            (unsigned long)handoff.reclaims[TKO_RECLAIM_BROKEN],
+            (unsigned long)handoff.reclaims[TKO_RECLAIM_DESYNC]));
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,87 @@
+/******************************************************************************
+* File Name: ka_offload.h
+*
+* Description: This file is the public interface of ka_offload.c, which hands
+* the ARP replies and the TCP keep-alives of a connection to the WLAN firmware
+* while the network stack is suspended.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef KA_OFFLOAD_H_
+#define KA_OFFLOAD_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+#include <stdbool.h>
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+/* The firmware sends a keep-alive every KA_OFFLOAD_INTERVAL_S. If the peer
+ * does not answer, it sends KA_OFFLOAD_RETRY_COUNT more every
+ * KA_OFFLOAD_RETRY_INTERVAL_S and then wakes up the host, which aborts the
+ * connection.
+ */
+#define KA_OFFLOAD_INTERVAL_S           (60U)
+#define KA_OFFLOAD_RETRY_INTERVAL_S     (3U)
+#define KA_OFFLOAD_RETRY_COUNT          (3U)
+
+/* Connection slot of the firmware used for the connection */
+#define KA_OFFLOAD_TKO_INDEX            (0U)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void ka_offload_init(void);
+bool ka_offload_watch_socket(int sock);
+void ka_offload_suspend(void);
+void ka_offload_resume(void);
+void ka_offload_report(void);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* KA_OFFLOAD_H_ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,430 @@
+/*******************************************************************************
+* File Name:   latency_hist.c
+*
+* Description: This file contains the log-linear latency histograms and the
+* trace that timestamps the points between a wake event and the low power task
+* and records the time spent in each stage.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "latency_hist.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define US_PER_SECOND                   (1000000UL)
+#define MS_PER_SECOND                   (1000UL)
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: msb_index
+********************************************************************************
+* Summary:
+*  Returns the index of the most significant bit set in a non-zero value.
+*******************************************************************************/
+static uint32_t msb_index(uint32_t value)
+{
+    uint32_t index = 0U;
+
+    for (uint32_t shift = 16U; shift > 0U; shift >>= 1U)
+    {
+        if (0U != (value >> shift))
+        {
+            value >>= shift;
+            index += shift;
+        }
+    }
+
+    return index;
+}
+
+/*******************************************************************************
+* Function Name: ticks_to_us
+********************************************************************************
+* Summary:
+*  Converts timestamp counts to microseconds, saturated to UINT32_MAX.
+*******************************************************************************/
+static uint32_t ticks_to_us(uint32_t ticks, uint32_t tick_hz)
+{
+    uint64_t us;
+
+    if (0U == tick_hz)
+    {
+        return 0U;
+    }
+
+    us = ((uint64_t)ticks * US_PER_SECOND) / tick_hz;
+
+    return (us > UINT32_MAX) ? UINT32_MAX : (uint32_t)us;
+}
+
+/*******************************************************************************
+* Function Name: latency_hist_bucket
+********************************************************************************
+* Summary:
+*  Returns the bucket a latency is counted in.
+*
+* Parameters:
+*  uint32_t us: Latency in microseconds.
+*
+* Return:
+*  uint32_t: Bucket index, below LATENCY_HIST_BUCKETS.
+*
+*******************************************************************************/
+uint32_t latency_hist_bucket(uint32_t us)
+{
+    uint32_t exp;
+
+    if (us < LATENCY_HIST_SUB_COUNT)
+    {
+        return us;
+    }
+
+    exp = msb_index(us);
+    if (exp >= LATENCY_HIST_MAX_EXP)
+    {
+        return LATENCY_HIST_BUCKETS - 1U;
+    }
+
+    return ((exp - LATENCY_HIST_SUB_BITS + 1U) << LATENCY_HIST_SUB_BITS) +
+            ((us >> (exp - LATENCY_HIST_SUB_BITS)) &
+            (LATENCY_HIST_SUB_COUNT - 1U));
+}
+
+/*******************************************************************************
+* Function Name: latency_hist_bucket_max
+********************************************************************************
+* Summary:
+*  Returns the largest latency counted in a bucket. For the last bucket, this
+*  is the largest value below 2^LATENCY_HIST_MAX_EXP.
+*
+* Parameters:
+*  uint32_t bucket: Bucket index.
+*
+* Return:
+*  uint32_t: Latency in microseconds.
+*
+*******************************************************************************/
+uint32_t latency_hist_bucket_max(uint32_t bucket)
+{
+    uint32_t shift;
+    uint32_t sub;
+
+    if (bucket < LATENCY_HIST_SUB_COUNT)
+    {
+        return bucket;
+    }
+
+    shift = (bucket >> LATENCY_HIST_SUB_BITS) - 1U;
+    sub = bucket & (LATENCY_HIST_SUB_COUNT - 1U);
+
+    return ((LATENCY_HIST_SUB_COUNT + sub + 1U) << shift) - 1U;
+}
+
+/*******************************************************************************
+* Function Name: latency_hist_reset
+********************************************************************************
+* Summary:
+*  Clears a histogram. Must not race with latency_hist_record().
+*
+* Parameters:
+*  latency_hist_t *hist: Histogram to clear.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void latency_hist_reset(latency_hist_t *hist)
+{
+    for (uint32_t i = 0U; i < LATENCY_HIST_BUCKETS; i++)
+    {
+        atomic_init(&hist->buckets[i], 0U);
+    }
+    atomic_init(&hist->max_us, 0U);
+}
+
+/*******************************************************************************
+* Function Name: latency_hist_record
+********************************************************************************
+* Summary:
+*  Counts a latency. Lock-free: can be called from interrupt context and from
+*  several contexts at once.
+*
+* Parameters:
+*  latency_hist_t *hist: Histogram to update.
+*  uint32_t us: Latency in microseconds.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void latency_hist_record(latency_hist_t *hist, uint32_t us)
+{
+    uint_fast32_t max;
+
+    atomic_fetch_add_explicit(&hist->buckets[latency_hist_bucket(us)], 1U,
+            memory_order_relaxed);
+
+    max = atomic_load_explicit(&hist->max_us, memory_order_relaxed);
+    while ((us > max) && !atomic_compare_exchange_weak_explicit(&hist->max_us,
+            &max, us, memory_order_relaxed, memory_order_relaxed))
+    {
+    }
+}
+
+/*******************************************************************************
+* Function Name: latency_hist_summarize
+********************************************************************************
+* Summary:
+*  Computes the count, the median, the 99th percentile and the maximum of a
+*  histogram. A percentile is the largest value of the bucket it falls in,
+*  capped by the maximum, or the maximum when it falls in the last bucket.
+*  Can run while latencies are recorded; the result then includes some of
+*  them.
+*
+* Parameters:
+*  const latency_hist_t *hist: Histogram to summarize.
+*  latency_hist_summary_t *summary: Filled with the result.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void latency_hist_summarize(const latency_hist_t *hist,
+        latency_hist_summary_t *summary)
+{
+    uint32_t counts[LATENCY_HIST_BUCKETS];
+    uint32_t rank50;
+    uint32_t rank99;
+    uint32_t seen = 0U;
+
+    memset(summary, 0, sizeof(latency_hist_summary_t));
+
+    for (uint32_t i = 0U; i < LATENCY_HIST_BUCKETS; i++)
+    {
+        counts[i] = (uint32_t)atomic_load_explicit(&hist->buckets[i],
+                memory_order_relaxed);
+        summary->count += counts[i];
+    }
+    summary->max_us = (uint32_t)atomic_load_explicit(&hist->max_us,
+            memory_order_relaxed);
+
+    if (0U == summary->count)
+    {
+        return;
+    }
+
+    /* Smallest rank covering the percentile, at least the first value */
+    rank50 = (uint32_t)((((uint64_t)summary->count * 50U) + 99U) / 100U);
+    rank99 = (uint32_t)((((uint64_t)summary->count * 99U) + 99U) / 100U);
+
+    for (uint32_t i = 0U; i < LATENCY_HIST_BUCKETS; i++)
+    {
+        uint32_t value = latency_hist_bucket_max(i);
+
+        /* The last bucket has no upper bound */
+        if ((value > summary->max_us) || (i == (LATENCY_HIST_BUCKETS - 1U)))
+        {
+            value = summary->max_us;
+        }
+
+        seen += counts[i];
+        if ((0U == summary->p50_us) && (seen >= rank50))
+        {
+            summary->p50_us = value;
+        }
+        if (seen >= rank99)
+        {
+            summary->p99_us = value;
+            break;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: latency_trace_init
+********************************************************************************
+* Summary:
+*  Initializes an empty trace.
+*
+* Parameters:
+*  latency_trace_t *trace: Trace to initialize.
+*  uint32_t gap_ms: Silence after which a mark starts a new trace. Must be
+*   shorter than the shortest inactivity window and longer than any stage.
+*  uint32_t tick_hz: Frequency of the timestamps.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void latency_trace_init(latency_trace_t *trace, uint32_t gap_ms,
+        uint32_t tick_hz)
+{
+    memset(trace, 0, sizeof(latency_trace_t));
+    trace->gap_ticks = (uint32_t)(((uint64_t)gap_ms * tick_hz) /
+            MS_PER_SECOND);
+    trace->tick_hz = tick_hz;
+}
+
+/*******************************************************************************
+* Function Name: latency_trace_mark
+********************************************************************************
+* Summary:
+*  Timestamps a point of the wake being traced. Only the first occurrence of
+*  a point is kept. Not reentrant: the caller serializes the marks.
+*
+* Parameters:
+*  latency_trace_t *trace: Trace to update.
+*  latency_point_t point: Point reached.
+*  uint32_t now: Current timestamp.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void latency_trace_mark(latency_trace_t *trace, latency_point_t point,
+        uint32_t now)
+{
+    uint32_t bit = 1UL << (uint32_t)point;
+
+    if ((now - trace->last_mark) > trace->gap_ticks)
+    {
+        trace->captured = 0U;
+    }
+    trace->last_mark = now;
+
+    if (0U == (trace->captured & bit))
+    {
+        trace->stamp[point] = now;
+        trace->captured |= bit;
+    }
+}
+
+/*******************************************************************************
+* Function Name: latency_trace_close
+********************************************************************************
+* Summary:
+*  Marks the low power task as resumed, records the time between consecutive
+*  points of the trace in the stage histograms and starts a new trace. A
+*  resume without any other point, for example one caused by a transmission,
+*  is only counted as untraced.
+*
+* Parameters:
+*  latency_trace_t *trace: Trace to close.
+*  latency_stages_t *stages: Histograms to update.
+*  uint32_t now: Current timestamp.
+*
+* Return:
+*  uint32_t: Number of stages recorded.
+*
+*******************************************************************************/
+uint32_t latency_trace_close(latency_trace_t *trace, latency_stages_t *stages,
+        uint32_t now)
+{
+    latency_point_t order[LATENCY_POINT_COUNT];
+    uint32_t count = 0U;
+
+    latency_trace_mark(trace, LATENCY_POINT_TASK_RESUMED, now);
+
+    /* Sort the captured points from the oldest, by their age at the close */
+    for (uint32_t p = 0U; p < (uint32_t)LATENCY_POINT_COUNT; p++)
+    {
+        uint32_t age = now - trace->stamp[p];
+        uint32_t i = count;
+
+        if (0U == (trace->captured & (1UL << p)))
+        {
+            continue;
+        }
+
+        while ((i > 0U) && ((now - trace->stamp[order[i - 1U]]) < age))
+        {
+            order[i] = order[i - 1U];
+            i--;
+        }
+        order[i] = (latency_point_t)p;
+        count++;
+    }
+
+    trace->captured = 0U;
+
+    if (count < 2U)
+    {
+        stages->untraced++;
+        return 0U;
+    }
+
+    for (uint32_t i = 1U; i < count; i++)
+    {
+        latency_hist_record(&stages->stage[order[i]], ticks_to_us(
+                trace->stamp[order[i]] - trace->stamp[order[i - 1U]],
+                trace->tick_hz));
+    }
+    latency_hist_record(&stages->total,
+            ticks_to_us(now - trace->stamp[order[0]], trace->tick_hz));
+
+    return count - 1U;
+}
+
+/*******************************************************************************
+* Function Name: latency_stages_reset
+********************************************************************************
+* Summary:
+*  Clears the stage histograms.
+*
+* Parameters:
+*  latency_stages_t *stages: Histograms to clear.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void latency_stages_reset(latency_stages_t *stages)
+{
+    for (uint32_t p = 0U; p < (uint32_t)LATENCY_POINT_COUNT; p++)
+    {
+        latency_hist_reset(&stages->stage[p]);
+    }
+    latency_hist_reset(&stages->total);
+    stages->untraced = 0U;
+}
+
+
+/* [] END OF FILE */
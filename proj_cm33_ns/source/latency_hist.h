@@ -0,0 +1,165 @@
+/******************************************************************************
+* File Name: latency_hist.h
+*
+* Description: This file is the public interface of latency_hist.c. It contains
+* the latency histograms and the trace that splits the time from a wake event to
+* the low power task into stages.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef LATENCY_HIST_H_
+#define LATENCY_HIST_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+/* This module has no device dependencies so that it can also be built for the
+ * host machine and benchmarked there.
+ */
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+/* Values below 2^LATENCY_HIST_SUB_BITS microseconds have a bucket each. Above,
+ * every power of two is split into 2^LATENCY_HIST_SUB_BITS buckets, so a
+ * percentile is reported at most 12.5% above the recorded value. Values of
+ * 2^LATENCY_HIST_MAX_EXP microseconds (about 1 second) and more share the
+ * last bucket; the maximum is kept exactly.
+ */
+#define LATENCY_HIST_SUB_BITS           (3U)
+#define LATENCY_HIST_SUB_COUNT          (1U << LATENCY_HIST_SUB_BITS)
+#define LATENCY_HIST_MAX_EXP            (20U)
+#define LATENCY_HIST_BUCKETS            ((LATENCY_HIST_MAX_EXP - \
+                                         LATENCY_HIST_SUB_BITS + 1U) * \
+                                         LATENCY_HIST_SUB_COUNT)
+
+/*******************************************************************************
+* Enumerations
+*******************************************************************************/
+/* Points timestamped between a wake event and the low power task, in the
+ * order they are expected to occur. The trace sorts them by time, so a point
+ * that occurs earlier than listed is still attributed correctly.
+ */
+typedef enum
+{
+    LATENCY_POINT_SDHC_RESTORED = 0,    /* SDHC restored after deep sleep */
+    LATENCY_POINT_HOST_WAKE,            /* Host wake interrupt */
+    LATENCY_POINT_SDIO_IRQ,             /* SDIO interrupt */
+    LATENCY_POINT_WHD_RX,               /* Frame passed up by the WHD thread */
+    LATENCY_POINT_TCPIP_RX,             /* Frame received by the tcpip thread */
+    LATENCY_POINT_TASK_RESUMED,         /* wait_net_suspend() returned */
+    LATENCY_POINT_COUNT
+} latency_point_t;
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Histogram of latencies in microseconds. Recording is lock-free, so that it
+ * can be done from interrupt context while another context reads it.
+ */
+typedef struct
+{
+    atomic_uint_fast32_t buckets[LATENCY_HIST_BUCKETS];
+    atomic_uint_fast32_t max_us;
+} latency_hist_t;
+
+/* Summary of a histogram */
+typedef struct
+{
+    uint32_t count;
+    uint32_t p50_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+} latency_hist_summary_t;
+
+/* Points of the wake being traced, in timestamp counts. A mark that comes
+ * more than gap_ticks after the previous one starts a new trace, since the
+ * network stack is only suspended after a longer silence.
+ */
+typedef struct
+{
+    uint32_t stamp[LATENCY_POINT_COUNT];
+    uint32_t captured;
+    uint32_t last_mark;
+    uint32_t gap_ticks;
+    uint32_t tick_hz;
+} latency_trace_t;
+
+/* Histograms of the stages of the traced wakes. stage[p] holds the time from
+ * the point captured just before p to p, and total the time from the first
+ * point to the low power task.
+ */
+typedef struct
+{
+    latency_hist_t stage[LATENCY_POINT_COUNT];
+    latency_hist_t total;
+    uint32_t untraced;
+} latency_stages_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void latency_hist_reset(latency_hist_t *hist);
+void latency_hist_record(latency_hist_t *hist, uint32_t us);
+void latency_hist_summarize(const latency_hist_t *hist,
+        latency_hist_summary_t *summary);
+uint32_t latency_hist_bucket(uint32_t us);
+uint32_t latency_hist_bucket_max(uint32_t bucket);
+
+void latency_trace_init(latency_trace_t *trace, uint32_t gap_ms,
+        uint32_t tick_hz);
+void latency_trace_mark(latency_trace_t *trace, latency_point_t point,
+        uint32_t now);
+uint32_t latency_trace_close(latency_trace_t *trace, latency_stages_t *stages,
+        uint32_t now);
+void latency_stages_reset(latency_stages_t *stages);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* LATENCY_HIST_H_ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,112 @@
+/******************************************************************************
+* File Name: lowpower_config.h
+*
+* Description: This file contains the timing of the network inactivity detection
+* and of the Wi-Fi connection retries. It has no device dependencies, so that
+* the Linux tools in tools/ use the same values as the device.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef LOWPOWER_CONFIG_H_
+#define LOWPOWER_CONFIG_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+#define LED_BLINK_DELAY_MS                (100U)
+
+/* This macro specifies the interval in milliseconds that the device monitors
+ * the network for inactivity. If the network is inactive for duration lesser 
+ * than INACTIVE_WINDOW_MS in this interval, the MCU does not suspend the network 
+ * stack and informs the calling function that the MCU wait period timed out 
+ * while waiting for network to become inactive.
+ */
+#define INACTIVE_INTERVAL_MS              (300U)
+
+/* This macro specifies the continuous duration in milliseconds for which the 
+ * network has to be inactive. If the network is inactive for this duaration,
+ * the MCU will suspend the network stack. Now, the MCU will not need to service
+ * the network timers which allows it to stay longer in sleep/deepsleep.
+ */
+#define INACTIVE_WINDOW_MS                (200U)
+
+/* Set to 1 to let the inactivity controller adapt the window (and the
+ * interval, scaled in the same ratio as the values above) to the inter-packet
+ * gaps observed on the link. INACTIVE_WINDOW_MS is then used until enough
+ * gaps have been observed and whenever no window fits MAX_ADDED_LATENCY_US.
+ * Set to 0 to always use the values above.
+ */
+#define ADAPTIVE_INACTIVE_WINDOW          (0U)
+
+/* Range of windows, in milliseconds, the inactivity controller selects from */
+#define ADAPTIVE_WINDOW_MIN_MS            (50U)
+#define ADAPTIVE_WINDOW_MAX_MS            (2000U)
+
+/* Budget for the average delay, in microseconds, added to every received
+ * packet by the network stack being suspended when the packet arrives.
+ */
+#define MAX_ADDED_LATENCY_US              (2000U)
+
+/* Delay to resume the network stack, and energy of one suspend/resume cycle
+ * in microjoules, used by the inactivity controller. Replace with the values
+ * measured on your board.
+ */
+#define NETWORK_RESUME_LATENCY_MS         (5U)
+#define NETWORK_SUSPEND_RESUME_UJ         (150U)
+
+/* Delay before retrying a failed Wi-Fi connection attempt, in milliseconds.
+ * The delay doubles after every failed attempt up to WIFI_RETRY_MAX_DELAY_MS
+ * and is randomized by +/- WIFI_RETRY_JITTER_PERCENT so that devices
+ * restarting together with their AP do not retry in lockstep. The MCU enters
+ * deep sleep between two attempts.
+ */
+#define WIFI_RETRY_INITIAL_DELAY_MS       (1000U)
+#define WIFI_RETRY_MAX_DELAY_MS           (300000U)
+#define WIFI_RETRY_JITTER_PERCENT         (20U)
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* LOWPOWER_CONFIG_H_ */
+
+
+/* [] END OF FILE */
@@ -57,10 +57,69 @@
 /* Retarget_io header file */
 #include "retarget_io_init.h"
 
+/* Energy model and power statistics header files */
+#include "power_model.h"
+#include "power_stats.h"
+
+/* Wake reason classifier header file */
+#include "wake_reason.h"
+
+/* Inactivity window controller header file */
+#include "inactivity_controller.h"
+
+/* Fast reconnect header file */
+#include "fast_reconnect.h"
+
+/* Connection manager header file */
+#include "conn_manager.h"
+
+/* SDIO bus profiles */
+#include "sdio_profile.h"
+#include "sdio_bench.h"
+
+/* WLAN receive buffer pool */
+#include "rx_pbuf_pool.h"
+
+/* Heap and stack usage report */
+#include "mem_report.h"
+
+/* CPU time per task */
+#include "cpu_stats.h"
+
+/* Idle governor */
+#include "idle_sleep.h"
+
+/* Batched uplink */
+#include "uplink.h"
+
+/* WLAN power-save control */
+#include "wlan_pm.h"
+
+/* Automatic packet filters */
+#include "pkt_filter.h"
+
+/* ARP and TCP keep-alive offloads */
+#include "ka_offload.h"
+
+/* Wake latency trace */
+#include "wake_latency.h"
+
+/* SDHC deep sleep fast path */
+#include "sdhc_resume.h"
+
+/* Roaming */
+#include "roam.h"
+
+/* Concurrent SoftAP */
+#include "softap.h"
+
+/* Power-state timeline */
+#include "trace_log.h"
+#include "app_timestamp.h"
+
 /*******************************************************************************
 * Macros
 *******************************************************************************/
-#define MAX_WIFI_RETRY_COUNT                         (3U)
 #define RESET_VAL                                    (0U)
 #define APP_SDIO_INTERRUPT_PRIORITY                  (7U)
 #define APP_HOST_WAKE_INTERRUPT_PRIORITY             (2U)
@@ -68,6 +127,12 @@
 #define SDHC_SDIO_64BYTES_BLOCK                      (64U)
 #define INTERFACE_ID                                 (0U)
 
+/* Number of network stack resumes between two statistics reports */
+#define STATS_REPORT_INTERVAL                        (20U)
+
+#define TICKS_TO_MS(ticks)                           ((uint32_t)((ticks) * \
+                                                      portTICK_PERIOD_MS))
+
 /*******************************************************************************
 * Global Variables
 *******************************************************************************/
@@ -78,8 +143,59 @@ static mtb_hal_sdio_t sdio_instance;
 static cy_stc_sd_host_context_t sdhc_host_context;
 static cy_wcm_config_t wcm_config;
 
+/* Number of times the network stack was resumed */
+static uint32_t net_resume_count;
+
+/* Input function of the Wi-Fi network interface wrapped by
+ * wake_capture_input().
+ */
+static netif_input_fn wifi_netif_input;
+
+/* Leading bytes of the first frame received after a period of inactivity,
+ * shared between the WHD thread and the low power task.
+ */
+static uint8_t wake_frame[WAKE_FRAME_SNAPSHOT_LEN];
+static uint16_t wake_frame_len;
+static bool wake_frame_pending;
+static TickType_t last_rx_tick;
+
+/* Histogram of the reasons the network stack was resumed */
+static wake_histogram_t wake_histogram;
+
+/* Inactivity window currently passed to wait_net_suspend() */
+static uint32_t inactive_window_ms = INACTIVE_WINDOW_MS;
+
+/* Controller adapting the inactivity window to the traffic on the link */
+static inactivity_controller_t inactivity_controller;
+
+static const inactivity_controller_config_t inactivity_controller_config =
+{
+    .default_window_ms      = INACTIVE_WINDOW_MS,
+    .min_window_ms          = ADAPTIVE_WINDOW_MIN_MS,
+    .max_window_ms          = ADAPTIVE_WINDOW_MAX_MS,
+    .awake_uw               = POWER_MODEL_MCU_SLEEP_UW,
+    .suspended_uw           = POWER_MODEL_MCU_DEEPSLEEP_UW,
+    .suspend_resume_uj      = NETWORK_SUSPEND_RESUME_UJ,
+    .resume_latency_ms      = NETWORK_RESUME_LATENCY_MS,
+    .max_added_latency_us   = MAX_ADDED_LATENCY_US
+};
+
+/* Connection state machine */
+static conn_manager_t conn_manager;
+
+static const conn_manager_config_t conn_manager_config =
+{
+    .initial_delay_ms       = WIFI_RETRY_INITIAL_DELAY_MS,
+    .max_delay_ms           = WIFI_RETRY_MAX_DELAY_MS,
+    .jitter_percent         = WIFI_RETRY_JITTER_PERCENT
+};
+
 #if (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP)
 
+static cy_en_syspm_status_t sdhc_deepsleep_callback(
+        cy_stc_syspm_callback_params_t *callback_params,
+        cy_en_syspm_callback_mode_t mode);
+
 /* SysPm callback parameter structure for SDHC */
 static cy_stc_syspm_callback_params_t sdcardDSParams =
 {
@@ -90,7 +206,7 @@ static cy_stc_syspm_callback_params_t sdcardDSParams =
 /* SysPm callback structure for SDHC*/
 static cy_stc_syspm_callback_t sdhcDeepSleepCallbackHandler =
 {
-    .callback           = Cy_SD_Host_DeepSleepCallback,
+    .callback           = sdhc_deepsleep_callback,
     .skipMode           = SYSPM_SKIP_MODE,
     .type               = CY_SYSPM_DEEPSLEEP,
     .callbackParams     = &sdcardDSParams,
@@ -104,6 +220,38 @@ static cy_stc_syspm_callback_t sdhcDeepSleepCallbackHandler =
 /*******************************************************************************
 * Function definitions
 *******************************************************************************/
+#if (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP)
+/*******************************************************************************
+* Function Name: sdhc_deepsleep_callback
+********************************************************************************
+* Summary:
+* SDHC deep sleep callback that counts the callback results in the power
+* statistics.
+*******************************************************************************/
+static cy_en_syspm_status_t sdhc_deepsleep_callback(
+        cy_stc_syspm_callback_params_t *callback_params,
+        cy_en_syspm_callback_mode_t mode)
+{
+#if (SDHC_FAST_RESUME_ENABLE == 1U)
+    cy_en_syspm_status_t result = sdhc_resume_callback(callback_params, mode);
+#else
+    cy_en_syspm_status_t result =
+            Cy_SD_Host_DeepSleepCallback(callback_params, mode);
+#endif /* (SDHC_FAST_RESUME_ENABLE == 1U) */
+
+    power_stats_record_callback(RESIDENCY_CALLBACK_SDHC, mode, result);
+
+#if (WAKE_LATENCY_TRACE_ENABLE == 1U)
+    if (CY_SYSPM_AFTER_TRANSITION == mode)
+    {
+        wake_latency_mark(LATENCY_POINT_SDHC_RESTORED);
+    }
+#endif /* (WAKE_LATENCY_TRACE_ENABLE == 1U) */
+
+    return result;
+}
+#endif /* (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP) */
+
 /*******************************************************************************
 * Function Name: sdio_interrupt_handler
 ********************************************************************************
@@ -112,6 +260,12 @@ static cy_stc_syspm_callback_t sdhcDeepSleepCallbackHandler =
 *******************************************************************************/
 static void sdio_interrupt_handler(void)
 {
+#if (TRACE_LOG_ENABLE == 1U)
+    trace_log_record(TRACE_EVENT_WAKE_IRQ, TRACE_IRQ_SDIO);
+#endif /* (TRACE_LOG_ENABLE == 1U) */
+#if (WAKE_LATENCY_TRACE_ENABLE == 1U)
+    wake_latency_mark(LATENCY_POINT_SDIO_IRQ);
+#endif /* (WAKE_LATENCY_TRACE_ENABLE == 1U) */
     mtb_hal_sdio_process_interrupt(&sdio_instance);
 }
 
@@ -123,6 +277,12 @@ static void sdio_interrupt_handler(void)
 *******************************************************************************/
 static void host_wake_interrupt_handler(void)
 {
+#if (TRACE_LOG_ENABLE == 1U)
+    trace_log_record(TRACE_EVENT_WAKE_IRQ, TRACE_IRQ_HOST_WAKE);
+#endif /* (TRACE_LOG_ENABLE == 1U) */
+#if (WAKE_LATENCY_TRACE_ENABLE == 1U)
+    wake_latency_mark(LATENCY_POINT_HOST_WAKE);
+#endif /* (WAKE_LATENCY_TRACE_ENABLE == 1U) */
     mtb_hal_gpio_process_interrupt(&wcm_config.wifi_host_wake_pin);
 }
 
@@ -207,12 +367,104 @@ static void app_sdio_init(void)
     NVIC_EnableIRQ(CYBSP_WIFI_HOST_WAKE_IRQ);
 }
 
+#if (TRACE_LOG_ENABLE == 1U)
+/*******************************************************************************
+* Function Name: trace_dump
+********************************************************************************
+* Summary:
+*  Writes the events of the power-state timeline to the debug UART, preceded
+*  by the frequency of the timestamps and the names of the tasks whenever the
+*  number of tasks changed. Convert the output with tools/trace_log_chrome.c.
+*  With more than TRACE_LOG_MAX_TASKS tasks, no name is written and the names
+*  are tried again at the next dump.
+*******************************************************************************/
+static void trace_dump(void)
+{
+    static TaskStatus_t task_status[TRACE_LOG_MAX_TASKS];
+    static UBaseType_t named_tasks;
+    static UBaseType_t reported_tasks;
+    UBaseType_t tasks = uxTaskGetNumberOfTasks();
+    UBaseType_t count;
+
+    if (named_tasks != tasks)
+    {
+        /* Returns 0 without writing any task when the array is too small */
+        count = uxTaskGetSystemState(task_status, TRACE_LOG_MAX_TASKS, NULL);
+
+        retarget_io_printf("trace-clock,%lu\n",
+                (unsigned long)app_timestamp_tick_hz());
+
+        if (0U != count)
+        {
+            named_tasks = tasks;
+        }
+        else if (reported_tasks != tasks)
+        {
+            reported_tasks = tasks;
+            retarget_io_printf("Trace: %lu tasks exceed TRACE_LOG_MAX_TASKS, "
+                    "task names not written\n", (unsigned long)tasks);
+        }
+
+        for (UBaseType_t i = 0U; i < count; i++)
+        {
+            retarget_io_printf("trace-task,%lu,%s\n",
+                    (unsigned long)task_status[i].xTaskNumber,
+                    task_status[i].pcTaskName);
+        }
+    }
+
+    (void)trace_log_drain(retarget_io_write_raw);
+}
+#endif /* (TRACE_LOG_ENABLE == 1U) */
+
+/*******************************************************************************
+* Function Name: app_log_flush
+********************************************************************************
+* Summary:
+*  Writes the messages recorded in the binary log and the events of the
+*  power-state timeline to the debug UART. Called by the low power task while
+*  it is awake anyway.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void app_log_flush(void)
+{
+#if (APP_BINARY_LOG_ENABLE == 1U)
+    (void)binlog_drain(retarget_io_write_raw);
+#endif /* (APP_BINARY_LOG_ENABLE == 1U) */
+#if (TRACE_LOG_ENABLE == 1U)
+    trace_dump();
+#endif /* (TRACE_LOG_ENABLE == 1U) */
+}
+
+/*******************************************************************************
+* Function Name: init_connect_params
+********************************************************************************
+* Summary:
+*  Fills the connection parameters with the credentials of the AP.
+*******************************************************************************/
+static void init_connect_params(cy_wcm_connect_params_t *connect_param)
+{
+    memset(connect_param, RESET_VAL, sizeof(cy_wcm_connect_params_t));
+    memcpy(&connect_param->ap_credentials.SSID, WIFI_SSID, sizeof(WIFI_SSID));
+    memcpy(&connect_param->ap_credentials.password, WIFI_PASSWORD,
+            sizeof(WIFI_PASSWORD));
+    connect_param->ap_credentials.security = WIFI_SECURITY;
+}
+
 /*******************************************************************************
 * Function Name: wifi_connect
 ********************************************************************************
 * Summary:
-*  This function executes a connect to the AP. The maximum number of
-*  times it attempts to connect to the AP is specified by MAX_RETRY_COUNT.
+*  This function executes one attempt to connect to the AP. When
+*  FAST_RECONNECT_ENABLE is set, the association cache is tried first and the
+*  cache is refreshed after a full connection. Retries are scheduled by
+*  wifi_connect_with_backoff().
 *
 * Parameters:
 *  None
@@ -227,47 +479,563 @@ static cy_rslt_t wifi_connect(void)
     cy_rslt_t result;
     cy_wcm_connect_params_t connect_param;
     cy_wcm_ip_address_t ip_address;
-    memset(&connect_param, RESET_VAL, sizeof(cy_wcm_connect_params_t));
-    memcpy(&connect_param.ap_credentials.SSID, WIFI_SSID, sizeof(WIFI_SSID));
-    memcpy(&connect_param.ap_credentials.password, WIFI_PASSWORD,
-            sizeof(WIFI_PASSWORD));
-    connect_param.ap_credentials.security = WIFI_SECURITY;
+    init_connect_params(&connect_param);
+
+#if (FAST_RECONNECT_ENABLE == 1U)
+    if (fast_reconnect_connect(&connect_param, &ip_address))
+    {
+        APP_INFO(("Successfully reconnected to Wi-Fi network '%s'.\n",
+                WIFI_SSID));
+        return CY_RSLT_SUCCESS;
+    }
+#endif /* (FAST_RECONNECT_ENABLE == 1U) */
+
     APP_INFO(("Connecting to AP\n"));
 
-   /* Attempt to connect to Wi-Fi until a connection is made or until
-    * MAX_WIFI_RETRY_COUNT attempts have been made.
-    */
-    for(uint32_t conn_retries = RESET_VAL; conn_retries < MAX_WIFI_RETRY_COUNT;
-            conn_retries++ )
+    result = cy_wcm_connect_ap(&connect_param, &ip_address);
+
+    if(CY_RSLT_SUCCESS == result)
     {
-        result = cy_wcm_connect_ap(&connect_param, &ip_address);
+        APP_INFO(("Successfully connected to Wi-Fi network '%s'.\n",
+                WIFI_SSID));
 
-        if(CY_RSLT_SUCCESS == result)
+        if (CY_WCM_IP_VER_V4 == ip_address.version)
+        {
+            /* Printed byte by byte so that the binary log can record it */
+            APP_INFO(("Assigned IP address = %u.%u.%u.%u\n",
+                    (unsigned int)(ip_address.ip.v4 & 0xFFU),
+                    (unsigned int)((ip_address.ip.v4 >> 8U) & 0xFFU),
+                    (unsigned int)((ip_address.ip.v4 >> 16U) & 0xFFU),
+                    (unsigned int)(ip_address.ip.v4 >> 24U)));
+        }
+        else if(CY_WCM_IP_VER_V6 == ip_address.version)
         {
-            APP_INFO(("Successfully connected to Wi-Fi network '%s'.\n",
-                    connect_param.ap_credentials.SSID));
+            APP_INFO_TEXT(("Assigned IP address = %s\n",
+                    ip6addr_ntoa((const ip6_addr_t *)&ip_address.ip.v6)));
+        }
 
-            if (CY_WCM_IP_VER_V4 == ip_address.version)
-            {
-                APP_INFO(("Assigned IP address = %s\n",
-                        ip4addr_ntoa((const ip4_addr_t *)&ip_address.ip.v4)));
-            }
-            else if(CY_WCM_IP_VER_V6 == ip_address.version)
+#if (FAST_RECONNECT_ENABLE == 1U)
+        fast_reconnect_save(&connect_param, &ip_address);
+#endif /* (FAST_RECONNECT_ENABLE == 1U) */
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: wifi_connect_with_backoff
+********************************************************************************
+* Summary:
+*  Connects to the AP, retrying failed attempts as scheduled by the
+*  connection manager. The task is blocked between two attempts, which lets
+*  the MCU enter deep sleep. Returns once the device is connected.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void wifi_connect_with_backoff(void)
+{
+    cy_rslt_t result;
+    uint32_t wait_ms;
+    uint32_t delay_ms;
+
+    while (CONN_STATE_CONNECTED != conn_manager_state(&conn_manager))
+    {
+        if (CONN_ACTION_CONNECT == conn_manager_next(&conn_manager,
+                TICKS_TO_MS(xTaskGetTickCount()), &wait_ms))
+        {
+#if (TRACE_LOG_ENABLE == 1U)
+            trace_log_record(TRACE_EVENT_CONNECT_START, conn_manager.attempts);
+#endif /* (TRACE_LOG_ENABLE == 1U) */
+            result = wifi_connect();
+#if (TRACE_LOG_ENABLE == 1U)
+            trace_log_record(TRACE_EVENT_CONNECT_END,
+                    (CY_RSLT_SUCCESS == result) ? 1U : 0U);
+#endif /* (TRACE_LOG_ENABLE == 1U) */
+            delay_ms = conn_manager_result(&conn_manager,
+                    (CY_RSLT_SUCCESS == result),
+                    TICKS_TO_MS(xTaskGetTickCount()));
+
+            if (CY_RSLT_SUCCESS != result)
             {
-                APP_INFO(("Assigned IP address = %s\n",
-                        ip6addr_ntoa((const ip6_addr_t *)&ip_address.ip.v6)));
+                ERR_INFO(("Connection to Wi-Fi network failed with error code "
+                        "0x%08lx. Retrying in %lu ms...\n",
+                        (unsigned long)result, (unsigned long)delay_ms));
             }
+        }
+        else if (0U != wait_ms)
+        {
+            app_log_flush();
+            vTaskDelay(pdMS_TO_TICKS(wait_ms));
+        }
+    }
+
+    APP_INFO(("Connected after %lu attempt(s), %lu link loss(es) so far.\n",
+            (unsigned long)conn_manager.attempts,
+            (unsigned long)conn_manager.link_losses));
+    app_log_flush();
 
-            break;
+#if (ROAM_ENABLE == 1U)
+    roam_associated();
+#endif /* (ROAM_ENABLE == 1U) */
+#if (SOFTAP_ENABLE == 1U)
+    softap_sta_connected();
+#endif /* (SOFTAP_ENABLE == 1U) */
+#if (PKT_FILTER_AUTO_ENABLE == 1U)
+    pkt_filter_link_up();
+#endif /* (PKT_FILTER_AUTO_ENABLE == 1U) */
+}
+
+#if (ROAM_ENABLE == 1U)
+/*******************************************************************************
+* Function Name: wifi_roam
+********************************************************************************
+* Summary:
+*  Reassociates to another AP of the network selected by the roaming policy.
+*  If the target cannot be joined, the device falls back to a connection
+*  scheduled by the connection manager.
+*
+* Parameters:
+*  const roam_candidate_t *target: AP to reassociate to.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void wifi_roam(const roam_candidate_t *target)
+{
+    cy_rslt_t result;
+    cy_wcm_connect_params_t connect_param;
+    cy_wcm_ip_address_t ip_address;
+
+    init_connect_params(&connect_param);
+    result = roam_reassociate(target, &connect_param, &ip_address);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+#if (FAST_RECONNECT_ENABLE == 1U)
+        fast_reconnect_save(&connect_param, &ip_address);
+#endif /* (FAST_RECONNECT_ENABLE == 1U) */
+        roam_associated();
+#if (SOFTAP_ENABLE == 1U)
+        softap_sta_connected();
+#endif /* (SOFTAP_ENABLE == 1U) */
+#if (PKT_FILTER_AUTO_ENABLE == 1U)
+        pkt_filter_link_up();
+#endif /* (PKT_FILTER_AUTO_ENABLE == 1U) */
+    }
+    else
+    {
+        ERR_INFO(("Roaming failed with error code 0x%08lx. Rejoining...\n",
+                (unsigned long)result));
+        conn_manager_link_lost(&conn_manager);
+        wifi_connect_with_backoff();
+    }
+
+    app_log_flush();
+}
+#endif /* (ROAM_ENABLE == 1U) */
+
+/*******************************************************************************
+* Function Name: wcm_event_callback
+********************************************************************************
+* Summary:
+*  Wi-Fi Connection Manager event callback. When WCM reports that the link to
+*  the AP is lost and could not be restored, signals network activity so that
+*  a suspended network stack is resumed and the low power task, which reads
+*  the link state from WCM, starts rejoining the AP. Runs in the context of
+*  the WCM worker thread.
+*
+* Parameters:
+*  cy_wcm_event_t event: WCM event.
+*  cy_wcm_event_data_t *event_data: Event data. Unused.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void wcm_event_callback(cy_wcm_event_t event,
+        cy_wcm_event_data_t *event_data)
+{
+    CY_UNUSED_PARAMETER(event_data);
+
+    if (CY_WCM_EVENT_DISCONNECTED == event)
+    {
+#if (TRACE_LOG_ENABLE == 1U)
+        trace_log_record(TRACE_EVENT_LINK_LOST, 0U);
+#endif /* (TRACE_LOG_ENABLE == 1U) */
+        cy_network_activity_notify(CY_NETWORK_ACTIVITY_TX);
+    }
+}
+
+/*******************************************************************************
+* Function Name: connection_seed
+********************************************************************************
+* Summary:
+*  Returns a seed for the retry jitter that differs between devices, so that
+*  devices restarting together with their AP do not retry in lockstep.
+*
+*******************************************************************************/
+static uint32_t connection_seed(void)
+{
+    cy_wcm_mac_t mac;
+    uint32_t seed = (uint32_t)xTaskGetTickCount();
+
+    if (CY_RSLT_SUCCESS == cy_wcm_get_mac_addr(CY_WCM_INTERFACE_TYPE_STA,
+            &mac))
+    {
+        for (uint32_t i = 0U; i < sizeof(mac); i++)
+        {
+            seed = (seed * 31U) + mac[i];
         }
+    }
+
+    return seed;
+}
+
+/*******************************************************************************
+* Function Name: wake_capture_input
+********************************************************************************
+* Summary:
+*  Input function installed on the Wi-Fi network interface. Feeds the gap
+*  since the previous frame to the inactivity controller and keeps a copy of
+*  the leading bytes of the frame when the gap is longer than the inactivity
+*  window, since only such a frame can have resumed the suspended network
+*  stack. The frame is then passed on to the original input function. Runs in
+*  the context of the WHD thread.
+*
+* Parameters:
+*  struct pbuf *p: Received frame.
+*  struct netif *inp: Network interface the frame was received on.
+*
+* Return:
+*  err_t: Result of the original input function.
+*
+*******************************************************************************/
+static err_t wake_capture_input(struct pbuf *p, struct netif *inp)
+{
+    TickType_t now = xTaskGetTickCount();
+    uint32_t gap_ms = TICKS_TO_MS(now - last_rx_tick);
 
-        ERR_INFO(("Connection to Wi-Fi network failed with error code %d."
-               "Retrying in %d ms...\n",
-               (int)result, WIFI_CONN_RETRY_INTERVAL_MSEC));
-        vTaskDelay(pdMS_TO_TICKS(WIFI_CONN_RETRY_INTERVAL_MSEC));
+    taskENTER_CRITICAL();
+
+    inactivity_controller_observe(&inactivity_controller, gap_ms);
+
+    if (gap_ms >= inactive_window_ms)
+    {
+        wake_frame_len = pbuf_copy_partial(p, wake_frame, sizeof(wake_frame),
+                RESET_VAL);
+        wake_frame_pending = true;
     }
 
-    return result;
+    taskEXIT_CRITICAL();
+
+    last_rx_tick = now;
+
+#if (WLAN_PM_CONTROL_ENABLE == 1U)
+    wlan_pm_frame();
+#endif /* (WLAN_PM_CONTROL_ENABLE == 1U) */
+
+#if (WAKE_LATENCY_TRACE_ENABLE == 1U)
+    return wake_latency_input(p, inp, wifi_netif_input);
+#else
+    return wifi_netif_input(p, inp);
+#endif /* (WAKE_LATENCY_TRACE_ENABLE == 1U) */
+}
+
+/*******************************************************************************
+* Function Name: record_wake_reason
+********************************************************************************
+* Summary:
+*  Classifies the frame captured by wake_capture_input() and counts it in the
+*  wake reason histogram. A resume without a captured frame is counted as a
+*  wake without frame.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void record_wake_reason(void)
+{
+    uint8_t frame[WAKE_FRAME_SNAPSHOT_LEN];
+    uint16_t frame_len;
+    bool pending;
+    wake_frame_info_t info;
+
+    taskENTER_CRITICAL();
+    pending = wake_frame_pending;
+    frame_len = wake_frame_len;
+    memcpy(frame, wake_frame, frame_len);
+    wake_frame_pending = false;
+    taskEXIT_CRITICAL();
+
+    if (!pending || !wake_classify_frame(frame, frame_len, &info))
+    {
+        wake_classify_none(&info);
+    }
+#if (PKT_FILTER_AUTO_ENABLE == 1U)
+    else
+    {
+        pkt_filter_observe(frame, frame_len, &info);
+    }
+#endif /* (PKT_FILTER_AUTO_ENABLE == 1U) */
+
+    wake_histogram_add(&wake_histogram, &info.key,
+            TICKS_TO_MS(xTaskGetTickCount()));
+}
+
+/*******************************************************************************
+* Function Name: report_wake_reasons
+********************************************************************************
+* Summary:
+*  Prints the wake reason histogram.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void report_wake_reasons(void)
+{
+    APP_INFO(("Wake reasons (%lu total):\n",
+            (unsigned long)wake_histogram.total));
+
+    for (uint32_t bin = 0U; bin < wake_histogram.used_bins; bin++)
+    {
+        const wake_histogram_bin_t *entry = &wake_histogram.bins[bin];
+
+        APP_INFO(("  %s %s proto %u port/type %u: %lu\n",
+                wake_ethertype_name(entry->key.ethertype),
+                wake_cast_name(entry->key.cast),
+                (unsigned int)entry->key.ip_proto,
+                (unsigned int)entry->key.port,
+                (unsigned long)entry->count));
+    }
+
+    if (0U != wake_histogram.overflow)
+    {
+        APP_INFO(("  other: %lu\n", (unsigned long)wake_histogram.overflow));
+    }
+}
+
+/*******************************************************************************
+* Function Name: report_inactivity_windows
+********************************************************************************
+* Summary:
+*  Prints the last changes of the inactivity window.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void report_inactivity_windows(void)
+{
+    inactivity_decision_t history[INACTIVITY_HISTORY_LEN];
+    uint32_t count;
+
+    taskENTER_CRITICAL();
+    count = inactivity_controller_history(&inactivity_controller, history,
+            INACTIVITY_HISTORY_LEN);
+    taskEXIT_CRITICAL();
+
+    APP_INFO(("Inactivity window changes:\n"));
+
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        APP_INFO(("  at %lu ms: window %lu ms, added latency %lu us\n",
+                (unsigned long)history[i].timestamp_ms,
+                (unsigned long)history[i].window_ms,
+                (unsigned long)history[i].expected_latency_us));
+    }
+}
+
+/*******************************************************************************
+* Function Name: report_power_estimate
+********************************************************************************
+* Summary:
+*  Prints the time spent in each power mode since reset and charges it
+*  against the default power table to print the estimated average power and
+*  the network stack resume rate.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void report_power_estimate(void)
+{
+    residency_snapshot_t snapshot;
+    power_model_residency_t residency;
+    power_model_estimate_t estimate;
+
+    power_stats_get(&snapshot);
+
+    power_model_residency_reset(&residency);
+    for (uint32_t state = 0U; state < (uint32_t)POWER_MODEL_STATE_COUNT;
+            state++)
+    {
+        power_model_charge(&residency, (power_model_state_t)state,
+                (uint32_t)snapshot.residency_ms[state]);
+    }
+    residency.wakeups = net_resume_count;
+
+    power_model_estimate(&power_model_default_table, &residency, &estimate);
+
+    APP_INFO(("Residency: active %lu ms, sleep %lu ms, deep sleep %lu ms "
+            "(%lu entries, %lu failed)\n",
+            (unsigned long)snapshot.residency_ms[POWER_MODEL_STATE_ACTIVE],
+            (unsigned long)snapshot.residency_ms[POWER_MODEL_STATE_SLEEP],
+            (unsigned long)snapshot.residency_ms[POWER_MODEL_STATE_DEEPSLEEP],
+            (unsigned long)snapshot.entries[POWER_MODEL_STATE_DEEPSLEEP],
+            (unsigned long)snapshot.failed_entries[POWER_MODEL_STATE_DEEPSLEEP]));
+
+    APP_INFO(("Estimated average power: MCU %lu uW, WLAN %lu uW, "
+            "total %lu uW, %lu wakeups/hour\n",
+            (unsigned long)estimate.mcu_avg_uw,
+            (unsigned long)estimate.wlan_avg_uw,
+            (unsigned long)estimate.total_avg_uw,
+            (unsigned long)estimate.wakeups_per_hour));
+}
+
+/*******************************************************************************
+* Function Name: report_console_stats
+********************************************************************************
+* Summary:
+*  Prints the statistics of the asynchronous debug UART output: bytes queued
+*  and dropped, and how often and how long deep sleep was deferred to send
+*  them.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void report_console_stats(void)
+{
+    retarget_io_tx_stats_t stats;
+
+    retarget_io_get_tx_stats(&stats);
+
+    APP_INFO(("Console: %lu bytes queued, %lu dropped, %lu deep sleep "
+            "deferrals (%lu us, max %lu us), %lu sleeps with output queued\n",
+            (unsigned long)stats.bytes_queued,
+            (unsigned long)stats.bytes_dropped,
+            (unsigned long)stats.sleep_deferrals,
+            (unsigned long)stats.flush_time_us,
+            (unsigned long)stats.max_flush_time_us,
+            (unsigned long)stats.sleeps_with_pending));
+}
+
+/*******************************************************************************
+* Function Name: report_connection_stats
+********************************************************************************
+* Summary:
+*  Prints the state of the connection to the AP and the connection attempts,
+*  failures and link losses since reset.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void report_connection_stats(void)
+{
+    APP_INFO(("Connection: %s, %lu attempts, %lu failed, %lu link losses\n",
+            conn_manager_state_name(conn_manager_state(&conn_manager)),
+            (unsigned long)conn_manager.total_attempts,
+            (unsigned long)conn_manager.total_failures,
+            (unsigned long)conn_manager.link_losses));
+}
+
+#if (RX_PBUF_POOL_ENABLE == 1U)
+/*******************************************************************************
+* Function Name: report_rx_pbuf_pool
+********************************************************************************
+* Summary:
+*  Prints the counters of the WLAN receive buffer pool.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void report_rx_pbuf_pool(void)
+{
+    rx_pbuf_pool_stats_t stats;
+
+    rx_pbuf_pool_get_stats(&stats);
+
+    APP_INFO(("Rx pool: %lu pool allocations, %lu exhausted, "
+            "%lu oversized, %lu of %lu buffers in use (max %lu)\n",
+            (unsigned long)stats.pool_allocs,
+            (unsigned long)stats.exhausted,
+            (unsigned long)stats.oversized,
+            (unsigned long)stats.in_use,
+            (unsigned long)RX_PBUF_POOL_COUNT,
+            (unsigned long)stats.max_in_use));
+}
+#endif /* (RX_PBUF_POOL_ENABLE == 1U) */
+
+/*******************************************************************************
+* Function Name: install_wake_capture
+********************************************************************************
+* Summary:
+*  Obtains the lwIP network interface of the Wi-Fi station and installs
+*  wake_capture_input() as its input function, to classify the reason the
+*  network stack was resumed. Called after every connection since the
+*  interface is added again when the AP is rejoined.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  struct netif *: Network interface of the Wi-Fi station.
+*
+*******************************************************************************/
+static struct netif *install_wake_capture(void)
+{
+    struct netif *wifi;
+
+   /* Obtain the pointer to the lwIP network interface. This pointer is used to
+    * access the Wi-Fi driver interface to configure the WLAN power-save mode.
+    */
+    wifi = (struct netif*)cy_network_get_nw_interface
+                         (CY_NETWORK_WIFI_STA_INTERFACE, INTERFACE_ID);
+
+    if (wake_capture_input != wifi->input)
+    {
+        wifi_netif_input = wifi->input;
+        wifi->input = wake_capture_input;
+    }
+
+    last_rx_tick = xTaskGetTickCount();
+
+#if (WLAN_PM_CONTROL_ENABLE == 1U)
+    /* Apply the power-save setting for the beacon interval of the new AP */
+    wlan_pm_link_up();
+#endif /* (WLAN_PM_CONTROL_ENABLE == 1U) */
+
+    return wifi;
 }
 
 /*******************************************************************************
@@ -294,6 +1062,13 @@ void lowpower_task(void *arg)
 {
     cy_rslt_t result;
     struct netif *wifi;
+    uint32_t inactive_interval_ms = INACTIVE_INTERVAL_MS;
+    uint32_t suspend_ms;
+    uint32_t suspend_interval_ms;
+    uint32_t suspend_window_ms;
+#if (ROAM_ENABLE == 1U)
+    roam_candidate_t roam_target;
+#endif /* (ROAM_ENABLE == 1U) */
 
 #if (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP)
     
@@ -302,6 +1077,10 @@ void lowpower_task(void *arg)
     
 #endif /* (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP) */
 
+#if (WAKE_LATENCY_TRACE_ENABLE == 1U)
+    wake_latency_init();
+#endif /* (WAKE_LATENCY_TRACE_ENABLE == 1U) */
+
     /* Initialize SDIO instance*/
     app_sdio_init();
 
@@ -309,40 +1088,211 @@ void lowpower_task(void *arg)
     wcm_config.interface = CY_WCM_INTERFACE_TYPE_AP_STA ;
     wcm_config.wifi_interface_instance = &sdio_instance;
 
+#if (RX_PBUF_POOL_ENABLE == 1U)
+    /* Serve the receive buffers of WHD from the pool from the first frame. */
+    rx_pbuf_pool_init();
+#endif /* (RX_PBUF_POOL_ENABLE == 1U) */
+
     /* Initializes the Wi-Fi device and lwIP stack.*/
     result = cy_wcm_init(&wcm_config);
 
     if(CY_RSLT_SUCCESS != result)
     {
         ERR_INFO(("Failed to initialize Wi-Fi Connection Manager.\n"));
+        app_log_flush();
         handle_app_error();
     }
 
-    /* Connect to Wi-Fi AP. */
-    result = wifi_connect();
+#if (SDIO_BENCHMARK_ENABLE == 1U)
+    /* Measure every SDIO bus profile while the bus is still idle. */
+    sdio_bench_run(&sdio_instance, CYBSP_WIFI_SDIO_HW, SDIO_BUS_PROFILE);
+    app_log_flush();
+#endif /* (SDIO_BENCHMARK_ENABLE == 1U) */
+
+    /* WHD brings the bus up at default speed. Switch it to the selected
+     * profile before any other WHD call.
+     */
+    APP_INFO(("SDIO bus profile: %s\n", sdio_profiles[sdio_profile_select(
+            &sdio_instance, CYBSP_WIFI_SDIO_HW, SDIO_BUS_PROFILE)].name));
 
-    if (CY_RSLT_SUCCESS != result)
+#if (SDHC_FAST_RESUME_ENABLE == 1U)
+    /* Save and restore this bus configuration around deep sleep. */
+    sdhc_resume_init(CYBSP_WIFI_SDIO_HW);
+#endif /* (SDHC_FAST_RESUME_ENABLE == 1U) */
+
+    /* Rejoin the AP when WCM reports that the link is lost. */
+    result = cy_wcm_register_event_callback(wcm_event_callback);
+
+    if(CY_RSLT_SUCCESS != result)
     {
-        ERR_INFO(("Failed to connect to AP.\n"));
+        ERR_INFO(("Failed to register the WCM event callback.\n"));
+        app_log_flush();
         handle_app_error();
     }
 
-   /* Obtain the pointer to the lwIP network interface. This pointer is used to
-    * access the Wi-Fi driver interface to configure the WLAN power-save mode.
-    */
-    wifi = (struct netif*)cy_network_get_nw_interface
-                         (CY_NETWORK_WIFI_STA_INTERFACE, INTERFACE_ID);
+    /* Connect to Wi-Fi AP. */
+    conn_manager_init(&conn_manager, &conn_manager_config, connection_seed());
+#if (ROAM_ENABLE == 1U)
+    roam_init();
+#endif /* (ROAM_ENABLE == 1U) */
+#if (SOFTAP_ENABLE == 1U)
+    softap_init();
+#endif /* (SOFTAP_ENABLE == 1U) */
+    wifi_connect_with_backoff();
+
+    wake_histogram_init(&wake_histogram);
+#if (PKT_FILTER_AUTO_ENABLE == 1U)
+    pkt_filter_init();
+#endif /* (PKT_FILTER_AUTO_ENABLE == 1U) */
+#if (KA_OFFLOAD_ENABLE == 1U)
+    ka_offload_init();
+#endif /* (KA_OFFLOAD_ENABLE == 1U) */
+    inactivity_controller_init(&inactivity_controller,
+            &inactivity_controller_config);
+    wifi = install_wake_capture();
+
+#if (MEM_REPORT_ENABLE == 1U)
+    mem_report_print("connected");
+    app_log_flush();
+#endif /* (MEM_REPORT_ENABLE == 1U) */
 
     while (true)
     {
+#if (ADAPTIVE_INACTIVE_WINDOW == 1U)
+        /* Select the inactivity window that minimizes the expected energy
+         * for the inter-packet gaps observed so far.
+         */
+        taskENTER_CRITICAL();
+        inactive_window_ms = inactivity_controller_select(
+                &inactivity_controller,
+                TICKS_TO_MS(xTaskGetTickCount()));
+        taskEXIT_CRITICAL();
+        inactive_interval_ms = inactivity_controller_interval(
+                inactive_window_ms);
+#endif /* (ADAPTIVE_INACTIVE_WINDOW == 1U) */
+
+        suspend_ms = portMAX_DELAY;
+        suspend_interval_ms = inactive_interval_ms;
+        suspend_window_ms = inactive_window_ms;
+
+#if (SOFTAP_ENABLE == 1U)
+        /* Start or tear down the SoftAP. The network stack stays suspended
+         * no longer than the idle timeout of the SoftAP, and is suspended
+         * after a longer inactivity window while a client is associated.
+         */
+        suspend_ms = softap_poll();
+        if (softap_has_clients())
+        {
+            suspend_interval_ms = SOFTAP_INACTIVE_INTERVAL_MS;
+            suspend_window_ms = SOFTAP_INACTIVE_WINDOW_MS;
+        }
+#endif /* (SOFTAP_ENABLE == 1U) */
+
        /* Configures an emac activity callback to the Wi-Fi interface and
         * suspends the network if the network is inactive for a duration of
-        * INACTIVE_WINDOW_MS inside an interval of INACTIVE_INTERVAL_MS. The
+        * suspend_window_ms inside an interval of suspend_interval_ms. The
         * callback is used to signal the presence/absence of network activity
         * to resume/suspend the network stack.
         */
-        wait_net_suspend(wifi, portMAX_DELAY, INACTIVE_INTERVAL_MS,
-                INACTIVE_WINDOW_MS);
+#if (KA_OFFLOAD_ENABLE == 1U)
+        /* Let the WLAN firmware answer the ARP requests and send the TCP
+         * keep-alives while the network stack is suspended.
+         */
+        ka_offload_suspend();
+#endif /* (KA_OFFLOAD_ENABLE == 1U) */
+#if (TRACE_LOG_ENABLE == 1U)
+        trace_log_record(TRACE_EVENT_NET_WAIT, 0U);
+#endif /* (TRACE_LOG_ENABLE == 1U) */
+        wait_net_suspend(wifi, suspend_ms, suspend_interval_ms,
+                suspend_window_ms);
+#if (TRACE_LOG_ENABLE == 1U)
+        trace_log_record(TRACE_EVENT_NET_RESUMED, 0U);
+#endif /* (TRACE_LOG_ENABLE == 1U) */
+
+#if (WAKE_LATENCY_TRACE_ENABLE == 1U)
+        wake_latency_resumed();
+#endif /* (WAKE_LATENCY_TRACE_ENABLE == 1U) */
+#if (KA_OFFLOAD_ENABLE == 1U)
+        ka_offload_resume();
+#endif /* (KA_OFFLOAD_ENABLE == 1U) */
+
+        if (!cy_wcm_is_connected_to_ap())
+        {
+            ERR_INFO(("Link to the AP lost. Rejoining...\n"));
+            conn_manager_link_lost(&conn_manager);
+            wifi_connect_with_backoff();
+            wifi = install_wake_capture();
+            continue;
+        }
+
+        net_resume_count++;
+        record_wake_reason();
+
+#if (UPLINK_BATCH_ENABLE == 1U)
+        /* Send the queued records while the network stack is resumed */
+        uplink_notify_wake();
+#endif /* (UPLINK_BATCH_ENABLE == 1U) */
+
+#if (ROAM_ENABLE == 1U)
+        /* Sample the link while the network stack is resumed anyway */
+        if (roam_poll(&roam_target))
+        {
+            wifi_roam(&roam_target);
+            wifi = install_wake_capture();
+        }
+#endif /* (ROAM_ENABLE == 1U) */
+
+        if (0U == (net_resume_count % STATS_REPORT_INTERVAL))
+        {
+            report_power_estimate();
+            report_wake_reasons();
+            report_inactivity_windows();
+            report_console_stats();
+            report_connection_stats();
+#if (configGENERATE_RUN_TIME_STATS == 1)
+            cpu_stats_report(STATS_REPORT_INTERVAL);
+#endif /* (configGENERATE_RUN_TIME_STATS == 1) */
+#if (IDLE_GOVERNOR_ENABLE == 1U)
+            idle_sleep_report();
+            idle_sleep_dump_trace();
+#endif /* (IDLE_GOVERNOR_ENABLE == 1U) */
+#if (RX_PBUF_POOL_ENABLE == 1U)
+            report_rx_pbuf_pool();
+#endif /* (RX_PBUF_POOL_ENABLE == 1U) */
+#if (UPLINK_BATCH_ENABLE == 1U)
+            uplink_report();
+#endif /* (UPLINK_BATCH_ENABLE == 1U) */
+#if (WLAN_PM_CONTROL_ENABLE == 1U)
+            wlan_pm_report();
+#endif /* (WLAN_PM_CONTROL_ENABLE == 1U) */
+#if (PKT_FILTER_AUTO_ENABLE == 1U)
+            pkt_filter_update();
+#endif /* (PKT_FILTER_AUTO_ENABLE == 1U) */
+#if (KA_OFFLOAD_ENABLE == 1U)
+            ka_offload_report();
+#endif /* (KA_OFFLOAD_ENABLE == 1U) */
+#if (WAKE_LATENCY_TRACE_ENABLE == 1U)
+            wake_latency_report();
+#endif /* (WAKE_LATENCY_TRACE_ENABLE == 1U) */
+#if (SDHC_FAST_RESUME_ENABLE == 1U)
+            sdhc_resume_report();
+#endif /* (SDHC_FAST_RESUME_ENABLE == 1U) */
+#if (ROAM_ENABLE == 1U)
+            roam_report();
+#endif /* (ROAM_ENABLE == 1U) */
+#if (SOFTAP_ENABLE == 1U)
+            softap_report();
+#endif /* (SOFTAP_ENABLE == 1U) */
+        }
+
+#if (MEM_REPORT_ENABLE == 1U)
+        if (0U == (net_resume_count % MEM_REPORT_RESUME_CYCLES))
+        {
+            mem_report_print("resume cycles");
+        }
+#endif /* (MEM_REPORT_ENABLE == 1U) */
+
+        app_log_flush();
 
         /* Invert the User LED 1 when the device wakes up */
         Cy_GPIO_Inv(CYBSP_USER_LED_PORT,CYBSP_USER_LED_NUM);
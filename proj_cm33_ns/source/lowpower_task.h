@@ -56,6 +56,15 @@ extern "C" {
 #include <FreeRTOS.h>
 #include <task.h>
 
+/* Binary log and debug UART header files */
+#include "binlog.h"
+#include "retarget_io_init.h"
+
+/* Inactivity detection and connection retry timing, shared with the Linux
+ * tools
+ */
+#include "lowpower_config.h"
+
 /*******************************************************************************
 * Defines
 *******************************************************************************/
@@ -70,29 +79,199 @@ extern "C" {
  */
 #define WIFI_SECURITY                     (CY_WCM_SECURITY_WPA2_AES_PSK)
 
-#define LED_BLINK_DELAY_MS                (100U)
+/* Set to 1 to persist the association parameters of the last connection in
+ * RRAM and use them on the next boot for a directed join that skips the scan
+ * and the passphrase hashing. ASSOC_CACHE_NVM_ADDR must then point to an RRAM
+ * area of at least 128 bytes that is not used by any application image.
+ */
+#define FAST_RECONNECT_ENABLE             (0U)
+#define ASSOC_CACHE_NVM_ADDR              (0x22FF0000UL)
+
+/* Set to 1 to reuse the cached IP lease as a static address on a fast
+ * reconnect instead of running DHCP. Only use it when the AP reserves the
+ * address for the device.
+ */
+#define FAST_RECONNECT_REUSE_IP           (0U)
+
+/* SDIO bus profile applied once the WLAN device is initialized. See
+ * sdio_profile.c. SDIO_PROFILE_DEFAULT_SPEED leaves the bus as configured by
+ * WHD. SDIO_PROFILE_HIGH_SPEED runs the bus at 50 MHz, which shortens bulk
+ * transfers such as OTA downloads. The measurements in Table 1 of README.md
+ * were made with SDIO_PROFILE_DEFAULT_SPEED.
+ */
+#define SDIO_BUS_PROFILE                  (SDIO_PROFILE_DEFAULT_SPEED)
+
+/* Set to 1 to measure the throughput and the per-transfer latency of every
+ * SDIO bus profile at startup, before connecting to the AP.
+ */
+#define SDIO_BENCHMARK_ENABLE             (0U)
+
+/* Set RX_PBUF_POOL_ENABLE to 1 in the Makefile to receive the WLAN frames
+ * into the fixed pool of rx_pbuf_pool.c. The SDIO bus then transfers every
+ * frame into a DMA-aligned buffer of whole blocks that is handed to lwIP as
+ * is, which shortens the time the host is awake for each received frame. The
+ * pool counters are printed with the statistics. The pool is installed with a
+ * linker wrap, so it requires the GCC_ARM toolchain.
+ */
+#ifndef RX_PBUF_POOL_ENABLE
+#define RX_PBUF_POOL_ENABLE               (0U)
+#endif
+
+/* Set to 1 to replace the default tickless idle implementation with the idle
+ * governor of idle_sleep.c. For every idle period, it selects staying awake,
+ * CPU sleep or deep sleep, whichever spends the least energy over the
+ * predicted period given the measured cost of entering and exiting each
+ * mode. Set IDLE_TRACE_ENABLE to 1 to also print the idle periods with the
+ * statistics, for tools/idle_trace_replay.c.
+ */
+#define IDLE_GOVERNOR_ENABLE              (0U)
+#define IDLE_TRACE_ENABLE                 (0U)
+
+/* Set to 1 to control the power-save mode and the listen interval of the
+ * WLAN device from the maximum downlink latency accepted by the application.
+ * The latency budget can be changed at run time with
+ * wlan_pm_set_latency_budget(). A budget shorter than one beacon interval
+ * keeps the WLAN device awake (PM0). See wlan_pm.h for the burst detection.
+ */
+#define WLAN_PM_CONTROL_ENABLE            (0U)
+#define WLAN_PM_LATENCY_BUDGET_MS         (1000U)
 
-/* This macro specifies the interval in milliseconds that the device monitors
- * the network for inactivity. If the network is inactive for duration lesser 
- * than INACTIVE_WINDOW_MS in this interval, the MCU does not suspend the network 
- * stack and informs the calling function that the MCU wait period timed out 
- * while waiting for network to become inactive.
+/* Set to 1 to judge every frame that resumes the network stack against the
+ * sockets open in lwIP and to propose WLAN packet filters for the frames
+ * never used by the host. With PKT_FILTER_DRY_RUN set to 1, the filters and
+ * the share of the wakes they would avoid are only printed with the
+ * statistics; set it to 0 to install them. See pkt_filter.h.
  */
-#define INACTIVE_INTERVAL_MS              (300U)
+#define PKT_FILTER_AUTO_ENABLE            (0U)
+#define PKT_FILTER_DRY_RUN                (1U)
 
-/* This macro specifies the continuous duration in milliseconds for which the 
- * network has to be inactive. If the network is inactive for this duaration,
- * the MCU will suspend the network stack. Now, the MCU will not need to service
- * the network timers which allows it to stay longer in sleep/deepsleep.
+/* Set to 1 to let the WLAN firmware answer the ARP requests for the IPv4
+ * address of the host and send the TCP keep-alives of the connection
+ * registered with ka_offload_watch_socket() while the network stack is
+ * suspended. The connection is handed over only when it has no data in
+ * flight. See ka_offload.h for the keep-alive interval.
  */
-#define INACTIVE_WINDOW_MS                (200U)
+#define KA_OFFLOAD_ENABLE                 (0U)
 
-/* Delay between successive Wi-Fi connection attempts, in milliseconds. */
-#define WIFI_CONN_RETRY_INTERVAL_MSEC     (100U)
+/* Set to 1 to timestamp the path from a wake event to the low power task:
+ * SDHC restore after deep sleep, host wake and SDIO interrupts, frame passed
+ * up by WHD and received by the tcpip thread, and return of
+ * wait_net_suspend(). The median, 99th percentile and maximum time of each
+ * stage are printed with the statistics or by wake_latency_report().
+ */
+#define WAKE_LATENCY_TRACE_ENABLE         (0U)
+
+/* Set to 1 to replace the generic SDHC deep sleep callback with a fast path
+ * once the SDIO bus is configured. The register context of the SD host is
+ * saved before deep sleep, and after wakeup only the registers that lost
+ * their value are written back and the SD clock is restarted as soon as the
+ * internal clock is stable. The card is not re-initialized. The generic
+ * callback is used whenever the bus configuration changed or a restore
+ * cannot be verified. See sdhc_retain.h.
+ */
+#define SDHC_FAST_RESUME_ENABLE           (0U)
+
+/* Set to 1 to roam between the APs of the network. While the link is weak,
+ * the wakes of the network stack are used to scan for the other APs of the
+ * network, and the device reassociates to the strongest AP found once the
+ * link is weaker than the trigger level and the AP is stronger by the
+ * hysteresis margin. See roam.h for the thresholds.
+ */
+#define ROAM_ENABLE                       (0U)
+
+/* Set to 1 to run a SoftAP alongside the STA link, for provisioning and
+ * local access. The SoftAP shares the channel of the STA link and is torn
+ * down once it has been left without clients for an idle timeout. While a
+ * client is associated, the network stack is suspended after a longer
+ * inactivity window. See softap.h for the credentials and timeouts.
+ */
+#define SOFTAP_ENABLE                     (0U)
+
+/* Set to 1 to record a timeline of the low-power mode transitions, the
+ * suspend and resume of the network stack, the wake interrupts, and the
+ * connection attempts in a fixed ring (see trace_log.h). The events are
+ * written to the debug UART as text lines whenever the low power task
+ * flushes its log. Convert the UART output to a Chrome trace with
+ * tools/trace_log_chrome.c. Set TRACE_LOG_TASK_SWITCHES in FreeRTOSConfig.h
+ * to also record the task switches.
+ */
+#define TRACE_LOG_ENABLE                  (0U)
+
+/* Set to 1 to create the application tasks in statically allocated stacks
+ * and control blocks instead of the heap. The tasks and RTOS objects created
+ * by the middleware are still allocated from the heap.
+ */
+#define APP_STATIC_ALLOCATION             (0U)
+
+/* Set MEM_REPORT_ENABLE to 1 in the Makefile to record the heap allocation
+ * sites and print a memory report once connected to the AP and then every
+ * MEM_REPORT_RESUME_CYCLES network stack resumes. See mem_report.c. The
+ * allocations are recorded with linker wraps, so it requires the GCC_ARM
+ * toolchain.
+ */
+#ifndef MEM_REPORT_ENABLE
+#define MEM_REPORT_ENABLE                 (0U)
+#endif
+#define MEM_REPORT_RESUME_CYCLES          (100U)
+
+/* Set to 1 to run the network benchmark task once connected to the AP. It
+ * runs TCP and UDP send and receive tests against tools/net_bench_peer.c
+ * running on NET_BENCH_PEER_IP and prints the throughput, the UDP loss and
+ * jitter, and the estimated energy per megabyte. The tests are repeated every
+ * NET_BENCH_REPEAT_INTERVAL_MS, or run once if it is 0.
+ */
+#define NET_BENCH_ENABLE                  (0U)
+#define NET_BENCH_PEER_IP                 "192.168.1.100"
+#define NET_BENCH_PEER_PORT               (5201U)
+#define NET_BENCH_REPEAT_INTERVAL_MS      (0U)
+
+/* Destination of the data processed by the CM55 when IPC_PIPELINE_ENABLE is
+ * set to 1 in ipc_config.h. Each buffer is sent as one UDP datagram.
+ */
+#define PIPELINE_SINK_IP                  "192.168.1.100"
+#define PIPELINE_SINK_PORT                (5300U)
+
+/* Set to 1 to create the batched uplink task. The application queues its
+ * records with uplink_send() while the network stack stays suspended, and
+ * they are sent to UPLINK_SINK_IP in one resume of the network stack. See
+ * uplink.h for the flush policy.
+ */
+#define UPLINK_BATCH_ENABLE               (0U)
+#define UPLINK_SINK_IP                    "192.168.1.100"
+#define UPLINK_SINK_PORT                  (5400U)
+
+/* Set to 1 to record the debug prints in the binary log instead of printing
+ * them. A message then costs a few tens of cycles instead of blocking on the
+ * UART, and the log is written to the debug UART in bulk when the low power
+ * task is awake. Decode the UART output with tools/binlog_decode.py and the
+ * ELF file of this project. Only the addresses of '%s' arguments are
+ * recorded, so they must point to constant strings: print messages with
+ * strings held in RAM with APP_INFO_TEXT.
+ */
+#define APP_BINARY_LOG_ENABLE             (0U)
 
 /* Debug prints */
-#define APP_INFO( x )           do { printf("Info: "); printf x;} while(0);
-#define ERR_INFO( x )           do { printf("Error: "); printf x;} while(0);
+#if (APP_BINARY_LOG_ENABLE == 1U)
+#define APP_INFO( x )           do { BINLOG_INFO x; } while(0);
+#define ERR_INFO( x )           do { BINLOG_ERROR x; } while(0);
+#else
+#define APP_INFO( x )           do { retarget_io_printf("Info: "); \
+                                     retarget_io_printf x;} while(0);
+#define ERR_INFO( x )           do { retarget_io_printf("Error: "); \
+                                     retarget_io_printf x;} while(0);
+#endif /* (APP_BINARY_LOG_ENABLE == 1U) */
+
+/* Debug prints with '%s' arguments held in RAM, such as task names or
+ * converted addresses. They are always printed as text, after the messages
+ * held in the binary log. Only used by the low power task, which drains it.
+ */
+#if (APP_BINARY_LOG_ENABLE == 1U)
+#define APP_INFO_TEXT( x )      do { (void)binlog_drain(retarget_io_write_raw); \
+                                     retarget_io_printf("Info: "); \
+                                     retarget_io_printf x;} while(0);
+#else
+#define APP_INFO_TEXT( x )      APP_INFO( x )
+#endif /* (APP_BINARY_LOG_ENABLE == 1U) */
 
 /*******************************************************************************
  * Global Variables
@@ -43,6 +43,16 @@
 #include "retarget_io_init.h"
 #include "cyabs_rtos_impl.h"
 #include "cy_time.h"
+#include "app_timestamp.h"
+#include "power_stats.h"
+#include "net_bench.h"
+#include "ipc_config.h"
+#include "pipeline_uplink.h"
+#include "mem_report.h"
+#include "idle_sleep.h"
+#include "uplink.h"
+#include "wlan_pm.h"
+#include "trace_log.h"
 
 /*******************************************************************************
 * Macros
@@ -80,6 +90,48 @@ static mtb_hal_lptimer_t lptimer_obj;
 /* RTC HAL object */
 static mtb_hal_rtc_t rtc_obj;
 
+/* Stacks and control blocks of the application tasks. xTaskCreate() takes the
+ * stack depth in words, so the static stacks have the same depth as the ones
+ * allocated from the heap.
+ */
+#if (APP_STATIC_ALLOCATION == 1U)
+static StackType_t lowpower_task_stack[LOW_POWER_TASK_STACK_SIZE_BYTES];
+static StaticTask_t lowpower_task_tcb;
+#define LOW_POWER_TASK_STORAGE  lowpower_task_stack, &lowpower_task_tcb
+
+#if (NET_BENCH_ENABLE == 1U)
+static StackType_t net_bench_task_stack[NET_BENCH_TASK_STACK_SIZE_BYTES];
+static StaticTask_t net_bench_task_tcb;
+#define NET_BENCH_TASK_STORAGE  net_bench_task_stack, &net_bench_task_tcb
+#endif /* (NET_BENCH_ENABLE == 1U) */
+
+#if (IPC_PIPELINE_ENABLE == 1U)
+static StackType_t pipeline_uplink_task_stack
+        [PIPELINE_UPLINK_TASK_STACK_SIZE_BYTES];
+static StaticTask_t pipeline_uplink_task_tcb;
+#define PIPELINE_UPLINK_TASK_STORAGE \
+        pipeline_uplink_task_stack, &pipeline_uplink_task_tcb
+#endif /* (IPC_PIPELINE_ENABLE == 1U) */
+
+#if (UPLINK_BATCH_ENABLE == 1U)
+static StackType_t uplink_task_stack[UPLINK_TASK_STACK_SIZE_BYTES];
+static StaticTask_t uplink_task_tcb;
+#define UPLINK_TASK_STORAGE     uplink_task_stack, &uplink_task_tcb
+#endif /* (UPLINK_BATCH_ENABLE == 1U) */
+
+#if (WLAN_PM_CONTROL_ENABLE == 1U)
+static StackType_t wlan_pm_task_stack[WLAN_PM_TASK_STACK_SIZE_BYTES];
+static StaticTask_t wlan_pm_task_tcb;
+#define WLAN_PM_TASK_STORAGE    wlan_pm_task_stack, &wlan_pm_task_tcb
+#endif /* (WLAN_PM_CONTROL_ENABLE == 1U) */
+#else
+#define LOW_POWER_TASK_STORAGE          NULL, NULL
+#define NET_BENCH_TASK_STORAGE          NULL, NULL
+#define PIPELINE_UPLINK_TASK_STORAGE    NULL, NULL
+#define UPLINK_TASK_STORAGE             NULL, NULL
+#define WLAN_PM_TASK_STORAGE            NULL, NULL
+#endif /* (APP_STATIC_ALLOCATION == 1U) */
+
 /*******************************************************************************
 * Function Name: lptimer_interrupt_handler
 ********************************************************************************
@@ -91,6 +143,48 @@ static void lptimer_interrupt_handler(void)
     mtb_hal_lptimer_process_interrupt(&lptimer_obj);
 }
 
+/*******************************************************************************
+* Function Name: create_task
+********************************************************************************
+* Summary:
+*  Creates an application task, in the stack and control block given when
+*  APP_STATIC_ALLOCATION is set to 1 and from the heap otherwise.
+*
+* Parameters:
+*  TaskFunction_t task: Task function.
+*  const char *name: Task name.
+*  uint32_t stack_depth: Stack depth, in words.
+*  UBaseType_t priority: Task priority.
+*  TaskHandle_t *handle: Filled with the task handle. Can be NULL.
+*  StackType_t *stack: Stack of stack_depth words when statically allocated.
+*  StaticTask_t *tcb: Task control block when statically allocated.
+*
+* Return:
+*  BaseType_t: pdPASS if the task was created.
+*
+*******************************************************************************/
+static BaseType_t create_task(TaskFunction_t task, const char *name,
+        uint32_t stack_depth, UBaseType_t priority, TaskHandle_t *handle,
+        StackType_t *stack, StaticTask_t *tcb)
+{
+#if (APP_STATIC_ALLOCATION == 1U)
+    TaskHandle_t created = xTaskCreateStatic(task, name, stack_depth, NULL,
+            priority, stack, tcb);
+
+    if (NULL != handle)
+    {
+        *handle = created;
+    }
+
+    return (NULL != created) ? pdPASS : pdFAIL;
+#else
+    (void)stack;
+    (void)tcb;
+
+    return xTaskCreate(task, name, stack_depth, NULL, priority, handle);
+#endif /* (APP_STATIC_ALLOCATION == 1U) */
+}
+
 /*******************************************************************************
 * Function Name: setup_clib_support
 ********************************************************************************
@@ -202,6 +296,11 @@ int main(void)
 {
     cy_rslt_t result;
 
+#if (MEM_REPORT_ENABLE == 1U)
+    /* Record the heap allocations from the first one */
+    mem_report_init();
+#endif /* (MEM_REPORT_ENABLE == 1U) */
+
     /* Initialize the device and board peripherals */
     result = cybsp_init();
 
@@ -217,6 +316,27 @@ int main(void)
     /* Setup the LPTimer instance for CM33 CPU. */
     setup_tickless_idle_timer();
 
+    /* Use the LPTimer as timestamp source and start counting the time spent
+     * in each power mode.
+     */
+    app_timestamp_init(&lptimer_obj);
+    power_stats_init();
+
+#if (IDLE_GOVERNOR_ENABLE == 1U)
+    /* Select the power mode of every idle period from now on */
+    idle_sleep_init(&lptimer_obj);
+#endif /* (IDLE_GOVERNOR_ENABLE == 1U) */
+
+#if (APP_BINARY_LOG_ENABLE == 1U)
+    /* Timestamp the binary log messages with the LPTimer */
+    binlog_init(app_timestamp_ticks);
+#endif /* (APP_BINARY_LOG_ENABLE == 1U) */
+
+#if (TRACE_LOG_ENABLE == 1U)
+    /* Timestamp the events of the power-state timeline with the LPTimer */
+    trace_log_init(app_timestamp_ticks);
+#endif /* (TRACE_LOG_ENABLE == 1U) */
+
     /* Initialize retarget-io middleware */
     init_retarget_io();
 
@@ -229,6 +349,21 @@ int main(void)
     printf("PSOC EDGE MCU: WLAN Lowpower\n");
     printf("===============================================================\n\n");
 
+#if (IPC_PIPELINE_ENABLE == 1U)
+    /* Initialize the buffers shared with the CM55 before it starts */
+    pipeline_uplink_init();
+#endif /* (IPC_PIPELINE_ENABLE == 1U) */
+
+#if (UPLINK_BATCH_ENABLE == 1U)
+    /* The application may queue records from the start */
+    uplink_init();
+#endif /* (UPLINK_BATCH_ENABLE == 1U) */
+
+#if (WLAN_PM_CONTROL_ENABLE == 1U)
+    /* The application may declare its latency budget from the start */
+    wlan_pm_init();
+#endif /* (WLAN_PM_CONTROL_ENABLE == 1U) */
+
    /* Enable CM55. CM55_APP_BOOT_ADDR must be updated if CM55 memory layout
     * is changed.
     */
@@ -238,15 +373,63 @@ int main(void)
     __enable_irq();
 
     /* SoCMEM Idle Power Mode Configuration */
+#if (IPC_PIPELINE_ENABLE == 1U)
+    /* Retain the buffers shared with the CM55 in deep sleep */
+    Cy_SysPm_SetSOCMEMDeepSleepMode(CY_SYSPM_MODE_DEEPSLEEP);
+#else
     Cy_SysPm_SetSOCMEMDeepSleepMode(CY_SYSPM_MODE_DEEPSLEEP_OFF);
+#endif /* (IPC_PIPELINE_ENABLE == 1U) */
 
    /* Create a task that initializes the Wi-Fi device, configures it
     * in the specified WLAN power save mode and suspends the network stack
     * indefinitely until there is network activity detected by the WLAN device.
     */
-    result = xTaskCreate(lowpower_task, "Low power task",
-              LOW_POWER_TASK_STACK_SIZE_BYTES, NULL, LOW_POWER_TASK_PRIORITY,
-              &lowpower_task_handle);
+    result = create_task(lowpower_task, "Low power task",
+              LOW_POWER_TASK_STACK_SIZE_BYTES, LOW_POWER_TASK_PRIORITY,
+              &lowpower_task_handle, LOW_POWER_TASK_STORAGE);
+
+#if (NET_BENCH_ENABLE == 1U)
+    /* Create the network benchmark task. It waits for the low power task to
+     * connect to the AP.
+     */
+    if (pdPASS == result)
+    {
+        result = create_task(net_bench_task, "Network benchmark task",
+                NET_BENCH_TASK_STACK_SIZE_BYTES, NET_BENCH_TASK_PRIORITY,
+                NULL, NET_BENCH_TASK_STORAGE);
+    }
+#endif /* (NET_BENCH_ENABLE == 1U) */
+
+#if (IPC_PIPELINE_ENABLE == 1U)
+    /* Create the task sending the data processed by the CM55 */
+    if (pdPASS == result)
+    {
+        result = create_task(pipeline_uplink_task, "Pipeline uplink task",
+                PIPELINE_UPLINK_TASK_STACK_SIZE_BYTES,
+                PIPELINE_UPLINK_TASK_PRIORITY, NULL,
+                PIPELINE_UPLINK_TASK_STORAGE);
+    }
+#endif /* (IPC_PIPELINE_ENABLE == 1U) */
+
+#if (UPLINK_BATCH_ENABLE == 1U)
+    /* Create the task sending the records queued by the application */
+    if (pdPASS == result)
+    {
+        result = create_task(uplink_task, "Uplink task",
+                UPLINK_TASK_STACK_SIZE_BYTES, UPLINK_TASK_PRIORITY, NULL,
+                UPLINK_TASK_STORAGE);
+    }
+#endif /* (UPLINK_BATCH_ENABLE == 1U) */
+
+#if (WLAN_PM_CONTROL_ENABLE == 1U)
+    /* Create the task applying the WLAN power-save setting */
+    if (pdPASS == result)
+    {
+        result = create_task(wlan_pm_task, "WLAN PM task",
+                WLAN_PM_TASK_STACK_SIZE_BYTES, WLAN_PM_TASK_PRIORITY, NULL,
+                WLAN_PM_TASK_STORAGE);
+    }
+#endif /* (WLAN_PM_CONTROL_ENABLE == 1U) */
 
     /* Start the FreeRTOS scheduler */
     if( pdPASS == result )
@@ -0,0 +1,386 @@
+/*******************************************************************************
+* File Name:   mem_report.c
+*
+* Description: This file records where the application and the middleware
+* allocate heap memory, and reports the heap usage, the allocation sites with
+* the largest totals and the stack high-water mark of every task. The numbers
+* size the heap and the task stacks so that unused SRAM can be powered down in
+* deep sleep.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "mem_report.h"
+
+#include "lowpower_task.h"
+
+/* The heap accounting relies on the GCC_ARM toolchain: newlib mallinfo(),
+ * __builtin_return_address(), the heap symbols of its linker script, and the
+ * linker wraps enabled with MEM_REPORT_ENABLE in the Makefile.
+ */
+#if (MEM_REPORT_ENABLE == 1U)
+
+#include <malloc.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Allocations made from one call site */
+typedef struct
+{
+    const void *caller;
+    uint32_t count;
+    uint32_t total_bytes;
+    uint32_t largest_bytes;
+} mem_report_site_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+/* The linker redirects the calls to these functions to their __wrap_
+ * versions, see LDFLAGS in the Makefile.
+ */
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void *__real_pvPortMalloc(size_t size);
+void *__wrap_malloc(size_t size);
+void *__wrap_calloc(size_t count, size_t size);
+void *__wrap_realloc(void *ptr, size_t size);
+void *__wrap_pvPortMalloc(size_t size);
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Bounds of the C heap, defined by the linker script. With heap_3.c, the
+ * FreeRTOS heap is the C heap and configTOTAL_HEAP_SIZE is not used.
+ */
+extern uint8_t __HeapBase[];
+extern uint8_t __HeapLimit[];
+
+static mem_report_site_t sites[MEM_REPORT_SITE_COUNT];
+static uint32_t untracked_count;
+static bool recording;
+
+/* Non-zero while pvPortMalloc() runs, so that its call to malloc() is not
+ * recorded a second time. The scheduler is suspended meanwhile.
+ */
+static uint32_t port_malloc_depth;
+
+static TaskStatus_t task_status[MEM_REPORT_MAX_TASKS];
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: record_allocation
+********************************************************************************
+* Summary:
+*  Charges an allocation to its call site.
+*
+* Parameters:
+*  const void *caller: Return address of the allocation call.
+*  size_t size: Size of the allocation, in bytes.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void record_allocation(const void *caller, size_t size)
+{
+    mem_report_site_t *site = NULL;
+
+    taskENTER_CRITICAL();
+
+    for (uint32_t i = 0U; i < MEM_REPORT_SITE_COUNT; i++)
+    {
+        if ((sites[i].caller == caller) || (NULL == sites[i].caller))
+        {
+            site = &sites[i];
+            break;
+        }
+    }
+
+    if (NULL == site)
+    {
+        untracked_count++;
+    }
+    else
+    {
+        site->caller = caller;
+        site->count++;
+        site->total_bytes += (uint32_t)size;
+        if (size > site->largest_bytes)
+        {
+            site->largest_bytes = (uint32_t)size;
+        }
+    }
+
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: __wrap_malloc
+********************************************************************************
+* Summary:
+*  Records the caller of malloc() and allocates the memory.
+*
+*******************************************************************************/
+void *__wrap_malloc(size_t size)
+{
+    void *ptr = __real_malloc(size);
+
+    if (recording && (NULL != ptr) && (0U == port_malloc_depth))
+    {
+        record_allocation(__builtin_return_address(0), size);
+    }
+
+    return ptr;
+}
+
+/*******************************************************************************
+* Function Name: __wrap_calloc
+********************************************************************************
+* Summary:
+*  Records the caller of calloc() and allocates the memory.
+*
+*******************************************************************************/
+void *__wrap_calloc(size_t count, size_t size)
+{
+    void *ptr = __real_calloc(count, size);
+
+    if (recording && (NULL != ptr))
+    {
+        record_allocation(__builtin_return_address(0), count * size);
+    }
+
+    return ptr;
+}
+
+/*******************************************************************************
+* Function Name: __wrap_realloc
+********************************************************************************
+* Summary:
+*  Records the caller of realloc() and reallocates the memory.
+*
+*******************************************************************************/
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    void *result = __real_realloc(ptr, size);
+
+    if (recording && (NULL != result))
+    {
+        record_allocation(__builtin_return_address(0), size);
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: __wrap_pvPortMalloc
+********************************************************************************
+* Summary:
+*  Records the caller of pvPortMalloc(), which creates the RTOS objects, and
+*  allocates the memory.
+*
+*******************************************************************************/
+void *__wrap_pvPortMalloc(size_t size)
+{
+    void *ptr;
+
+    vTaskSuspendAll();
+    port_malloc_depth++;
+    ptr = __real_pvPortMalloc(size);
+    port_malloc_depth--;
+    (void)xTaskResumeAll();
+
+    if (recording && (NULL != ptr))
+    {
+        record_allocation(__builtin_return_address(0), size);
+    }
+
+    return ptr;
+}
+
+/*******************************************************************************
+* Function Name: mem_report_init
+********************************************************************************
+* Summary:
+*  Starts recording the allocation sites. Call it first in main() so that the
+*  allocations made before the scheduler starts are recorded.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void mem_report_init(void)
+{
+    recording = true;
+}
+
+/*******************************************************************************
+* Function Name: report_heap
+********************************************************************************
+* Summary:
+*  Prints the size of the heap, the memory in use and the lowest free memory
+*  since boot. The newlib allocator does not return memory to the heap region
+*  once it has been claimed, so the memory claimed is the high-water mark.
+*
+*******************************************************************************/
+static void report_heap(void)
+{
+    struct mallinfo info = mallinfo();
+    uint32_t heap_size = (uint32_t)(__HeapLimit - __HeapBase);
+
+    APP_INFO(("  Heap: %lu bytes, %lu in use, %lu claimed, %lu minimum ever "
+            "free\n",
+            (unsigned long)heap_size,
+            (unsigned long)info.uordblks,
+            (unsigned long)info.arena,
+            (unsigned long)(heap_size - (uint32_t)info.arena)));
+}
+
+/*******************************************************************************
+* Function Name: report_sites
+********************************************************************************
+* Summary:
+*  Prints the allocation sites with the largest totals. Resolve the addresses
+*  with arm-none-eabi-addr2line and the ELF file of this project.
+*
+*******************************************************************************/
+static void report_sites(void)
+{
+    mem_report_site_t snapshot[MEM_REPORT_SITE_COUNT];
+    uint32_t untracked;
+
+    taskENTER_CRITICAL();
+    for (uint32_t i = 0U; i < MEM_REPORT_SITE_COUNT; i++)
+    {
+        snapshot[i] = sites[i];
+    }
+    untracked = untracked_count;
+    taskEXIT_CRITICAL();
+
+    for (uint32_t rank = 0U; rank < MEM_REPORT_TOP_SITES; rank++)
+    {
+        mem_report_site_t *top = NULL;
+
+        for (uint32_t i = 0U; i < MEM_REPORT_SITE_COUNT; i++)
+        {
+            if ((NULL != snapshot[i].caller) && ((NULL == top) ||
+                    (snapshot[i].total_bytes > top->total_bytes)))
+            {
+                top = &snapshot[i];
+            }
+        }
+
+        if (NULL == top)
+        {
+            break;
+        }
+
+        APP_INFO(("  Site 0x%08lx: %lu allocations, %lu bytes, largest %lu\n",
+                (unsigned long)(uintptr_t)top->caller,
+                (unsigned long)top->count,
+                (unsigned long)top->total_bytes,
+                (unsigned long)top->largest_bytes));
+
+        top->caller = NULL;
+    }
+
+    if (0U != untracked)
+    {
+        APP_INFO(("  Untracked allocations: %lu\n", (unsigned long)untracked));
+    }
+}
+
+/*******************************************************************************
+* Function Name: report_stacks
+********************************************************************************
+* Summary:
+*  Prints the lowest free stack space of every task since it was created.
+*
+*******************************************************************************/
+static void report_stacks(void)
+{
+    UBaseType_t count = uxTaskGetSystemState(task_status,
+            MEM_REPORT_MAX_TASKS, NULL);
+
+    if (0U == count)
+    {
+        APP_INFO(("  More than %lu tasks, stacks not reported\n",
+                (unsigned long)MEM_REPORT_MAX_TASKS));
+    }
+
+    for (UBaseType_t i = 0U; i < count; i++)
+    {
+        APP_INFO_TEXT(("  Stack %-16s: %lu bytes minimum free\n",
+                task_status[i].pcTaskName,
+                (unsigned long)(task_status[i].usStackHighWaterMark *
+                sizeof(StackType_t))));
+    }
+}
+
+/*******************************************************************************
+* Function Name: mem_report_print
+********************************************************************************
+* Summary:
+*  Prints the heap usage, the allocation sites with the largest totals and the
+*  stack high-water mark of every task.
+*
+* Parameters:
+*  const char *label: Point of the application the report is made at.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void mem_report_print(const char *label)
+{
+    APP_INFO(("Memory report (%s):\n", label));
+
+    report_heap();
+    report_sites();
+    report_stacks();
+}
+
+#endif /* (MEM_REPORT_ENABLE == 1U) */
+
+/* [] END OF FILE */
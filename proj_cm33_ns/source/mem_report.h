@@ -0,0 +1,83 @@
+/******************************************************************************
+* File Name: mem_report.h
+*
+* Description: This file is the public interface of mem_report.c, which records
+* the heap allocation sites and reports the heap usage and the stack high-water
+* mark of every task.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef MEM_REPORT_H_
+#define MEM_REPORT_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+/* Number of distinct allocation sites recorded. Allocations from further
+ * sites are only counted as untracked.
+ */
+#define MEM_REPORT_SITE_COUNT           (24U)
+
+/* Number of allocation sites printed, largest total first */
+#define MEM_REPORT_TOP_SITES            (8U)
+
+/* Largest number of tasks whose stack is reported */
+#define MEM_REPORT_MAX_TASKS            (16U)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void mem_report_init(void);
+void mem_report_print(const char *label);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* MEM_REPORT_H_ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,536 @@
+/*******************************************************************************
+* File Name:   net_bench.c
+*
+* Description: This file contains the network benchmark task. It runs TCP and
+* UDP send and receive tests against the host peer in tools/net_bench_peer.c,
+* and prints the throughput, the UDP loss and jitter, and the energy spent per
+* megabyte, estimated from the residency counters.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "net_bench.h"
+
+#include "lowpower_task.h"
+
+/* Wi-Fi connection manager header files */
+#include "cy_wcm.h"
+
+/* Low power assistant header files */
+#include "network_activity_handler.h"
+
+/* lwIP socket API */
+#include "lwip/sockets.h"
+
+#include "app_timestamp.h"
+#include "power_model.h"
+#include "power_stats.h"
+#include "net_bench_proto.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CONNECT_POLL_INTERVAL_MS        (1000U)
+#define MS_PER_SEC                      (1000U)
+#define US_PER_MS                       (1000U)
+#define BYTES_PER_MB                    (1048576ULL)
+
+/* Payload of a TCP segment on an Ethernet-sized MTU */
+#define TCP_CHUNK_SIZE                  (1460U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static uint8_t bench_buffer[NET_BENCH_DATAGRAM_MAX];
+static struct sockaddr_in peer_addr;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: elapsed_us
+********************************************************************************
+* Summary:
+*  Returns the time elapsed since start, in microseconds. The LPTimer has a
+*  resolution of about 30 us.
+*******************************************************************************/
+static uint32_t elapsed_us(uint32_t start)
+{
+    return app_timestamp_ticks_to_us(app_timestamp_ticks() - start);
+}
+
+/*******************************************************************************
+* Function Name: bench_socket
+********************************************************************************
+* Summary:
+*  Opens a socket with a receive timeout of NET_BENCH_TIMEOUT_MS.
+*******************************************************************************/
+static int bench_socket(int type)
+{
+    struct timeval timeout =
+    {
+        .tv_sec = NET_BENCH_TIMEOUT_MS / MS_PER_SEC,
+        .tv_usec = (NET_BENCH_TIMEOUT_MS % MS_PER_SEC) * US_PER_MS
+    };
+    int sock = lwip_socket(AF_INET, type, 0);
+
+    if (sock >= 0)
+    {
+        (void)lwip_setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout,
+                sizeof(timeout));
+    }
+
+    return sock;
+}
+
+/*******************************************************************************
+* Function Name: send_all
+********************************************************************************
+* Summary:
+*  Sends a whole buffer on a TCP socket.
+*******************************************************************************/
+static bool send_all(int sock, const uint8_t *data, size_t size)
+{
+    while (size > 0U)
+    {
+        ssize_t sent = lwip_send(sock, data, size, 0);
+
+        if (sent <= 0)
+        {
+            return false;
+        }
+
+        data += sent;
+        size -= (size_t)sent;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tcp_start
+********************************************************************************
+* Summary:
+*  Connects to the peer and sends the request of a TCP test.
+*******************************************************************************/
+static int tcp_start(net_bench_test_t test)
+{
+    uint8_t message[NET_BENCH_REQUEST_SIZE];
+    net_bench_request_t request =
+    {
+        .test = (uint8_t)test,
+        .datagram_size = 0U,
+        .length = NET_BENCH_TCP_BYTES,
+        .rate_kbps = 0U
+    };
+    int sock = bench_socket(SOCK_STREAM);
+
+    if (sock < 0)
+    {
+        return -1;
+    }
+
+    net_bench_encode_request(&request, message);
+
+    if ((0 != lwip_connect(sock, (struct sockaddr *)&peer_addr,
+            sizeof(peer_addr))) || !send_all(sock, message, sizeof(message)))
+    {
+        (void)lwip_close(sock);
+        return -1;
+    }
+
+    return sock;
+}
+
+/*******************************************************************************
+* Function Name: bench_tcp_up
+********************************************************************************
+* Summary:
+*  Sends NET_BENCH_TCP_BYTES to the peer. The transfer ends when the peer
+*  reports that it has received all the bytes.
+*******************************************************************************/
+static bool bench_tcp_up(net_bench_report_t *report)
+{
+    uint8_t message[NET_BENCH_REPORT_SIZE];
+    uint32_t remaining = NET_BENCH_TCP_BYTES;
+    uint32_t received = 0U;
+    uint32_t start;
+    bool success;
+    int sock = tcp_start(NET_BENCH_TEST_TCP_UP);
+
+    if (sock < 0)
+    {
+        return false;
+    }
+
+    memset(bench_buffer, 0x55, sizeof(bench_buffer));
+    start = app_timestamp_ticks();
+
+    while (remaining > 0U)
+    {
+        uint32_t chunk = (remaining < TCP_CHUNK_SIZE) ? remaining :
+                TCP_CHUNK_SIZE;
+
+        if (!send_all(sock, bench_buffer, chunk))
+        {
+            break;
+        }
+
+        remaining -= chunk;
+    }
+
+    while ((0U == remaining) && (received < sizeof(message)))
+    {
+        ssize_t size = lwip_recv(sock, &message[received],
+                sizeof(message) - received, 0);
+
+        if (size <= 0)
+        {
+            break;
+        }
+
+        received += (uint32_t)size;
+    }
+
+    success = net_bench_decode_report(message, received, report);
+    report->elapsed_us = elapsed_us(start);
+
+    (void)lwip_close(sock);
+
+    return success;
+}
+
+/*******************************************************************************
+* Function Name: bench_tcp_down
+********************************************************************************
+* Summary:
+*  Receives NET_BENCH_TCP_BYTES from the peer.
+*******************************************************************************/
+static bool bench_tcp_down(net_bench_report_t *report)
+{
+    uint32_t start = 0U;
+    int sock = tcp_start(NET_BENCH_TEST_TCP_DOWN);
+
+    if (sock < 0)
+    {
+        return false;
+    }
+
+    memset(report, 0, sizeof(net_bench_report_t));
+
+    while (report->bytes < NET_BENCH_TCP_BYTES)
+    {
+        ssize_t size = lwip_recv(sock, bench_buffer, sizeof(bench_buffer), 0);
+
+        if (size <= 0)
+        {
+            break;
+        }
+
+        if (0U == report->bytes)
+        {
+            start = app_timestamp_ticks();
+        }
+
+        report->bytes += (uint32_t)size;
+    }
+
+    report->elapsed_us = elapsed_us(start);
+
+    (void)lwip_close(sock);
+
+    return (NET_BENCH_TCP_BYTES == report->bytes);
+}
+
+/*******************************************************************************
+* Function Name: bench_udp_up
+********************************************************************************
+* Summary:
+*  Sends NET_BENCH_UDP_DATAGRAMS datagrams to the peer at
+*  NET_BENCH_UDP_RATE_KBPS, then header-only FIN datagrams until the peer
+*  answers with its receive report.
+*******************************************************************************/
+static bool bench_udp_up(net_bench_report_t *report)
+{
+    net_bench_datagram_t datagram = { 0U, 0U, 0U };
+    uint32_t interval_us = (uint32_t)(((uint64_t)NET_BENCH_UDP_DATAGRAM_SIZE *
+            8U * MS_PER_SEC) / NET_BENCH_UDP_RATE_KBPS);
+    uint32_t start;
+    uint32_t now_us;
+    uint32_t due_us;
+    ssize_t size;
+    bool success = false;
+    int sock = bench_socket(SOCK_DGRAM);
+
+    if (sock < 0)
+    {
+        return false;
+    }
+
+    memset(bench_buffer, 0x55, sizeof(bench_buffer));
+    start = app_timestamp_ticks();
+
+    for (datagram.seq = 0U; datagram.seq < NET_BENCH_UDP_DATAGRAMS;
+            datagram.seq++)
+    {
+        /* Sleep until the datagram is due when at least one tick ahead */
+        due_us = datagram.seq * interval_us;
+        now_us = elapsed_us(start);
+        if ((due_us > now_us) && ((due_us - now_us) >=
+                (portTICK_PERIOD_MS * US_PER_MS)))
+        {
+            vTaskDelay(pdMS_TO_TICKS((due_us - now_us) / US_PER_MS));
+        }
+
+        datagram.send_us = elapsed_us(start);
+        net_bench_encode_datagram(&datagram, bench_buffer);
+        (void)lwip_sendto(sock, bench_buffer, NET_BENCH_UDP_DATAGRAM_SIZE, 0,
+                (struct sockaddr *)&peer_addr, sizeof(peer_addr));
+    }
+
+    datagram.flags = NET_BENCH_DATAGRAM_FIN;
+
+    for (uint32_t i = 0U; (i < NET_BENCH_FIN_COUNT) && !success; i++)
+    {
+        datagram.send_us = elapsed_us(start);
+        net_bench_encode_datagram(&datagram, bench_buffer);
+        (void)lwip_sendto(sock, bench_buffer, NET_BENCH_DATAGRAM_HEADER_SIZE, 0,
+                (struct sockaddr *)&peer_addr, sizeof(peer_addr));
+
+        size = lwip_recv(sock, bench_buffer, sizeof(bench_buffer), 0);
+        success = (size > 0) &&
+                net_bench_decode_report(bench_buffer, (size_t)size, report);
+    }
+
+    (void)lwip_close(sock);
+
+    return success;
+}
+
+/*******************************************************************************
+* Function Name: bench_udp_down
+********************************************************************************
+* Summary:
+*  Asks the peer to send NET_BENCH_UDP_DATAGRAMS datagrams at
+*  NET_BENCH_UDP_RATE_KBPS and measures the loss, the reordering and the
+*  jitter. Datagrams missing at the end of the test are counted as lost.
+*******************************************************************************/
+static bool bench_udp_down(net_bench_report_t *report)
+{
+    uint8_t message[NET_BENCH_REQUEST_SIZE];
+    net_bench_request_t request =
+    {
+        .test = (uint8_t)NET_BENCH_TEST_UDP_DOWN,
+        .datagram_size = NET_BENCH_UDP_DATAGRAM_SIZE,
+        .length = NET_BENCH_UDP_DATAGRAMS,
+        .rate_kbps = NET_BENCH_UDP_RATE_KBPS
+    };
+    net_bench_rx_stats_t stats;
+    net_bench_datagram_t datagram;
+    uint32_t start = app_timestamp_ticks();
+    int sock = bench_socket(SOCK_DGRAM);
+
+    if (sock < 0)
+    {
+        return false;
+    }
+
+    net_bench_rx_init(&stats);
+    net_bench_encode_request(&request, message);
+    (void)lwip_sendto(sock, message, sizeof(message), 0,
+            (struct sockaddr *)&peer_addr, sizeof(peer_addr));
+
+    while (true)
+    {
+        ssize_t size = lwip_recv(sock, bench_buffer, sizeof(bench_buffer), 0);
+
+        if ((size <= 0) ||
+            !net_bench_decode_datagram(bench_buffer, (size_t)size, &datagram))
+        {
+            break;
+        }
+
+        if (0U != (datagram.flags & NET_BENCH_DATAGRAM_FIN))
+        {
+            break;
+        }
+
+        net_bench_rx_update(&stats, &datagram, (size_t)size, elapsed_us(start));
+    }
+
+    (void)lwip_close(sock);
+
+    net_bench_rx_report(&stats, report);
+
+    if (report->received < NET_BENCH_UDP_DATAGRAMS)
+    {
+        report->lost = NET_BENCH_UDP_DATAGRAMS - report->received;
+    }
+
+    return (stats.received > 0U);
+}
+
+/*******************************************************************************
+* Function Name: bench_run
+********************************************************************************
+* Summary:
+*  Runs one test and prints its throughput and the energy spent per
+*  megabyte. The energy is the time spent by the MCU in each power state
+*  during the test, charged against the default power table, plus the WLAN
+*  device charged NET_BENCH_WLAN_ACTIVE_UW for the whole test.
+*******************************************************************************/
+static void bench_run(const char *name, bool (*test)(net_bench_report_t *),
+        bool udp)
+{
+    residency_snapshot_t before;
+    residency_snapshot_t after;
+    power_model_residency_t residency;
+    power_model_estimate_t estimate;
+    power_model_table_t table = power_model_default_table;
+    net_bench_report_t report;
+    uint64_t mcu_uj;
+    uint64_t wlan_uj;
+
+    /* Resume the network stack now rather than on the first packet */
+    cy_network_activity_notify(CY_NETWORK_ACTIVITY_TX);
+
+    power_stats_get(&before);
+
+    if (!test(&report))
+    {
+        ERR_INFO(("Benchmark %s failed.\n", name));
+        return;
+    }
+
+    power_stats_get(&after);
+
+    power_model_residency_reset(&residency);
+    for (uint32_t state = 0U; state < (uint32_t)POWER_MODEL_STATE_COUNT;
+            state++)
+    {
+        power_model_charge(&residency, (power_model_state_t)state,
+                (uint32_t)(after.residency_ms[state] -
+                before.residency_ms[state]));
+    }
+
+    table.wlan_avg_uw = NET_BENCH_WLAN_ACTIVE_UW;
+    power_model_estimate(&table, &residency, &estimate);
+
+    /* uW x ms = nJ */
+    mcu_uj = ((uint64_t)estimate.mcu_avg_uw * estimate.elapsed_ms) / 1000U;
+    wlan_uj = ((uint64_t)estimate.wlan_avg_uw * estimate.elapsed_ms) / 1000U;
+
+    APP_INFO(("Benchmark %s: %lu bytes in %lu ms, %lu kbps\n", name,
+            (unsigned long)report.bytes,
+            (unsigned long)(report.elapsed_us / US_PER_MS),
+            (unsigned long)net_bench_kbps(report.bytes, report.elapsed_us)));
+
+    if (udp)
+    {
+        APP_INFO(("  %lu datagrams received, %lu lost, %lu out of order, "
+                "jitter %lu us\n", (unsigned long)report.received,
+                (unsigned long)report.lost,
+                (unsigned long)report.out_of_order,
+                (unsigned long)report.jitter_us));
+    }
+
+    if (0U != report.bytes)
+    {
+        APP_INFO(("  Energy: MCU %lu uJ/MB, WLAN %lu uJ/MB\n",
+                (unsigned long)((mcu_uj * BYTES_PER_MB) / report.bytes),
+                (unsigned long)((wlan_uj * BYTES_PER_MB) / report.bytes)));
+    }
+}
+
+/*******************************************************************************
+* Function Name: net_bench_task
+********************************************************************************
+* Summary:
+*  Waits for the low power task to connect to the AP, then runs the TCP and
+*  UDP tests against the peer at NET_BENCH_PEER_IP. The tests are repeated
+*  every NET_BENCH_REPEAT_INTERVAL_MS, or run once if it is 0. Between two
+*  runs, the task is blocked and the network stack can be suspended.
+*
+* Parameters:
+*  void *arg: Not used.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void net_bench_task(void *arg)
+{
+    (void)arg;
+
+    memset(&peer_addr, 0, sizeof(peer_addr));
+    peer_addr.sin_family = AF_INET;
+    peer_addr.sin_port = lwip_htons(NET_BENCH_PEER_PORT);
+
+    if (1 != lwip_inet_pton(AF_INET, NET_BENCH_PEER_IP, &peer_addr.sin_addr))
+    {
+        ERR_INFO(("Invalid benchmark peer address %s.\n", NET_BENCH_PEER_IP));
+        vTaskDelete(NULL);
+    }
+
+    while (true)
+    {
+        while (!cy_wcm_is_connected_to_ap())
+        {
+            vTaskDelay(pdMS_TO_TICKS(CONNECT_POLL_INTERVAL_MS));
+        }
+
+        APP_INFO(("Running the network benchmark against %s:%u\n",
+                NET_BENCH_PEER_IP, (unsigned int)NET_BENCH_PEER_PORT));
+
+        bench_run("TCP up", bench_tcp_up, false);
+        bench_run("TCP down", bench_tcp_down, false);
+        bench_run("UDP up", bench_udp_up, true);
+        bench_run("UDP down", bench_udp_down, true);
+
+        if (0U == NET_BENCH_REPEAT_INTERVAL_MS)
+        {
+            break;
+        }
+
+        vTaskDelay(pdMS_TO_TICKS(NET_BENCH_REPEAT_INTERVAL_MS));
+    }
+
+    vTaskDelete(NULL);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,95 @@
+/******************************************************************************
+* File Name: net_bench.h
+*
+* Description: This file is the public interface of net_bench.c. It contains the
+* task that measures the TCP and UDP throughput against a host peer and the
+* energy spent per megabyte.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef NET_BENCH_H_
+#define NET_BENCH_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+#include <FreeRTOS.h>
+#include <task.h>
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+#define NET_BENCH_TASK_STACK_SIZE_BYTES (1024U)
+#define NET_BENCH_TASK_PRIORITY         (2U)
+
+/* Size of the TCP transfers, in bytes */
+#define NET_BENCH_TCP_BYTES             (1048576UL)
+
+/* Number and size of the UDP datagrams, and rate at which they are sent */
+#define NET_BENCH_UDP_DATAGRAMS         (1000U)
+#define NET_BENCH_UDP_DATAGRAM_SIZE     (1024U)
+#define NET_BENCH_UDP_RATE_KBPS         (8000U)
+
+/* Time to wait for the peer report or for the next datagram */
+#define NET_BENCH_TIMEOUT_MS            (2000U)
+
+/* Number of times the last datagram of a UDP test is sent */
+#define NET_BENCH_FIN_COUNT             (3U)
+
+/* Power drawn by the CYW55513 while transferring, in microwatts, charged in
+ * place of the power-save average of the power model during a test. Not
+ * characterized in README.md. Replace with the value measured on your board.
+ */
+#define NET_BENCH_WLAN_ACTIVE_UW        (0U)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void net_bench_task(void *arg);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* NET_BENCH_H_ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,399 @@
+/*******************************************************************************
+* File Name:   net_bench_proto.c
+*
+* Description: This file contains the wire format of the network benchmark
+* messages, which are encoded in little-endian byte order, and the loss,
+* reordering and jitter statistics of the UDP receive tests. The jitter is the
+* interarrival jitter estimator of RFC 3550.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "net_bench_proto.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Gain of the RFC 3550 jitter estimator: J += (|D| - J) / 16 */
+#define JITTER_GAIN_SHIFT               (4U)
+
+#define BITS_PER_BYTE                   (8U)
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: put_u32
+********************************************************************************
+* Summary:
+*  Writes a 32-bit value in little-endian byte order.
+*******************************************************************************/
+static void put_u32(uint8_t *buffer, uint32_t value)
+{
+    buffer[0] = (uint8_t)value;
+    buffer[1] = (uint8_t)(value >> 8U);
+    buffer[2] = (uint8_t)(value >> 16U);
+    buffer[3] = (uint8_t)(value >> 24U);
+}
+
+/*******************************************************************************
+* Function Name: get_u32
+********************************************************************************
+* Summary:
+*  Reads a 32-bit value in little-endian byte order.
+*******************************************************************************/
+static uint32_t get_u32(const uint8_t *buffer)
+{
+    return (uint32_t)buffer[0] | ((uint32_t)buffer[1] << 8U) |
+            ((uint32_t)buffer[2] << 16U) | ((uint32_t)buffer[3] << 24U);
+}
+
+/*******************************************************************************
+* Function Name: net_bench_encode_request
+********************************************************************************
+* Summary:
+*  Encodes a test request.
+*
+* Parameters:
+*  const net_bench_request_t *request: Request to encode.
+*  uint8_t buffer[]: Filled with the NET_BENCH_REQUEST_SIZE byte message.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void net_bench_encode_request(const net_bench_request_t *request,
+        uint8_t buffer[NET_BENCH_REQUEST_SIZE])
+{
+    put_u32(&buffer[0], NET_BENCH_REQUEST_MAGIC);
+    buffer[4] = request->test;
+    buffer[5] = 0U;
+    buffer[6] = (uint8_t)request->datagram_size;
+    buffer[7] = (uint8_t)(request->datagram_size >> 8U);
+    put_u32(&buffer[8], request->length);
+    put_u32(&buffer[12], request->rate_kbps);
+}
+
+/*******************************************************************************
+* Function Name: net_bench_decode_request
+********************************************************************************
+* Summary:
+*  Decodes a test request.
+*
+* Parameters:
+*  const uint8_t *buffer: Received message.
+*  size_t size: Size of the received message.
+*  net_bench_request_t *request: Filled with the decoded request.
+*
+* Return:
+*  bool: false if the message is not a valid request.
+*
+*******************************************************************************/
+bool net_bench_decode_request(const uint8_t *buffer, size_t size,
+        net_bench_request_t *request)
+{
+    if ((size < NET_BENCH_REQUEST_SIZE) ||
+        (NET_BENCH_REQUEST_MAGIC != get_u32(&buffer[0])) ||
+        (buffer[4] < (uint8_t)NET_BENCH_TEST_TCP_UP) ||
+        (buffer[4] > (uint8_t)NET_BENCH_TEST_UDP_DOWN))
+    {
+        return false;
+    }
+
+    request->test = buffer[4];
+    request->datagram_size = (uint16_t)(buffer[6] |
+            ((uint16_t)buffer[7] << 8U));
+    request->length = get_u32(&buffer[8]);
+    request->rate_kbps = get_u32(&buffer[12]);
+
+    if ((request->datagram_size < NET_BENCH_DATAGRAM_MIN) ||
+        (request->datagram_size > NET_BENCH_DATAGRAM_MAX))
+    {
+        request->datagram_size = NET_BENCH_DATAGRAM_MAX;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: net_bench_encode_datagram
+********************************************************************************
+* Summary:
+*  Encodes the header of a UDP test datagram.
+*
+* Parameters:
+*  const net_bench_datagram_t *datagram: Header to encode.
+*  uint8_t buffer[]: Filled with the NET_BENCH_DATAGRAM_HEADER_SIZE byte
+*  header.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void net_bench_encode_datagram(const net_bench_datagram_t *datagram,
+        uint8_t buffer[NET_BENCH_DATAGRAM_HEADER_SIZE])
+{
+    put_u32(&buffer[0], NET_BENCH_DATAGRAM_MAGIC);
+    put_u32(&buffer[4], datagram->seq);
+    put_u32(&buffer[8], datagram->send_us);
+    put_u32(&buffer[12], datagram->flags);
+}
+
+/*******************************************************************************
+* Function Name: net_bench_decode_datagram
+********************************************************************************
+* Summary:
+*  Decodes the header of a UDP test datagram.
+*
+* Parameters:
+*  const uint8_t *buffer: Received datagram.
+*  size_t size: Size of the received datagram.
+*  net_bench_datagram_t *datagram: Filled with the decoded header.
+*
+* Return:
+*  bool: false if the datagram is not a test datagram.
+*
+*******************************************************************************/
+bool net_bench_decode_datagram(const uint8_t *buffer, size_t size,
+        net_bench_datagram_t *datagram)
+{
+    if ((size < NET_BENCH_DATAGRAM_HEADER_SIZE) ||
+        (NET_BENCH_DATAGRAM_MAGIC != get_u32(&buffer[0])))
+    {
+        return false;
+    }
+
+    datagram->seq = get_u32(&buffer[4]);
+    datagram->send_us = get_u32(&buffer[8]);
+    datagram->flags = get_u32(&buffer[12]);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: net_bench_encode_report
+********************************************************************************
+* Summary:
+*  Encodes a test report.
+*
+* Parameters:
+*  const net_bench_report_t *report: Report to encode.
+*  uint8_t buffer[]: Filled with the NET_BENCH_REPORT_SIZE byte message.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void net_bench_encode_report(const net_bench_report_t *report,
+        uint8_t buffer[NET_BENCH_REPORT_SIZE])
+{
+    put_u32(&buffer[0], NET_BENCH_REPORT_MAGIC);
+    put_u32(&buffer[4], report->received);
+    put_u32(&buffer[8], report->lost);
+    put_u32(&buffer[12], report->out_of_order);
+    put_u32(&buffer[16], report->jitter_us);
+    put_u32(&buffer[20], report->bytes);
+    put_u32(&buffer[24], report->elapsed_us);
+}
+
+/*******************************************************************************
+* Function Name: net_bench_decode_report
+********************************************************************************
+* Summary:
+*  Decodes a test report.
+*
+* Parameters:
+*  const uint8_t *buffer: Received message.
+*  size_t size: Size of the received message.
+*  net_bench_report_t *report: Filled with the decoded report.
+*
+* Return:
+*  bool: false if the message is not a report.
+*
+*******************************************************************************/
+bool net_bench_decode_report(const uint8_t *buffer, size_t size,
+        net_bench_report_t *report)
+{
+    if ((size < NET_BENCH_REPORT_SIZE) ||
+        (NET_BENCH_REPORT_MAGIC != get_u32(&buffer[0])))
+    {
+        return false;
+    }
+
+    report->received = get_u32(&buffer[4]);
+    report->lost = get_u32(&buffer[8]);
+    report->out_of_order = get_u32(&buffer[12]);
+    report->jitter_us = get_u32(&buffer[16]);
+    report->bytes = get_u32(&buffer[20]);
+    report->elapsed_us = get_u32(&buffer[24]);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: net_bench_rx_init
+********************************************************************************
+* Summary:
+*  Clears the receive statistics before a UDP test.
+*
+* Parameters:
+*  net_bench_rx_stats_t *stats: Statistics to clear.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void net_bench_rx_init(net_bench_rx_stats_t *stats)
+{
+    memset(stats, 0, sizeof(net_bench_rx_stats_t));
+}
+
+/*******************************************************************************
+* Function Name: net_bench_rx_update
+********************************************************************************
+* Summary:
+*  Accounts a received test datagram. A gap in the sequence numbers is counted
+*  as lost and a datagram arriving after a later one as out of order; it is
+*  then no longer counted as lost. The jitter is the smoothed absolute
+*  difference between the transit times of consecutive datagrams, so the
+*  sender and receiver clocks need not be synchronized.
+*
+* Parameters:
+*  net_bench_rx_stats_t *stats: Statistics to update.
+*  const net_bench_datagram_t *datagram: Header of the received datagram.
+*  size_t size: Size of the received datagram, in bytes.
+*  uint32_t recv_us: Receiver clock when the datagram was received.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void net_bench_rx_update(net_bench_rx_stats_t *stats,
+        const net_bench_datagram_t *datagram, size_t size, uint32_t recv_us)
+{
+    int32_t transit_us = (int32_t)(recv_us - datagram->send_us);
+    int32_t delta_us;
+
+    if (0U == stats->received)
+    {
+        stats->first_us = recv_us;
+    }
+    else
+    {
+        delta_us = transit_us - stats->last_transit_us;
+        if (delta_us < 0)
+        {
+            delta_us = -delta_us;
+        }
+
+        stats->jitter_q4 += (uint32_t)delta_us -
+                ((stats->jitter_q4 + (1U << (JITTER_GAIN_SHIFT - 1U))) >>
+                JITTER_GAIN_SHIFT);
+    }
+
+    if (datagram->seq >= stats->next_seq)
+    {
+        stats->lost += datagram->seq - stats->next_seq;
+        stats->next_seq = datagram->seq + 1U;
+    }
+    else
+    {
+        stats->out_of_order++;
+        if (stats->lost > 0U)
+        {
+            stats->lost--;
+        }
+    }
+
+    stats->last_transit_us = transit_us;
+    stats->last_us = recv_us;
+    stats->received++;
+    stats->bytes += (uint32_t)size;
+}
+
+/*******************************************************************************
+* Function Name: net_bench_rx_report
+********************************************************************************
+* Summary:
+*  Converts the receive statistics into a report.
+*
+* Parameters:
+*  const net_bench_rx_stats_t *stats: Statistics of the test.
+*  net_bench_report_t *report: Filled with the report.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void net_bench_rx_report(const net_bench_rx_stats_t *stats,
+        net_bench_report_t *report)
+{
+    report->received = stats->received;
+    report->lost = stats->lost;
+    report->out_of_order = stats->out_of_order;
+    report->jitter_us = stats->jitter_q4 >> JITTER_GAIN_SHIFT;
+    report->bytes = stats->bytes;
+    report->elapsed_us = stats->last_us - stats->first_us;
+}
+
+/*******************************************************************************
+* Function Name: net_bench_kbps
+********************************************************************************
+* Summary:
+*  Computes a throughput.
+*
+* Parameters:
+*  uint32_t bytes: Bytes transferred.
+*  uint32_t elapsed_us: Duration of the transfer, in microseconds.
+*
+* Return:
+*  uint32_t: Throughput in kilobits per second, 0 if elapsed_us is 0.
+*
+*******************************************************************************/
+uint32_t net_bench_kbps(uint32_t bytes, uint32_t elapsed_us)
+{
+    if (0U == elapsed_us)
+    {
+        return 0U;
+    }
+
+    /* bits / us = Mbps, so bits x 1000 / us = kbps */
+    return (uint32_t)(((uint64_t)bytes * BITS_PER_BYTE * 1000U) / elapsed_us);
+}
+
+
+/* [] END OF FILE */
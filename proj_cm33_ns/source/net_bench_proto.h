@@ -0,0 +1,174 @@
+/******************************************************************************
+* File Name: net_bench_proto.h
+*
+* Description: This file is the public interface of net_bench_proto.c. It
+* contains the wire format shared by the network benchmark task and its host
+* peer (tools/net_bench_peer.c), and the receive statistics of the UDP tests.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef NET_BENCH_PROTO_H_
+#define NET_BENCH_PROTO_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+/* This module has no device dependencies so that it can also be built for the
+ * host machine. tools/net_bench_peer.c is built with it.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+#define NET_BENCH_DEFAULT_PORT          (5201U)
+
+/* Magic numbers of the messages */
+#define NET_BENCH_REQUEST_MAGIC         (0x4E425251UL)  /* "NBRQ" */
+#define NET_BENCH_DATAGRAM_MAGIC        (0x4E424447UL)  /* "NBDG" */
+#define NET_BENCH_REPORT_MAGIC          (0x4E425250UL)  /* "NBRP" */
+
+/* Sizes of the messages on the wire, in bytes */
+#define NET_BENCH_REQUEST_SIZE          (16U)
+#define NET_BENCH_DATAGRAM_HEADER_SIZE  (16U)
+#define NET_BENCH_REPORT_SIZE           (28U)
+
+/* Datagram flag set on the last datagrams of a UDP test */
+#define NET_BENCH_DATAGRAM_FIN          (0x01U)
+
+/* Smallest and largest UDP datagram, in bytes */
+#define NET_BENCH_DATAGRAM_MIN          (NET_BENCH_DATAGRAM_HEADER_SIZE)
+#define NET_BENCH_DATAGRAM_MAX          (1472U)
+
+/*******************************************************************************
+* Enumerations
+*******************************************************************************/
+/* Tests, seen from the device: "up" sends to the peer, "down" receives */
+typedef enum
+{
+    NET_BENCH_TEST_TCP_UP = 1,
+    NET_BENCH_TEST_TCP_DOWN,
+    NET_BENCH_TEST_UDP_UP,
+    NET_BENCH_TEST_UDP_DOWN
+} net_bench_test_t;
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Sent by the device to start a test. For TCP, it is the first 16 bytes of
+ * the connection. For UDP_DOWN, it is a datagram. UDP_UP has no request: the
+ * peer starts a test on a datagram with sequence number 0.
+ */
+typedef struct
+{
+    uint8_t test;               /* net_bench_test_t */
+    uint16_t datagram_size;     /* UDP only */
+    uint32_t length;            /* Bytes for TCP, datagrams for UDP */
+    uint32_t rate_kbps;         /* UDP_DOWN pacing, 0 for no pacing */
+} net_bench_request_t;
+
+/* Header of every UDP test datagram */
+typedef struct
+{
+    uint32_t seq;
+    uint32_t send_us;           /* Sender clock, in microseconds */
+    uint32_t flags;
+} net_bench_datagram_t;
+
+/* Receive side result, sent by the peer at the end of TCP_UP and UDP_UP */
+typedef struct
+{
+    uint32_t received;          /* Datagrams (UDP) */
+    uint32_t lost;
+    uint32_t out_of_order;
+    uint32_t jitter_us;
+    uint32_t bytes;
+    uint32_t elapsed_us;        /* First to last byte received */
+} net_bench_report_t;
+
+/* Receive statistics of a UDP test */
+typedef struct
+{
+    uint32_t received;
+    uint32_t lost;
+    uint32_t out_of_order;
+    uint32_t next_seq;
+    uint32_t bytes;
+    uint32_t first_us;
+    uint32_t last_us;
+    int32_t last_transit_us;
+    uint32_t jitter_q4;         /* Jitter estimate, in 1/16 us */
+} net_bench_rx_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void net_bench_encode_request(const net_bench_request_t *request,
+        uint8_t buffer[NET_BENCH_REQUEST_SIZE]);
+bool net_bench_decode_request(const uint8_t *buffer, size_t size,
+        net_bench_request_t *request);
+void net_bench_encode_datagram(const net_bench_datagram_t *datagram,
+        uint8_t buffer[NET_BENCH_DATAGRAM_HEADER_SIZE]);
+bool net_bench_decode_datagram(const uint8_t *buffer, size_t size,
+        net_bench_datagram_t *datagram);
+void net_bench_encode_report(const net_bench_report_t *report,
+        uint8_t buffer[NET_BENCH_REPORT_SIZE]);
+bool net_bench_decode_report(const uint8_t *buffer, size_t size,
+        net_bench_report_t *report);
+
+void net_bench_rx_init(net_bench_rx_stats_t *stats);
+void net_bench_rx_update(net_bench_rx_stats_t *stats,
+        const net_bench_datagram_t *datagram, size_t size, uint32_t recv_us);
+void net_bench_rx_report(const net_bench_rx_stats_t *stats,
+        net_bench_report_t *report);
+
+uint32_t net_bench_kbps(uint32_t bytes, uint32_t elapsed_us);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* NET_BENCH_PROTO_H_ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,199 @@
+/*******************************************************************************
+* File Name:   pipeline_uplink.c
+*
+* Description: This file contains the CM33 side of the inter-core data pipeline.
+* It initializes the shared area in SOCMEM before the CM55 is enabled. When the
+* CM55 rings its doorbell, it sends the buffers processed by the CM55 to a UDP
+* sink in one resume of the network stack, straight from the shared area.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "pipeline_uplink.h"
+
+#include "lowpower_task.h"
+
+/* Wi-Fi connection manager header files */
+#include "cy_wcm.h"
+
+/* Low power assistant header files */
+#include "network_activity_handler.h"
+
+/* lwIP socket API */
+#include "lwip/sockets.h"
+
+#include "ipc_config.h"
+#include "ipc_doorbell.h"
+#include "ipc_pipeline.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static ipc_pipeline_t pipeline;
+static TaskHandle_t uplink_task_handle;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: pipeline_uplink_init
+********************************************************************************
+* Summary:
+*  Initializes the shared area. Must be called before the CM55 is enabled.
+*  The CM33 has no data cache, so no cache maintenance is needed on this
+*  side.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void pipeline_uplink_init(void)
+{
+    ipc_pipeline_init(&pipeline,
+            (ipc_pipeline_shared_t *)IPC_SHARED_SOCMEM_ADDR, NULL);
+}
+
+/*******************************************************************************
+* Function Name: doorbell_interrupt_handler
+********************************************************************************
+* Summary:
+*  Wakes the uplink task when the CM55 rings the doorbell.
+*******************************************************************************/
+static void doorbell_interrupt_handler(void)
+{
+    BaseType_t higher_priority_task_woken = pdFALSE;
+
+    ipc_doorbell_clear(IPC_DOORBELL_CM33_INTR);
+    vTaskNotifyGiveFromISR(uplink_task_handle, &higher_priority_task_woken);
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+/*******************************************************************************
+* Function Name: pipeline_uplink_task
+********************************************************************************
+* Summary:
+*  Arms the ready ring and blocks until the CM55 rings the doorbell, then
+*  sends each buffer ready as one UDP datagram to PIPELINE_SINK_IP and returns
+*  it to the CM55. The payload is passed to lwIP in place, so it is copied
+*  once, into the lwIP packet buffer. The CM33 is not woken up by the CM55
+*  for each buffer.
+*
+* Parameters:
+*  void *arg: Not used.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void pipeline_uplink_task(void *arg)
+{
+    struct sockaddr_in sink;
+    ipc_pipeline_buffer_t *buffer;
+    uint32_t sent;
+    int sock = -1;
+
+    (void)arg;
+
+    uplink_task_handle = xTaskGetCurrentTaskHandle();
+
+    memset(&sink, 0, sizeof(sink));
+    sink.sin_family = AF_INET;
+    sink.sin_port = lwip_htons(PIPELINE_SINK_PORT);
+
+    if (1 != lwip_inet_pton(AF_INET, PIPELINE_SINK_IP, &sink.sin_addr))
+    {
+        ERR_INFO(("Invalid pipeline sink address %s.\n", PIPELINE_SINK_IP));
+        vTaskDelete(NULL);
+    }
+
+    if (CY_SYSINT_SUCCESS != ipc_doorbell_init(IPC_DOORBELL_CM33_INTR,
+            IPC_DOORBELL_CM33_IRQ, IPC_DOORBELL_INTERRUPT_PRIORITY,
+            doorbell_interrupt_handler))
+    {
+        handle_app_error();
+    }
+
+    while (true)
+    {
+        if (!ipc_pipeline_arm(&pipeline, PIPELINE_UPLINK_BATCH,
+                PIPELINE_UPLINK_MAX_DELAY_MS))
+        {
+            (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
+
+        if (!cy_wcm_is_connected_to_ap())
+        {
+            vTaskDelay(pdMS_TO_TICKS(PIPELINE_UPLINK_RETRY_MS));
+            continue;
+        }
+
+        /* Resume the network stack now rather than on the first packet */
+        cy_network_activity_notify(CY_NETWORK_ACTIVITY_TX);
+
+        if (sock < 0)
+        {
+            sock = lwip_socket(AF_INET, SOCK_DGRAM, 0);
+            if (sock < 0)
+            {
+                ERR_INFO(("Failed to open the pipeline socket.\n"));
+                vTaskDelay(pdMS_TO_TICKS(PIPELINE_UPLINK_RETRY_MS));
+                continue;
+            }
+        }
+
+        sent = 0U;
+
+        while (NULL != (buffer = ipc_pipeline_receive(&pipeline)))
+        {
+            if (lwip_sendto(sock, buffer->data, buffer->length, 0,
+                    (struct sockaddr *)&sink, sizeof(sink)) > 0)
+            {
+                sent++;
+            }
+
+            ipc_pipeline_release(&pipeline, buffer);
+        }
+
+        APP_INFO(("Pipeline: %lu buffers sent\n", (unsigned long)sent));
+    }
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,86 @@
+/******************************************************************************
+* File Name: pipeline_uplink.h
+*
+* Description: This file is the public interface of pipeline_uplink.c. It
+* contains the CM33 side of the inter-core data pipeline, which sends the
+* buffers processed by the CM55.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef PIPELINE_UPLINK_H_
+#define PIPELINE_UPLINK_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+#include <FreeRTOS.h>
+#include <task.h>
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+#define PIPELINE_UPLINK_TASK_STACK_SIZE_BYTES   (1024U)
+#define PIPELINE_UPLINK_TASK_PRIORITY           (2U)
+
+/* The CM55 rings the doorbell of the CM33 once PIPELINE_UPLINK_BATCH buffers
+ * are ready, or once a buffer has waited PIPELINE_UPLINK_MAX_DELAY_MS. All the
+ * buffers ready are then sent in the same resume of the network stack.
+ */
+#define PIPELINE_UPLINK_BATCH                   (4U)
+#define PIPELINE_UPLINK_MAX_DELAY_MS            (60000U)
+
+/* Delay before trying again when the AP is not connected */
+#define PIPELINE_UPLINK_RETRY_MS                (5000U)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void pipeline_uplink_init(void);
+void pipeline_uplink_task(void *arg);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* PIPELINE_UPLINK_H_ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,420 @@
+/*******************************************************************************
+* File Name:   pkt_filter.c
+*
+* Description: This file contains the automatic packet filters. Every frame that
+* resumes the network stack is judged against the sockets open in lwIP, and WLAN
+* packet filters are installed for the wake reasons that were never used, so
+* that the WLAN device discards these frames instead of waking up the host. In
+* dry-run mode the filters are only reported with the wakes they would avoid.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "pkt_filter.h"
+#include "wake_filter.h"
+
+#include "lowpower_task.h"
+
+/* Wi-Fi connection manager header files */
+#include "cy_wcm.h"
+
+/* Wi-Fi Host Driver (WHD) header files */
+#include "whd_wifi_api.h"
+
+/* lwIP header files */
+#include "lwip/tcpip.h"
+#include "lwip/udp.h"
+#include "lwip/priv/tcp_priv.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static wake_filter_table_t wake_table;
+static wake_filter_t proposals[PKT_FILTER_MAX];
+static wake_filter_t installed[PKT_FILTER_MAX];
+static uint8_t installed_ids[PKT_FILTER_MAX];
+static uint32_t installed_count;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: port_open
+********************************************************************************
+* Summary:
+*  Returns true if an lwIP socket receives on the TCP or UDP port. Called
+*  with the lwIP core locked.
+*******************************************************************************/
+static bool port_open(void *context, uint8_t ip_proto, uint16_t port)
+{
+    (void)context;
+
+    if (WAKE_IP_PROTO_UDP == ip_proto)
+    {
+        for (struct udp_pcb *pcb = udp_pcbs; NULL != pcb; pcb = pcb->next)
+        {
+            if (pcb->local_port == port)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    for (struct tcp_pcb_listen *pcb = tcp_listen_pcbs.listen_pcbs;
+            NULL != pcb; pcb = pcb->next)
+    {
+        if (pcb->local_port == port)
+        {
+            return true;
+        }
+    }
+
+    for (struct tcp_pcb *pcb = tcp_active_pcbs; NULL != pcb; pcb = pcb->next)
+    {
+        if (pcb->local_port == port)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: key_port_open
+********************************************************************************
+* Summary:
+*  Returns true if the wake reason is TCP or UDP to a port an lwIP socket now
+*  receives on.
+*******************************************************************************/
+static bool key_port_open(const wake_key_t *key)
+{
+    bool open;
+
+    if ((WAKE_IP_PROTO_TCP != key->ip_proto) &&
+            (WAKE_IP_PROTO_UDP != key->ip_proto))
+    {
+        return false;
+    }
+
+    LOCK_TCPIP_CORE();
+    open = port_open(NULL, key->ip_proto, key->port);
+    UNLOCK_TCPIP_CORE();
+
+    return open;
+}
+
+/*******************************************************************************
+* Function Name: same_key
+********************************************************************************
+* Summary:
+*  Returns true if two wake reasons are the same.
+*******************************************************************************/
+static bool same_key(const wake_key_t *a, const wake_key_t *b)
+{
+    return (a->ethertype == b->ethertype) && (a->cast == b->cast) &&
+            (a->ip_proto == b->ip_proto) && (a->port == b->port);
+}
+
+/*******************************************************************************
+* Function Name: pkt_filter_init
+********************************************************************************
+* Summary:
+*  Clears the wake counts.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void pkt_filter_init(void)
+{
+    wake_filter_table_init(&wake_table);
+}
+
+/*******************************************************************************
+* Function Name: pkt_filter_observe
+********************************************************************************
+* Summary:
+*  Judges whether a frame that resumed the network stack is used by the host
+*  and counts it against its wake reason. Called by the low power task for
+*  every classified wake frame.
+*
+* Parameters:
+*  const uint8_t *frame: Leading bytes of the frame.
+*  uint16_t len: Number of bytes of the frame available.
+*  const wake_frame_info_t *info: Frame decoded by wake_classify_frame().
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void pkt_filter_observe(const uint8_t *frame, uint16_t len,
+        const wake_frame_info_t *info)
+{
+    wake_filter_host_t host;
+    bool useful;
+
+    memset(&host, 0, sizeof(host));
+    host.port_open = port_open;
+
+    LOCK_TCPIP_CORE();
+    if (NULL != netif_default)
+    {
+        memcpy(host.ipv4_addr, &netif_ip4_addr(netif_default)->addr,
+                sizeof(host.ipv4_addr));
+    }
+    useful = wake_filter_judge(info, frame, len, &host);
+    UNLOCK_TCPIP_CORE();
+
+    wake_filter_table_add(&wake_table, &info->key, useful);
+}
+
+/*******************************************************************************
+* Function Name: install
+********************************************************************************
+* Summary:
+*  Installs a filter in the WLAN device. The filter is negative matching: the
+*  WLAN firmware only forwards the frames that do not match the pattern.
+*******************************************************************************/
+static bool install(whd_interface_t ifp, wake_filter_t *filter, uint8_t id)
+{
+    whd_packet_filter_t settings;
+
+    memset(&settings, 0, sizeof(settings));
+    settings.id = id;
+    settings.rule = WHD_PACKET_FILTER_RULE_NEGATIVE_MATCHING;
+    settings.offset = 0U;
+    settings.mask_size = filter->size;
+    settings.mask = filter->mask;
+    settings.pattern = filter->pattern;
+
+    if (WHD_SUCCESS != whd_pf_add_packet_filter(ifp, &settings))
+    {
+        return false;
+    }
+
+    if (WHD_SUCCESS != whd_pf_enable_packet_filter(ifp, id))
+    {
+        (void)whd_pf_remove_packet_filter(ifp, id);
+        return false;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: free_id
+********************************************************************************
+* Summary:
+*  Returns the lowest filter identifier not used by an installed filter.
+*******************************************************************************/
+static uint8_t free_id(void)
+{
+    uint8_t id = (uint8_t)PKT_FILTER_ID_BASE;
+    bool used = true;
+
+    while (used)
+    {
+        used = false;
+        for (uint32_t i = 0U; i < installed_count; i++)
+        {
+            used |= (installed_ids[i] == id);
+        }
+        if (used)
+        {
+            id++;
+        }
+    }
+
+    return id;
+}
+
+/*******************************************************************************
+* Function Name: uninstall
+********************************************************************************
+* Summary:
+*  Removes an installed filter from the WLAN device and from the list of
+*  installed filters.
+*******************************************************************************/
+static void uninstall(whd_interface_t ifp, uint32_t index)
+{
+    if (WHD_SUCCESS != whd_pf_remove_packet_filter(ifp, installed_ids[index]))
+    {
+        ERR_INFO(("Failed to remove a packet filter.\n"));
+    }
+
+    installed_count--;
+    installed[index] = installed[installed_count];
+    installed_ids[index] = installed_ids[installed_count];
+}
+
+/*******************************************************************************
+* Function Name: pkt_filter_link_up
+********************************************************************************
+* Summary:
+*  Removes the installed filters and clears the wake counts. Called by the low
+*  power task once the device is associated, since the filters derived for
+*  the previous link do not apply to the new one.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void pkt_filter_link_up(void)
+{
+    whd_interface_t ifp = NULL;
+
+    if ((0U != installed_count) && (CY_RSLT_SUCCESS ==
+            cy_wcm_get_whd_interface(CY_WCM_INTERFACE_TYPE_STA, &ifp)))
+    {
+        while (0U != installed_count)
+        {
+            uninstall(ifp, installed_count - 1U);
+        }
+    }
+
+    installed_count = 0U;
+    wake_filter_table_init(&wake_table);
+}
+
+/*******************************************************************************
+* Function Name: pkt_filter_update
+********************************************************************************
+* Summary:
+*  Removes the installed filters of the ports a socket has opened since. Then
+*  proposes filters for the wake reasons never used by the host and prints
+*  them with the share of the wakes they would have avoided. Unless
+*  PKT_FILTER_DRY_RUN is set, the new filters are also installed, up to
+*  PKT_FILTER_MAX.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void pkt_filter_update(void)
+{
+    whd_interface_t ifp = NULL;
+    uint32_t count;
+    uint32_t projected = 0U;
+
+    count = wake_filter_propose(&wake_table, PKT_FILTER_MIN_WAKES, proposals,
+            PKT_FILTER_MAX);
+
+    if ((PKT_FILTER_DRY_RUN != 1U) && (CY_RSLT_SUCCESS !=
+            cy_wcm_get_whd_interface(CY_WCM_INTERFACE_TYPE_STA, &ifp)))
+    {
+        ifp = NULL;
+    }
+
+    if (NULL != ifp)
+    {
+        for (uint32_t i = installed_count; i > 0U; i--)
+        {
+            if (key_port_open(&installed[i - 1U].key))
+            {
+                APP_INFO(("Packet filter removed: %s proto %lu port %lu "
+                        "opened\n",
+                        wake_ethertype_name(installed[i - 1U].key.ethertype),
+                        (unsigned long)installed[i - 1U].key.ip_proto,
+                        (unsigned long)installed[i - 1U].key.port));
+                uninstall(ifp, i - 1U);
+            }
+        }
+    }
+
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        wake_filter_t *filter = &proposals[i];
+        bool is_installed = false;
+
+        if (key_port_open(&filter->key))
+        {
+            continue;
+        }
+
+        for (uint32_t j = 0U; j < installed_count; j++)
+        {
+            is_installed |= same_key(&installed[j].key, &filter->key);
+        }
+
+        if ((NULL != ifp) && !is_installed &&
+                (installed_count < PKT_FILTER_MAX))
+        {
+            uint8_t id = free_id();
+
+            if (install(ifp, filter, id))
+            {
+                installed[installed_count] = *filter;
+                installed_ids[installed_count++] = id;
+                is_installed = true;
+            }
+            else
+            {
+                ERR_INFO(("Failed to install a packet filter.\n"));
+            }
+        }
+
+        projected += filter->wakes;
+
+        APP_INFO(("Packet filter %s: %s %s proto %lu port %lu, "
+                "%lu wakes\n", is_installed ? "installed" : "proposed",
+                wake_ethertype_name(filter->key.ethertype),
+                wake_cast_name(filter->key.cast),
+                (unsigned long)filter->key.ip_proto,
+                (unsigned long)filter->key.port,
+                (unsigned long)filter->wakes));
+    }
+
+    APP_INFO(("Packet filters: %lu of %lu wakes not used, %lu%% avoidable\n",
+            (unsigned long)wake_table.useless,
+            (unsigned long)wake_table.total,
+            (unsigned long)((0U != wake_table.total) ?
+            ((projected * 100U) / wake_table.total) : 0U)));
+}
+
+
+/* [] END OF FILE */
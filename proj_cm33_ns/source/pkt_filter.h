@@ -0,0 +1,88 @@
+/******************************************************************************
+* File Name: pkt_filter.h
+*
+* Description: This file is the public interface of pkt_filter.c, which installs
+* WLAN packet filters for the frames that resume the network stack without being
+* used by the host.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef PKT_FILTER_H_
+#define PKT_FILTER_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+#include "wake_reason.h"
+
+#include <stdint.h>
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+/* Number of filters installed, and identifier of the first one. The
+ * identifiers must not be used by other packet filters of the application.
+ */
+#define PKT_FILTER_MAX                  (4U)
+#define PKT_FILTER_ID_BASE              (100U)
+
+/* Wakes of a reason needed before it is filtered. A reason is never filtered
+ * once one of its frames was used by the host.
+ */
+#define PKT_FILTER_MIN_WAKES            (20U)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void pkt_filter_init(void);
+void pkt_filter_observe(const uint8_t *frame, uint16_t len,
+        const wake_frame_info_t *info);
+void pkt_filter_link_up(void);
+void pkt_filter_update(void);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* PKT_FILTER_H_ */
+
+
+/* [] END OF FILE */
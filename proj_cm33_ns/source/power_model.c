@@ -0,0 +1,163 @@
+/*******************************************************************************
+* File Name:   power_model.c
+*
+* Description: This file contains the energy model that charges the time spent
+* by the host MCU in each power state against a per-state power table and
+* reports the resulting average power and wakeup rate.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/* Header file includes */
+#include "power_model.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+
+/* Power table seeded from Table 1 of README.md */
+const power_model_table_t power_model_default_table =
+{
+    .mcu_uw =
+    {
+        [POWER_MODEL_STATE_ACTIVE]      = POWER_MODEL_MCU_ACTIVE_UW,
+        [POWER_MODEL_STATE_SLEEP]       = POWER_MODEL_MCU_SLEEP_UW,
+        [POWER_MODEL_STATE_DEEPSLEEP]   = POWER_MODEL_MCU_DEEPSLEEP_UW
+    },
+    .wlan_avg_uw        = POWER_MODEL_WLAN_DTIM_AVG_UW,
+    .wlan_wakeup_uj     = POWER_MODEL_WLAN_WAKEUP_UJ
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: power_model_residency_reset
+********************************************************************************
+* Summary:
+*  Clears the time spent in each state and the wakeup count.
+*
+* Parameters:
+*  power_model_residency_t *residency: Residency record to clear.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void power_model_residency_reset(power_model_residency_t *residency)
+{
+    memset(residency, 0, sizeof(power_model_residency_t));
+}
+
+/*******************************************************************************
+* Function Name: power_model_charge
+********************************************************************************
+* Summary:
+*  Adds a period spent in the given power state to the residency record.
+*
+* Parameters:
+*  power_model_residency_t *residency: Residency record to update.
+*  power_model_state_t state: Power state the MCU was in.
+*  uint32_t duration_ms: Time spent in the state, in milliseconds.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void power_model_charge(power_model_residency_t *residency,
+        power_model_state_t state, uint32_t duration_ms)
+{
+    if (state < POWER_MODEL_STATE_COUNT)
+    {
+        residency->residency_ms[state] += duration_ms;
+    }
+}
+
+/*******************************************************************************
+* Function Name: power_model_estimate
+********************************************************************************
+* Summary:
+*  Computes the average power of the MCU and of the WLAN device, and the
+*  wakeup rate, over the period covered by the residency record. The average
+*  power is the energy charged to every state divided by the total elapsed
+*  time. The WLAN device is charged its power-save average for the whole
+*  period and a fixed energy for every wakeup of the host.
+*
+* Parameters:
+*  const power_model_table_t *table: Power drawn in each state.
+*  const power_model_residency_t *residency: Time spent in each state.
+*  power_model_estimate_t *estimate: Filled with the result.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void power_model_estimate(const power_model_table_t *table,
+        const power_model_residency_t *residency,
+        power_model_estimate_t *estimate)
+{
+    /* Energy in nanojoules: uW x ms = nJ */
+    uint64_t mcu_energy_nj = 0U;
+    uint64_t wlan_energy_nj;
+    uint64_t elapsed_ms = 0U;
+
+    memset(estimate, 0, sizeof(power_model_estimate_t));
+
+    for (uint32_t state = 0U; state < (uint32_t)POWER_MODEL_STATE_COUNT;
+            state++)
+    {
+        elapsed_ms += residency->residency_ms[state];
+        mcu_energy_nj += residency->residency_ms[state] *
+                (uint64_t)table->mcu_uw[state];
+    }
+
+    if (0U == elapsed_ms)
+    {
+        return;
+    }
+
+    wlan_energy_nj = (elapsed_ms * (uint64_t)table->wlan_avg_uw) +
+            ((uint64_t)residency->wakeups * table->wlan_wakeup_uj * 1000U);
+
+    estimate->elapsed_ms        = elapsed_ms;
+    estimate->mcu_avg_uw        = (uint32_t)(mcu_energy_nj / elapsed_ms);
+    estimate->wlan_avg_uw       = (uint32_t)(wlan_energy_nj / elapsed_ms);
+    estimate->total_avg_uw      = estimate->mcu_avg_uw + estimate->wlan_avg_uw;
+    estimate->wakeups_per_hour  = (uint32_t)(((uint64_t)residency->wakeups *
+            POWER_MODEL_MS_PER_HOUR) / elapsed_ms);
+}
+
+
+/* [] END OF FILE */
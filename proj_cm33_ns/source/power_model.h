@@ -0,0 +1,155 @@
+/******************************************************************************
+* File Name: power_model.h
+*
+* Description: This file is the public interface of power_model.c. It contains
+* the per-state power table and the functions used to estimate the average
+* power and the wakeup rate of the host MCU and the WLAN device from the time
+* spent in each power state.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef POWER_MODEL_H_
+#define POWER_MODEL_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+/* This module has no device dependencies so that it can also be built for the
+ * host machine.
+ */
+#include <stdint.h>
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+/* Power drawn by the PSOC Edge E84 MCU in deep sleep and by the CYW55513 in
+ * power-save mode between two DTIM beacons, in microwatts. See Table 1 of
+ * README.md.
+ */
+#define POWER_MODEL_MCU_DEEPSLEEP_UW      (1063U)
+#define POWER_MODEL_WLAN_IDLE_UW          (180U)
+
+/* Average power drawn by the CYW55513 over 3 DTIM periods for a 2.4 GHz AP
+ * with a beacon interval of 100 and a DTIM of 1, in microwatts. See Table 1 of
+ * README.md. Use the value of the row matching the AP configuration.
+ */
+#define POWER_MODEL_WLAN_DTIM_AVG_UW      (2361U)
+
+/* Power drawn by the MCU in Active and CPU Sleep modes, in microwatts. These
+ * states are not characterized in Table 1 of README.md. Replace these values
+ * with the ones measured on your board.
+ */
+#define POWER_MODEL_MCU_ACTIVE_UW         (25000U)
+#define POWER_MODEL_MCU_SLEEP_UW          (8000U)
+
+/* Energy spent by the WLAN device to service one host wakeup (host wake
+ * signalling and SDIO bus transactions), in microjoules. Not characterized in
+ * README.md. Replace with the measured value.
+ */
+#define POWER_MODEL_WLAN_WAKEUP_UJ        (0U)
+
+#define POWER_MODEL_MS_PER_HOUR           (3600000UL)
+
+/*******************************************************************************
+* Enumerations
+*******************************************************************************/
+/* Power states of the host MCU that are charged by the model */
+typedef enum
+{
+    POWER_MODEL_STATE_ACTIVE = 0,
+    POWER_MODEL_STATE_SLEEP,
+    POWER_MODEL_STATE_DEEPSLEEP,
+    POWER_MODEL_STATE_COUNT
+} power_model_state_t;
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Power drawn in each state. The WLAN device is charged with a constant
+ * average while it is connected in power-save mode, plus a fixed energy for
+ * every host wakeup.
+ */
+typedef struct
+{
+    uint32_t mcu_uw[POWER_MODEL_STATE_COUNT];
+    uint32_t wlan_avg_uw;
+    uint32_t wlan_wakeup_uj;
+} power_model_table_t;
+
+/* Time spent in each state over an observation period */
+typedef struct
+{
+    uint64_t residency_ms[POWER_MODEL_STATE_COUNT];
+    uint32_t wakeups;
+} power_model_residency_t;
+
+/* Result of an estimate */
+typedef struct
+{
+    uint64_t elapsed_ms;
+    uint32_t mcu_avg_uw;
+    uint32_t wlan_avg_uw;
+    uint32_t total_avg_uw;
+    uint32_t wakeups_per_hour;
+} power_model_estimate_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern const power_model_table_t power_model_default_table;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void power_model_residency_reset(power_model_residency_t *residency);
+void power_model_charge(power_model_residency_t *residency,
+        power_model_state_t state, uint32_t duration_ms);
+void power_model_estimate(const power_model_table_t *table,
+        const power_model_residency_t *residency,
+        power_model_estimate_t *estimate);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* POWER_MODEL_H_ */
+
+
+/* [] END OF FILE */
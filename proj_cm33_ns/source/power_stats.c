@@ -0,0 +1,339 @@
+/*******************************************************************************
+* File Name:   power_stats.c
+*
+* Description: This file contains the SysPm callbacks that measure the time
+* spent by the MCU in Active, Sleep and DeepSleep modes using the LPTimer set up
+* for the RTOS tickless idle mode, and counts the low-power mode entries and the
+* results of the application SysPm callbacks.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "power_stats.h"
+#include "app_timestamp.h"
+#include "lowpower_task.h"
+#include "trace_log.h"
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static cy_en_syspm_status_t power_stats_probe_callback(
+        cy_stc_syspm_callback_params_t *callback_params,
+        cy_en_syspm_callback_mode_t mode);
+static cy_en_syspm_status_t power_stats_residency_callback(
+        cy_stc_syspm_callback_params_t *callback_params,
+        cy_en_syspm_callback_mode_t mode);
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+
+/* Counters updated from the SysPm callbacks */
+static residency_counter_t power_counter;
+
+/* Last low-power mode transition */
+static power_stats_transition_t last_transition;
+
+/* Power state passed to the callbacks through their context */
+static power_model_state_t sleep_state = POWER_MODEL_STATE_SLEEP;
+static power_model_state_t deepsleep_state = POWER_MODEL_STATE_DEEPSLEEP;
+
+/* SysPm callback parameter structures */
+static cy_stc_syspm_callback_params_t sleep_stats_params =
+{
+    .context            = &sleep_state,
+    .base               = NULL
+};
+
+static cy_stc_syspm_callback_params_t deepsleep_stats_params =
+{
+    .context            = &deepsleep_state,
+    .base               = NULL
+};
+
+/* SysPm callback structures counting the low-power mode requests */
+static cy_stc_syspm_callback_t sleep_probe_callback =
+{
+    .callback           = power_stats_probe_callback,
+    .skipMode           = CY_SYSPM_SKIP_BEFORE_TRANSITION |
+                          CY_SYSPM_SKIP_AFTER_TRANSITION |
+                          CY_SYSPM_SKIP_CHECK_FAIL,
+    .type               = CY_SYSPM_SLEEP,
+    .callbackParams     = &sleep_stats_params,
+    .prevItm            = NULL,
+    .nextItm            = NULL,
+    .order              = POWER_STATS_PROBE_CALLBACK_ORDER
+};
+
+static cy_stc_syspm_callback_t deepsleep_probe_callback =
+{
+    .callback           = power_stats_probe_callback,
+    .skipMode           = CY_SYSPM_SKIP_BEFORE_TRANSITION |
+                          CY_SYSPM_SKIP_AFTER_TRANSITION |
+                          CY_SYSPM_SKIP_CHECK_FAIL,
+    .type               = CY_SYSPM_DEEPSLEEP,
+    .callbackParams     = &deepsleep_stats_params,
+    .prevItm            = NULL,
+    .nextItm            = NULL,
+    .order              = POWER_STATS_PROBE_CALLBACK_ORDER
+};
+
+/* SysPm callback structures measuring the time spent in low-power modes */
+static cy_stc_syspm_callback_t sleep_residency_callback =
+{
+    .callback           = power_stats_residency_callback,
+    .skipMode           = CY_SYSPM_SKIP_CHECK_READY | CY_SYSPM_SKIP_CHECK_FAIL,
+    .type               = CY_SYSPM_SLEEP,
+    .callbackParams     = &sleep_stats_params,
+    .prevItm            = NULL,
+    .nextItm            = NULL,
+    .order              = POWER_STATS_RESIDENCY_CALLBACK_ORDER
+};
+
+static cy_stc_syspm_callback_t deepsleep_residency_callback =
+{
+    .callback           = power_stats_residency_callback,
+    .skipMode           = CY_SYSPM_SKIP_CHECK_READY | CY_SYSPM_SKIP_CHECK_FAIL,
+    .type               = CY_SYSPM_DEEPSLEEP,
+    .callbackParams     = &deepsleep_stats_params,
+    .prevItm            = NULL,
+    .nextItm            = NULL,
+    .order              = POWER_STATS_RESIDENCY_CALLBACK_ORDER
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: power_stats_probe_callback
+********************************************************************************
+* Summary:
+*  SysPm callback counting every request to enter a low-power mode.
+*******************************************************************************/
+static cy_en_syspm_status_t power_stats_probe_callback(
+        cy_stc_syspm_callback_params_t *callback_params,
+        cy_en_syspm_callback_mode_t mode)
+{
+    if (CY_SYSPM_CHECK_READY == mode)
+    {
+        residency_counter_attempt(&power_counter,
+                *(power_model_state_t *)callback_params->context);
+    }
+
+    return CY_SYSPM_SUCCESS;
+}
+
+#if (TRACE_LOG_ENABLE == 1U)
+/*******************************************************************************
+* Function Name: trace_power
+********************************************************************************
+* Summary:
+*  Returns the power-state timeline code of the mode of a callback.
+*******************************************************************************/
+static uint32_t trace_power(const cy_stc_syspm_callback_params_t *params)
+{
+    return (POWER_MODEL_STATE_DEEPSLEEP ==
+            *(const power_model_state_t *)params->context) ?
+            TRACE_POWER_DEEPSLEEP : TRACE_POWER_SLEEP;
+}
+#endif /* (TRACE_LOG_ENABLE == 1U) */
+
+/*******************************************************************************
+* Function Name: power_stats_residency_callback
+********************************************************************************
+* Summary:
+*  SysPm callback timestamping the entry to and the exit from a low-power mode.
+*******************************************************************************/
+static cy_en_syspm_status_t power_stats_residency_callback(
+        cy_stc_syspm_callback_params_t *callback_params,
+        cy_en_syspm_callback_mode_t mode)
+{
+    if (CY_SYSPM_BEFORE_TRANSITION == mode)
+    {
+        last_transition.enter_ticks = app_timestamp_ticks();
+        residency_counter_enter(&power_counter,
+                *(power_model_state_t *)callback_params->context,
+                last_transition.enter_ticks);
+#if (TRACE_LOG_ENABLE == 1U)
+        trace_log_record(TRACE_EVENT_POWER_ENTER, trace_power(callback_params));
+#endif /* (TRACE_LOG_ENABLE == 1U) */
+    }
+    else if (CY_SYSPM_AFTER_TRANSITION == mode)
+    {
+#if (TRACE_LOG_ENABLE == 1U)
+        trace_log_record(TRACE_EVENT_POWER_EXIT, trace_power(callback_params));
+#endif /* (TRACE_LOG_ENABLE == 1U) */
+        last_transition.exit_ticks = app_timestamp_ticks();
+        last_transition.count++;
+        residency_counter_exit(&power_counter, last_transition.exit_ticks);
+    }
+
+    return CY_SYSPM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: power_stats_init
+********************************************************************************
+* Summary:
+*  Clears the counters and registers the SysPm callbacks. Must be called after
+*  app_timestamp_init().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void power_stats_init(void)
+{
+    residency_counter_init(&power_counter, app_timestamp_ticks(),
+            app_timestamp_tick_hz());
+
+    Cy_SysPm_RegisterCallback(&sleep_probe_callback);
+    Cy_SysPm_RegisterCallback(&sleep_residency_callback);
+    Cy_SysPm_RegisterCallback(&deepsleep_probe_callback);
+    Cy_SysPm_RegisterCallback(&deepsleep_residency_callback);
+}
+
+/*******************************************************************************
+* Function Name: power_stats_record_callback
+********************************************************************************
+* Summary:
+*  Counts the result of an application SysPm callback. Called by the wrappers
+*  of the SDHC and debug UART deep sleep callbacks.
+*
+* Parameters:
+*  residency_callback_t callback: Callback that was invoked.
+*  cy_en_syspm_callback_mode_t mode: Mode the callback was invoked with.
+*  cy_en_syspm_status_t result: Value returned by the callback.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void power_stats_record_callback(residency_callback_t callback,
+        cy_en_syspm_callback_mode_t mode, cy_en_syspm_status_t result)
+{
+    if ((CY_SYSPM_CHECK_READY == mode) && (CY_SYSPM_SUCCESS != result))
+    {
+        residency_counter_callback(&power_counter, callback,
+                RESIDENCY_CALLBACK_REFUSED);
+    }
+    else if ((CY_SYSPM_BEFORE_TRANSITION == mode) &&
+            (CY_SYSPM_SUCCESS == result))
+    {
+        residency_counter_callback(&power_counter, callback,
+                RESIDENCY_CALLBACK_ENTERED);
+    }
+    else if (CY_SYSPM_CHECK_FAIL == mode)
+    {
+        residency_counter_callback(&power_counter, callback,
+                RESIDENCY_CALLBACK_ROLLED_BACK);
+    }
+}
+
+/*******************************************************************************
+* Function Name: power_stats_get
+********************************************************************************
+* Summary:
+*  Returns the counters accumulated since power_stats_init().
+*
+* Parameters:
+*  residency_snapshot_t *snapshot: Filled with the counters.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void power_stats_get(residency_snapshot_t *snapshot)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    residency_counter_snapshot(&power_counter, app_timestamp_ticks(),
+            snapshot);
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+/*******************************************************************************
+* Function Name: power_stats_dump
+********************************************************************************
+* Summary:
+*  Writes the counters as a binary record. See residency_counter_serialize()
+*  for the record layout.
+*
+* Parameters:
+*  uint8_t *buffer: Destination buffer.
+*  size_t size: Size of the destination buffer.
+*
+* Return:
+*  size_t: Number of bytes written, 0 if the buffer is too small.
+*
+*******************************************************************************/
+size_t power_stats_dump(uint8_t *buffer, size_t size)
+{
+    residency_snapshot_t snapshot;
+
+    power_stats_get(&snapshot);
+
+    return residency_counter_serialize(&snapshot, buffer, size);
+}
+
+/*******************************************************************************
+* Function Name: power_stats_get_transition
+********************************************************************************
+* Summary:
+*  Returns the timestamps of the last low-power mode transition. Used to
+*  measure the time spent in the SysPm callbacks around a transition.
+*
+* Parameters:
+*  power_stats_transition_t *transition: Filled with the timestamps.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void power_stats_get_transition(power_stats_transition_t *transition)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    *transition = last_transition;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+
+/* [] END OF FILE */
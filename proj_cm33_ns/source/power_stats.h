@@ -0,0 +1,99 @@
+/******************************************************************************
+* File Name: power_stats.h
+*
+* Description: This file is the public interface of power_stats.c. It contains
+* the functions used to query the time spent by the MCU in Active, Sleep and
+* DeepSleep modes and the results of the application SysPm callbacks.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef POWER_STATS_H_
+#define POWER_STATS_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+#include "cybsp.h"
+#include "residency_counter.h"
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+/* The probe callbacks run first in CHECK_READY so that they count every
+ * low-power mode request. The residency callbacks run last in
+ * BEFORE_TRANSITION and first in AFTER_TRANSITION so that the time spent in
+ * the other callbacks is charged to the Active state.
+ */
+#define POWER_STATS_PROBE_CALLBACK_ORDER        (0U)
+#define POWER_STATS_RESIDENCY_CALLBACK_ORDER    (255U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* LPTimer counts at which the last low-power mode was entered, after the
+ * other callbacks, and exited, before the other callbacks. The count is
+ * incremented on every exit.
+ */
+typedef struct
+{
+    uint32_t count;
+    uint32_t enter_ticks;
+    uint32_t exit_ticks;
+} power_stats_transition_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void power_stats_init(void);
+void power_stats_record_callback(residency_callback_t callback,
+        cy_en_syspm_callback_mode_t mode, cy_en_syspm_status_t result);
+void power_stats_get(residency_snapshot_t *snapshot);
+size_t power_stats_dump(uint8_t *buffer, size_t size);
+void power_stats_get_transition(power_stats_transition_t *transition);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* POWER_STATS_H_ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,340 @@
+/*******************************************************************************
+* File Name:   residency_counter.c
+*
+* Description: This file contains the accounting of the time spent by the MCU in
+* each power mode. The functions take the timestamps as arguments so that the
+* accounting can be driven by the LPTimer on the device or by fake timestamps on
+* a host machine.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "residency_counter.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define RESIDENCY_RECORD_MAGIC          (0x52U)
+#define MS_PER_SEC                      (1000U)
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: ticks_to_ms
+********************************************************************************
+* Summary:
+*  Converts a number of timestamp ticks to milliseconds.
+*******************************************************************************/
+static uint64_t ticks_to_ms(const residency_counter_t *counter, uint64_t ticks)
+{
+    return (0U != counter->tick_hz) ?
+            ((ticks * MS_PER_SEC) / counter->tick_hz) : 0U;
+}
+
+/*******************************************************************************
+* Function Name: put_u32
+********************************************************************************
+* Summary:
+*  Writes a 32-bit value in little-endian byte order.
+*******************************************************************************/
+static uint8_t *put_u32(uint8_t *buffer, uint64_t value)
+{
+    uint32_t word = (value > UINT32_MAX) ? UINT32_MAX : (uint32_t)value;
+
+    buffer[0] = (uint8_t)(word);
+    buffer[1] = (uint8_t)(word >> 8U);
+    buffer[2] = (uint8_t)(word >> 16U);
+    buffer[3] = (uint8_t)(word >> 24U);
+
+    return buffer + sizeof(uint32_t);
+}
+
+/*******************************************************************************
+* Function Name: charge_current_state
+********************************************************************************
+* Summary:
+*  Charges the time elapsed since the last event to the current state.
+*******************************************************************************/
+static void charge_current_state(residency_counter_t *counter, uint32_t now)
+{
+    /* Unsigned subtraction handles one wrap of the timestamp counter. */
+    counter->state_ticks[counter->state] += (uint32_t)(now - counter->last_ticks);
+    counter->last_ticks = now;
+}
+
+/*******************************************************************************
+* Function Name: residency_counter_init
+********************************************************************************
+* Summary:
+*  Clears all counters and starts accounting in the Active state.
+*
+* Parameters:
+*  residency_counter_t *counter: Counter to initialize.
+*  uint32_t now: Current timestamp.
+*  uint32_t tick_hz: Frequency of the timestamps, in Hz.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void residency_counter_init(residency_counter_t *counter, uint32_t now,
+        uint32_t tick_hz)
+{
+    memset(counter, 0, sizeof(residency_counter_t));
+    counter->state = POWER_MODEL_STATE_ACTIVE;
+    counter->last_ticks = now;
+    counter->tick_hz = tick_hz;
+}
+
+/*******************************************************************************
+* Function Name: residency_counter_attempt
+********************************************************************************
+* Summary:
+*  Counts a request to enter a low-power mode. Attempts that are not followed
+*  by residency_counter_enter() are reported as failed entries.
+*
+* Parameters:
+*  residency_counter_t *counter: Counter to update.
+*  power_model_state_t state: Requested low-power mode.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void residency_counter_attempt(residency_counter_t *counter,
+        power_model_state_t state)
+{
+    if (state < POWER_MODEL_STATE_COUNT)
+    {
+        counter->attempts[state]++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: residency_counter_enter
+********************************************************************************
+* Summary:
+*  Charges the time elapsed since the last event to the Active state and
+*  switches to the given low-power mode.
+*
+* Parameters:
+*  residency_counter_t *counter: Counter to update.
+*  power_model_state_t state: Low-power mode being entered.
+*  uint32_t now: Current timestamp.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void residency_counter_enter(residency_counter_t *counter,
+        power_model_state_t state, uint32_t now)
+{
+    if (state < POWER_MODEL_STATE_COUNT)
+    {
+        charge_current_state(counter, now);
+        counter->entries[state]++;
+        counter->state = state;
+    }
+}
+
+/*******************************************************************************
+* Function Name: residency_counter_exit
+********************************************************************************
+* Summary:
+*  Charges the time elapsed since the last event to the current low-power mode
+*  and switches back to the Active state.
+*
+* Parameters:
+*  residency_counter_t *counter: Counter to update.
+*  uint32_t now: Current timestamp.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void residency_counter_exit(residency_counter_t *counter, uint32_t now)
+{
+    charge_current_state(counter, now);
+    counter->state = POWER_MODEL_STATE_ACTIVE;
+}
+
+/*******************************************************************************
+* Function Name: residency_counter_callback
+********************************************************************************
+* Summary:
+*  Counts the result of one invocation of an application SysPm callback.
+*
+* Parameters:
+*  residency_counter_t *counter: Counter to update.
+*  residency_callback_t callback: Callback that was invoked.
+*  residency_callback_event_t event: Result of the invocation.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void residency_counter_callback(residency_counter_t *counter,
+        residency_callback_t callback, residency_callback_event_t event)
+{
+    residency_callback_stats_t *stats;
+
+    if (callback >= RESIDENCY_CALLBACK_COUNT)
+    {
+        return;
+    }
+
+    stats = &counter->callbacks[callback];
+
+    switch (event)
+    {
+        case RESIDENCY_CALLBACK_ENTERED:
+            stats->entries++;
+            break;
+
+        case RESIDENCY_CALLBACK_REFUSED:
+            stats->refused++;
+            break;
+
+        case RESIDENCY_CALLBACK_ROLLED_BACK:
+            stats->rolled_back++;
+            break;
+
+        default:
+            break;
+    }
+}
+
+/*******************************************************************************
+* Function Name: residency_counter_snapshot
+********************************************************************************
+* Summary:
+*  Charges the time elapsed since the last event to the current state and
+*  converts the counters to milliseconds.
+*
+* Parameters:
+*  residency_counter_t *counter: Counter to read.
+*  uint32_t now: Current timestamp.
+*  residency_snapshot_t *snapshot: Filled with the converted counters.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void residency_counter_snapshot(residency_counter_t *counter, uint32_t now,
+        residency_snapshot_t *snapshot)
+{
+    memset(snapshot, 0, sizeof(residency_snapshot_t));
+
+    charge_current_state(counter, now);
+
+    for (uint32_t state = 0U; state < (uint32_t)POWER_MODEL_STATE_COUNT;
+            state++)
+    {
+        snapshot->residency_ms[state] = ticks_to_ms(counter,
+                counter->state_ticks[state]);
+        snapshot->elapsed_ms += snapshot->residency_ms[state];
+        snapshot->entries[state] = counter->entries[state];
+
+        if (counter->attempts[state] > counter->entries[state])
+        {
+            snapshot->failed_entries[state] = counter->attempts[state] -
+                    counter->entries[state];
+        }
+    }
+
+    memcpy(snapshot->callbacks, counter->callbacks,
+            sizeof(snapshot->callbacks));
+}
+
+/*******************************************************************************
+* Function Name: residency_counter_serialize
+********************************************************************************
+* Summary:
+*  Writes a snapshot as a compact little-endian binary record of
+*  RESIDENCY_RECORD_SIZE bytes:
+*   - magic (1 byte), version (1 byte), number of states (1 byte), number of
+*     callbacks (1 byte), elapsed time in ms (4 bytes)
+*   - for each state: residency in ms, entries, failed entries (4 bytes each)
+*   - for each callback: entries, refused, rolled back (4 bytes each)
+*  Values that do not fit in 32 bits are saturated.
+*
+* Parameters:
+*  const residency_snapshot_t *snapshot: Snapshot to write.
+*  uint8_t *buffer: Destination buffer.
+*  size_t size: Size of the destination buffer.
+*
+* Return:
+*  size_t: Number of bytes written, 0 if the buffer is too small.
+*
+*******************************************************************************/
+size_t residency_counter_serialize(const residency_snapshot_t *snapshot,
+        uint8_t *buffer, size_t size)
+{
+    uint8_t *pos = buffer;
+
+    if (size < RESIDENCY_RECORD_SIZE)
+    {
+        return 0U;
+    }
+
+    *pos++ = RESIDENCY_RECORD_MAGIC;
+    *pos++ = RESIDENCY_RECORD_VERSION;
+    *pos++ = (uint8_t)POWER_MODEL_STATE_COUNT;
+    *pos++ = (uint8_t)RESIDENCY_CALLBACK_COUNT;
+    pos = put_u32(pos, snapshot->elapsed_ms);
+
+    for (uint32_t state = 0U; state < (uint32_t)POWER_MODEL_STATE_COUNT;
+            state++)
+    {
+        pos = put_u32(pos, snapshot->residency_ms[state]);
+        pos = put_u32(pos, snapshot->entries[state]);
+        pos = put_u32(pos, snapshot->failed_entries[state]);
+    }
+
+    for (uint32_t cb = 0U; cb < (uint32_t)RESIDENCY_CALLBACK_COUNT; cb++)
+    {
+        pos = put_u32(pos, snapshot->callbacks[cb].entries);
+        pos = put_u32(pos, snapshot->callbacks[cb].refused);
+        pos = put_u32(pos, snapshot->callbacks[cb].rolled_back);
+    }
+
+    return (size_t)(pos - buffer);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,151 @@
+/******************************************************************************
+* File Name: residency_counter.h
+*
+* Description: This file is the public interface of residency_counter.c. It
+* contains the accounting of the time spent by the MCU in Active, Sleep and
+* DeepSleep modes, of the low-power mode entries, and of the SysPm callback
+* results.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef RESIDENCY_COUNTER_H_
+#define RESIDENCY_COUNTER_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+/* This module has no device dependencies so that it can also be built for the
+ * host machine and driven with fake timestamps.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "power_model.h"
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+/* Version of the binary record written by residency_counter_serialize() */
+#define RESIDENCY_RECORD_VERSION        (1U)
+
+/* Size in bytes of the binary record */
+#define RESIDENCY_RECORD_SIZE           (8U + \
+        (4U * 3U * (uint32_t)POWER_MODEL_STATE_COUNT) + \
+        (4U * 3U * (uint32_t)RESIDENCY_CALLBACK_COUNT))
+
+/*******************************************************************************
+* Enumerations
+*******************************************************************************/
+/* SysPm callbacks of the application whose results are counted */
+typedef enum
+{
+    RESIDENCY_CALLBACK_SDHC = 0,
+    RESIDENCY_CALLBACK_DEBUG_UART,
+    RESIDENCY_CALLBACK_COUNT
+} residency_callback_t;
+
+/* Result of a SysPm callback invocation */
+typedef enum
+{
+    RESIDENCY_CALLBACK_ENTERED,     /* BEFORE_TRANSITION completed */
+    RESIDENCY_CALLBACK_REFUSED,     /* CHECK_READY returned fail */
+    RESIDENCY_CALLBACK_ROLLED_BACK  /* CHECK_FAIL invoked */
+} residency_callback_event_t;
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Results of one SysPm callback */
+typedef struct
+{
+    uint32_t entries;
+    uint32_t refused;
+    uint32_t rolled_back;
+} residency_callback_stats_t;
+
+/* Accumulated counters */
+typedef struct
+{
+    uint64_t state_ticks[POWER_MODEL_STATE_COUNT];
+    uint32_t attempts[POWER_MODEL_STATE_COUNT];
+    uint32_t entries[POWER_MODEL_STATE_COUNT];
+    residency_callback_stats_t callbacks[RESIDENCY_CALLBACK_COUNT];
+    power_model_state_t state;
+    uint32_t last_ticks;
+    uint32_t tick_hz;
+} residency_counter_t;
+
+/* Counters converted to milliseconds at a point in time */
+typedef struct
+{
+    uint64_t elapsed_ms;
+    uint64_t residency_ms[POWER_MODEL_STATE_COUNT];
+    uint32_t entries[POWER_MODEL_STATE_COUNT];
+    uint32_t failed_entries[POWER_MODEL_STATE_COUNT];
+    residency_callback_stats_t callbacks[RESIDENCY_CALLBACK_COUNT];
+} residency_snapshot_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void residency_counter_init(residency_counter_t *counter, uint32_t now,
+        uint32_t tick_hz);
+void residency_counter_attempt(residency_counter_t *counter,
+        power_model_state_t state);
+void residency_counter_enter(residency_counter_t *counter,
+        power_model_state_t state, uint32_t now);
+void residency_counter_exit(residency_counter_t *counter, uint32_t now);
+void residency_counter_callback(residency_counter_t *counter,
+        residency_callback_t callback, residency_callback_event_t event);
+void residency_counter_snapshot(residency_counter_t *counter, uint32_t now,
+        residency_snapshot_t *snapshot);
+size_t residency_counter_serialize(const residency_snapshot_t *snapshot,
+        uint8_t *buffer, size_t size);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* RESIDENCY_COUNTER_H_ */
+
+
+/* [] END OF FILE */
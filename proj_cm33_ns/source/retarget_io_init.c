@@ -40,6 +40,13 @@
 * Header Files
 *******************************************************************************/
 #include "retarget_io_init.h"
+#include "power_stats.h"
+#include "app_timestamp.h"
+#include "byte_ring.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
 
 /*******************************************************************************
 * Global Variables
@@ -49,6 +56,171 @@
 static cy_stc_scb_uart_context_t    DEBUG_UART_context;  
 static mtb_hal_uart_t               DEBUG_UART_hal_obj;
 
+#if (DEBUG_UART_ASYNC_TX == 1U)
+
+/* Output queued for the TX interrupt. Written by tasks with interrupts
+ * masked and read by the TX interrupt.
+ */
+static uint8_t tx_ring_buffer[DEBUG_UART_TX_RING_SIZE];
+static byte_ring_t tx_ring;
+
+/* Set when deep sleep was deferred for DEBUG_UART_FLUSH_DEFER_MAX_US. The TX
+ * interrupt then stops refilling the FIFO so that the UART becomes idle, and
+ * the rest of the ring is sent after wakeup.
+ */
+static volatile bool tx_paused;
+
+static retarget_io_tx_stats_t tx_stats;
+
+static const cy_stc_sysint_t debug_uart_irq_cfg =
+{
+    .intrSrc            = CYBSP_DEBUG_UART_IRQ,
+    .intrPriority       = DEBUG_UART_INTERRUPT_PRIORITY
+};
+
+/*******************************************************************************
+* Function Name: tx_fill_fifo
+********************************************************************************
+* Summary:
+* Moves bytes from the ring to the TX FIFO, and enables the TX trigger
+* interrupt while bytes remain to be sent. Must be called from the TX
+* interrupt or with interrupts masked.
+*******************************************************************************/
+static void tx_fill_fifo(void)
+{
+    const uint8_t *data;
+    uint32_t len;
+    uint32_t put;
+
+    while (!tx_paused && (0U != (len = byte_ring_peek(&tx_ring, &data))))
+    {
+        put = Cy_SCB_UART_PutArray(CYBSP_DEBUG_UART_HW, (void *)data, len);
+        byte_ring_consume(&tx_ring, put);
+
+        /* FIFO full */
+        if (put < len)
+        {
+            break;
+        }
+    }
+
+    Cy_SCB_SetTxInterruptMask(CYBSP_DEBUG_UART_HW,
+            (tx_paused || (0U == byte_ring_used(&tx_ring))) ?
+            0U : CY_SCB_UART_TX_TRIGGER);
+}
+
+/*******************************************************************************
+* Function Name: debug_uart_interrupt_handler
+********************************************************************************
+* Summary:
+* Debug UART interrupt handler. Refills the TX FIFO from the ring.
+*******************************************************************************/
+static void debug_uart_interrupt_handler(void)
+{
+    Cy_SCB_ClearTxInterrupt(CYBSP_DEBUG_UART_HW, CY_SCB_UART_TX_TRIGGER);
+    tx_fill_fifo();
+}
+
+/*******************************************************************************
+* Function Name: tx_queue
+********************************************************************************
+* Summary:
+* Queues bytes for the TX interrupt. Bytes that do not fit in the ring are
+* dropped and counted.
+*******************************************************************************/
+static void tx_queue(const uint8_t *data, uint32_t size)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+    uint32_t written = byte_ring_write(&tx_ring, data, size);
+
+    tx_stats.bytes_queued += written;
+    tx_stats.bytes_dropped += size - written;
+
+    /* A task is running, so there is no deep sleep to prepare for */
+    tx_paused = false;
+    tx_fill_fifo();
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+#if (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP)
+
+/* Start of the current deep sleep deferral, in LPTimer ticks */
+static bool flush_pending;
+static uint32_t flush_start_ticks;
+
+/*******************************************************************************
+* Function Name: tx_ready_for_deepsleep
+********************************************************************************
+* Summary:
+* Decides whether deep sleep can be entered. Deep sleep is deferred while
+* output is queued, for at most DEBUG_UART_FLUSH_DEFER_MAX_US. After that, the
+* FIFO is no longer refilled and deep sleep is entered as soon as the UART is
+* idle, with the rest of the output kept in the ring. Accounts the time deep
+* sleep was deferred.
+*******************************************************************************/
+static bool tx_ready_for_deepsleep(void)
+{
+    uint32_t now = app_timestamp_ticks();
+    uint32_t elapsed_us = flush_pending ?
+            app_timestamp_ticks_to_us(now - flush_start_ticks) : 0U;
+    bool uart_idle = Cy_SCB_UART_IsTxComplete(CYBSP_DEBUG_UART_HW);
+
+    if (uart_idle && (tx_paused || (0U == byte_ring_used(&tx_ring))))
+    {
+        if (0U != byte_ring_used(&tx_ring))
+        {
+            tx_stats.sleeps_with_pending++;
+        }
+
+        if (flush_pending)
+        {
+            flush_pending = false;
+            tx_stats.flush_time_us += elapsed_us;
+            if (elapsed_us > tx_stats.max_flush_time_us)
+            {
+                tx_stats.max_flush_time_us = elapsed_us;
+            }
+        }
+
+        return true;
+    }
+
+    if (!flush_pending)
+    {
+        flush_pending = true;
+        flush_start_ticks = now;
+    }
+    else if (elapsed_us >= DEBUG_UART_FLUSH_DEFER_MAX_US)
+    {
+        tx_paused = true;
+    }
+
+    tx_stats.sleep_deferrals++;
+
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: tx_resume
+********************************************************************************
+* Summary:
+* Resumes sending the output kept in the ring after deep sleep.
+*******************************************************************************/
+static void tx_resume(void)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    tx_paused = false;
+    tx_fill_fifo();
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+#endif /* (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP) */
+
+#endif /* (DEBUG_UART_ASYNC_TX == 1U) */
+
 /* Retarget-io deepsleep callback parameters  */
 #if (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP)
 
@@ -78,10 +250,48 @@ static cy_stc_syspm_callback_params_t retarget_io_syspm_cb_params =
     .base               = CYBSP_DEBUG_UART_HW
 };
 
+/*******************************************************************************
+* Function Name: retarget_io_deepsleep_callback
+********************************************************************************
+* Summary:
+* Debug UART deep sleep callback that counts the callback results in the
+* power statistics. With DEBUG_UART_ASYNC_TX, deep sleep is also deferred for
+* a bounded time to send the queued output, and the output left in the ring
+* is sent after wakeup.
+*******************************************************************************/
+static cy_en_syspm_status_t retarget_io_deepsleep_callback(
+        cy_stc_syspm_callback_params_t *callback_params,
+        cy_en_syspm_callback_mode_t mode)
+{
+    cy_en_syspm_status_t result;
+
+#if (DEBUG_UART_ASYNC_TX == 1U)
+    if ((CY_SYSPM_CHECK_READY == mode) && !tx_ready_for_deepsleep())
+    {
+        power_stats_record_callback(RESIDENCY_CALLBACK_DEBUG_UART, mode,
+                CY_SYSPM_FAIL);
+        return CY_SYSPM_FAIL;
+    }
+#endif /* (DEBUG_UART_ASYNC_TX == 1U) */
+
+    result = mtb_syspm_scb_uart_deepsleep_callback(callback_params, mode);
+
+#if (DEBUG_UART_ASYNC_TX == 1U)
+    if ((CY_SYSPM_AFTER_TRANSITION == mode) || (CY_SYSPM_CHECK_FAIL == mode))
+    {
+        tx_resume();
+    }
+#endif /* (DEBUG_UART_ASYNC_TX == 1U) */
+
+    power_stats_record_callback(RESIDENCY_CALLBACK_DEBUG_UART, mode, result);
+
+    return result;
+}
+
 /* SysPm callback structure for Debug UART */
 static cy_stc_syspm_callback_t retarget_io_syspm_cb =
 {
-    .callback           = &mtb_syspm_scb_uart_deepsleep_callback,
+    .callback           = &retarget_io_deepsleep_callback,
     .skipMode           = SYSPM_SKIP_MODE,
     .type               = CY_SYSPM_DEEPSLEEP,
     .callbackParams     = &retarget_io_syspm_cb_params,
@@ -134,6 +344,24 @@ void init_retarget_io(void)
         handle_app_error();
     }
 
+#if (DEBUG_UART_ASYNC_TX == 1U)
+    /* Send the queued output from the TX interrupt. Only the TX trigger
+     * interrupt is used.
+     */
+    byte_ring_init(&tx_ring, tx_ring_buffer, sizeof(tx_ring_buffer));
+    Cy_SCB_SetTxFifoLevel(CYBSP_DEBUG_UART_HW, DEBUG_UART_TX_FIFO_TRIGGER);
+    Cy_SCB_SetTxInterruptMask(CYBSP_DEBUG_UART_HW, 0U);
+    Cy_SCB_SetRxInterruptMask(CYBSP_DEBUG_UART_HW, 0U);
+
+    if (CY_SYSINT_SUCCESS != Cy_SysInt_Init(&debug_uart_irq_cfg,
+            debug_uart_interrupt_handler))
+    {
+        handle_app_error();
+    }
+
+    NVIC_EnableIRQ(CYBSP_DEBUG_UART_IRQ);
+#endif /* (DEBUG_UART_ASYNC_TX == 1U) */
+
 #if (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP)
 
     /* UART SysPm callback registration for retarget-io */
@@ -143,4 +371,89 @@ void init_retarget_io(void)
 
 }
 
+/*******************************************************************************
+* Function Name: retarget_io_write_raw
+********************************************************************************
+* Summary:
+* Writes bytes to the debug UART without the newline conversion of
+* retarget-io. Used to drain the binary log. With DEBUG_UART_ASYNC_TX, the
+* bytes are queued for the TX interrupt. Otherwise, blocks until all the bytes
+* are in the TX FIFO.
+*******************************************************************************/
+void retarget_io_write_raw(const uint8_t *data, uint32_t size)
+{
+#if (DEBUG_UART_ASYNC_TX == 1U)
+    tx_queue(data, size);
+#else
+    Cy_SCB_UART_PutArrayBlocking(CYBSP_DEBUG_UART_HW, (void *)data, size);
+#endif /* (DEBUG_UART_ASYNC_TX == 1U) */
+}
+
+/*******************************************************************************
+* Function Name: retarget_io_printf
+********************************************************************************
+* Summary:
+* printf() for the debug prints. With DEBUG_UART_ASYNC_TX, the message is
+* formatted in a buffer of DEBUG_UART_PRINTF_BUFFER_SIZE bytes, converting
+* line feeds to CR-LF as retarget-io does, and queued for the TX interrupt so
+* the caller does not wait for the UART. Otherwise, it is printed through
+* retarget-io.
+*******************************************************************************/
+void retarget_io_printf(const char *fmt, ...)
+{
+    va_list args;
+
+    va_start(args, fmt);
+
+#if (DEBUG_UART_ASYNC_TX == 1U)
+    char buffer[DEBUG_UART_PRINTF_BUFFER_SIZE];
+    int len = vsnprintf(buffer, sizeof(buffer), fmt, args);
+    uint32_t start = 0U;
+
+    if (len > 0)
+    {
+        if ((uint32_t)len >= sizeof(buffer))
+        {
+            len = (int)sizeof(buffer) - 1;
+        }
+
+        for (uint32_t i = 0U; i < (uint32_t)len; i++)
+        {
+            if ('\n' == buffer[i])
+            {
+                tx_queue((const uint8_t *)&buffer[start], i - start);
+                tx_queue((const uint8_t *)"\r\n", 2U);
+                start = i + 1U;
+            }
+        }
+
+        tx_queue((const uint8_t *)&buffer[start], (uint32_t)len - start);
+    }
+#else
+    (void)vprintf(fmt, args);
+#endif /* (DEBUG_UART_ASYNC_TX == 1U) */
+
+    va_end(args);
+}
+
+/*******************************************************************************
+* Function Name: retarget_io_get_tx_stats
+********************************************************************************
+* Summary:
+* Returns the statistics of the asynchronous TX path. All zero when
+* DEBUG_UART_ASYNC_TX is 0.
+*******************************************************************************/
+void retarget_io_get_tx_stats(retarget_io_tx_stats_t *stats)
+{
+#if (DEBUG_UART_ASYNC_TX == 1U)
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    *stats = tx_stats;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+#else
+    memset(stats, 0, sizeof(retarget_io_tx_stats_t));
+#endif /* (DEBUG_UART_ASYNC_TX == 1U) */
+}
+
 /* [] END OF FILE */
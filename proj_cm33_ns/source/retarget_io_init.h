@@ -59,11 +59,54 @@
 #define SYSPM_SKIP_MODE         (0U)
 #define SYSPM_CALLBACK_ORDER    (1U)
 
+/* Set to 1 to queue the output of retarget_io_printf() and
+ * retarget_io_write_raw() in a ring buffer sent by the UART TX interrupt,
+ * instead of waiting for every byte to be sent. The printf() calls of main.c
+ * and of the middleware still write to the UART directly, so their output
+ * can interleave with the queued output. Set to 0 for polled output.
+ */
+#define DEBUG_UART_ASYNC_TX             (0U)
+
+/* Size of the TX ring buffer in bytes. Must be a power of two. Output that
+ * does not fit is dropped and counted.
+ */
+#define DEBUG_UART_TX_RING_SIZE         (2048U)
+
+/* Longest time, in microseconds, deep sleep is deferred to send the queued
+ * output. Once elapsed, the bytes still in the ring are kept across deep
+ * sleep and sent after wakeup.
+ */
+#define DEBUG_UART_FLUSH_DEFER_MAX_US   (2000U)
+
+/* The TX interrupt refills the FIFO when it holds fewer bytes than this */
+#define DEBUG_UART_TX_FIFO_TRIGGER      (8U)
+#define DEBUG_UART_INTERRUPT_PRIORITY   (7U)
+
+/* Size of the buffer retarget_io_printf() formats a message in */
+#define DEBUG_UART_PRINTF_BUFFER_SIZE   (160U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Statistics of the asynchronous TX path */
+typedef struct
+{
+    uint32_t bytes_queued;
+    uint32_t bytes_dropped;         /* Ring full */
+    uint32_t sleep_deferrals;       /* Deep sleep refused to send output */
+    uint32_t sleeps_with_pending;   /* Deep sleep entered with output queued */
+    uint32_t flush_time_us;         /* Total time deep sleep was deferred */
+    uint32_t max_flush_time_us;
+} retarget_io_tx_stats_t;
+
 
 /*******************************************************************************
 * Function prototypes
 *******************************************************************************/
 void init_retarget_io(void);
+void retarget_io_write_raw(const uint8_t *data, uint32_t size);
+void retarget_io_printf(const char *fmt, ...);
+void retarget_io_get_tx_stats(retarget_io_tx_stats_t *stats);
 
 /*******************************************************************************
 * Function Name: handle_app_error
@@ -0,0 +1,339 @@
+/*******************************************************************************
+* File Name:   roam.c
+*
+* Description: This file contains the roaming component. On every wake of the
+* network stack, the RSSI of the link is sampled and passed to the roaming
+* policy. When the link is weak, the wakes refresh a cached table of the APs of
+* the network with a scan for the SSID, and the device is reassociated to the
+* strongest of them once the link has degraded past the hysteresis margin.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "roam.h"
+
+#include "lowpower_task.h"
+
+/* FreeRTOS header files */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define MAX_2_4GHZ_CHANNEL              (14U)
+
+#define TICKS_TO_MS(ticks)              ((uint32_t)((ticks) * \
+                                         portTICK_PERIOD_MS))
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Shared between the low power task and the WCM worker thread, which
+ * delivers the scan results.
+ */
+static roam_policy_t policy;
+static volatile bool scanning;
+
+static const roam_config_t roam_config =
+{
+    .scan_rssi_dbm      = ROAM_SCAN_RSSI_DBM,
+    .trigger_rssi_dbm   = ROAM_TRIGGER_RSSI_DBM,
+    .hysteresis_db      = ROAM_HYSTERESIS_DB,
+    .scan_interval_ms   = ROAM_SCAN_INTERVAL_MS,
+    .max_age_ms         = ROAM_MAX_AGE_MS,
+    .min_dwell_ms       = ROAM_MIN_DWELL_MS,
+    .penalty_ms         = ROAM_PENALTY_MS
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: now_ms
+********************************************************************************
+* Summary:
+*  Returns the time since the scheduler started, in milliseconds.
+*******************************************************************************/
+static uint32_t now_ms(void)
+{
+    return TICKS_TO_MS(xTaskGetTickCount());
+}
+
+/*******************************************************************************
+* Function Name: scan_callback
+********************************************************************************
+* Summary:
+*  Adds every AP of the network found by the scan to the candidate table.
+*  Runs in the context of the WCM worker thread.
+*******************************************************************************/
+static void scan_callback(cy_wcm_scan_result_t *result_ptr, void *user_data,
+        cy_wcm_scan_status_t status)
+{
+    CY_UNUSED_PARAMETER(user_data);
+
+    if ((CY_WCM_SCAN_INCOMPLETE == status) && (NULL != result_ptr))
+    {
+        taskENTER_CRITICAL();
+        roam_policy_observe(&policy, result_ptr->BSSID, result_ptr->channel,
+                result_ptr->signal_strength, now_ms());
+        taskEXIT_CRITICAL();
+    }
+    else if (CY_WCM_SCAN_COMPLETE == status)
+    {
+        scanning = false;
+    }
+    else
+    {
+        /* Empty result */
+    }
+}
+
+/*******************************************************************************
+* Function Name: start_scan
+********************************************************************************
+* Summary:
+*  Starts a scan for the APs of the network. The results are delivered to
+*  scan_callback() while the network stack is resumed.
+*******************************************************************************/
+static void start_scan(void)
+{
+    cy_wcm_scan_filter_t filter;
+
+    if (scanning)
+    {
+        return;
+    }
+
+    memset(&filter, 0, sizeof(filter));
+    filter.mode = CY_WCM_SCAN_FILTER_TYPE_SSID;
+    memcpy(filter.param.SSID, WIFI_SSID, sizeof(WIFI_SSID));
+
+    scanning = true;
+    if (CY_RSLT_SUCCESS != cy_wcm_start_scan(scan_callback, NULL, &filter))
+    {
+        scanning = false;
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    roam_policy_scan_started(&policy, now_ms());
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: roam_init
+********************************************************************************
+* Summary:
+*  Initializes the roaming policy with an empty candidate table.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void roam_init(void)
+{
+    roam_policy_init(&policy, &roam_config);
+}
+
+/*******************************************************************************
+* Function Name: roam_associated
+********************************************************************************
+* Summary:
+*  Records the AP the device is associated to. Called after every
+*  connection.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void roam_associated(void)
+{
+    cy_wcm_associated_ap_info_t ap_info;
+
+    if (CY_RSLT_SUCCESS != cy_wcm_get_associated_ap_info(&ap_info))
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    roam_policy_associated(&policy, ap_info.BSSID, (uint8_t)ap_info.channel,
+            ap_info.signal_strength, now_ms());
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: roam_poll
+********************************************************************************
+* Summary:
+*  Samples the RSSI of the link and runs the roaming policy. Called by the
+*  low power task on every wake of the network stack, so that no wake is
+*  added for roaming. Starts a scan when the policy asks for one.
+*
+* Parameters:
+*  roam_candidate_t *target: Filled with the AP to reassociate to.
+*
+* Return:
+*  bool: true if the device should reassociate to the target.
+*
+*******************************************************************************/
+bool roam_poll(roam_candidate_t *target)
+{
+    cy_wcm_associated_ap_info_t ap_info;
+    roam_action_t action;
+
+    if (CY_RSLT_SUCCESS != cy_wcm_get_associated_ap_info(&ap_info))
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    roam_policy_link_sample(&policy, ap_info.signal_strength);
+    action = roam_policy_decide(&policy, now_ms(), target);
+    taskEXIT_CRITICAL();
+
+    if (ROAM_ACTION_SCAN == action)
+    {
+        start_scan();
+    }
+
+    return (ROAM_ACTION_ROAM == action) && !scanning;
+}
+
+/*******************************************************************************
+* Function Name: roam_reassociate
+********************************************************************************
+* Summary:
+*  Leaves the current AP and joins the target AP of the network. A target
+*  that cannot be joined is penalized in the candidate table.
+*
+* Parameters:
+*  const roam_candidate_t *target: AP to join.
+*  cy_wcm_connect_params_t *connect_param: Credentials of the network. The
+*   BSSID and band of the target are added.
+*  cy_wcm_ip_address_t *ip_address: Filled with the assigned IP address.
+*
+* Return:
+*  cy_rslt_t: Result of the join.
+*
+*******************************************************************************/
+cy_rslt_t roam_reassociate(const roam_candidate_t *target,
+        cy_wcm_connect_params_t *connect_param,
+        cy_wcm_ip_address_t *ip_address)
+{
+    cy_rslt_t result;
+
+    memcpy(connect_param->BSSID, target->bssid, ROAM_BSSID_LEN);
+    connect_param->band = (target->channel > MAX_2_4GHZ_CHANNEL) ?
+            CY_WCM_WIFI_BAND_5GHZ : CY_WCM_WIFI_BAND_2_4GHZ;
+
+    APP_INFO(("Roaming from %ld dBm to %02x:%02x:%02x:%02x:%02x:%02x on "
+            "channel %u (%ld dBm)\n",
+            (long)roam_policy_link_rssi(&policy),
+            target->bssid[0], target->bssid[1], target->bssid[2],
+            target->bssid[3], target->bssid[4], target->bssid[5],
+            (unsigned int)target->channel, (long)target->rssi_dbm));
+
+    (void)cy_wcm_disconnect_ap();
+    result = cy_wcm_connect_ap(connect_param, ip_address);
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        taskENTER_CRITICAL();
+        roam_policy_join_failed(&policy, target->bssid, now_ms());
+        taskEXIT_CRITICAL();
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: roam_report
+********************************************************************************
+* Summary:
+*  Prints the link RSSI, the roaming counters and the candidate table.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void roam_report(void)
+{
+    roam_policy_t copy;
+    uint32_t now = now_ms();
+
+    taskENTER_CRITICAL();
+    copy = policy;
+    taskEXIT_CRITICAL();
+
+    APP_INFO(("Roaming: link %ld dBm, %lu scans, %lu roams, %lu failed\n",
+            (long)roam_policy_link_rssi(&copy),
+            (unsigned long)copy.stats.scans,
+            (unsigned long)copy.stats.roams,
+            (unsigned long)copy.stats.failures));
+
+    for (uint32_t i = 0U; i < ROAM_TABLE_SIZE; i++)
+    {
+        const roam_candidate_t *entry = &copy.table[i];
+
+        if (!entry->used)
+        {
+            continue;
+        }
+
+        APP_INFO(("  %02x:%02x:%02x:%02x:%02x:%02x ch %u: %ld dBm, "
+                "%lu s ago%s\n",
+                entry->bssid[0], entry->bssid[1], entry->bssid[2],
+                entry->bssid[3], entry->bssid[4], entry->bssid[5],
+                (unsigned int)entry->channel, (long)entry->rssi_dbm,
+                (unsigned long)((now - entry->seen_ms) / 1000U),
+                (0 == memcmp(entry->bssid, copy.current, ROAM_BSSID_LEN)) ?
+                " (current)" : ""));
+    }
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,94 @@
+/******************************************************************************
+* File Name: roam.h
+*
+* Description: This file is the public interface of roam.c, which reassociates
+* the device to a stronger AP of the network when the link degrades.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef ROAM_H_
+#define ROAM_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+#include "roam_policy.h"
+
+#include "cy_wcm.h"
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+/* Below ROAM_SCAN_RSSI_DBM, the wakes refresh the candidate table with a scan
+ * for the SSID at most every ROAM_SCAN_INTERVAL_MS. Below
+ * ROAM_TRIGGER_RSSI_DBM, the device reassociates to the strongest candidate
+ * seen in the last ROAM_MAX_AGE_MS if it is ROAM_HYSTERESIS_DB stronger than
+ * the link, and it has stayed ROAM_MIN_DWELL_MS on the current AP.
+ */
+#define ROAM_SCAN_RSSI_DBM              (-70)
+#define ROAM_TRIGGER_RSSI_DBM           (-75)
+#define ROAM_HYSTERESIS_DB              (8U)
+#define ROAM_SCAN_INTERVAL_MS           (60000U)
+#define ROAM_MAX_AGE_MS                 (120000U)
+#define ROAM_MIN_DWELL_MS               (30000U)
+
+/* Time a candidate that could not be joined is skipped */
+#define ROAM_PENALTY_MS                 (300000U)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void roam_init(void);
+void roam_associated(void);
+bool roam_poll(roam_candidate_t *target);
+cy_rslt_t roam_reassociate(const roam_candidate_t *target,
+        cy_wcm_connect_params_t *connect_param,
+        cy_wcm_ip_address_t *ip_address);
+void roam_report(void);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* ROAM_H_ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,407 @@
+/*******************************************************************************
+* File Name:   roam_policy.c
+*
+* Description: This file contains the roaming policy. It keeps a small table of
+* the APs of the network with their RSSI and channel, smooths the RSSI of the
+* link, and decides when the table should be refreshed and when the device
+* should reassociate to a stronger AP.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "roam_policy.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* The RSSI of the link is smoothed with a weight of 1/4 for new samples */
+#define LINK_RSSI_SCALE                 (16)
+#define LINK_RSSI_WEIGHT_SHIFT          (2)
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: is_current
+********************************************************************************
+* Summary:
+*  Returns true if a BSSID is the one of the AP the device is associated to.
+*******************************************************************************/
+static bool is_current(const roam_policy_t *policy, const uint8_t *bssid)
+{
+    return policy->associated &&
+            (0 == memcmp(policy->current, bssid, ROAM_BSSID_LEN));
+}
+
+/*******************************************************************************
+* Function Name: find_entry
+********************************************************************************
+* Summary:
+*  Returns the table entry of a BSSID, or NULL if it is not in the table.
+*******************************************************************************/
+static roam_candidate_t *find_entry(roam_policy_t *policy,
+        const uint8_t *bssid)
+{
+    for (uint32_t i = 0U; i < ROAM_TABLE_SIZE; i++)
+    {
+        roam_candidate_t *entry = &policy->table[i];
+
+        if (entry->used && (0 == memcmp(entry->bssid, bssid, ROAM_BSSID_LEN)))
+        {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: find_slot
+********************************************************************************
+* Summary:
+*  Returns the table entry of a BSSID. If the BSSID is not in the table,
+*  returns a free entry or, when the table is full, the entry seen the
+*  longest ago other than the current AP.
+*******************************************************************************/
+static roam_candidate_t *find_slot(roam_policy_t *policy,
+        const uint8_t *bssid, uint32_t now_ms)
+{
+    roam_candidate_t *slot = find_entry(policy, bssid);
+    roam_candidate_t *oldest = NULL;
+
+    for (uint32_t i = 0U; (NULL == slot) && (i < ROAM_TABLE_SIZE); i++)
+    {
+        roam_candidate_t *entry = &policy->table[i];
+
+        if (!entry->used)
+        {
+            slot = entry;
+        }
+        else if (!is_current(policy, entry->bssid) && ((NULL == oldest) ||
+                ((now_ms - entry->seen_ms) > (now_ms - oldest->seen_ms))))
+        {
+            oldest = entry;
+        }
+        else
+        {
+            /* Current AP, or seen more recently than the oldest entry */
+        }
+    }
+
+    return (NULL != slot) ? slot : oldest;
+}
+
+/*******************************************************************************
+* Function Name: roam_policy_init
+********************************************************************************
+* Summary:
+*  Initializes the policy with an empty table and no association.
+*
+* Parameters:
+*  roam_policy_t *policy: Policy to initialize.
+*  const roam_config_t *config: Thresholds and timings.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void roam_policy_init(roam_policy_t *policy, const roam_config_t *config)
+{
+    memset(policy, 0, sizeof(roam_policy_t));
+    policy->config = *config;
+}
+
+/*******************************************************************************
+* Function Name: roam_policy_associated
+********************************************************************************
+* Summary:
+*  Records a new association. The AP is added to the table and its RSSI
+*  restarts the smoothing of the link. A penalty of the AP is cleared, and
+*  the previous AP keeps the last RSSI of the link as its table entry. An
+*  association to another AP than the previous one is counted as a roam.
+*
+* Parameters:
+*  roam_policy_t *policy: Policy to update.
+*  const uint8_t *bssid: BSSID of the AP.
+*  uint8_t channel: Channel of the AP.
+*  int32_t rssi_dbm: RSSI of the AP.
+*  uint32_t now_ms: Current time.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void roam_policy_associated(roam_policy_t *policy, const uint8_t *bssid,
+        uint8_t channel, int32_t rssi_dbm, uint32_t now_ms)
+{
+    roam_candidate_t *entry;
+
+    /* The AP left behind is remembered with the last RSSI of the link */
+    if (policy->associated && !is_current(policy, bssid))
+    {
+        entry = find_entry(policy, policy->current);
+        if (NULL != entry)
+        {
+            entry->rssi_dbm = roam_policy_link_rssi(policy);
+            entry->seen_ms = now_ms;
+        }
+        policy->stats.roams++;
+    }
+
+    memcpy(policy->current, bssid, ROAM_BSSID_LEN);
+    policy->associated = true;
+    policy->link_rssi_q4 = rssi_dbm * LINK_RSSI_SCALE;
+    policy->assoc_ms = now_ms;
+
+    roam_policy_observe(policy, bssid, channel, rssi_dbm, now_ms);
+
+    entry = find_entry(policy, bssid);
+    if (NULL != entry)
+    {
+        entry->penalized = false;
+    }
+}
+
+/*******************************************************************************
+* Function Name: roam_policy_link_sample
+********************************************************************************
+* Summary:
+*  Adds an RSSI sample of the link to the smoothed value.
+*
+* Parameters:
+*  roam_policy_t *policy: Policy to update.
+*  int32_t rssi_dbm: RSSI of the link.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void roam_policy_link_sample(roam_policy_t *policy, int32_t rssi_dbm)
+{
+    policy->link_rssi_q4 += ((rssi_dbm * LINK_RSSI_SCALE) -
+            policy->link_rssi_q4) / (1 << LINK_RSSI_WEIGHT_SHIFT);
+    policy->stats.samples++;
+}
+
+/*******************************************************************************
+* Function Name: roam_policy_link_rssi
+********************************************************************************
+* Summary:
+*  Returns the smoothed RSSI of the link, in dBm.
+*
+* Parameters:
+*  const roam_policy_t *policy: Policy.
+*
+* Return:
+*  int32_t: RSSI in dBm.
+*
+*******************************************************************************/
+int32_t roam_policy_link_rssi(const roam_policy_t *policy)
+{
+    return policy->link_rssi_q4 / LINK_RSSI_SCALE;
+}
+
+/*******************************************************************************
+* Function Name: roam_policy_observe
+********************************************************************************
+* Summary:
+*  Adds an AP seen in a scan to the table, or refreshes its entry. The RSSI
+*  of a known AP is averaged with the previous observation.
+*
+* Parameters:
+*  roam_policy_t *policy: Policy to update.
+*  const uint8_t *bssid: BSSID of the AP.
+*  uint8_t channel: Channel of the AP.
+*  int32_t rssi_dbm: RSSI of the AP.
+*  uint32_t now_ms: Current time.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void roam_policy_observe(roam_policy_t *policy, const uint8_t *bssid,
+        uint8_t channel, int32_t rssi_dbm, uint32_t now_ms)
+{
+    roam_candidate_t *entry = find_slot(policy, bssid, now_ms);
+
+    if (NULL == entry)
+    {
+        return;
+    }
+
+    if (entry->used && (0 == memcmp(entry->bssid, bssid, ROAM_BSSID_LEN)))
+    {
+        entry->rssi_dbm = (entry->rssi_dbm + rssi_dbm) / 2;
+    }
+    else
+    {
+        memset(entry, 0, sizeof(roam_candidate_t));
+        memcpy(entry->bssid, bssid, ROAM_BSSID_LEN);
+        entry->used = true;
+        entry->rssi_dbm = rssi_dbm;
+    }
+
+    entry->channel = channel;
+    entry->seen_ms = now_ms;
+}
+
+/*******************************************************************************
+* Function Name: roam_policy_scan_started
+********************************************************************************
+* Summary:
+*  Records that a scan for candidates was started.
+*
+* Parameters:
+*  roam_policy_t *policy: Policy to update.
+*  uint32_t now_ms: Current time.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void roam_policy_scan_started(roam_policy_t *policy, uint32_t now_ms)
+{
+    policy->scan_ms = now_ms;
+    policy->scanned = true;
+    policy->stats.scans++;
+}
+
+/*******************************************************************************
+* Function Name: roam_policy_decide
+********************************************************************************
+* Summary:
+*  Decides what to do on a wake. Nothing is done while the smoothed RSSI of
+*  the link is at or above the scan threshold. Below it, the device roams to
+*  the strongest candidate if the link is also below the trigger threshold,
+*  the candidate is stronger than the link by the hysteresis margin, has been
+*  seen recently and is not penalized, and the device has stayed on the
+*  current AP for the minimum dwell time. Otherwise, a scan is requested if
+*  the last one is older than the scan interval.
+*
+* Parameters:
+*  roam_policy_t *policy: Policy.
+*  uint32_t now_ms: Current time.
+*  roam_candidate_t *target: Filled with the candidate for ROAM_ACTION_ROAM.
+*
+* Return:
+*  roam_action_t: Action to take.
+*
+*******************************************************************************/
+roam_action_t roam_policy_decide(roam_policy_t *policy, uint32_t now_ms,
+        roam_candidate_t *target)
+{
+    const roam_config_t *config = &policy->config;
+    const roam_candidate_t *best = NULL;
+    int32_t link = roam_policy_link_rssi(policy);
+
+    if (!policy->associated || (link >= config->scan_rssi_dbm))
+    {
+        return ROAM_ACTION_NONE;
+    }
+
+    for (uint32_t i = 0U; i < ROAM_TABLE_SIZE; i++)
+    {
+        roam_candidate_t *entry = &policy->table[i];
+
+        if (entry->penalized &&
+            ((now_ms - entry->penalty_ms) >= config->penalty_ms))
+        {
+            entry->penalized = false;
+        }
+
+        if (!entry->used || entry->penalized ||
+            is_current(policy, entry->bssid) ||
+            ((now_ms - entry->seen_ms) > config->max_age_ms))
+        {
+            continue;
+        }
+
+        if ((NULL == best) || (entry->rssi_dbm > best->rssi_dbm))
+        {
+            best = entry;
+        }
+    }
+
+    if ((link < config->trigger_rssi_dbm) && (NULL != best) &&
+        (best->rssi_dbm >= (link + (int32_t)config->hysteresis_db)) &&
+        ((now_ms - policy->assoc_ms) >= config->min_dwell_ms))
+    {
+        *target = *best;
+        return ROAM_ACTION_ROAM;
+    }
+
+    if (!policy->scanned ||
+        ((now_ms - policy->scan_ms) >= config->scan_interval_ms))
+    {
+        return ROAM_ACTION_SCAN;
+    }
+
+    return ROAM_ACTION_NONE;
+}
+
+/*******************************************************************************
+* Function Name: roam_policy_join_failed
+********************************************************************************
+* Summary:
+*  Penalizes a candidate the device could not join, so that it is skipped
+*  for the penalty time.
+*
+* Parameters:
+*  roam_policy_t *policy: Policy to update.
+*  const uint8_t *bssid: BSSID of the candidate.
+*  uint32_t now_ms: Current time.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void roam_policy_join_failed(roam_policy_t *policy, const uint8_t *bssid,
+        uint32_t now_ms)
+{
+    roam_candidate_t *entry = find_entry(policy, bssid);
+
+    if (NULL != entry)
+    {
+        entry->penalized = true;
+        entry->penalty_ms = now_ms;
+    }
+
+    policy->stats.failures++;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,145 @@
+/******************************************************************************
+* File Name: roam_policy.h
+*
+* Description: This file is the public interface of roam_policy.c. It contains
+* the cached table of candidate APs and the policy deciding when to collect
+* candidates and when to reassociate to a stronger AP of the same network.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef ROAM_POLICY_H_
+#define ROAM_POLICY_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+/* This module has no device dependencies so that it can also be built for the
+ * host machine and driven with synthetic RSSI traces.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+#define ROAM_TABLE_SIZE                 (8U)
+#define ROAM_BSSID_LEN                  (6U)
+
+/*******************************************************************************
+* Enumerations
+*******************************************************************************/
+typedef enum
+{
+    ROAM_ACTION_NONE = 0,
+    ROAM_ACTION_SCAN,               /* Refresh the candidate table */
+    ROAM_ACTION_ROAM                /* Reassociate to the returned candidate */
+} roam_action_t;
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    int32_t scan_rssi_dbm;          /* Collect candidates below this RSSI */
+    int32_t trigger_rssi_dbm;       /* Roam only below this RSSI */
+    uint32_t hysteresis_db;         /* Margin a candidate must exceed */
+    uint32_t scan_interval_ms;      /* Minimum time between two scans */
+    uint32_t max_age_ms;            /* Age after which a candidate is unused */
+    uint32_t min_dwell_ms;          /* Minimum time on an AP before roaming */
+    uint32_t penalty_ms;            /* Time a failed candidate is skipped */
+} roam_config_t;
+
+typedef struct
+{
+    uint8_t bssid[ROAM_BSSID_LEN];
+    uint8_t channel;
+    bool used;
+    int32_t rssi_dbm;
+    uint32_t seen_ms;
+    uint32_t penalty_ms;            /* Start of the penalty, if penalized */
+    bool penalized;
+} roam_candidate_t;
+
+typedef struct
+{
+    uint32_t samples;
+    uint32_t scans;
+    uint32_t roams;                 /* Associations to another AP */
+    uint32_t failures;              /* Candidates that could not be joined */
+} roam_stats_t;
+
+typedef struct
+{
+    roam_config_t config;
+    roam_candidate_t table[ROAM_TABLE_SIZE];
+    uint8_t current[ROAM_BSSID_LEN];
+    bool associated;
+    int32_t link_rssi_q4;           /* Smoothed RSSI of the link, dBm x 16 */
+    uint32_t assoc_ms;
+    uint32_t scan_ms;
+    bool scanned;
+    roam_stats_t stats;
+} roam_policy_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void roam_policy_init(roam_policy_t *policy, const roam_config_t *config);
+void roam_policy_associated(roam_policy_t *policy, const uint8_t *bssid,
+        uint8_t channel, int32_t rssi_dbm, uint32_t now_ms);
+void roam_policy_link_sample(roam_policy_t *policy, int32_t rssi_dbm);
+void roam_policy_observe(roam_policy_t *policy, const uint8_t *bssid,
+        uint8_t channel, int32_t rssi_dbm, uint32_t now_ms);
+void roam_policy_scan_started(roam_policy_t *policy, uint32_t now_ms);
+roam_action_t roam_policy_decide(roam_policy_t *policy, uint32_t now_ms,
+        roam_candidate_t *target);
+void roam_policy_join_failed(roam_policy_t *policy, const uint8_t *bssid,
+        uint32_t now_ms);
+int32_t roam_policy_link_rssi(const roam_policy_t *policy);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* ROAM_POLICY_H_ */
+
+
+/* [] END OF FILE */
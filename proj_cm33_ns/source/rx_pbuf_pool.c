@@ -0,0 +1,239 @@
+/*******************************************************************************
+* File Name:   rx_pbuf_pool.c
+*
+* Description: This file contains a fixed pool of receive buffers for the WLAN
+* frames. WHD receives frames from the SDIO bus directly into the pool buffers,
+* which are handed to lwIP as custom pbufs and returned to the pool when lwIP
+* frees them.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "rx_pbuf_pool.h"
+
+#include <stdbool.h>
+
+#include "cy_utils.h"
+
+#include "lowpower_task.h"
+
+/* WHD and lwIP header files */
+#include "cy_network_buffer.h"
+#include "lwip/pbuf.h"
+#include "lwip/sys.h"
+
+#if (RX_PBUF_POOL_ENABLE == 1U)
+
+#if !LWIP_SUPPORT_CUSTOM_PBUF
+#error "rx_pbuf_pool.c requires LWIP_SUPPORT_CUSTOM_PBUF"
+#endif
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* The pbuf is the first member so that a pbuf pointer freed by lwIP is also a
+ * pointer to its pool buffer.
+ */
+typedef struct
+{
+    struct pbuf_custom custom;
+    CY_ALIGN(RX_PBUF_POOL_ALIGNMENT) uint8_t payload[RX_PBUF_POOL_BUFFER_SIZE];
+} rx_pbuf_pool_buffer_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+/* Default WHD buffer allocator. The linker redirects the calls of WHD to
+ * __wrap_cy_host_buffer_get(), see LDFLAGS in the Makefile.
+ */
+whd_result_t __real_cy_host_buffer_get(whd_buffer_t *buffer,
+        whd_buffer_dir_t direction, uint16_t size, uint32_t timeout_ms);
+whd_result_t __wrap_cy_host_buffer_get(whd_buffer_t *buffer,
+        whd_buffer_dir_t direction, uint16_t size, uint32_t timeout_ms);
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static rx_pbuf_pool_buffer_t pool[RX_PBUF_POOL_COUNT];
+static rx_pbuf_pool_buffer_t *free_list[RX_PBUF_POOL_COUNT];
+static uint32_t free_count;
+static bool pool_ready;
+static rx_pbuf_pool_stats_t pool_stats;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: rx_pbuf_pool_free
+********************************************************************************
+* Summary:
+*  Custom free function of the pool pbufs. Called by pbuf_free() from WHD or
+*  from the lwIP thread when the last reference to the frame is dropped, and
+*  returns the buffer to the pool.
+*
+* Parameters:
+*  struct pbuf *p: pbuf of a pool buffer.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void rx_pbuf_pool_free(struct pbuf *p)
+{
+    SYS_ARCH_DECL_PROTECT(level);
+
+    SYS_ARCH_PROTECT(level);
+    free_list[free_count] = (rx_pbuf_pool_buffer_t *)p;
+    free_count++;
+    pool_stats.in_use--;
+    SYS_ARCH_UNPROTECT(level);
+}
+
+/*******************************************************************************
+* Function Name: rx_pbuf_pool_init
+********************************************************************************
+* Summary:
+*  Fills the pool and starts serving the receive buffers requested by WHD from
+*  it. Must be called before the WLAN device is initialized.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rx_pbuf_pool_init(void)
+{
+    for (uint32_t i = 0U; i < RX_PBUF_POOL_COUNT; i++)
+    {
+        pool[i].custom.custom_free_function = rx_pbuf_pool_free;
+        free_list[i] = &pool[i];
+    }
+
+    free_count = RX_PBUF_POOL_COUNT;
+    pool_ready = true;
+}
+
+/*******************************************************************************
+* Function Name: rx_pbuf_pool_get_stats
+********************************************************************************
+* Summary:
+*  Returns a copy of the pool counters.
+*
+* Parameters:
+*  rx_pbuf_pool_stats_t *stats: Filled with the counters.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rx_pbuf_pool_get_stats(rx_pbuf_pool_stats_t *stats)
+{
+    SYS_ARCH_DECL_PROTECT(level);
+
+    SYS_ARCH_PROTECT(level);
+    *stats = pool_stats;
+    SYS_ARCH_UNPROTECT(level);
+}
+
+/*******************************************************************************
+* Function Name: __wrap_cy_host_buffer_get
+********************************************************************************
+* Summary:
+*  Buffer allocator called by WHD in place of cy_host_buffer_get(). Receive
+*  buffers are taken from the pool so that the SDIO bus transfers the frame
+*  into a DMA-aligned buffer of whole blocks, and the frame is handed to lwIP
+*  in that same buffer. Transmit buffers, and receive buffers when the pool is
+*  not initialized, empty or too small for the frame, are obtained from the
+*  default allocator.
+*
+* Parameters:
+*  whd_buffer_t *buffer: Filled with the allocated pbuf.
+*  whd_buffer_dir_t direction: WHD_NETWORK_RX or WHD_NETWORK_TX.
+*  uint16_t size: Size of the frame, in bytes.
+*  uint32_t timeout_ms: Time to wait for a buffer from the default allocator.
+*
+* Return:
+*  whd_result_t: WHD_SUCCESS if a buffer was allocated.
+*
+*******************************************************************************/
+whd_result_t __wrap_cy_host_buffer_get(whd_buffer_t *buffer,
+        whd_buffer_dir_t direction, uint16_t size, uint32_t timeout_ms)
+{
+    rx_pbuf_pool_buffer_t *entry = NULL;
+    SYS_ARCH_DECL_PROTECT(level);
+
+    if ((WHD_NETWORK_RX != direction) || (!pool_ready))
+    {
+        return __real_cy_host_buffer_get(buffer, direction, size, timeout_ms);
+    }
+
+    SYS_ARCH_PROTECT(level);
+    if (size > RX_PBUF_POOL_BUFFER_SIZE)
+    {
+        pool_stats.oversized++;
+    }
+    else if (0U == free_count)
+    {
+        pool_stats.exhausted++;
+    }
+    else
+    {
+        free_count--;
+        entry = free_list[free_count];
+        pool_stats.pool_allocs++;
+        pool_stats.in_use++;
+        if (pool_stats.in_use > pool_stats.max_in_use)
+        {
+            pool_stats.max_in_use = pool_stats.in_use;
+        }
+    }
+    SYS_ARCH_UNPROTECT(level);
+
+    if (NULL == entry)
+    {
+        return __real_cy_host_buffer_get(buffer, direction, size, timeout_ms);
+    }
+
+    *buffer = (whd_buffer_t)pbuf_alloced_custom(PBUF_RAW, size, PBUF_REF,
+            &entry->custom, entry->payload, RX_PBUF_POOL_BUFFER_SIZE);
+
+    return WHD_SUCCESS;
+}
+
+#endif /* (RX_PBUF_POOL_ENABLE == 1U) */
+
+/* [] END OF FILE */
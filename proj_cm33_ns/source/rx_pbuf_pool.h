@@ -0,0 +1,109 @@
+/******************************************************************************
+* File Name: rx_pbuf_pool.h
+*
+* Description: This file is the public interface of rx_pbuf_pool.c, the pool of
+* DMA-aligned receive buffers that WHD receives WLAN frames into and that are
+* handed to lwIP as custom pbufs.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef RX_PBUF_POOL_H_
+#define RX_PBUF_POOL_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+/* Number of receive buffers in the pool */
+#define RX_PBUF_POOL_COUNT              (8U)
+
+/* Largest frame read from the WLAN device, including the SDPCM and bus
+ * headers that WHD strips before the frame is given to lwIP.
+ */
+#define RX_PBUF_POOL_FRAME_SIZE         (1600U)
+
+/* The SDIO bus transfers whole blocks, so every buffer is sized to a multiple
+ * of the block size configured by WHD and aligned for the SDHC DMA.
+ */
+#define RX_PBUF_POOL_SDIO_BLOCK_SIZE    (64U)
+#define RX_PBUF_POOL_ALIGNMENT          (32U)
+#define RX_PBUF_POOL_BUFFER_SIZE        \
+    (((RX_PBUF_POOL_FRAME_SIZE + RX_PBUF_POOL_SDIO_BLOCK_SIZE) - 1U) / \
+    RX_PBUF_POOL_SDIO_BLOCK_SIZE * RX_PBUF_POOL_SDIO_BLOCK_SIZE)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Counters of the pool since initialization */
+typedef struct
+{
+    /* Receive buffers allocated from the pool */
+    uint32_t pool_allocs;
+
+    /* Receive buffers obtained from the default WHD buffer allocator because
+     * the pool was empty or the frame did not fit in a pool buffer.
+     */
+    uint32_t exhausted;
+    uint32_t oversized;
+
+    /* Buffers currently held by WHD or lwIP, and the highest value seen */
+    uint32_t in_use;
+    uint32_t max_in_use;
+} rx_pbuf_pool_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void rx_pbuf_pool_init(void);
+void rx_pbuf_pool_get_stats(rx_pbuf_pool_stats_t *stats);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* RX_PBUF_POOL_H_ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,209 @@
+/*******************************************************************************
+* File Name:   sdhc_resume.c
+*
+* Description: This file contains the SDHC deep sleep callback with a retained-
+* state fast path. Once the SDIO bus is configured, the entries into deep sleep
+* save the register context of the controller and the exits restore it with
+* sdhc_retain.c. The generic callback of the PDL is used until then, whenever
+* the bus configuration changed, and when a restore cannot be verified.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "sdhc_resume.h"
+#include "sdhc_retain.h"
+
+#include "lowpower_task.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static sdhc_retain_t retain;
+static bool fast_path_ready;
+
+/* Set when the last entry into deep sleep used the fast path */
+static bool fast_path_entered;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: core_read
+********************************************************************************
+* Summary:
+*  Reads a register of the SDHC core.
+*******************************************************************************/
+static uint32_t core_read(void *regs, uint32_t offset, uint32_t width)
+{
+    uintptr_t addr = (uintptr_t)regs + offset;
+
+    switch (width)
+    {
+        case 1U:
+            return *(volatile uint8_t *)addr;
+        case 2U:
+            return *(volatile uint16_t *)addr;
+        default:
+            return *(volatile uint32_t *)addr;
+    }
+}
+
+/*******************************************************************************
+* Function Name: core_write
+********************************************************************************
+* Summary:
+*  Writes a register of the SDHC core.
+*******************************************************************************/
+static void core_write(void *regs, uint32_t offset, uint32_t width,
+        uint32_t value)
+{
+    uintptr_t addr = (uintptr_t)regs + offset;
+
+    switch (width)
+    {
+        case 1U:
+            *(volatile uint8_t *)addr = (uint8_t)value;
+            break;
+        case 2U:
+            *(volatile uint16_t *)addr = (uint16_t)value;
+            break;
+        default:
+            *(volatile uint32_t *)addr = value;
+            break;
+    }
+}
+
+/*******************************************************************************
+* Function Name: sdhc_resume_init
+********************************************************************************
+* Summary:
+*  Captures the bus configuration of the SD host and enables the fast path.
+*  Call it once the bus is configured for the WLAN device, after the bus
+*  profile is applied.
+*
+* Parameters:
+*  SDHC_Type *base: SD host instance.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void sdhc_resume_init(SDHC_Type *base)
+{
+    const sdhc_retain_io_t io =
+    {
+        .read   = core_read,
+        .write  = core_write,
+        .regs   = (void *)&base->CORE
+    };
+
+    sdhc_retain_init(&retain, &io);
+    sdhc_retain_capture_bus(&retain);
+    fast_path_ready = true;
+}
+
+/*******************************************************************************
+* Function Name: sdhc_resume_callback
+********************************************************************************
+* Summary:
+*  SDHC deep sleep callback. CHECK_READY and CHECK_FAIL are handled by the
+*  generic callback, which checks that the bus is idle. BEFORE_TRANSITION
+*  saves the register context and stops the SD clock, and AFTER_TRANSITION
+*  restores the context and restarts the SD clock, unless the fast path is
+*  not ready or the card state is not known good.
+*
+* Parameters:
+*  cy_stc_syspm_callback_params_t *callback_params: SysPm callback parameters.
+*  cy_en_syspm_callback_mode_t mode: SysPm callback mode.
+*
+* Return:
+*  cy_en_syspm_status_t: Result of the callback.
+*
+*******************************************************************************/
+cy_en_syspm_status_t sdhc_resume_callback(
+        cy_stc_syspm_callback_params_t *callback_params,
+        cy_en_syspm_callback_mode_t mode)
+{
+    if (CY_SYSPM_BEFORE_TRANSITION == mode)
+    {
+        fast_path_entered = fast_path_ready && sdhc_retain_save(&retain);
+        if (fast_path_entered)
+        {
+            return CY_SYSPM_SUCCESS;
+        }
+    }
+    else if ((CY_SYSPM_AFTER_TRANSITION == mode) && fast_path_entered)
+    {
+        fast_path_entered = false;
+        if (sdhc_retain_restore(&retain))
+        {
+            return CY_SYSPM_SUCCESS;
+        }
+    }
+    else
+    {
+        /* CHECK_READY and CHECK_FAIL, or an exit without the fast path */
+    }
+
+    return Cy_SD_Host_DeepSleepCallback(callback_params, mode);
+}
+
+/*******************************************************************************
+* Function Name: sdhc_resume_report
+********************************************************************************
+* Summary:
+*  Prints the counters of the fast path.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void sdhc_resume_report(void)
+{
+    APP_INFO(("SDHC fast resume: %lu resumes (%lu fully retained), %lu "
+            "registers restored, %lu writes, %lu bus changes, %lu fallbacks\n",
+            (unsigned long)retain.stats.fast_resumes,
+            (unsigned long)retain.stats.retained,
+            (unsigned long)retain.stats.lost_regs,
+            (unsigned long)retain.stats.writes,
+            (unsigned long)retain.stats.bus_changed,
+            (unsigned long)retain.stats.failures));
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,280 @@
+/*******************************************************************************
+* File Name:   sdhc_retain.c
+*
+* Description: This file contains the retained-state fast path of the SD host
+* controller deep sleep callback. The register context is saved before deep
+* sleep and, after wakeup, only the registers that lost their value are written
+* back before the SD clock is restarted. The card is not re-initialized, since
+* the WLAN device keeps its SDIO state while the host sleeps.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "sdhc_retain.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Index of the clock control register, restored last */
+#define CLK_INDEX                       (SDHC_RETAIN_REG_COUNT - 1U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    uint8_t offset;
+    uint8_t width;
+    uint16_t mask;              /* Bits saved and restored */
+    bool bus;                   /* Part of the bus configuration */
+} sdhc_reg_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Saved context, in restore order: bus power and bus configuration first,
+ * then timeouts, block size and interrupt enables, and the clock last so
+ * that the SD clock only runs once the bus is set up. Read-only, self-
+ * clearing and reserved bits are left out of the masks, and so is the SD
+ * clock enable, which is saved cleared and set after the restore.
+ */
+static const sdhc_reg_t sdhc_regs[SDHC_RETAIN_REG_COUNT] =
+{
+    { SDHC_REG_PWR_CTRL,            1U, 0x00FFU, true  },
+    { SDHC_REG_HOST_CTRL1,          1U, 0x00FFU, true  },
+    { SDHC_REG_HOST_CTRL2,          2U, 0xFFBFU, true  },
+    { SDHC_REG_TOUT_CTRL,           1U, 0x000FU, false },
+    { SDHC_REG_WUP_CTRL,            1U, 0x0007U, false },
+    { SDHC_REG_BLOCKSIZE,           2U, 0x7FFFU, false },
+    { SDHC_REG_NORMAL_INT_STAT_EN,  2U, 0x7FFFU, false },
+    { SDHC_REG_ERROR_INT_STAT_EN,   2U, 0xFFFFU, false },
+    { SDHC_REG_NORMAL_INT_SIGNAL_EN, 2U, 0x7FFFU, false },
+    { SDHC_REG_ERROR_INT_SIGNAL_EN, 2U, 0xFFFFU, false },
+    { SDHC_REG_CLK_CTRL,            2U, 0xFFE9U, true  }
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: read_reg
+********************************************************************************
+* Summary:
+*  Returns the saved bits of a register of the context.
+*******************************************************************************/
+static uint32_t read_reg(const sdhc_retain_t *retain, uint32_t index)
+{
+    return retain->io.read(retain->io.regs, sdhc_regs[index].offset,
+            sdhc_regs[index].width) & sdhc_regs[index].mask;
+}
+
+/*******************************************************************************
+* Function Name: write_reg
+********************************************************************************
+* Summary:
+*  Writes a register of the context.
+*******************************************************************************/
+static void write_reg(sdhc_retain_t *retain, uint32_t index, uint32_t value)
+{
+    retain->io.write(retain->io.regs, sdhc_regs[index].offset,
+            sdhc_regs[index].width, value);
+    retain->stats.writes++;
+}
+
+/*******************************************************************************
+* Function Name: sdhc_retain_init
+********************************************************************************
+* Summary:
+*  Initializes the fast path with no bus configuration captured, so that
+*  every transition uses the generic callback until
+*  sdhc_retain_capture_bus() is called.
+*
+* Parameters:
+*  sdhc_retain_t *retain: Fast path state to initialize.
+*  const sdhc_retain_io_t *io: Access to the SDHC core registers.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void sdhc_retain_init(sdhc_retain_t *retain, const sdhc_retain_io_t *io)
+{
+    memset(retain, 0, sizeof(sdhc_retain_t));
+    retain->io = *io;
+}
+
+/*******************************************************************************
+* Function Name: sdhc_retain_capture_bus
+********************************************************************************
+* Summary:
+*  Captures the bus configuration negotiated with the card: bus power, bus
+*  width, speed mode and clock divider. The card state is known good as long
+*  as the controller is still configured this way when entering deep sleep.
+*  Call it again after every reconfiguration of the bus.
+*
+* Parameters:
+*  sdhc_retain_t *retain: Fast path state.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void sdhc_retain_capture_bus(sdhc_retain_t *retain)
+{
+    for (uint32_t i = 0U; i < SDHC_RETAIN_REG_COUNT; i++)
+    {
+        retain->bus[i] = sdhc_regs[i].bus ? read_reg(retain, i) : 0U;
+    }
+
+    retain->bus_valid = true;
+}
+
+/*******************************************************************************
+* Function Name: sdhc_retain_save
+********************************************************************************
+* Summary:
+*  Saves the register context and stops the SD clock. Called before deep
+*  sleep. The context is only saved if the bus configuration still matches
+*  the captured one; otherwise the card state is unknown and the caller must
+*  use the generic callback for this transition.
+*
+* Parameters:
+*  sdhc_retain_t *retain: Fast path state.
+*
+* Return:
+*  bool: true if the context was saved and the SD clock stopped.
+*
+*******************************************************************************/
+bool sdhc_retain_save(sdhc_retain_t *retain)
+{
+    bool known_good = retain->bus_valid;
+
+    for (uint32_t i = 0U; i < SDHC_RETAIN_REG_COUNT; i++)
+    {
+        retain->saved[i] = read_reg(retain, i);
+    }
+
+    for (uint32_t i = 0U; known_good && (i < SDHC_RETAIN_REG_COUNT); i++)
+    {
+        known_good = !sdhc_regs[i].bus || (retain->saved[i] == retain->bus[i]);
+    }
+
+    retain->saved_valid = known_good;
+    if (!known_good)
+    {
+        retain->stats.bus_changed += retain->bus_valid ? 1U : 0U;
+        return false;
+    }
+
+    write_reg(retain, CLK_INDEX, retain->saved[CLK_INDEX]);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: sdhc_retain_restore
+********************************************************************************
+* Summary:
+*  Restores the context saved by sdhc_retain_save() and restarts the SD clock.
+*  Called after deep sleep. Only the registers whose value differs from the
+*  saved one are written; when the controller retained its state, the only
+*  write is the one starting the SD clock. The SD clock is started as soon as
+*  the internal clock reports stable, instead of after a fixed delay. The
+*  registers are read back before returning.
+*
+* Parameters:
+*  sdhc_retain_t *retain: Fast path state.
+*
+* Return:
+*  bool: false if no context was saved, if the internal clock did not
+*   stabilize or if a register did not keep the restored value. The caller
+*   must then fall back to the generic callback.
+*
+*******************************************************************************/
+bool sdhc_retain_restore(sdhc_retain_t *retain)
+{
+    uint32_t lost = 0U;
+    uint32_t clk;
+    uint32_t polls = 0U;
+
+    if (!retain->saved_valid)
+    {
+        return false;
+    }
+    retain->saved_valid = false;
+
+    for (uint32_t i = 0U; i < SDHC_RETAIN_REG_COUNT; i++)
+    {
+        if (read_reg(retain, i) != retain->saved[i])
+        {
+            write_reg(retain, i, retain->saved[i]);
+            lost++;
+        }
+    }
+
+    clk = retain->io.read(retain->io.regs, SDHC_REG_CLK_CTRL, 2U);
+    while (0U == (clk & SDHC_CLK_CTRL_INTERNAL_STABLE))
+    {
+        if (++polls >= SDHC_RETAIN_STABLE_POLLS)
+        {
+            retain->stats.failures++;
+            return false;
+        }
+        clk = retain->io.read(retain->io.regs, SDHC_REG_CLK_CTRL, 2U);
+    }
+
+    for (uint32_t i = 0U; i < SDHC_RETAIN_REG_COUNT; i++)
+    {
+        if (read_reg(retain, i) != retain->saved[i])
+        {
+            retain->stats.failures++;
+            return false;
+        }
+    }
+
+    write_reg(retain, CLK_INDEX,
+            retain->saved[CLK_INDEX] | SDHC_CLK_CTRL_SD_CLK_EN);
+
+    retain->stats.fast_resumes++;
+    retain->stats.retained += (0U == lost) ? 1U : 0U;
+    retain->stats.lost_regs += lost;
+
+    return true;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,137 @@
+/******************************************************************************
+* File Name: sdhc_retain.h
+*
+* Description: This file is the public interface of sdhc_retain.c, which saves
+* the register context of the SD host controller before deep sleep and restores
+* it with the fewest register writes after wakeup.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef SDHC_RETAIN_H_
+#define SDHC_RETAIN_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+/* This module has no device dependencies so that it can also be built for the
+ * host machine and checked against a fake register file.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+/* Offsets of the registers of the SD Host Controller Standard register set,
+ * relative to the SDHC core.
+ */
+#define SDHC_REG_BLOCKSIZE              (0x04U)
+#define SDHC_REG_HOST_CTRL1             (0x28U)
+#define SDHC_REG_PWR_CTRL               (0x29U)
+#define SDHC_REG_WUP_CTRL               (0x2BU)
+#define SDHC_REG_CLK_CTRL               (0x2CU)
+#define SDHC_REG_TOUT_CTRL              (0x2EU)
+#define SDHC_REG_NORMAL_INT_STAT_EN     (0x34U)
+#define SDHC_REG_ERROR_INT_STAT_EN      (0x36U)
+#define SDHC_REG_NORMAL_INT_SIGNAL_EN   (0x38U)
+#define SDHC_REG_ERROR_INT_SIGNAL_EN    (0x3AU)
+#define SDHC_REG_HOST_CTRL2             (0x3EU)
+
+/* Bits of the clock control register */
+#define SDHC_CLK_CTRL_INTERNAL_CLK_EN   (0x0001U)
+#define SDHC_CLK_CTRL_INTERNAL_STABLE   (0x0002U)
+#define SDHC_CLK_CTRL_SD_CLK_EN         (0x0004U)
+
+/* Number of registers in the saved context */
+#define SDHC_RETAIN_REG_COUNT           (11U)
+
+/* Reads of the clock control register after which the internal clock is
+ * considered unable to stabilize.
+ */
+#define SDHC_RETAIN_STABLE_POLLS        (10000U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Access to the registers of the SDHC core. width is 1, 2 or 4 bytes. */
+typedef struct
+{
+    uint32_t (*read)(void *regs, uint32_t offset, uint32_t width);
+    void (*write)(void *regs, uint32_t offset, uint32_t width, uint32_t value);
+    void *regs;
+} sdhc_retain_io_t;
+
+typedef struct
+{
+    uint32_t fast_resumes;      /* Resumes restored by the fast path */
+    uint32_t retained;          /* ... with every register retained */
+    uint32_t lost_regs;         /* Registers found changed after wakeup */
+    uint32_t writes;            /* Register writes by the fast path */
+    uint32_t bus_changed;       /* Entries where the bus was reconfigured */
+    uint32_t failures;          /* Restores that could not be verified */
+} sdhc_retain_stats_t;
+
+typedef struct
+{
+    sdhc_retain_io_t io;
+    uint32_t bus[SDHC_RETAIN_REG_COUNT];
+    uint32_t saved[SDHC_RETAIN_REG_COUNT];
+    bool bus_valid;
+    bool saved_valid;
+    sdhc_retain_stats_t stats;
+} sdhc_retain_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void sdhc_retain_init(sdhc_retain_t *retain, const sdhc_retain_io_t *io);
+void sdhc_retain_capture_bus(sdhc_retain_t *retain);
+bool sdhc_retain_save(sdhc_retain_t *retain);
+bool sdhc_retain_restore(sdhc_retain_t *retain);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SDHC_RETAIN_H_ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,212 @@
+/*******************************************************************************
+* File Name:   sdio_bench.c
+*
+* Description: This file contains the SDIO bus benchmark. For every SDIO bus
+* profile, it times CMD52 register reads and CMD53 block reads of the function 0
+* CIS area of the WLAN device, and prints the per-transfer latency and the
+* throughput. Reading the CIS area has no side effect on the WLAN device.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "sdio_bench.h"
+
+#include "lowpower_task.h"
+#include "app_timestamp.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Start of the CIS area of function 0 */
+#define SDIO_CIS_START_ADDRESS          (0x1000U)
+
+/* Fields of the CMD53 (IO_RW_EXTENDED) argument */
+#define SDIO_CMD53_BLOCK_MODE           (1UL << 27U)
+#define SDIO_CMD53_INCREMENT_ADDRESS    (1UL << 26U)
+#define SDIO_CMD53_ADDRESS_POS          (9U)
+
+#define SDIO_CCCR_REVISION              (0x00U)
+#define KBYTES_PER_SEC_SCALE            (1000U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Sizes of the CMD53 transfers measured, in bytes */
+static const uint16_t bench_transfer_sizes[] = { 64U, 512U, 2048U };
+
+static uint32_t bench_buffer[SDIO_BENCH_MAX_TRANSFER / sizeof(uint32_t)];
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: bench_report
+********************************************************************************
+* Summary:
+*  Prints the average latency of a transfer and the throughput.
+*******************************************************************************/
+static void bench_report(const char *transfer, uint32_t bytes,
+        uint32_t elapsed_us)
+{
+    uint32_t latency_us = elapsed_us / SDIO_BENCH_ITERATIONS;
+    uint32_t kbytes_per_sec = (0U == elapsed_us) ? 0U :
+            (uint32_t)(((uint64_t)bytes * SDIO_BENCH_ITERATIONS *
+            KBYTES_PER_SEC_SCALE) / elapsed_us);
+
+    APP_INFO(("  %s %lu bytes: %lu us per transfer, %lu kB/s\n", transfer,
+            (unsigned long)bytes, (unsigned long)latency_us,
+            (unsigned long)kbytes_per_sec));
+}
+
+/*******************************************************************************
+* Function Name: bench_cmd52
+********************************************************************************
+* Summary:
+*  Times CMD52 reads of the CCCR revision register.
+*******************************************************************************/
+static void bench_cmd52(mtb_hal_sdio_t *sdio)
+{
+    uint8_t value;
+    uint32_t start = app_timestamp_ticks();
+
+    for (uint32_t i = 0U; i < SDIO_BENCH_ITERATIONS; i++)
+    {
+        if (!sdio_cmd52(sdio, false, 0U, SDIO_CCCR_REVISION, &value))
+        {
+            ERR_INFO(("  CMD52 read failed.\n"));
+            return;
+        }
+    }
+
+    bench_report("CMD52", 1U,
+            app_timestamp_ticks_to_us(app_timestamp_ticks() - start));
+}
+
+/*******************************************************************************
+* Function Name: bench_cmd53
+********************************************************************************
+* Summary:
+*  Times CMD53 block reads of the function 0 CIS area.
+*******************************************************************************/
+static void bench_cmd53(mtb_hal_sdio_t *sdio, uint16_t size,
+        uint16_t block_size)
+{
+    uint32_t response;
+    uint32_t argument = SDIO_CMD53_BLOCK_MODE | SDIO_CMD53_INCREMENT_ADDRESS |
+            (SDIO_CIS_START_ADDRESS << SDIO_CMD53_ADDRESS_POS) |
+            (uint32_t)(size / block_size);
+    uint32_t start = app_timestamp_ticks();
+
+    for (uint32_t i = 0U; i < SDIO_BENCH_ITERATIONS; i++)
+    {
+        if (CY_RSLT_SUCCESS != mtb_hal_sdio_bulk_transfer(sdio,
+                MTB_HAL_SDIO_XFER_TYPE_READ, argument, bench_buffer, size,
+                &response))
+        {
+            ERR_INFO(("  CMD53 read of %u bytes failed.\n", (unsigned int)size));
+            return;
+        }
+    }
+
+    bench_report("CMD53", size,
+            app_timestamp_ticks_to_us(app_timestamp_ticks() - start));
+}
+
+/*******************************************************************************
+* Function Name: sdio_bench_run
+********************************************************************************
+* Summary:
+*  Measures every SDIO bus profile supported by the WLAN device, then
+*  applies the given profile again. The default speed profile is measured
+*  first, on the bus as configured by WHD, so it must be called before the
+*  bus profile is selected. The other profiles are applied before they are
+*  measured, and the given profile is applied at the end even when it is the
+*  default speed one, since the bus was switched away from it. Must be called
+*  after the WLAN device is initialized and before it is connected, while the
+*  bus is idle. The host wake interrupt is masked during the measurement so
+*  that WHD does not access the bus.
+*
+* Parameters:
+*  mtb_hal_sdio_t *sdio: SDIO HAL object.
+*  SDHC_Type *base: SD host instance.
+*  sdio_profile_id_t restore: Profile to apply after the measurement.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void sdio_bench_run(mtb_hal_sdio_t *sdio, SDHC_Type *base,
+        sdio_profile_id_t restore)
+{
+    sdio_profile_id_t applied;
+
+    NVIC_DisableIRQ(CYBSP_WIFI_HOST_WAKE_IRQ);
+
+    for (uint32_t id = 0U; id < (uint32_t)SDIO_PROFILE_COUNT; id++)
+    {
+        /* WHD brings the bus up at default speed */
+        applied = ((uint32_t)SDIO_PROFILE_DEFAULT_SPEED == id) ?
+                SDIO_PROFILE_DEFAULT_SPEED :
+                sdio_profile_apply(sdio, base, (sdio_profile_id_t)id);
+
+        if ((uint32_t)applied != id)
+        {
+            APP_INFO(("SDIO profile '%s' is not supported.\n",
+                    sdio_profiles[id].name));
+            continue;
+        }
+
+        APP_INFO(("SDIO profile '%s' (%lu Hz, %u-byte blocks):\n",
+                sdio_profiles[id].name,
+                (unsigned long)sdio_profiles[id].frequency_hz,
+                (unsigned int)sdio_profiles[id].block_size));
+
+        bench_cmd52(sdio);
+
+        for (uint32_t i = 0U; i < (sizeof(bench_transfer_sizes) /
+                sizeof(bench_transfer_sizes[0])); i++)
+        {
+            bench_cmd53(sdio, bench_transfer_sizes[i],
+                    sdio_profiles[id].block_size);
+        }
+    }
+
+    (void)sdio_profile_apply(sdio, base, restore);
+
+    NVIC_EnableIRQ(CYBSP_WIFI_HOST_WAKE_IRQ);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,78 @@
+/******************************************************************************
+* File Name: sdio_bench.h
+*
+* Description: This file is the public interface of sdio_bench.c. It contains
+* the function that measures the SDIO bus throughput and the per-transfer
+* latency for every SDIO bus profile.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef SDIO_BENCH_H_
+#define SDIO_BENCH_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+#include "sdio_profile.h"
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+/* Number of transfers of each size timed for every profile */
+#define SDIO_BENCH_ITERATIONS           (200U)
+
+/* Largest CMD53 transfer measured, in bytes */
+#define SDIO_BENCH_MAX_TRANSFER         (2048U)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void sdio_bench_run(mtb_hal_sdio_t *sdio, SDHC_Type *base,
+        sdio_profile_id_t restore);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SDIO_BENCH_H_ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,222 @@
+/*******************************************************************************
+* File Name:   sdio_profile.c
+*
+* Description: This file contains the SDIO bus profiles and their negotiation
+* with the WLAN device. High speed is only enabled if the device reports support
+* for it in its CCCR, otherwise the default speed profile is used.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "sdio_profile.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* WHD configures the function block sizes of the WLAN device to 64 bytes, so
+ * the host block size is kept at 64 bytes in all the profiles.
+ */
+const sdio_profile_t sdio_profiles[SDIO_PROFILE_COUNT] =
+{
+    [SDIO_PROFILE_DEFAULT_SPEED] =
+    {
+        .name           = "default speed",
+        .frequency_hz   = 25000000U,
+        .block_size     = 64U,
+        .high_speed     = false
+    },
+    [SDIO_PROFILE_HIGH_SPEED] =
+    {
+        .name           = "high speed",
+        .frequency_hz   = 50000000U,
+        .block_size     = 64U,
+        .high_speed     = true
+    }
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: sdio_cmd52
+********************************************************************************
+* Summary:
+*  Reads or writes one register of the WLAN device with CMD52.
+*
+* Parameters:
+*  mtb_hal_sdio_t *sdio: SDIO HAL object.
+*  bool write: true to write *data, false to read into *data.
+*  uint32_t function: SDIO function number.
+*  uint32_t address: Register address.
+*  uint8_t *data: Value to write, or value read.
+*
+* Return:
+*  bool: true if the command succeeded and its response has no error flag.
+*
+*******************************************************************************/
+bool sdio_cmd52(mtb_hal_sdio_t *sdio, bool write, uint32_t function,
+        uint32_t address, uint8_t *data)
+{
+    uint32_t response = 0U;
+    uint32_t argument = (function << SDIO_CMD52_FUNCTION_POS) |
+            (address << SDIO_CMD52_ADDRESS_POS);
+    cy_rslt_t result;
+
+    if (write)
+    {
+        argument |= SDIO_CMD52_WRITE | *data;
+    }
+
+    result = mtb_hal_sdio_send_cmd(sdio,
+            write ? MTB_HAL_SDIO_XFER_TYPE_WRITE : MTB_HAL_SDIO_XFER_TYPE_READ,
+            MTB_HAL_SDIO_CMD_IO_RW_DIRECT, argument, &response);
+
+    *data = (uint8_t)(response & SDIO_CMD52_DATA_MASK);
+
+    return (CY_RSLT_SUCCESS == result) &&
+           (0U == (response & SDIO_R5_ERROR_MASK));
+}
+
+/*******************************************************************************
+* Function Name: sdio_profile_apply
+********************************************************************************
+* Summary:
+*  Switches the WLAN device and the SD host to a bus profile. For a
+*  high-speed profile, the high-speed support bit of the CCCR is checked and
+*  the device is switched before the clock is raised. If the device does not
+*  support high speed, or if the switch fails, the default speed profile is
+*  applied instead. Must be called after the WLAN device is initialized and
+*  while WHD does not access the bus; see sdio_profile_select().
+*
+* Parameters:
+*  mtb_hal_sdio_t *sdio: SDIO HAL object.
+*  SDHC_Type *base: SD host instance.
+*  sdio_profile_id_t requested: Profile to apply.
+*
+* Return:
+*  sdio_profile_id_t: Profile applied.
+*
+*******************************************************************************/
+sdio_profile_id_t sdio_profile_apply(mtb_hal_sdio_t *sdio, SDHC_Type *base,
+        sdio_profile_id_t requested)
+{
+    const sdio_profile_t *profile;
+    mtb_hal_sdio_cfg_t sdio_hal_cfg;
+    uint8_t speed = 0U;
+    bool high_speed = false;
+
+    if (requested >= SDIO_PROFILE_COUNT)
+    {
+        requested = SDIO_PROFILE_DEFAULT_SPEED;
+    }
+
+    if (sdio_cmd52(sdio, false, 0U, SDIO_CCCR_BUS_SPEED_SELECT, &speed))
+    {
+        if (sdio_profiles[requested].high_speed &&
+            (0U != (speed & SDIO_CCCR_SUPPORT_HIGH_SPEED)))
+        {
+            speed |= SDIO_CCCR_ENABLE_HIGH_SPEED;
+        }
+        else
+        {
+            speed &= (uint8_t)~SDIO_CCCR_ENABLE_HIGH_SPEED;
+        }
+
+        /* Switch the device first, the host is switched once the device
+         * has acknowledged the new speed.
+         */
+        if (sdio_cmd52(sdio, true, 0U, SDIO_CCCR_BUS_SPEED_SELECT, &speed) &&
+            sdio_cmd52(sdio, false, 0U, SDIO_CCCR_BUS_SPEED_SELECT, &speed))
+        {
+            high_speed = (0U != (speed & SDIO_CCCR_ENABLE_HIGH_SPEED));
+        }
+    }
+
+    if (sdio_profiles[requested].high_speed && !high_speed)
+    {
+        requested = SDIO_PROFILE_DEFAULT_SPEED;
+    }
+
+    profile = &sdio_profiles[requested];
+
+    (void)Cy_SD_Host_SetHostSpeedMode(base, high_speed ?
+            CY_SD_HOST_BUS_SPEED_HIGHSPEED : CY_SD_HOST_BUS_SPEED_DEFAULT);
+
+    sdio_hal_cfg.frequencyhal_hz = profile->frequency_hz;
+    sdio_hal_cfg.block_size = profile->block_size;
+    (void)mtb_hal_sdio_configure(sdio, &sdio_hal_cfg);
+
+    return requested;
+}
+
+/*******************************************************************************
+* Function Name: sdio_profile_select
+********************************************************************************
+* Summary:
+*  Applies the bus profile selected for the application. WHD brings the bus
+*  up at default speed, so the default speed profile leaves the device and
+*  the host untouched. Another profile is applied with the host wake
+*  interrupt masked: WHD only accesses the bus on a host wake or an API call,
+*  so it must be called before any other WHD API call, in particular before
+*  connecting.
+*
+* Parameters:
+*  mtb_hal_sdio_t *sdio: SDIO HAL object.
+*  SDHC_Type *base: SD host instance.
+*  sdio_profile_id_t requested: Profile to apply.
+*
+* Return:
+*  sdio_profile_id_t: Profile in use.
+*
+*******************************************************************************/
+sdio_profile_id_t sdio_profile_select(mtb_hal_sdio_t *sdio, SDHC_Type *base,
+        sdio_profile_id_t requested)
+{
+    sdio_profile_id_t applied;
+
+    if (SDIO_PROFILE_DEFAULT_SPEED == requested)
+    {
+        return SDIO_PROFILE_DEFAULT_SPEED;
+    }
+
+    NVIC_DisableIRQ(CYBSP_WIFI_HOST_WAKE_IRQ);
+    applied = sdio_profile_apply(sdio, base, requested);
+    NVIC_EnableIRQ(CYBSP_WIFI_HOST_WAKE_IRQ);
+
+    return applied;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,117 @@
+/******************************************************************************
+* File Name: sdio_profile.h
+*
+* Description: This file is the public interface of sdio_profile.c. It contains
+* the SDIO bus profiles (bus speed, clock frequency and block size) and the
+* function that negotiates a profile with the WLAN device.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef SDIO_PROFILE_H_
+#define SDIO_PROFILE_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+#include "cybsp.h"
+#include "mtb_hal.h"
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+/* SDIO CCCR registers and bits used to negotiate the bus speed */
+#define SDIO_CCCR_BUS_SPEED_SELECT      (0x13U)
+#define SDIO_CCCR_SUPPORT_HIGH_SPEED    (0x01U)
+#define SDIO_CCCR_ENABLE_HIGH_SPEED     (0x02U)
+
+/* Fields of the CMD52 (IO_RW_DIRECT) argument */
+#define SDIO_CMD52_WRITE                (1UL << 31U)
+#define SDIO_CMD52_FUNCTION_POS         (28U)
+#define SDIO_CMD52_ADDRESS_POS          (9U)
+#define SDIO_CMD52_DATA_MASK            (0xFFU)
+
+/* Error flags of the R5 response */
+#define SDIO_R5_ERROR_MASK              (0xCB00UL)
+
+/*******************************************************************************
+* Enumerations
+*******************************************************************************/
+typedef enum
+{
+    SDIO_PROFILE_DEFAULT_SPEED = 0,     /* 25 MHz, 64-byte blocks */
+    SDIO_PROFILE_HIGH_SPEED,            /* 50 MHz, 64-byte blocks */
+    SDIO_PROFILE_COUNT
+} sdio_profile_id_t;
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    const char *name;
+    uint32_t frequency_hz;
+    uint16_t block_size;
+    bool high_speed;                    /* Requires CCCR high-speed support */
+} sdio_profile_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern const sdio_profile_t sdio_profiles[SDIO_PROFILE_COUNT];
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool sdio_cmd52(mtb_hal_sdio_t *sdio, bool write, uint32_t function,
+        uint32_t address, uint8_t *data);
+sdio_profile_id_t sdio_profile_apply(mtb_hal_sdio_t *sdio, SDHC_Type *base,
+        sdio_profile_id_t requested);
+sdio_profile_id_t sdio_profile_select(mtb_hal_sdio_t *sdio, SDHC_Type *base,
+        sdio_profile_id_t requested);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SDIO_PROFILE_H_ */
+
+
+/* [] END OF FILE */
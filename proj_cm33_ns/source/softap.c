@@ -0,0 +1,414 @@
+/*******************************************************************************
+* File Name:   softap.c
+*
+* Description: This file contains the SoftAP component. The SoftAP runs
+* alongside the STA link on its channel, with a tuned beacon interval, and is
+* torn down once it has been left without clients for the idle timeout. While a
+* client is associated, the network stack is suspended after a longer inactivity
+* window.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "softap.h"
+
+#include "lowpower_task.h"
+
+/* FreeRTOS header files */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Network activity notification */
+#include "network_activity_handler.h"
+
+/* WHD header file */
+#include "whd_wifi_api.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define MAX_2_4GHZ_CHANNEL              (14U)
+
+#define TICKS_TO_MS(ticks)              ((uint32_t)((ticks) * \
+                                         portTICK_PERIOD_MS))
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Shared between the low power task and the WCM worker thread, which
+ * delivers the client events.
+ */
+static softap_policy_t policy;
+static uint8_t softap_channel;
+
+static const softap_policy_config_t softap_config =
+{
+    .idle_timeout_ms    = SOFTAP_IDLE_TIMEOUT_MS
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: now_ms
+********************************************************************************
+* Summary:
+*  Returns the time since the scheduler started, in milliseconds.
+*******************************************************************************/
+static uint32_t now_ms(void)
+{
+    return TICKS_TO_MS(xTaskGetTickCount());
+}
+
+/*******************************************************************************
+* Function Name: softap_event_callback
+********************************************************************************
+* Summary:
+*  Counts the clients associated to the SoftAP and signals network activity,
+*  so that the low power task reevaluates the inactivity window and the idle
+*  timeout. Runs in the context of the WCM worker thread.
+*******************************************************************************/
+static void softap_event_callback(cy_wcm_event_t event,
+        cy_wcm_event_data_t *event_data)
+{
+    CY_UNUSED_PARAMETER(event_data);
+
+    if (CY_WCM_EVENT_STA_JOINED_SOFTAP == event)
+    {
+        taskENTER_CRITICAL();
+        softap_policy_client_joined(&policy);
+        taskEXIT_CRITICAL();
+        cy_network_activity_notify(CY_NETWORK_ACTIVITY_TX);
+    }
+    else if (CY_WCM_EVENT_STA_LEFT_SOFTAP == event)
+    {
+        taskENTER_CRITICAL();
+        softap_policy_client_left(&policy, now_ms());
+        taskEXIT_CRITICAL();
+        cy_network_activity_notify(CY_NETWORK_ACTIVITY_TX);
+    }
+    else
+    {
+        /* Events of the STA interface */
+    }
+}
+
+/*******************************************************************************
+* Function Name: start_ap
+********************************************************************************
+* Summary:
+*  Starts the SoftAP on the channel of the STA link.
+*******************************************************************************/
+static void start_ap(void)
+{
+    cy_rslt_t result;
+    cy_wcm_ap_config_t ap_config;
+    cy_wcm_associated_ap_info_t ap_info;
+    whd_interface_t ifp = NULL;
+
+    softap_channel = SOFTAP_DEFAULT_CHANNEL;
+    if (cy_wcm_is_connected_to_ap() &&
+            (CY_RSLT_SUCCESS == cy_wcm_get_associated_ap_info(&ap_info)))
+    {
+        softap_channel = ap_info.channel;
+    }
+
+    memset(&ap_config, 0, sizeof(ap_config));
+    memcpy(ap_config.ap_credentials.SSID, SOFTAP_SSID, sizeof(SOFTAP_SSID));
+    memcpy(ap_config.ap_credentials.password, SOFTAP_PASSWORD,
+            sizeof(SOFTAP_PASSWORD));
+    ap_config.ap_credentials.security = SOFTAP_SECURITY;
+    ap_config.channel = softap_channel;
+    ap_config.band = (softap_channel > MAX_2_4GHZ_CHANNEL) ?
+            CY_WCM_WIFI_BAND_5GHZ : CY_WCM_WIFI_BAND_2_4GHZ;
+    ap_config.ip_settings.ip_address.version = CY_WCM_IP_VER_V4;
+    ap_config.ip_settings.ip_address.ip.v4 = SOFTAP_IP_ADDRESS;
+    ap_config.ip_settings.netmask.version = CY_WCM_IP_VER_V4;
+    ap_config.ip_settings.netmask.ip.v4 = SOFTAP_NETMASK;
+    ap_config.ip_settings.gateway.version = CY_WCM_IP_VER_V4;
+    ap_config.ip_settings.gateway.ip.v4 = SOFTAP_GATEWAY;
+
+    /* The beacon settings only take effect when the SoftAP is started. */
+    if ((CY_RSLT_SUCCESS != cy_wcm_get_whd_interface(
+            CY_WCM_INTERFACE_TYPE_AP, &ifp)) ||
+            (WHD_SUCCESS != whd_wifi_ap_set_beacon_interval(ifp,
+            SOFTAP_BEACON_INTERVAL_TU)) ||
+            (WHD_SUCCESS != whd_wifi_ap_set_dtim_interval(ifp,
+            SOFTAP_DTIM_PERIOD)))
+    {
+        ERR_INFO(("Failed to set the SoftAP beacon interval.\n"));
+    }
+
+    result = cy_wcm_start_ap(&ap_config);
+
+    taskENTER_CRITICAL();
+    softap_policy_started(&policy, (CY_RSLT_SUCCESS == result), now_ms());
+    taskEXIT_CRITICAL();
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        APP_INFO(("SoftAP '%s' started on channel %u\n", SOFTAP_SSID,
+                (unsigned int)softap_channel));
+    }
+    else
+    {
+        ERR_INFO(("Failed to start the SoftAP with error code 0x%08lx.\n",
+                (unsigned long)result));
+    }
+}
+
+/*******************************************************************************
+* Function Name: stop_ap
+********************************************************************************
+* Summary:
+*  Stops the SoftAP.
+*******************************************************************************/
+static void stop_ap(void)
+{
+    cy_rslt_t result = cy_wcm_stop_ap();
+
+    taskENTER_CRITICAL();
+    softap_policy_stopped(&policy, now_ms());
+    taskEXIT_CRITICAL();
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        ERR_INFO(("Failed to stop the SoftAP with error code 0x%08lx.\n",
+                (unsigned long)result));
+    }
+}
+
+/*******************************************************************************
+* Function Name: softap_init
+********************************************************************************
+* Summary:
+*  Registers for the client events of the SoftAP and, when
+*  SOFTAP_START_AT_BOOT is set, requests the SoftAP. Called after cy_wcm_init().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void softap_init(void)
+{
+    softap_policy_init(&policy, &softap_config);
+
+    if (CY_RSLT_SUCCESS != cy_wcm_register_event_callback(
+            softap_event_callback))
+    {
+        ERR_INFO(("Failed to register the SoftAP event callback.\n"));
+    }
+
+#if (SOFTAP_START_AT_BOOT == 1U)
+    softap_policy_request(&policy);
+#endif /* (SOFTAP_START_AT_BOOT == 1U) */
+}
+
+/*******************************************************************************
+* Function Name: softap_request
+********************************************************************************
+* Summary:
+*  Requests the SoftAP, for instance from a button or a command of the
+*  application. The SoftAP is started, or its idle timeout restarted, by the
+*  low power task. Can be called from any task.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void softap_request(void)
+{
+    taskENTER_CRITICAL();
+    softap_policy_request(&policy);
+    taskEXIT_CRITICAL();
+
+    /* Resume the network stack so that the request is served */
+    cy_network_activity_notify(CY_NETWORK_ACTIVITY_TX);
+}
+
+/*******************************************************************************
+* Function Name: softap_poll
+********************************************************************************
+* Summary:
+*  Starts the SoftAP when requested and stops it when the idle timeout
+*  expired. Called by the low power task on every wake of the network stack.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: Longest time the network stack may stay suspended before the
+*  next call, in milliseconds. portMAX_DELAY if there is no deadline.
+*
+*******************************************************************************/
+uint32_t softap_poll(void)
+{
+    softap_action_t action;
+    uint32_t wait_ms;
+
+    taskENTER_CRITICAL();
+    action = softap_policy_next(&policy, now_ms(), &wait_ms);
+    taskEXIT_CRITICAL();
+
+    if (SOFTAP_ACTION_NONE != action)
+    {
+        if (SOFTAP_ACTION_START == action)
+        {
+            start_ap();
+        }
+        else
+        {
+            APP_INFO(("SoftAP idle for %lu ms. Stopping it.\n",
+                    (unsigned long)SOFTAP_IDLE_TIMEOUT_MS));
+            stop_ap();
+        }
+
+        /* Deadline of the new state */
+        taskENTER_CRITICAL();
+        (void)softap_policy_next(&policy, now_ms(), &wait_ms);
+        taskEXIT_CRITICAL();
+    }
+
+    return (SOFTAP_POLICY_WAIT_FOREVER == wait_ms) ?
+            (uint32_t)portMAX_DELAY : wait_ms;
+}
+
+/*******************************************************************************
+* Function Name: softap_has_clients
+********************************************************************************
+* Summary:
+*  Returns whether a client is associated to the SoftAP.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true if at least one client is associated.
+*
+*******************************************************************************/
+bool softap_has_clients(void)
+{
+    bool has_clients;
+
+    taskENTER_CRITICAL();
+    has_clients = policy.up && (0U != policy.clients);
+    taskEXIT_CRITICAL();
+
+    return has_clients;
+}
+
+/*******************************************************************************
+* Function Name: softap_sta_connected
+********************************************************************************
+* Summary:
+*  Moves the SoftAP to the channel of the STA link after a connection to a
+*  different channel. Called after every connection of the STA.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void softap_sta_connected(void)
+{
+    cy_wcm_associated_ap_info_t ap_info;
+
+    if (!policy.up ||
+            (CY_RSLT_SUCCESS != cy_wcm_get_associated_ap_info(&ap_info)) ||
+            (ap_info.channel == softap_channel))
+    {
+        return;
+    }
+
+    APP_INFO(("STA moved to channel %u. Restarting the SoftAP.\n",
+            (unsigned int)ap_info.channel));
+    stop_ap();
+
+    taskENTER_CRITICAL();
+    softap_policy_request(&policy);
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: softap_report
+********************************************************************************
+* Summary:
+*  Prints the state of the SoftAP and its counters.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void softap_report(void)
+{
+    softap_policy_t copy;
+    uint32_t up_ms;
+
+    taskENTER_CRITICAL();
+    copy = policy;
+    taskEXIT_CRITICAL();
+
+    up_ms = copy.stats.up_ms;
+    if (copy.up)
+    {
+        up_ms += now_ms() - copy.up_since_ms;
+    }
+
+    APP_INFO(("SoftAP: %s, %lu client(s), %lu start(s), %lu failed, "
+            "%lu join(s), %lu idle stop(s), up %lu s\n",
+            copy.up ? "up" : "down",
+            (unsigned long)copy.clients,
+            (unsigned long)copy.stats.starts,
+            (unsigned long)copy.stats.start_failures,
+            (unsigned long)copy.stats.joins,
+            (unsigned long)copy.stats.idle_stops,
+            (unsigned long)(up_ms / 1000U)));
+}
+
+
+/* [] END OF FILE */
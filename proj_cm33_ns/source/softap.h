@@ -0,0 +1,123 @@
+/******************************************************************************
+* File Name: softap.h
+*
+* Description: This file is the public interface of softap.c. It contains the
+* configuration of the SoftAP that runs alongside the STA link for provisioning
+* and local access.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef SOFTAP_H_
+#define SOFTAP_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+#include "softap_policy.h"
+
+#include "cy_wcm.h"
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+/* SoftAP credentials */
+#define SOFTAP_SSID                     "MY_SOFTAP_SSID"
+#define SOFTAP_PASSWORD                 "MY_SOFTAP_PASSWORD"
+#define SOFTAP_SECURITY                 (CY_WCM_SECURITY_WPA2_AES_PSK)
+
+/* Converts an IPv4 address to the network byte order used by WCM */
+#define MAKE_IPV4_ADDRESS(a, b, c, d)   ((((uint32_t)(d)) << 24U) | \
+                                         (((uint32_t)(c)) << 16U) | \
+                                         (((uint32_t)(b)) << 8U) | \
+                                         ((uint32_t)(a)))
+
+/* IPv4 address, netmask and gateway of the SoftAP interface */
+#define SOFTAP_IP_ADDRESS               MAKE_IPV4_ADDRESS(192U, 168U, 10U, 1U)
+#define SOFTAP_NETMASK                  MAKE_IPV4_ADDRESS(255U, 255U, 255U, 0U)
+#define SOFTAP_GATEWAY                  SOFTAP_IP_ADDRESS
+
+/* Channel of the SoftAP when the STA is not connected. Otherwise the SoftAP
+ * shares the channel of the STA link, as the radio cannot serve two channels
+ * without time sharing.
+ */
+#define SOFTAP_DEFAULT_CHANNEL          (1U)
+
+/* Beacon interval in TUs and DTIM period of the SoftAP. Beacons are sent
+ * whether or not a client is associated. A longer interval than the usual
+ * 100 TUs reduces the airtime of the SoftAP when idle, at the cost of a
+ * slower discovery by the clients.
+ */
+#define SOFTAP_BEACON_INTERVAL_TU       (200U)
+#define SOFTAP_DTIM_PERIOD              (3U)
+
+/* The SoftAP is stopped once it has been left without clients for
+ * SOFTAP_IDLE_TIMEOUT_MS. Set SOFTAP_START_AT_BOOT to 1 to open the SoftAP
+ * for that time after every power-up, for field provisioning.
+ */
+#define SOFTAP_IDLE_TIMEOUT_MS          (600000U)
+#define SOFTAP_START_AT_BOOT            (1U)
+
+/* Inactivity interval and window used instead of INACTIVE_INTERVAL_MS and
+ * INACTIVE_WINDOW_MS while a client is associated, so that the exchanges of
+ * a local session do not suspend and resume the network stack for every
+ * request.
+ */
+#define SOFTAP_INACTIVE_INTERVAL_MS     (2000U)
+#define SOFTAP_INACTIVE_WINDOW_MS       (1500U)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void softap_init(void);
+void softap_request(void);
+uint32_t softap_poll(void);
+bool softap_has_clients(void);
+void softap_sta_connected(void);
+void softap_report(void);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOFTAP_H_ */
+
+
+/* [] END OF FILE */
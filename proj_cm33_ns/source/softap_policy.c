@@ -0,0 +1,257 @@
+/*******************************************************************************
+* File Name:   softap_policy.c
+*
+* Description: This file contains the SoftAP policy. The SoftAP is started on
+* request and stopped once it has been left without any associated client for
+* the idle timeout.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "softap_policy.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: softap_policy_init
+********************************************************************************
+* Summary:
+*  Initializes the policy with the SoftAP stopped and not requested.
+*
+* Parameters:
+*  softap_policy_t *policy: Policy to initialize.
+*  const softap_policy_config_t *config: Idle timeout.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void softap_policy_init(softap_policy_t *policy,
+        const softap_policy_config_t *config)
+{
+    memset(policy, 0, sizeof(softap_policy_t));
+    policy->config = *config;
+}
+
+/*******************************************************************************
+* Function Name: softap_policy_request
+********************************************************************************
+* Summary:
+*  Requests the SoftAP. It is started by the next call to
+*  softap_policy_next(). A request while the SoftAP is up restarts the idle
+*  timeout.
+*
+* Parameters:
+*  softap_policy_t *policy: Policy.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void softap_policy_request(softap_policy_t *policy)
+{
+    policy->requested = true;
+}
+
+/*******************************************************************************
+* Function Name: softap_policy_next
+********************************************************************************
+* Summary:
+*  Returns the action to take at the given time. The SoftAP is started when
+*  requested, and stopped when no client has been associated for the idle
+*  timeout. Otherwise, returns the time until the idle timeout expires, or
+*  SOFTAP_POLICY_WAIT_FOREVER if the SoftAP is stopped or has clients.
+*
+* Parameters:
+*  softap_policy_t *policy: Policy.
+*  uint32_t now_ms: Current time, in milliseconds.
+*  uint32_t *wait_ms: Filled with the time until the next action.
+*
+* Return:
+*  softap_action_t: Action to take.
+*
+*******************************************************************************/
+softap_action_t softap_policy_next(softap_policy_t *policy, uint32_t now_ms,
+        uint32_t *wait_ms)
+{
+    uint32_t idle_ms;
+
+    *wait_ms = SOFTAP_POLICY_WAIT_FOREVER;
+
+    if (!policy->up)
+    {
+        return policy->requested ? SOFTAP_ACTION_START : SOFTAP_ACTION_NONE;
+    }
+
+    if (policy->requested)
+    {
+        policy->requested = false;
+        policy->idle_since_ms = now_ms;
+    }
+
+    if (0U != policy->clients)
+    {
+        return SOFTAP_ACTION_NONE;
+    }
+
+    idle_ms = now_ms - policy->idle_since_ms;
+
+    if (idle_ms >= policy->config.idle_timeout_ms)
+    {
+        policy->stats.idle_stops++;
+        return SOFTAP_ACTION_STOP;
+    }
+
+    *wait_ms = policy->config.idle_timeout_ms - idle_ms;
+    return SOFTAP_ACTION_NONE;
+}
+
+/*******************************************************************************
+* Function Name: softap_policy_started
+********************************************************************************
+* Summary:
+*  Records the result of a start. The idle timeout runs from the start. A
+*  failed start drops the request.
+*
+* Parameters:
+*  softap_policy_t *policy: Policy.
+*  bool success: true if the SoftAP is up.
+*  uint32_t now_ms: Current time, in milliseconds.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void softap_policy_started(softap_policy_t *policy, bool success,
+        uint32_t now_ms)
+{
+    policy->requested = false;
+
+    if (!success)
+    {
+        policy->stats.start_failures++;
+        return;
+    }
+
+    policy->up = true;
+    policy->clients = 0U;
+    policy->up_since_ms = now_ms;
+    policy->idle_since_ms = now_ms;
+    policy->stats.starts++;
+}
+
+/*******************************************************************************
+* Function Name: softap_policy_stopped
+********************************************************************************
+* Summary:
+*  Records that the SoftAP is stopped.
+*
+* Parameters:
+*  softap_policy_t *policy: Policy.
+*  uint32_t now_ms: Current time, in milliseconds.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void softap_policy_stopped(softap_policy_t *policy, uint32_t now_ms)
+{
+    if (policy->up)
+    {
+        policy->stats.up_ms += now_ms - policy->up_since_ms;
+    }
+
+    policy->up = false;
+    policy->clients = 0U;
+}
+
+/*******************************************************************************
+* Function Name: softap_policy_client_joined
+********************************************************************************
+* Summary:
+*  Records that a client associated to the SoftAP. The idle timeout is
+*  suspended while a client is associated.
+*
+* Parameters:
+*  softap_policy_t *policy: Policy.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void softap_policy_client_joined(softap_policy_t *policy)
+{
+    if (policy->up)
+    {
+        policy->clients++;
+        policy->stats.joins++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: softap_policy_client_left
+********************************************************************************
+* Summary:
+*  Records that a client left the SoftAP. The idle timeout restarts when the
+*  last client leaves.
+*
+* Parameters:
+*  softap_policy_t *policy: Policy.
+*  uint32_t now_ms: Current time, in milliseconds.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void softap_policy_client_left(softap_policy_t *policy, uint32_t now_ms)
+{
+    if (0U == policy->clients)
+    {
+        return;
+    }
+
+    policy->clients--;
+
+    if (0U == policy->clients)
+    {
+        policy->idle_since_ms = now_ms;
+    }
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,126 @@
+/******************************************************************************
+* File Name: softap_policy.h
+*
+* Description: This file is the public interface of softap_policy.c. It contains
+* the policy that decides when the SoftAP is started and when it is torn down
+* after it has been left without clients.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef SOFTAP_POLICY_H_
+#define SOFTAP_POLICY_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+/* This module has no device dependencies so that it can also be built for the
+ * host machine and driven with a simulated clock.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+/* Returned by softap_policy_next() when no deadline is pending */
+#define SOFTAP_POLICY_WAIT_FOREVER        (0xFFFFFFFFUL)
+
+/*******************************************************************************
+* Enumerations
+*******************************************************************************/
+/* Action requested from the caller by softap_policy_next() */
+typedef enum
+{
+    SOFTAP_ACTION_NONE = 0,
+    SOFTAP_ACTION_START,            /* Start the SoftAP */
+    SOFTAP_ACTION_STOP              /* Idle timeout expired, stop the SoftAP */
+} softap_action_t;
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    uint32_t idle_timeout_ms;       /* Time without clients before teardown */
+} softap_policy_config_t;
+
+typedef struct
+{
+    uint32_t starts;
+    uint32_t start_failures;
+    uint32_t idle_stops;
+    uint32_t joins;
+    uint32_t up_ms;                 /* Time up, of the previous sessions */
+} softap_policy_stats_t;
+
+typedef struct
+{
+    softap_policy_config_t config;
+    bool requested;
+    bool up;
+    uint32_t clients;
+    uint32_t up_since_ms;
+    uint32_t idle_since_ms;         /* Time the last client left */
+    softap_policy_stats_t stats;
+} softap_policy_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void softap_policy_init(softap_policy_t *policy,
+        const softap_policy_config_t *config);
+void softap_policy_request(softap_policy_t *policy);
+softap_action_t softap_policy_next(softap_policy_t *policy, uint32_t now_ms,
+        uint32_t *wait_ms);
+void softap_policy_started(softap_policy_t *policy, bool success,
+        uint32_t now_ms);
+void softap_policy_stopped(softap_policy_t *policy, uint32_t now_ms);
+void softap_policy_client_joined(softap_policy_t *policy);
+void softap_policy_client_left(softap_policy_t *policy, uint32_t now_ms);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* SOFTAP_POLICY_H_ */
+
+
+/* [] END OF FILE */
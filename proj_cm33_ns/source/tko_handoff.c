@@ -0,0 +1,394 @@
+/*******************************************************************************
+* File Name:   tko_handoff.c
+*
+* Description: This file contains the handoff of a TCP connection to the TCP
+* keep-alive offload (TKO) of the WLAN firmware. Before the network stack is
+* suspended, the sequence numbers of the connection are given to the firmware
+* with the keep-alive segment it sends and the acknowledgement it expects. When
+* the network stack resumes, the state of the connection in lwIP is checked
+* against the one handed over and the status reported by the firmware.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "tko_handoff.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define IPV4_HEADER_LEN                 (20U)
+#define IPV4_VERSION_IHL                (0x45U)
+#define IPV4_FLAG_DF                    (0x4000U)
+#define IPV4_TTL                        (64U)
+#define IP_PROTO_TCP                    (6U)
+#define TCP_HEADER_LEN                  (20U)
+#define TCP_DATA_OFFSET                 ((TCP_HEADER_LEN / 4U) << 4U)
+#define TCP_FLAG_ACK                    (0x10U)
+
+#define TKO_IOVAR_HEADER_LEN            (4U)
+#define TKO_CONNECT_HEADER_LEN          (20U)
+#define TKO_IP_ADDR_TYPE_IPV4           (0U)
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: put_be16
+********************************************************************************
+* Summary:
+*  Writes a 16-bit value in network byte order.
+*******************************************************************************/
+static void put_be16(uint8_t *p, uint16_t value)
+{
+    p[0] = (uint8_t)(value >> 8U);
+    p[1] = (uint8_t)value;
+}
+
+/*******************************************************************************
+* Function Name: put_be32
+********************************************************************************
+* Summary:
+*  Writes a 32-bit value in network byte order.
+*******************************************************************************/
+static void put_be32(uint8_t *p, uint32_t value)
+{
+    put_be16(p, (uint16_t)(value >> 16U));
+    put_be16(&p[2], (uint16_t)value);
+}
+
+/*******************************************************************************
+* Function Name: put_le16
+********************************************************************************
+* Summary:
+*  Writes a 16-bit value in little-endian byte order.
+*******************************************************************************/
+static void put_le16(uint8_t *p, uint16_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8U);
+}
+
+/*******************************************************************************
+* Function Name: checksum_add
+********************************************************************************
+* Summary:
+*  Adds bytes to a ones' complement sum of 16-bit words.
+*******************************************************************************/
+static uint32_t checksum_add(uint32_t sum, const uint8_t *data, size_t len)
+{
+    for (size_t i = 0U; (i + 1U) < len; i += 2U)
+    {
+        sum += ((uint32_t)data[i] << 8U) | data[i + 1U];
+    }
+
+    if (0U != (len & 1U))
+    {
+        sum += (uint32_t)data[len - 1U] << 8U;
+    }
+
+    return sum;
+}
+
+/*******************************************************************************
+* Function Name: checksum_fold
+********************************************************************************
+* Summary:
+*  Returns the ones' complement of a folded sum.
+*******************************************************************************/
+static uint16_t checksum_fold(uint32_t sum)
+{
+    while (0U != (sum >> 16U))
+    {
+        sum = (sum & 0xFFFFU) + (sum >> 16U);
+    }
+
+    return (uint16_t)~sum;
+}
+
+/*******************************************************************************
+* Function Name: tko_seq_before
+********************************************************************************
+* Summary:
+*  Compares two sequence numbers modulo 2^32.
+*
+* Parameters:
+*  uint32_t a: Sequence number.
+*  uint32_t b: Sequence number.
+*
+* Return:
+*  bool: true if a comes before b.
+*
+*******************************************************************************/
+bool tko_seq_before(uint32_t a, uint32_t b)
+{
+    return ((int32_t)(a - b) < 0);
+}
+
+/*******************************************************************************
+* Function Name: tko_handoff_init
+********************************************************************************
+* Summary:
+*  Clears the handoff state and the counters.
+*
+* Parameters:
+*  tko_handoff_t *handoff: Handoff state.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void tko_handoff_init(tko_handoff_t *handoff)
+{
+    memset(handoff, 0, sizeof(tko_handoff_t));
+}
+
+/*******************************************************************************
+* Function Name: tko_handoff_begin
+********************************************************************************
+* Summary:
+*  Records the state of the connection given to the firmware.
+*
+* Parameters:
+*  tko_handoff_t *handoff: Handoff state.
+*  const tko_conn_t *conn: State of the connection in lwIP.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void tko_handoff_begin(tko_handoff_t *handoff, const tko_conn_t *conn)
+{
+    handoff->handed = *conn;
+    handoff->active = true;
+    handoff->handoffs++;
+}
+
+/*******************************************************************************
+* Function Name: tko_handoff_reclaim
+********************************************************************************
+* Summary:
+*  Checks the state of the connection in lwIP when the host takes it back.
+*  The keep-alive segments of the firmware carry SND.NXT - 1 and consume no
+*  sequence number, so the state in lwIP stays valid and is kept as is. A
+*  connection whose sequence numbers moved since the handoff was used by
+*  the host before it was suspended: the firmware may have sent segments
+*  with old numbers, which the peer answered with an acknowledgement, and
+*  its status is not meaningful. Otherwise, the peer not answering breaks
+*  the connection, and a peer answering with other sequence numbers than
+*  the ones handed over means the two ends are out of sync. Sequence
+*  numbers that went backwards belong to another connection.
+*
+* Parameters:
+*  tko_handoff_t *handoff: Handoff state.
+*  const tko_conn_t *conn: State of the connection in lwIP.
+*  uint8_t status: Status of the connection reported by the firmware.
+*
+* Return:
+*  tko_reclaim_t: TKO_RECLAIM_BROKEN and TKO_RECLAIM_DESYNC mean the
+*  connection must be aborted.
+*
+*******************************************************************************/
+tko_reclaim_t tko_handoff_reclaim(tko_handoff_t *handoff,
+        const tko_conn_t *conn, uint8_t status)
+{
+    const tko_conn_t *handed = &handoff->handed;
+    tko_reclaim_t result;
+    bool moved;
+
+    if (!handoff->active)
+    {
+        return TKO_RECLAIM_OK;
+    }
+
+    handoff->active = false;
+    moved = (conn->snd_nxt != handed->snd_nxt) ||
+            (conn->rcv_nxt != handed->rcv_nxt);
+
+    if ((conn->local_port != handed->local_port) ||
+        (conn->remote_port != handed->remote_port) ||
+        (0 != memcmp(conn->remote_ip, handed->remote_ip,
+                sizeof(conn->remote_ip))) ||
+        tko_seq_before(conn->snd_nxt, handed->snd_nxt) ||
+        tko_seq_before(conn->rcv_nxt, handed->rcv_nxt))
+    {
+        result = TKO_RECLAIM_DESYNC;
+    }
+    else
+    {
+        switch (status)
+        {
+            case TKO_STATUS_NO_RESPONSE:
+                result = TKO_RECLAIM_BROKEN;
+                break;
+
+            case TKO_STATUS_NO_TCP_ACK_FLAG:
+            case TKO_STATUS_UNEXPECT_TCP_ACK:
+            case TKO_STATUS_SEQ_NUM_INVALID:
+            case TKO_STATUS_REMOTE_SEQ_NUM_INVALID:
+                result = moved ? TKO_RECLAIM_STALE : TKO_RECLAIM_DESYNC;
+                break;
+
+            default:
+                result = moved ? TKO_RECLAIM_STALE : TKO_RECLAIM_OK;
+                break;
+        }
+    }
+
+    handoff->reclaims[result]++;
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: tko_build_segment
+********************************************************************************
+* Summary:
+*  Builds the keep-alive segment sent by the firmware, or the acknowledgement
+*  it expects from the peer. The keep-alive carries SND.NXT - 1 so that the
+*  peer answers with an acknowledgement of SND.NXT (RFC 9293, 3.8.4).
+*
+* Parameters:
+*  const tko_conn_t *conn: State of the connection.
+*  bool request: true for the keep-alive, false for the acknowledgement.
+*  uint8_t *buffer: Filled with the IPv4 packet.
+*  size_t size: Size of buffer.
+*
+* Return:
+*  uint16_t: Length of the packet, 0 if buffer is too small.
+*
+*******************************************************************************/
+uint16_t tko_build_segment(const tko_conn_t *conn, bool request,
+        uint8_t *buffer, size_t size)
+{
+    static const uint8_t pseudo_proto[2] = { 0U, IP_PROTO_TCP };
+    const uint8_t *src_ip = request ? conn->local_ip : conn->remote_ip;
+    const uint8_t *dst_ip = request ? conn->remote_ip : conn->local_ip;
+    uint8_t *ip = buffer;
+    uint8_t *tcp = &buffer[IPV4_HEADER_LEN];
+    uint8_t tcp_len[2];
+    uint32_t sum;
+
+    if (size < TKO_SEGMENT_LEN)
+    {
+        return 0U;
+    }
+
+    memset(buffer, 0, TKO_SEGMENT_LEN);
+
+    ip[0] = IPV4_VERSION_IHL;
+    put_be16(&ip[2], (uint16_t)TKO_SEGMENT_LEN);
+    put_be16(&ip[6], (uint16_t)IPV4_FLAG_DF);
+    ip[8] = IPV4_TTL;
+    ip[9] = IP_PROTO_TCP;
+    memcpy(&ip[12], src_ip, 4U);
+    memcpy(&ip[16], dst_ip, 4U);
+    put_be16(&ip[10], checksum_fold(checksum_add(0U, ip, IPV4_HEADER_LEN)));
+
+    put_be16(&tcp[0], request ? conn->local_port : conn->remote_port);
+    put_be16(&tcp[2], request ? conn->remote_port : conn->local_port);
+    put_be32(&tcp[4], request ? (conn->snd_nxt - 1U) : conn->rcv_nxt);
+    put_be32(&tcp[8], request ? conn->rcv_nxt : conn->snd_nxt);
+    tcp[12] = TCP_DATA_OFFSET;
+    tcp[13] = TCP_FLAG_ACK;
+    put_be16(&tcp[14], request ? conn->rcv_wnd : 0U);
+
+    put_be16(tcp_len, (uint16_t)TCP_HEADER_LEN);
+    sum = checksum_add(0U, &ip[12], 8U);
+    sum = checksum_add(sum, pseudo_proto, sizeof(pseudo_proto));
+    sum = checksum_add(sum, tcp_len, sizeof(tcp_len));
+    sum = checksum_add(sum, tcp, TCP_HEADER_LEN);
+    put_be16(&tcp[16], checksum_fold(sum));
+
+    return (uint16_t)TKO_SEGMENT_LEN;
+}
+
+/*******************************************************************************
+* Function Name: tko_build_connect_iovar
+********************************************************************************
+* Summary:
+*  Builds the buffer of the "tko" iovar that describes a connection to the
+*  firmware: the sub-command header, the ports and sequence numbers in
+*  network byte order, then the local and remote addresses, the keep-alive
+*  segment and the expected acknowledgement.
+*
+* Parameters:
+*  const tko_conn_t *conn: State of the connection.
+*  uint8_t index: Connection slot of the firmware.
+*  uint8_t *buffer: Filled with the iovar buffer.
+*  size_t size: Size of buffer.
+*
+* Return:
+*  uint16_t: Length of the buffer, 0 if buffer is too small.
+*
+*******************************************************************************/
+uint16_t tko_build_connect_iovar(const tko_conn_t *conn, uint8_t index,
+        uint8_t *buffer, size_t size)
+{
+    uint8_t *connect = &buffer[TKO_IOVAR_HEADER_LEN];
+    uint8_t *data = &connect[TKO_CONNECT_HEADER_LEN];
+
+    if (size < TKO_CONNECT_IOVAR_LEN)
+    {
+        return 0U;
+    }
+
+    memset(buffer, 0, TKO_CONNECT_IOVAR_LEN);
+
+    put_le16(&buffer[0], (uint16_t)TKO_SUBCMD_CONNECT);
+    put_le16(&buffer[2],
+            (uint16_t)(TKO_CONNECT_IOVAR_LEN - TKO_IOVAR_HEADER_LEN));
+
+    connect[0] = index;
+    connect[1] = TKO_IP_ADDR_TYPE_IPV4;
+    put_be16(&connect[2], conn->local_port);
+    put_be16(&connect[4], conn->remote_port);
+    put_be32(&connect[8], conn->snd_nxt);
+    put_be32(&connect[12], conn->rcv_nxt);
+    put_le16(&connect[16], (uint16_t)TKO_SEGMENT_LEN);
+    put_le16(&connect[18], (uint16_t)TKO_SEGMENT_LEN);
+
+    memcpy(&data[0], conn->local_ip, 4U);
+    memcpy(&data[4], conn->remote_ip, 4U);
+    (void)tko_build_segment(conn, true, &data[8], TKO_SEGMENT_LEN);
+    (void)tko_build_segment(conn, false, &data[8U + TKO_SEGMENT_LEN],
+            TKO_SEGMENT_LEN);
+
+    return (uint16_t)TKO_CONNECT_IOVAR_LEN;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,145 @@
+/******************************************************************************
+* File Name: tko_handoff.h
+*
+* Description: This file is the public interface of tko_handoff.c, which hands
+* the state of a TCP connection to the TCP keep-alive offload of the WLAN
+* firmware and checks it when the host takes the connection back.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef TKO_HANDOFF_H_
+#define TKO_HANDOFF_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+/* This module has no device dependencies so that it can also be built for the
+ * host machine. See tools/tko_handoff_test.c.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+/* Length of the keep-alive segments built for the firmware: an IPv4 header
+ * and a TCP header without options.
+ */
+#define TKO_SEGMENT_LEN                 (40U)
+
+/* Sub-command of the "tko" iovar that describes a connection to the
+ * firmware, and length of its buffer.
+ */
+#define TKO_SUBCMD_CONNECT              (2U)
+#define TKO_CONNECT_IOVAR_LEN           (4U + 20U + 8U + \
+                                         (2U * TKO_SEGMENT_LEN))
+
+/* Status of an offloaded connection reported by the firmware */
+#define TKO_STATUS_NORMAL               (0U)
+#define TKO_STATUS_NO_RESPONSE          (1U)
+#define TKO_STATUS_NO_TCP_ACK_FLAG      (2U)
+#define TKO_STATUS_UNEXPECT_TCP_ACK     (3U)
+#define TKO_STATUS_SEQ_NUM_INVALID      (4U)
+#define TKO_STATUS_REMOTE_SEQ_NUM_INVALID (5U)
+#define TKO_STATUS_TCP_DATA             (6U)
+#define TKO_STATUS_UNAVAILABLE          (255U)
+
+/*******************************************************************************
+* Enumerations
+*******************************************************************************/
+/* Outcome of taking a connection back from the firmware */
+typedef enum
+{
+    TKO_RECLAIM_OK = 0,         /* Kept alive by the firmware */
+    TKO_RECLAIM_STALE,          /* The host used the connection after it was
+                                 * handed over; the host state is kept */
+    TKO_RECLAIM_BROKEN,         /* The peer stopped answering */
+    TKO_RECLAIM_DESYNC,         /* The peer and the host disagree on the
+                                 * sequence numbers */
+    TKO_RECLAIM_COUNT
+} tko_reclaim_t;
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* State of an IPv4 TCP connection. Addresses are in network byte order. */
+typedef struct
+{
+    uint8_t local_ip[4];
+    uint8_t remote_ip[4];
+    uint16_t local_port;
+    uint16_t remote_port;
+    uint32_t snd_nxt;           /* Next sequence number to send */
+    uint32_t rcv_nxt;           /* Next sequence number expected */
+    uint16_t rcv_wnd;           /* Receive window announced */
+} tko_conn_t;
+
+/* Handoff state and counters */
+typedef struct
+{
+    tko_conn_t handed;          /* State given to the firmware */
+    bool active;
+    uint32_t handoffs;
+    uint32_t reclaims[TKO_RECLAIM_COUNT];
+} tko_handoff_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool tko_seq_before(uint32_t a, uint32_t b);
+void tko_handoff_init(tko_handoff_t *handoff);
+void tko_handoff_begin(tko_handoff_t *handoff, const tko_conn_t *conn);
+tko_reclaim_t tko_handoff_reclaim(tko_handoff_t *handoff,
+        const tko_conn_t *conn, uint8_t status);
+uint16_t tko_build_segment(const tko_conn_t *conn, bool request,
+        uint8_t *buffer, size_t size);
+uint16_t tko_build_connect_iovar(const tko_conn_t *conn, uint8_t index,
+        uint8_t *buffer, size_t size);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* TKO_HANDOFF_H_ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,234 @@
+/*******************************************************************************
+* File Name:   trace_log.c
+*
+* Description: This file contains the event log of the power-state timeline.
+* Every event is an LPTimer timestamp, an event code and an argument, recorded
+* lock-free in a fixed ring so that it can be called from any task, interrupt or
+* SysPm callback.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "trace_log.h"
+
+#include <stdatomic.h>
+#include <stdio.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TRACE_LOG_SLOT_MASK             (TRACE_LOG_SLOTS - 1U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Recorded event, 8 bytes. The event code is written last and is
+ * TRACE_EVENT_NONE while the event is being recorded, so the reader never
+ * sees a partial event.
+ */
+typedef struct
+{
+    uint32_t ticks;
+    uint16_t arg;
+    atomic_uint_least16_t event;
+} trace_log_slot_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Writers reserve slots by advancing head with a compare-and-swap. The single
+ * reader advances tail.
+ */
+static trace_log_slot_t trace_log_slots[TRACE_LOG_SLOTS];
+static atomic_uint_fast32_t trace_log_head;
+static atomic_uint_fast32_t trace_log_tail;
+static atomic_uint_fast32_t trace_log_dropped;
+static trace_log_timestamp_fn_t trace_log_timestamp;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: trace_log_init
+********************************************************************************
+* Summary:
+*  Empties the ring and sets the source of the event timestamps.
+*
+* Parameters:
+*  trace_log_timestamp_fn_t timestamp: Returns the current time. Can be NULL.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void trace_log_init(trace_log_timestamp_fn_t timestamp)
+{
+    for (uint32_t i = 0U; i < TRACE_LOG_SLOTS; i++)
+    {
+        atomic_store_explicit(&trace_log_slots[i].event, TRACE_EVENT_NONE,
+                memory_order_relaxed);
+    }
+    atomic_store_explicit(&trace_log_head, 0U, memory_order_relaxed);
+    atomic_store_explicit(&trace_log_tail, 0U, memory_order_relaxed);
+    atomic_store_explicit(&trace_log_dropped, 0U, memory_order_relaxed);
+    trace_log_timestamp = timestamp;
+}
+
+/*******************************************************************************
+* Function Name: trace_log_record
+********************************************************************************
+* Summary:
+*  Records an event with the current time. Lock-free and allocation-free, so
+*  it can be called from any task, interrupt or SysPm callback. The argument
+*  is truncated to 16 bits.
+*
+* Parameters:
+*  uint32_t event: trace_event_t code.
+*  uint32_t arg: Argument of the event.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void trace_log_record(uint32_t event, uint32_t arg)
+{
+    uint_fast32_t head = atomic_load_explicit(&trace_log_head,
+            memory_order_relaxed);
+    trace_log_slot_t *slot;
+
+    /* Reserve a slot, or drop the event if the ring is full */
+    do
+    {
+        if ((uint32_t)(head - atomic_load_explicit(&trace_log_tail,
+                memory_order_acquire)) >= TRACE_LOG_SLOTS)
+        {
+            atomic_fetch_add_explicit(&trace_log_dropped, 1U,
+                    memory_order_relaxed);
+            return;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&trace_log_head, &head,
+            head + 1U, memory_order_relaxed, memory_order_relaxed));
+
+    slot = &trace_log_slots[head & TRACE_LOG_SLOT_MASK];
+    slot->ticks = (NULL != trace_log_timestamp) ? trace_log_timestamp() : 0U;
+    slot->arg = (uint16_t)arg;
+
+    /* Publish the event */
+    atomic_store_explicit(&slot->event, (uint_least16_t)event,
+            memory_order_release);
+}
+
+/*******************************************************************************
+* Function Name: trace_log_drain
+********************************************************************************
+* Summary:
+*  Writes the recorded events to the output as "trace," lines, oldest first,
+*  and frees their slots. Stops at an event that is still being recorded. If
+*  events were dropped, a "trace-dropped," line is written last. Must only be
+*  called from one task.
+*
+*  The events are timestamped when their slot is reserved, so an event
+*  recorded by an interrupt that preempts another recording can be written
+*  before an event with an earlier timestamp.
+*
+* Parameters:
+*  trace_log_output_fn_t output: Sink of the lines.
+*
+* Return:
+*  uint32_t: Number of events written.
+*
+*******************************************************************************/
+uint32_t trace_log_drain(trace_log_output_fn_t output)
+{
+    char line[TRACE_LOG_LINE_MAX_SIZE];
+    uint_fast32_t tail = atomic_load_explicit(&trace_log_tail,
+            memory_order_relaxed);
+    uint32_t count = 0U;
+    uint32_t dropped;
+    trace_log_slot_t *slot;
+    uint_least16_t event;
+    int size;
+
+    while (tail != atomic_load_explicit(&trace_log_head, memory_order_acquire))
+    {
+        slot = &trace_log_slots[tail & TRACE_LOG_SLOT_MASK];
+        event = atomic_load_explicit(&slot->event, memory_order_acquire);
+
+        if (TRACE_EVENT_NONE == event)
+        {
+            break;
+        }
+
+        size = snprintf(line, sizeof(line), "trace,%lu,%u,%u\n",
+                (unsigned long)slot->ticks, (unsigned int)event,
+                (unsigned int)slot->arg);
+        output((const uint8_t *)line, (uint32_t)size);
+
+        atomic_store_explicit(&slot->event, TRACE_EVENT_NONE,
+                memory_order_relaxed);
+        tail++;
+        atomic_store_explicit(&trace_log_tail, tail, memory_order_release);
+        count++;
+    }
+
+    dropped = (uint32_t)atomic_exchange_explicit(&trace_log_dropped, 0U,
+            memory_order_relaxed);
+
+    if (0U != dropped)
+    {
+        size = snprintf(line, sizeof(line), "trace-dropped,%lu\n",
+                (unsigned long)dropped);
+        output((const uint8_t *)line, (uint32_t)size);
+    }
+
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: trace_log_pending
+********************************************************************************
+* Summary:
+*  Returns the number of events recorded and not drained yet.
+*
+*******************************************************************************/
+uint32_t trace_log_pending(void)
+{
+    return (uint32_t)(atomic_load_explicit(&trace_log_head,
+            memory_order_acquire) - atomic_load_explicit(&trace_log_tail,
+            memory_order_acquire));
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,139 @@
+/******************************************************************************
+* File Name: trace_log.h
+*
+* Description: This file is the public interface of trace_log.c. It contains the
+* events of the power-state timeline and the functions used to record them and
+* to write them out as text lines.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef TRACE_LOG_H_
+#define TRACE_LOG_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+/* This module has no device dependencies so that it can also be built for the
+ * host machine.
+ */
+#include <stdint.h>
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+/* Number of events the ring holds. Must be a power of two. Events recorded
+ * while the ring is full are dropped and counted.
+ */
+#define TRACE_LOG_SLOTS                 (1024U)
+
+/* Lines written by trace_log_drain(). The other lines of the UART output are
+ * ignored by tools/trace_log_chrome.c.
+ *   trace,<ticks>,<event>,<arg>    one event, oldest first
+ *   trace-dropped,<count>          events dropped since the previous drain
+ * The timestamps are LPTimer counts. The device also writes the lines
+ *   trace-clock,<tick_hz>          frequency of the timestamps
+ *   trace-task,<number>,<name>     name of a task of TRACE_EVENT_TASK_SWITCH
+ */
+#define TRACE_LOG_LINE_MAX_SIZE         (40U)
+
+/* Largest number of tasks named with trace-task lines. With more tasks, no
+ * trace-task line is written.
+ */
+#define TRACE_LOG_MAX_TASKS             (16U)
+
+/*******************************************************************************
+* Enumerations
+*******************************************************************************/
+/* Events of the timeline. The values are part of the line format. */
+typedef enum
+{
+    TRACE_EVENT_NONE = 0,           /* Slot being recorded */
+    TRACE_EVENT_POWER_ENTER,        /* arg: trace_power_t entered */
+    TRACE_EVENT_POWER_EXIT,         /* arg: trace_power_t exited */
+    TRACE_EVENT_NET_WAIT,           /* wait_net_suspend() called */
+    TRACE_EVENT_NET_RESUMED,        /* wait_net_suspend() returned */
+    TRACE_EVENT_WAKE_IRQ,           /* arg: trace_irq_t */
+    TRACE_EVENT_CONNECT_START,      /* arg: attempt since the last connection */
+    TRACE_EVENT_CONNECT_END,        /* arg: 1 if connected, 0 if failed */
+    TRACE_EVENT_LINK_LOST,
+    TRACE_EVENT_TASK_SWITCH,        /* arg: FreeRTOS task number */
+    TRACE_EVENT_COUNT
+} trace_event_t;
+
+/* Low-power modes of TRACE_EVENT_POWER_ENTER and TRACE_EVENT_POWER_EXIT */
+typedef enum
+{
+    TRACE_POWER_SLEEP = 0,
+    TRACE_POWER_DEEPSLEEP
+} trace_power_t;
+
+/* Interrupts of TRACE_EVENT_WAKE_IRQ */
+typedef enum
+{
+    TRACE_IRQ_HOST_WAKE = 0,
+    TRACE_IRQ_SDIO
+} trace_irq_t;
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Source of the event timestamps */
+typedef uint32_t (*trace_log_timestamp_fn_t)(void);
+
+/* Sink of the lines written by trace_log_drain() */
+typedef void (*trace_log_output_fn_t)(const uint8_t *data, uint32_t size);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void trace_log_init(trace_log_timestamp_fn_t timestamp);
+void trace_log_record(uint32_t event, uint32_t arg);
+uint32_t trace_log_drain(trace_log_output_fn_t output);
+uint32_t trace_log_pending(void);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* TRACE_LOG_H_ */
+
+
+/* [] END OF FILE */
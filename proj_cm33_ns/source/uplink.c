@@ -0,0 +1,329 @@
+/*******************************************************************************
+* File Name:   uplink.c
+*
+* Description: This file contains the batched uplink. The application queues
+* records with uplink_send() without resuming the network stack, and the uplink
+* task sends all of them to UPLINK_SINK_IP in one resume of the network stack
+* when the flush policy of uplink_batch.c says so.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "uplink.h"
+#include "uplink_batch.h"
+
+#include "lowpower_task.h"
+
+/* Wi-Fi connection manager header files */
+#include "cy_wcm.h"
+
+/* Low power assistant header files */
+#include "network_activity_handler.h"
+
+/* lwIP socket API */
+#include "lwip/sockets.h"
+
+#include <semphr.h>
+#include <string.h>
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Destination of the datagrams */
+typedef struct
+{
+    int sock;
+    struct sockaddr_in sink;
+} uplink_socket_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static uplink_batch_t batch;
+static SemaphoreHandle_t batch_mutex;
+static StaticSemaphore_t batch_mutex_buffer;
+static TaskHandle_t uplink_task_handle;
+
+/* Set when inbound traffic has resumed the network stack */
+static volatile bool inbound_wake;
+
+static const uplink_batch_config_t uplink_batch_config =
+{
+    .flush_bytes    = UPLINK_FLUSH_BYTES,
+    .max_delay_ms   = UPLINK_MAX_DELAY_MS,
+    .datagram_size  = UPLINK_DATAGRAM_SIZE
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: now_ms
+********************************************************************************
+* Summary:
+*  Returns the RTOS time in milliseconds.
+*******************************************************************************/
+static uint32_t now_ms(void)
+{
+    return (uint32_t)pdTICKS_TO_MS(xTaskGetTickCount());
+}
+
+/*******************************************************************************
+* Function Name: uplink_init
+********************************************************************************
+* Summary:
+*  Initializes the queue. Must be called before uplink_send().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uplink_init(void)
+{
+    uplink_batch_init(&batch, &uplink_batch_config);
+    batch_mutex = xSemaphoreCreateMutexStatic(&batch_mutex_buffer);
+}
+
+/*******************************************************************************
+* Function Name: uplink_send
+********************************************************************************
+* Summary:
+*  Queues a record without resuming the network stack. The uplink task is
+*  only woken up when the record is the first one queued, to start waiting
+*  for its deadline, or when the size threshold is reached. The caller may
+*  block while a batch is being sent.
+*
+* Parameters:
+*  const void *record: Record to send.
+*  uint16_t length: Length of the record, in bytes.
+*
+* Return:
+*  bool: false if the record was dropped because the queue is full.
+*
+*******************************************************************************/
+bool uplink_send(const void *record, uint16_t length)
+{
+    uint32_t now = now_ms();
+    bool queued;
+    bool wake;
+
+    (void)xSemaphoreTake(batch_mutex, portMAX_DELAY);
+    queued = uplink_batch_enqueue(&batch, record, length, now);
+    wake = queued && ((1U == batch.records) ||
+            (UPLINK_FLUSH_SIZE == uplink_batch_flush_due(&batch, now, false)));
+    (void)xSemaphoreGive(batch_mutex);
+
+    if (wake && (NULL != uplink_task_handle))
+    {
+        xTaskNotifyGive(uplink_task_handle);
+    }
+
+    return queued;
+}
+
+/*******************************************************************************
+* Function Name: uplink_notify_wake
+********************************************************************************
+* Summary:
+*  Tells the uplink task that inbound traffic has resumed the network stack,
+*  so that the queued records are sent before it is suspended again. Called
+*  by the low power task after every resume.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uplink_notify_wake(void)
+{
+    uint32_t queued;
+
+    if (NULL == uplink_task_handle)
+    {
+        return;
+    }
+
+    (void)xSemaphoreTake(batch_mutex, portMAX_DELAY);
+    queued = batch.records;
+    (void)xSemaphoreGive(batch_mutex);
+
+    if (0U != queued)
+    {
+        inbound_wake = true;
+        xTaskNotifyGive(uplink_task_handle);
+    }
+}
+
+/*******************************************************************************
+* Function Name: uplink_report
+********************************************************************************
+* Summary:
+*  Prints the counters of the queue.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uplink_report(void)
+{
+    uplink_batch_stats_t stats;
+
+    (void)xSemaphoreTake(batch_mutex, portMAX_DELAY);
+    stats = batch.stats;
+    (void)xSemaphoreGive(batch_mutex);
+
+    APP_INFO(("Uplink: %lu records queued, %lu sent in %lu datagrams, "
+            "%lu dropped, %lu lost\n",
+            (unsigned long)stats.records_queued,
+            (unsigned long)stats.records_sent,
+            (unsigned long)stats.datagrams_sent,
+            (unsigned long)stats.records_dropped,
+            (unsigned long)stats.records_lost));
+    APP_INFO(("Uplink flushes: %lu size, %lu deadline, %lu piggyback\n",
+            (unsigned long)stats.flushes[UPLINK_FLUSH_SIZE],
+            (unsigned long)stats.flushes[UPLINK_FLUSH_DEADLINE],
+            (unsigned long)stats.flushes[UPLINK_FLUSH_PIGGYBACK]));
+}
+
+/*******************************************************************************
+* Function Name: send_datagram
+********************************************************************************
+* Summary:
+*  Transport of the queue: sends one datagram on the UDP socket.
+*******************************************************************************/
+static bool send_datagram(void *context, const uint8_t *data, uint16_t length)
+{
+    uplink_socket_t *socket = (uplink_socket_t *)context;
+
+    return (lwip_sendto(socket->sock, data, length, 0,
+            (struct sockaddr *)&socket->sink, sizeof(socket->sink)) > 0);
+}
+
+/*******************************************************************************
+* Function Name: uplink_task
+********************************************************************************
+* Summary:
+*  Blocks until the queue must be flushed, then sends all the queued records
+*  to UPLINK_SINK_IP. The task sleeps until the deadline of the oldest record,
+*  so the device is not woken up while the queue is empty. A flush triggered
+*  by inbound traffic does not signal network activity since the network
+*  stack is already resumed.
+*
+* Parameters:
+*  void *arg: Not used.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uplink_task(void *arg)
+{
+    uplink_socket_t socket;
+    uplink_flush_reason_t reason;
+    uint32_t wait_ms;
+
+    (void)arg;
+
+    memset(&socket, 0, sizeof(socket));
+    socket.sock = -1;
+    socket.sink.sin_family = AF_INET;
+    socket.sink.sin_port = lwip_htons(UPLINK_SINK_PORT);
+
+    if (1 != lwip_inet_pton(AF_INET, UPLINK_SINK_IP, &socket.sink.sin_addr))
+    {
+        ERR_INFO(("Invalid uplink sink address %s.\n", UPLINK_SINK_IP));
+        vTaskDelete(NULL);
+    }
+
+    uplink_task_handle = xTaskGetCurrentTaskHandle();
+
+    while (true)
+    {
+        (void)xSemaphoreTake(batch_mutex, portMAX_DELAY);
+        wait_ms = uplink_batch_time_to_deadline(&batch, now_ms());
+        (void)xSemaphoreGive(batch_mutex);
+
+        (void)ulTaskNotifyTake(pdTRUE, (UINT32_MAX == wait_ms) ?
+                portMAX_DELAY : pdMS_TO_TICKS(wait_ms));
+
+        (void)xSemaphoreTake(batch_mutex, portMAX_DELAY);
+        reason = uplink_batch_flush_due(&batch, now_ms(), inbound_wake);
+        inbound_wake = false;
+        (void)xSemaphoreGive(batch_mutex);
+
+        if (UPLINK_FLUSH_NONE == reason)
+        {
+            continue;
+        }
+
+        if (!cy_wcm_is_connected_to_ap())
+        {
+            vTaskDelay(pdMS_TO_TICKS(UPLINK_RETRY_MS));
+            continue;
+        }
+
+        if (UPLINK_FLUSH_PIGGYBACK != reason)
+        {
+            /* Resume the network stack now rather than on the first packet */
+            cy_network_activity_notify(CY_NETWORK_ACTIVITY_TX);
+        }
+
+        if (socket.sock < 0)
+        {
+            socket.sock = lwip_socket(AF_INET, SOCK_DGRAM, 0);
+            if (socket.sock < 0)
+            {
+                ERR_INFO(("Failed to open the uplink socket.\n"));
+                vTaskDelay(pdMS_TO_TICKS(UPLINK_RETRY_MS));
+                continue;
+            }
+        }
+
+        (void)xSemaphoreTake(batch_mutex, portMAX_DELAY);
+        uplink_batch_flush(&batch, reason, send_datagram, &socket);
+        (void)xSemaphoreGive(batch_mutex);
+    }
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,95 @@
+/******************************************************************************
+* File Name: uplink.h
+*
+* Description: This file is the public interface of uplink.c, which queues the
+* data sent by the application while the network stack is suspended and sends it
+* in batches.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef UPLINK_H_
+#define UPLINK_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+#define UPLINK_TASK_STACK_SIZE_BYTES    (1024U)
+#define UPLINK_TASK_PRIORITY            (2U)
+
+/* The queued records are sent in one resume of the network stack once
+ * UPLINK_FLUSH_BYTES are queued, once the oldest record has waited
+ * UPLINK_MAX_DELAY_MS, or as soon as inbound traffic resumes the network
+ * stack, whichever comes first. UPLINK_DATAGRAM_SIZE must not exceed the
+ * payload of a UDP datagram that fits in one Ethernet frame.
+ */
+#define UPLINK_FLUSH_BYTES              (1024U)
+#define UPLINK_MAX_DELAY_MS             (30000U)
+#define UPLINK_DATAGRAM_SIZE            (1472U)
+
+/* Delay before trying again when the AP is not connected */
+#define UPLINK_RETRY_MS                 (5000U)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void uplink_init(void);
+bool uplink_send(const void *record, uint16_t length);
+void uplink_notify_wake(void);
+void uplink_report(void);
+void uplink_task(void *arg);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* UPLINK_H_ */
+
+
+/* [] END OF FILE */
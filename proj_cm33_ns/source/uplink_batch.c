@@ -0,0 +1,253 @@
+/*******************************************************************************
+* File Name:   uplink_batch.c
+*
+* Description: This file contains the queue of outbound records. Producers queue
+* records while the network stack is suspended, and the queue is flushed in one
+* resume of the network stack when enough bytes are queued, when the oldest
+* record has waited the maximum delay, or when inbound traffic has already
+* resumed the network stack.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "uplink_batch.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: uplink_batch_init
+********************************************************************************
+* Summary:
+*  Initializes an empty queue.
+*
+* Parameters:
+*  uplink_batch_t *batch: Queue state.
+*  const uplink_batch_config_t *config: Flush policy.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uplink_batch_init(uplink_batch_t *batch,
+        const uplink_batch_config_t *config)
+{
+    memset(batch, 0, sizeof(uplink_batch_t));
+    batch->config = *config;
+}
+
+/*******************************************************************************
+* Function Name: uplink_batch_enqueue
+********************************************************************************
+* Summary:
+*  Copies a record at the end of the queue with its length header.
+*
+* Parameters:
+*  uplink_batch_t *batch: Queue state.
+*  const void *record: Record to send.
+*  uint16_t length: Length of the record, in bytes.
+*  uint32_t now_ms: Current time.
+*
+* Return:
+*  bool: false if the queue is full or the record does not fit in a datagram.
+*
+*******************************************************************************/
+bool uplink_batch_enqueue(uplink_batch_t *batch, const void *record,
+        uint16_t length, uint32_t now_ms)
+{
+    uint32_t size = UPLINK_BATCH_RECORD_HEADER + (uint32_t)length;
+    uint8_t *slot = &batch->data[batch->used];
+
+    if ((size > batch->config.datagram_size) ||
+            (size > (UPLINK_BATCH_CAPACITY - batch->used)))
+    {
+        batch->stats.records_dropped++;
+        return false;
+    }
+
+    slot[0] = (uint8_t)(length & 0xFFU);
+    slot[1] = (uint8_t)(length >> 8U);
+    memcpy(&slot[UPLINK_BATCH_RECORD_HEADER], record, length);
+
+    if (0U == batch->records)
+    {
+        batch->oldest_ms = now_ms;
+    }
+
+    batch->used += size;
+    batch->records++;
+    batch->stats.records_queued++;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: uplink_batch_flush_due
+********************************************************************************
+* Summary:
+*  Returns the reason the queue must be flushed now, if any. Records are sent
+*  with any inbound wake since the network stack is resumed anyway.
+*
+* Parameters:
+*  const uplink_batch_t *batch: Queue state.
+*  uint32_t now_ms: Current time.
+*  bool inbound_wake: true if inbound traffic has resumed the network stack.
+*
+* Return:
+*  uplink_flush_reason_t: UPLINK_FLUSH_NONE if the queue can wait.
+*
+*******************************************************************************/
+uplink_flush_reason_t uplink_batch_flush_due(const uplink_batch_t *batch,
+        uint32_t now_ms, bool inbound_wake)
+{
+    if (0U == batch->records)
+    {
+        return UPLINK_FLUSH_NONE;
+    }
+
+    if (batch->used >= batch->config.flush_bytes)
+    {
+        return UPLINK_FLUSH_SIZE;
+    }
+
+    if ((now_ms - batch->oldest_ms) >= batch->config.max_delay_ms)
+    {
+        return UPLINK_FLUSH_DEADLINE;
+    }
+
+    return inbound_wake ? UPLINK_FLUSH_PIGGYBACK : UPLINK_FLUSH_NONE;
+}
+
+/*******************************************************************************
+* Function Name: uplink_batch_time_to_deadline
+********************************************************************************
+* Summary:
+*  Returns the time until the oldest record reaches the maximum delay.
+*
+* Parameters:
+*  const uplink_batch_t *batch: Queue state.
+*  uint32_t now_ms: Current time.
+*
+* Return:
+*  uint32_t: Time in milliseconds, 0 if already reached, UINT32_MAX if the
+*  queue is empty.
+*
+*******************************************************************************/
+uint32_t uplink_batch_time_to_deadline(const uplink_batch_t *batch,
+        uint32_t now_ms)
+{
+    uint32_t waited = now_ms - batch->oldest_ms;
+
+    if (0U == batch->records)
+    {
+        return UINT32_MAX;
+    }
+
+    return (waited >= batch->config.max_delay_ms) ?
+            0U : (batch->config.max_delay_ms - waited);
+}
+
+/*******************************************************************************
+* Function Name: uplink_batch_flush
+********************************************************************************
+* Summary:
+*  Sends all the queued records, packing as many whole records as fit in each
+*  datagram, and empties the queue. The datagrams are sent from the queue
+*  without copying. The records of a datagram that could not be sent are
+*  counted as lost.
+*
+* Parameters:
+*  uplink_batch_t *batch: Queue state.
+*  uplink_flush_reason_t reason: Reason of the flush, for the counters.
+*  uplink_send_fn_t send: Sends one datagram.
+*  void *context: Passed to send.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uplink_batch_flush(uplink_batch_t *batch, uplink_flush_reason_t reason,
+        uplink_send_fn_t send, void *context)
+{
+    uint32_t start = 0U;
+
+    if (0U == batch->records)
+    {
+        return;
+    }
+
+    while (start < batch->used)
+    {
+        uint32_t end = start;
+        uint32_t records = 0U;
+
+        /* Extend the datagram record by record while it fits */
+        while (end < batch->used)
+        {
+            uint32_t size = UPLINK_BATCH_RECORD_HEADER +
+                    ((uint32_t)batch->data[end] |
+                    ((uint32_t)batch->data[end + 1U] << 8U));
+
+            if ((end - start + size) > batch->config.datagram_size)
+            {
+                break;
+            }
+
+            end += size;
+            records++;
+        }
+
+        if (send(context, &batch->data[start], (uint16_t)(end - start)))
+        {
+            batch->stats.datagrams_sent++;
+            batch->stats.records_sent += records;
+        }
+        else
+        {
+            batch->stats.records_lost += records;
+        }
+
+        start = end;
+    }
+
+    batch->stats.flushes[reason]++;
+    batch->used = 0U;
+    batch->records = 0U;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,142 @@
+/******************************************************************************
+* File Name: uplink_batch.h
+*
+* Description: This file is the public interface of uplink_batch.c, the queue of
+* outbound records and the policy that decides when they are flushed to the
+* network in one batch.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef UPLINK_BATCH_H_
+#define UPLINK_BATCH_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+/* This module has no device dependencies so that it can also be built for the
+ * host machine and driven with a fake transport. See tools/uplink_batch_sim.c.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+/* Size of the queue, in bytes, including the record headers */
+#define UPLINK_BATCH_CAPACITY           (2048U)
+
+/* Every record is queued and sent with a 16-bit little-endian length header.
+ * A datagram holds as many whole records as fit in its size.
+ */
+#define UPLINK_BATCH_RECORD_HEADER      (2U)
+
+/*******************************************************************************
+* Enumerations
+*******************************************************************************/
+/* Reason a batch is flushed */
+typedef enum
+{
+    UPLINK_FLUSH_NONE = 0,
+    UPLINK_FLUSH_SIZE,          /* Queued bytes reached the threshold */
+    UPLINK_FLUSH_DEADLINE,      /* Oldest record waited the maximum delay */
+    UPLINK_FLUSH_PIGGYBACK,     /* Network stack resumed by inbound traffic */
+    UPLINK_FLUSH_REASON_COUNT
+} uplink_flush_reason_t;
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Sends one datagram. Returns false if it could not be sent. */
+typedef bool (*uplink_send_fn_t)(void *context, const uint8_t *data,
+        uint16_t length);
+
+/* Flush policy */
+typedef struct
+{
+    uint32_t flush_bytes;       /* Flush once this many bytes are queued */
+    uint32_t max_delay_ms;      /* Flush once a record waited this long */
+    uint16_t datagram_size;     /* Largest datagram sent */
+} uplink_batch_config_t;
+
+/* Counters since initialization */
+typedef struct
+{
+    uint32_t records_queued;
+    uint32_t records_dropped;   /* Queue full or record too large */
+    uint32_t records_sent;
+    uint32_t records_lost;      /* Datagram could not be sent */
+    uint32_t datagrams_sent;
+    uint32_t flushes[UPLINK_FLUSH_REASON_COUNT];
+} uplink_batch_stats_t;
+
+/* Queue state */
+typedef struct
+{
+    uplink_batch_config_t config;
+    uint8_t data[UPLINK_BATCH_CAPACITY];
+    uint32_t used;
+    uint32_t records;
+    uint32_t oldest_ms;
+    uplink_batch_stats_t stats;
+} uplink_batch_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void uplink_batch_init(uplink_batch_t *batch,
+        const uplink_batch_config_t *config);
+bool uplink_batch_enqueue(uplink_batch_t *batch, const void *record,
+        uint16_t length, uint32_t now_ms);
+uplink_flush_reason_t uplink_batch_flush_due(const uplink_batch_t *batch,
+        uint32_t now_ms, bool inbound_wake);
+uint32_t uplink_batch_time_to_deadline(const uplink_batch_t *batch,
+        uint32_t now_ms);
+void uplink_batch_flush(uplink_batch_t *batch, uplink_flush_reason_t reason,
+        uplink_send_fn_t send, void *context);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* UPLINK_BATCH_H_ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,480 @@
+/*******************************************************************************
+* File Name:   wake_filter.c
+*
+* Description: This file contains the derivation of WLAN packet filters from the
+* frames that resumed the network stack. Each wake frame is judged useful if the
+* host has a local endpoint for it, and a filter is proposed for every wake
+* reason that was never useful. A filter is a pattern matched against the
+* leading bytes of the frame, as done by the WLAN firmware.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "wake_filter.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define ETH_ADDR_LEN                    (6U)
+#define ETH_TYPE_OFFSET                 (12U)
+#define ETH_HEADER_LEN                  (14U)
+
+/* Target protocol address of an untagged ARP packet */
+#define ARP_TARGET_IP_OFFSET            (38U)
+
+/* Filters match untagged IPv4 packets without options, and IPv6 packets
+ * without extension headers. Other layouts are never filtered.
+ */
+#define IPV4_VERSION_IHL                (0x45U)
+#define IPV4_FRAG_OFFSET                (20U)
+#define IPV4_PROTO_OFFSET               (23U)
+#define IPV4_L4_OFFSET                  (34U)
+#define IPV6_VERSION                    (0x60U)
+#define IPV6_VERSION_MASK               (0xF0U)
+#define IPV6_NEXT_HEADER_OFFSET         (20U)
+#define IPV6_L4_OFFSET                  (54U)
+#define L4_DST_PORT_OFFSET              (2U)
+
+/* ICMPv6 Router Solicitation to Redirect, needed for IPv6 addressing */
+#define ICMPV6_ND_FIRST                 (133U)
+#define ICMPV6_ND_LAST                  (137U)
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: set_field
+********************************************************************************
+* Summary:
+*  Adds a field to the pattern of a filter and extends the filter over it.
+*******************************************************************************/
+static void set_field(wake_filter_t *filter, uint16_t offset,
+        const uint8_t *pattern, const uint8_t *mask, uint16_t len)
+{
+    for (uint16_t i = 0U; i < len; i++)
+    {
+        filter->pattern[offset + i] = pattern[i] & mask[i];
+        filter->mask[offset + i] = mask[i];
+    }
+
+    if ((offset + len) > filter->size)
+    {
+        filter->size = (uint16_t)(offset + len);
+    }
+}
+
+/*******************************************************************************
+* Function Name: set_u16
+********************************************************************************
+* Summary:
+*  Adds a 16-bit field in network byte order to the pattern of a filter.
+*******************************************************************************/
+static void set_u16(wake_filter_t *filter, uint16_t offset, uint16_t value)
+{
+    static const uint8_t mask[2] = { 0xFFU, 0xFFU };
+    uint8_t pattern[2] = { (uint8_t)(value >> 8U), (uint8_t)value };
+
+    set_field(filter, offset, pattern, mask, 2U);
+}
+
+/*******************************************************************************
+* Function Name: wake_filter_judge
+********************************************************************************
+* Summary:
+*  Returns whether a wake frame was used by the host. TCP and UDP segments
+*  are used when a local socket receives on their destination port, and ARP
+*  requests when they ask for the address of the host. ICMP messages are
+*  used when sent to the host only, except the IPv6 neighbor discovery and
+*  IGMP, which are needed to stay reachable. Other EtherTypes and IP
+*  protocols are dropped by lwIP. Frames that cannot be fully decoded are
+*  counted as used.
+*
+* Parameters:
+*  const wake_frame_info_t *info: Frame decoded by wake_classify_frame().
+*  const uint8_t *frame: Frame starting at the Ethernet header.
+*  size_t len: Number of bytes available in the buffer.
+*  const wake_filter_host_t *host: Local endpoints of the host.
+*
+* Return:
+*  bool: true if the frame was used.
+*
+*******************************************************************************/
+bool wake_filter_judge(const wake_frame_info_t *info, const uint8_t *frame,
+        size_t len, const wake_filter_host_t *host)
+{
+    static const uint8_t no_addr[4] = { 0U, 0U, 0U, 0U };
+
+    switch (info->key.ethertype)
+    {
+        case WAKE_ETHERTYPE_ARP:
+            /* Only untagged packets are decoded here */
+            if ((0 == memcmp(host->ipv4_addr, no_addr, sizeof(no_addr))) ||
+                (len < (ARP_TARGET_IP_OFFSET + sizeof(no_addr))) ||
+                (WAKE_ETHERTYPE_ARP != (((uint16_t)frame[ETH_TYPE_OFFSET] <<
+                        8U) | frame[ETH_TYPE_OFFSET + 1U])))
+            {
+                return true;
+            }
+            return (0 == memcmp(&frame[ARP_TARGET_IP_OFFSET],
+                    host->ipv4_addr, sizeof(no_addr)));
+
+        case WAKE_ETHERTYPE_IPV4:
+        case WAKE_ETHERTYPE_IPV6:
+            break;
+
+        case WAKE_ETHERTYPE_NONE:
+        case WAKE_ETHERTYPE_EAPOL:
+            return true;
+
+        default:
+            return false;
+    }
+
+    if (info->truncated)
+    {
+        return true;
+    }
+
+    switch (info->key.ip_proto)
+    {
+        case WAKE_IP_PROTO_TCP:
+        case WAKE_IP_PROTO_UDP:
+            return (NULL == host->port_open) || host->port_open(
+                    host->context, info->key.ip_proto, info->dst_port);
+
+        case WAKE_IP_PROTO_ICMPV6:
+            if ((info->key.port >= ICMPV6_ND_FIRST) &&
+                (info->key.port <= ICMPV6_ND_LAST))
+            {
+                return true;
+            }
+            return ((uint8_t)WAKE_CAST_UNICAST == info->key.cast);
+
+        case WAKE_IP_PROTO_ICMP:
+            return ((uint8_t)WAKE_CAST_UNICAST == info->key.cast);
+
+        case WAKE_IP_PROTO_IGMP:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+/*******************************************************************************
+* Function Name: wake_filter_table_init
+********************************************************************************
+* Summary:
+*  Clears the wake counts.
+*
+* Parameters:
+*  wake_filter_table_t *table: Table to clear.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wake_filter_table_init(wake_filter_table_t *table)
+{
+    memset(table, 0, sizeof(wake_filter_table_t));
+}
+
+/*******************************************************************************
+* Function Name: wake_filter_table_add
+********************************************************************************
+* Summary:
+*  Counts a judged wake against its reason. A new reason takes the next free
+*  entry and is ignored when all the entries are in use.
+*
+* Parameters:
+*  wake_filter_table_t *table: Table to update.
+*  const wake_key_t *key: Wake reason.
+*  bool useful: Result of wake_filter_judge().
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wake_filter_table_add(wake_filter_table_t *table, const wake_key_t *key,
+        bool useful)
+{
+    wake_filter_entry_t *entry = NULL;
+
+    for (uint32_t i = 0U; i < table->used_entries; i++)
+    {
+        const wake_key_t *entry_key = &table->entries[i].key;
+
+        if ((entry_key->ethertype == key->ethertype) &&
+            (entry_key->cast == key->cast) &&
+            (entry_key->ip_proto == key->ip_proto) &&
+            (entry_key->port == key->port))
+        {
+            entry = &table->entries[i];
+            break;
+        }
+    }
+
+    if ((NULL == entry) && (table->used_entries < WAKE_FILTER_KEYS))
+    {
+        entry = &table->entries[table->used_entries++];
+        entry->key = *key;
+    }
+
+    table->total++;
+    table->useless += useful ? 0U : 1U;
+
+    if (NULL != entry)
+    {
+        if (useful)
+        {
+            entry->useful++;
+        }
+        else
+        {
+            entry->useless++;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: wake_filter_build
+********************************************************************************
+* Summary:
+*  Builds the filter matching the frames of a wake reason: the destination
+*  address type, the EtherType and, for IP packets, the protocol and the
+*  destination port or ICMP type. Only unfragmented or first fragments are
+*  matched. ARP, EAPOL and IGMP are never filtered, nor are unicast TCP and
+*  UDP, whose port may be opened later or be the local port of a connection
+*  made by the host.
+*
+* Parameters:
+*  const wake_key_t *key: Wake reason.
+*  wake_filter_t *filter: Filled with the filter.
+*
+* Return:
+*  bool: false if the wake reason must not be filtered.
+*
+*******************************************************************************/
+bool wake_filter_build(const wake_key_t *key, wake_filter_t *filter)
+{
+    static const uint8_t broadcast[ETH_ADDR_LEN] =
+            { 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU };
+    static const uint8_t group_bit = 0x01U;
+    static const uint8_t byte_mask = 0xFFU;
+    static const uint8_t frag_mask[2] = { 0x1FU, 0xFFU };
+    static const uint8_t zero[2] = { 0U, 0U };
+    static const uint8_t ipv4_version = IPV4_VERSION_IHL;
+    static const uint8_t ipv6_version = IPV6_VERSION;
+    static const uint8_t ipv6_version_mask = IPV6_VERSION_MASK;
+    uint16_t l4_offset;
+    uint8_t proto = key->ip_proto;
+
+    memset(filter, 0, sizeof(wake_filter_t));
+    filter->key = *key;
+
+    switch (key->ethertype)
+    {
+        case WAKE_ETHERTYPE_NONE:
+        case WAKE_ETHERTYPE_ARP:
+        case WAKE_ETHERTYPE_EAPOL:
+        case WAKE_ETHERTYPE_VLAN:
+            return false;
+
+        default:
+            break;
+    }
+
+    if ((uint8_t)WAKE_CAST_BROADCAST == key->cast)
+    {
+        set_field(filter, 0U, broadcast, broadcast, ETH_ADDR_LEN);
+    }
+    else
+    {
+        set_field(filter, 0U, ((uint8_t)WAKE_CAST_MULTICAST == key->cast) ?
+                &group_bit : zero, &group_bit, 1U);
+    }
+
+    set_u16(filter, ETH_TYPE_OFFSET, key->ethertype);
+
+    if (WAKE_ETHERTYPE_IPV4 == key->ethertype)
+    {
+        set_field(filter, ETH_HEADER_LEN, &ipv4_version, &byte_mask, 1U);
+        set_field(filter, IPV4_FRAG_OFFSET, zero, frag_mask, 2U);
+        set_field(filter, IPV4_PROTO_OFFSET, &proto, &byte_mask, 1U);
+        l4_offset = IPV4_L4_OFFSET;
+    }
+    else if (WAKE_ETHERTYPE_IPV6 == key->ethertype)
+    {
+        set_field(filter, ETH_HEADER_LEN, &ipv6_version, &ipv6_version_mask,
+                1U);
+        set_field(filter, IPV6_NEXT_HEADER_OFFSET, &proto, &byte_mask, 1U);
+        l4_offset = IPV6_L4_OFFSET;
+    }
+    else
+    {
+        /* Any other EtherType is dropped by lwIP as a whole */
+        return true;
+    }
+
+    switch (proto)
+    {
+        case WAKE_IP_PROTO_TCP:
+        case WAKE_IP_PROTO_UDP:
+            if ((uint8_t)WAKE_CAST_UNICAST == key->cast)
+            {
+                return false;
+            }
+            set_u16(filter, (uint16_t)(l4_offset + L4_DST_PORT_OFFSET),
+                    key->port);
+            break;
+
+        case WAKE_IP_PROTO_ICMP:
+        case WAKE_IP_PROTO_ICMPV6:
+        {
+            uint8_t type = (uint8_t)key->port;
+
+            set_field(filter, l4_offset, &type, &byte_mask, 1U);
+            break;
+        }
+
+        case WAKE_IP_PROTO_IGMP:
+            return false;
+
+        default:
+            break;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: wake_filter_propose
+********************************************************************************
+* Summary:
+*  Proposes a filter for every wake reason counted at least min_wakes times
+*  and never used, the reasons with the most wakes first.
+*
+* Parameters:
+*  const wake_filter_table_t *table: Wake counts.
+*  uint32_t min_wakes: Wakes needed before a reason is filtered.
+*  wake_filter_t *filters: Filled with the proposed filters.
+*  uint32_t max_filters: Size of filters.
+*
+* Return:
+*  uint32_t: Number of filters proposed.
+*
+*******************************************************************************/
+uint32_t wake_filter_propose(const wake_filter_table_t *table,
+        uint32_t min_wakes, wake_filter_t *filters, uint32_t max_filters)
+{
+    uint32_t count = 0U;
+
+    for (uint32_t i = 0U; i < table->used_entries; i++)
+    {
+        const wake_filter_entry_t *entry = &table->entries[i];
+        wake_filter_t candidate;
+        uint32_t slot = count;
+
+        if ((0U != entry->useful) || (0U == entry->useless) ||
+                (entry->useless < min_wakes) ||
+                !wake_filter_build(&entry->key, &candidate))
+        {
+            continue;
+        }
+
+        candidate.wakes = entry->useless;
+
+        /* Keep the filters sorted by wakes avoided */
+        while ((slot > 0U) && (filters[slot - 1U].wakes < candidate.wakes))
+        {
+            slot--;
+        }
+
+        if (slot >= max_filters)
+        {
+            continue;
+        }
+
+        if (count < max_filters)
+        {
+            count++;
+        }
+
+        memmove(&filters[slot + 1U], &filters[slot],
+                (count - 1U - slot) * sizeof(wake_filter_t));
+        filters[slot] = candidate;
+    }
+
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: wake_filter_match
+********************************************************************************
+* Summary:
+*  Returns whether a frame matches a filter.
+*
+* Parameters:
+*  const wake_filter_t *filter: Filter.
+*  const uint8_t *frame: Frame starting at the Ethernet header.
+*  size_t len: Length of the frame.
+*
+* Return:
+*  bool: true if the frame matches.
+*
+*******************************************************************************/
+bool wake_filter_match(const wake_filter_t *filter, const uint8_t *frame,
+        size_t len)
+{
+    if (len < filter->size)
+    {
+        return false;
+    }
+
+    for (uint16_t i = 0U; i < filter->size; i++)
+    {
+        if ((frame[i] & filter->mask[i]) != filter->pattern[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+/* [] END OF FILE */
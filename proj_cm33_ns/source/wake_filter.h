@@ -0,0 +1,142 @@
+/******************************************************************************
+* File Name: wake_filter.h
+*
+* Description: This file is the public interface of wake_filter.c, which judges
+* whether the frames that resumed the network stack were used by the host and
+* derives WLAN packet filters for the wake reasons that never were.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef WAKE_FILTER_H_
+#define WAKE_FILTER_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+/* This module has no device dependencies so that it can also be built for the
+ * host machine and run against recorded captures. See
+ * tools/wake_filter_pcap.c.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "wake_reason.h"
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+/* Number of distinct wake reasons judged. Further reasons are ignored. */
+#define WAKE_FILTER_KEYS                (16U)
+
+/* Largest pattern of a filter. A filter matches the frame from its first
+ * byte, so it covers an untagged Ethernet header, an IPv6 header and the
+ * L4 ports.
+ */
+#define WAKE_FILTER_PATTERN_MAX         (WAKE_FRAME_SNAPSHOT_LEN)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Returns true if a local socket receives on the TCP or UDP port */
+typedef bool (*wake_filter_port_open_fn_t)(void *context, uint8_t ip_proto,
+        uint16_t port);
+
+/* Local endpoints of the host */
+typedef struct
+{
+    uint8_t ipv4_addr[4];               /* All zero if not known */
+    wake_filter_port_open_fn_t port_open;
+    void *context;
+} wake_filter_host_t;
+
+/* Wakes counted for one wake reason */
+typedef struct
+{
+    wake_key_t key;
+    uint32_t useful;
+    uint32_t useless;
+} wake_filter_entry_t;
+
+/* Wakes counted for every wake reason */
+typedef struct
+{
+    wake_filter_entry_t entries[WAKE_FILTER_KEYS];
+    uint32_t used_entries;
+    uint32_t total;
+    uint32_t useless;
+} wake_filter_table_t;
+
+/* Filter that keeps the frames matching the pattern from the host. A frame
+ * matches when (frame[i] & mask[i]) == pattern[i] for every i < size.
+ */
+typedef struct
+{
+    wake_key_t key;
+    uint8_t pattern[WAKE_FILTER_PATTERN_MAX];
+    uint8_t mask[WAKE_FILTER_PATTERN_MAX];
+    uint16_t size;
+    uint32_t wakes;                     /* Wakes the filter would have
+                                         * avoided */
+} wake_filter_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool wake_filter_judge(const wake_frame_info_t *info, const uint8_t *frame,
+        size_t len, const wake_filter_host_t *host);
+void wake_filter_table_init(wake_filter_table_t *table);
+void wake_filter_table_add(wake_filter_table_t *table, const wake_key_t *key,
+        bool useful);
+bool wake_filter_build(const wake_key_t *key, wake_filter_t *filter);
+uint32_t wake_filter_propose(const wake_filter_table_t *table,
+        uint32_t min_wakes, wake_filter_t *filters, uint32_t max_filters);
+bool wake_filter_match(const wake_filter_t *filter, const uint8_t *frame,
+        size_t len);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* WAKE_FILTER_H_ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,240 @@
+/*******************************************************************************
+* File Name:   wake_latency.c
+*
+* Description: This file contains the wake latency trace. The interrupt
+* handlers, the SDHC deep sleep callback, the WHD and tcpip threads and the low
+* power task timestamp the points they reach after a wake event with the
+* LPTimer, and the time between consecutive points is counted in one histogram
+* per stage.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "wake_latency.h"
+#include "app_timestamp.h"
+
+#include "lowpower_task.h"
+
+/* FreeRTOS header files */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* lwIP header files */
+#include "lwip/ip.h"
+#include "lwip/tcpip.h"
+#include "netif/ethernet.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static latency_trace_t trace;
+static latency_stages_t stages;
+
+static const char * const point_names[LATENCY_POINT_COUNT] =
+{
+    "SDHC restored",
+    "Host wake IRQ",
+    "SDIO IRQ",
+    "WHD RX",
+    "tcpip RX",
+    "Task resumed"
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: wake_latency_init
+********************************************************************************
+* Summary:
+*  Clears the trace and the histograms. Must be called after
+*  app_timestamp_init().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wake_latency_init(void)
+{
+    latency_trace_init(&trace, WAKE_LATENCY_GAP_MS, app_timestamp_tick_hz());
+    latency_stages_reset(&stages);
+}
+
+/*******************************************************************************
+* Function Name: wake_latency_mark
+********************************************************************************
+* Summary:
+*  Timestamps a point of the current wake. Can be called from interrupt
+*  context, from SysPm callbacks and from tasks.
+*
+* Parameters:
+*  latency_point_t point: Point reached.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wake_latency_mark(latency_point_t point)
+{
+    UBaseType_t state = taskENTER_CRITICAL_FROM_ISR();
+
+    latency_trace_mark(&trace, point, app_timestamp_ticks());
+
+    taskEXIT_CRITICAL_FROM_ISR(state);
+}
+
+/*******************************************************************************
+* Function Name: tcpip_thread_input
+********************************************************************************
+* Summary:
+*  Timestamps the frame in the tcpip thread and passes it to the protocol
+*  input function selected by tcpip_input().
+*******************************************************************************/
+static err_t tcpip_thread_input(struct pbuf *p, struct netif *inp)
+{
+    wake_latency_mark(LATENCY_POINT_TCPIP_RX);
+
+    if (0U != (inp->flags & (NETIF_FLAG_ETHARP | NETIF_FLAG_ETHERNET)))
+    {
+        return ethernet_input(p, inp);
+    }
+
+    return ip_input(p, inp);
+}
+
+/*******************************************************************************
+* Function Name: wake_latency_input
+********************************************************************************
+* Summary:
+*  Timestamps a frame passed up by the WHD thread and delivers it with the
+*  input function of the network interface. When that function is
+*  tcpip_input(), the frame is posted to the tcpip thread through a wrapper
+*  that also timestamps its reception there.
+*
+* Parameters:
+*  struct pbuf *p: Received frame.
+*  struct netif *inp: Network interface the frame was received on.
+*  netif_input_fn input: Input function of the network interface.
+*
+* Return:
+*  err_t: Result of the input function.
+*
+*******************************************************************************/
+err_t wake_latency_input(struct pbuf *p, struct netif *inp,
+        netif_input_fn input)
+{
+    wake_latency_mark(LATENCY_POINT_WHD_RX);
+
+    if (tcpip_input == input)
+    {
+        return tcpip_inpkt(p, inp, tcpip_thread_input);
+    }
+
+    return input(p, inp);
+}
+
+/*******************************************************************************
+* Function Name: wake_latency_resumed
+********************************************************************************
+* Summary:
+*  Closes the trace of the current wake. Called by the low power task when
+*  wait_net_suspend() returns.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wake_latency_resumed(void)
+{
+    UBaseType_t state = taskENTER_CRITICAL_FROM_ISR();
+
+    (void)latency_trace_close(&trace, &stages, app_timestamp_ticks());
+
+    taskEXIT_CRITICAL_FROM_ISR(state);
+}
+
+/*******************************************************************************
+* Function Name: wake_latency_report
+********************************************************************************
+* Summary:
+*  Prints the median, 99th percentile and maximum latency of each stage, the
+*  stage being named by the point that ends it. Can be called at any time.
+*  The resolution is one LPTimer count.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wake_latency_report(void)
+{
+    latency_hist_summary_t summary;
+
+    latency_hist_summarize(&stages.total, &summary);
+    APP_INFO(("Wake to task: %lu traced, %lu untraced, p50 %lu us, "
+            "p99 %lu us, max %lu us\n",
+            (unsigned long)summary.count,
+            (unsigned long)stages.untraced,
+            (unsigned long)summary.p50_us,
+            (unsigned long)summary.p99_us,
+            (unsigned long)summary.max_us));
+
+    for (uint32_t p = 0U; p < (uint32_t)LATENCY_POINT_COUNT; p++)
+    {
+        latency_hist_summarize(&stages.stage[p], &summary);
+        if (0U == summary.count)
+        {
+            continue;
+        }
+
+        APP_INFO(("  to %-13s %5lu: p50 %lu us, p99 %lu us, max %lu us\n",
+                point_names[p],
+                (unsigned long)summary.count,
+                (unsigned long)summary.p50_us,
+                (unsigned long)summary.p99_us,
+                (unsigned long)summary.max_us));
+    }
+}
+
+
+/* [] END OF FILE */
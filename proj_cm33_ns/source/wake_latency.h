@@ -0,0 +1,85 @@
+/******************************************************************************
+* File Name: wake_latency.h
+*
+* Description: This file is the public interface of wake_latency.c, which
+* timestamps the path from a wake event to the low power task and reports the
+* latency of each stage.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef WAKE_LATENCY_H_
+#define WAKE_LATENCY_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+#include "latency_hist.h"
+
+#include "lwip/netif.h"
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+/* A point reached more than WAKE_LATENCY_GAP_MS after the previous one starts
+ * the trace of a new wake. Keep it below ADAPTIVE_WINDOW_MIN_MS, so that the
+ * silence before a suspend always separates two wakes, and above the longest
+ * expected stage.
+ */
+#define WAKE_LATENCY_GAP_MS             (20U)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void wake_latency_init(void);
+void wake_latency_mark(latency_point_t point);
+err_t wake_latency_input(struct pbuf *p, struct netif *inp,
+        netif_input_fn input);
+void wake_latency_resumed(void);
+void wake_latency_report(void);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* WAKE_LATENCY_H_ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,469 @@
+/*******************************************************************************
+* File Name:   wake_reason.c
+*
+* Description: This file contains the classifier that decodes the Ethernet,
+* IPv4/IPv6, ARP and L4 headers of the frame that resumed the network stack, and
+* the histogram and event history of the decoded wake reasons. The classifier is
+* a pure function over a frame buffer.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "wake_reason.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define ETH_ADDR_LEN                    (6U)
+#define ETH_HEADER_LEN                  (14U)
+#define ETH_TYPE_OFFSET                 (12U)
+#define VLAN_TAG_LEN                    (4U)
+#define MAX_VLAN_TAGS                   (2U)
+
+#define ARP_OPER_OFFSET                 (6U)
+
+#define IPV4_MIN_HEADER_LEN             (20U)
+#define IPV4_FRAG_OFFSET                (6U)
+#define IPV4_FRAG_OFFSET_MASK           (0x1FFFU)
+#define IPV4_PROTO_OFFSET               (9U)
+#define IPV4_IHL_MASK                   (0x0FU)
+
+#define IPV6_HEADER_LEN                 (40U)
+#define IPV6_NEXT_HEADER_OFFSET         (6U)
+#define IPV6_EXT_HOP_BY_HOP             (0U)
+#define IPV6_EXT_ROUTING                (43U)
+#define IPV6_EXT_FRAGMENT               (44U)
+#define IPV6_EXT_DEST_OPTIONS           (60U)
+#define IPV6_FRAGMENT_HEADER_LEN        (8U)
+#define IPV6_FRAG_OFFSET_MASK           (0xFFF8U)
+#define MAX_IPV6_EXT_HEADERS            (4U)
+
+#define L4_PORTS_LEN                    (4U)
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: get_u16
+********************************************************************************
+* Summary:
+*  Reads a 16-bit value in network byte order.
+*******************************************************************************/
+static uint16_t get_u16(const uint8_t *data)
+{
+    return (uint16_t)(((uint16_t)data[0] << 8U) | data[1]);
+}
+
+/*******************************************************************************
+* Function Name: decode_l4
+********************************************************************************
+* Summary:
+*  Decodes the ports of a TCP or UDP header, or the type of an ICMP message.
+*******************************************************************************/
+static void decode_l4(const uint8_t *frame, size_t len, size_t offset,
+        wake_frame_info_t *info)
+{
+    switch (info->key.ip_proto)
+    {
+        case WAKE_IP_PROTO_TCP:
+        case WAKE_IP_PROTO_UDP:
+            if ((offset + L4_PORTS_LEN) > len)
+            {
+                info->truncated = true;
+                break;
+            }
+            info->src_port = get_u16(&frame[offset]);
+            info->dst_port = get_u16(&frame[offset + 2U]);
+            info->key.port = info->dst_port;
+            break;
+
+        case WAKE_IP_PROTO_ICMP:
+        case WAKE_IP_PROTO_ICMPV6:
+            if (offset >= len)
+            {
+                info->truncated = true;
+                break;
+            }
+            info->key.port = frame[offset];
+            break;
+
+        default:
+            break;
+    }
+}
+
+/*******************************************************************************
+* Function Name: decode_ipv4
+********************************************************************************
+* Summary:
+*  Decodes the protocol of an IPv4 header and the L4 header that follows it.
+*  Non-first fragments carry no L4 header.
+*******************************************************************************/
+static void decode_ipv4(const uint8_t *frame, size_t len, size_t offset,
+        wake_frame_info_t *info)
+{
+    size_t header_len;
+
+    if ((offset + IPV4_MIN_HEADER_LEN) > len)
+    {
+        info->truncated = true;
+        return;
+    }
+
+    info->key.ip_proto = frame[offset + IPV4_PROTO_OFFSET];
+    header_len = (size_t)(frame[offset] & IPV4_IHL_MASK) * 4U;
+
+    if ((header_len >= IPV4_MIN_HEADER_LEN) &&
+        (0U == (get_u16(&frame[offset + IPV4_FRAG_OFFSET]) &
+                IPV4_FRAG_OFFSET_MASK)))
+    {
+        decode_l4(frame, len, offset + header_len, info);
+    }
+}
+
+/*******************************************************************************
+* Function Name: decode_ipv6
+********************************************************************************
+* Summary:
+*  Decodes the upper-layer protocol of an IPv6 packet, skipping the common
+*  extension headers, and the L4 header that follows it.
+*******************************************************************************/
+static void decode_ipv6(const uint8_t *frame, size_t len, size_t offset,
+        wake_frame_info_t *info)
+{
+    uint8_t next_header;
+
+    if ((offset + IPV6_HEADER_LEN) > len)
+    {
+        info->truncated = true;
+        return;
+    }
+
+    next_header = frame[offset + IPV6_NEXT_HEADER_OFFSET];
+    offset += IPV6_HEADER_LEN;
+
+    for (uint32_t ext = 0U; ext < MAX_IPV6_EXT_HEADERS; ext++)
+    {
+        size_t ext_len;
+
+        if ((IPV6_EXT_HOP_BY_HOP != next_header) &&
+            (IPV6_EXT_ROUTING != next_header) &&
+            (IPV6_EXT_FRAGMENT != next_header) &&
+            (IPV6_EXT_DEST_OPTIONS != next_header))
+        {
+            break;
+        }
+
+        if ((offset + 2U) > len)
+        {
+            info->key.ip_proto = next_header;
+            info->truncated = true;
+            return;
+        }
+
+        if (IPV6_EXT_FRAGMENT == next_header)
+        {
+            ext_len = IPV6_FRAGMENT_HEADER_LEN;
+
+            /* Non-first fragments carry no L4 header */
+            if (((offset + 4U) > len) ||
+                (0U != (get_u16(&frame[offset + 2U]) & IPV6_FRAG_OFFSET_MASK)))
+            {
+                info->key.ip_proto = frame[offset];
+                return;
+            }
+        }
+        else
+        {
+            ext_len = ((size_t)frame[offset + 1U] + 1U) * 8U;
+        }
+
+        next_header = frame[offset];
+        offset += ext_len;
+    }
+
+    info->key.ip_proto = next_header;
+    decode_l4(frame, len, offset, info);
+}
+
+/*******************************************************************************
+* Function Name: wake_classify_frame
+********************************************************************************
+* Summary:
+*  Decodes the destination address type, the EtherType (after up to two VLAN
+*  tags), the ARP operation, the IP protocol and the L4 ports or ICMP type of
+*  a frame. Fields beyond the end of the buffer are left zero and the frame is
+*  flagged as truncated.
+*
+* Parameters:
+*  const uint8_t *frame: Frame starting at the Ethernet header.
+*  size_t len: Number of bytes available in the buffer.
+*  wake_frame_info_t *info: Filled with the decoded fields.
+*
+* Return:
+*  bool: false if the buffer does not hold a complete Ethernet header.
+*
+*******************************************************************************/
+bool wake_classify_frame(const uint8_t *frame, size_t len,
+        wake_frame_info_t *info)
+{
+    static const uint8_t broadcast_addr[ETH_ADDR_LEN] =
+            { 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU };
+    size_t offset = ETH_HEADER_LEN;
+    uint16_t ethertype;
+
+    memset(info, 0, sizeof(wake_frame_info_t));
+
+    if ((NULL == frame) || (len < ETH_HEADER_LEN))
+    {
+        info->truncated = true;
+        return false;
+    }
+
+    if (0 == memcmp(frame, broadcast_addr, ETH_ADDR_LEN))
+    {
+        info->key.cast = (uint8_t)WAKE_CAST_BROADCAST;
+    }
+    else if (0U != (frame[0] & 0x01U))
+    {
+        info->key.cast = (uint8_t)WAKE_CAST_MULTICAST;
+    }
+    else
+    {
+        info->key.cast = (uint8_t)WAKE_CAST_UNICAST;
+    }
+
+    ethertype = get_u16(&frame[ETH_TYPE_OFFSET]);
+
+    for (uint32_t tag = 0U; (tag < MAX_VLAN_TAGS) &&
+            (WAKE_ETHERTYPE_VLAN == ethertype); tag++)
+    {
+        if ((offset + VLAN_TAG_LEN) > len)
+        {
+            info->truncated = true;
+            break;
+        }
+        ethertype = get_u16(&frame[offset + 2U]);
+        offset += VLAN_TAG_LEN;
+    }
+
+    info->key.ethertype = ethertype;
+
+    switch (ethertype)
+    {
+        case WAKE_ETHERTYPE_ARP:
+            if ((offset + ARP_OPER_OFFSET + 2U) > len)
+            {
+                info->truncated = true;
+                break;
+            }
+            info->key.port = get_u16(&frame[offset + ARP_OPER_OFFSET]);
+            break;
+
+        case WAKE_ETHERTYPE_IPV4:
+            decode_ipv4(frame, len, offset, info);
+            break;
+
+        case WAKE_ETHERTYPE_IPV6:
+            decode_ipv6(frame, len, offset, info);
+            break;
+
+        default:
+            break;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: wake_classify_none
+********************************************************************************
+* Summary:
+*  Fills the wake reason used when the network stack resumed without a
+*  received frame, for example on transmit activity.
+*
+* Parameters:
+*  wake_frame_info_t *info: Filled with the wake reason.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wake_classify_none(wake_frame_info_t *info)
+{
+    memset(info, 0, sizeof(wake_frame_info_t));
+    info->key.ethertype = WAKE_ETHERTYPE_NONE;
+}
+
+/*******************************************************************************
+* Function Name: wake_histogram_init
+********************************************************************************
+* Summary:
+*  Clears the histogram and the event history.
+*
+* Parameters:
+*  wake_histogram_t *histogram: Histogram to clear.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wake_histogram_init(wake_histogram_t *histogram)
+{
+    memset(histogram, 0, sizeof(wake_histogram_t));
+}
+
+/*******************************************************************************
+* Function Name: wake_histogram_add
+********************************************************************************
+* Summary:
+*  Counts a wake reason in its bin and records it in the event history. A new
+*  reason takes the next free bin, or is counted in the overflow bin when all
+*  the bins are in use.
+*
+* Parameters:
+*  wake_histogram_t *histogram: Histogram to update.
+*  const wake_key_t *key: Wake reason.
+*  uint32_t timestamp_ms: Time of the wake event.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wake_histogram_add(wake_histogram_t *histogram, const wake_key_t *key,
+        uint32_t timestamp_ms)
+{
+    wake_event_t *event;
+    uint32_t bin;
+
+    for (bin = 0U; bin < histogram->used_bins; bin++)
+    {
+        const wake_key_t *bin_key = &histogram->bins[bin].key;
+
+        if ((bin_key->ethertype == key->ethertype) &&
+            (bin_key->cast == key->cast) &&
+            (bin_key->ip_proto == key->ip_proto) &&
+            (bin_key->port == key->port))
+        {
+            break;
+        }
+    }
+
+    if (bin < histogram->used_bins)
+    {
+        histogram->bins[bin].count++;
+    }
+    else if (histogram->used_bins < WAKE_HISTOGRAM_BINS)
+    {
+        histogram->bins[histogram->used_bins].key = *key;
+        histogram->bins[histogram->used_bins].count = 1U;
+        histogram->used_bins++;
+    }
+    else
+    {
+        histogram->overflow++;
+    }
+
+    histogram->total++;
+
+    event = &histogram->history[histogram->history_next];
+    event->timestamp_ms = timestamp_ms;
+    event->key = *key;
+    histogram->history_next = (histogram->history_next + 1U) %
+            WAKE_EVENT_HISTORY_LEN;
+}
+
+/*******************************************************************************
+* Function Name: wake_ethertype_name
+********************************************************************************
+* Summary:
+*  Returns a printable name for an EtherType.
+*
+* Parameters:
+*  uint16_t ethertype: EtherType of the wake reason.
+*
+* Return:
+*  const char *: Name of the EtherType.
+*
+*******************************************************************************/
+const char *wake_ethertype_name(uint16_t ethertype)
+{
+    switch (ethertype)
+    {
+        case WAKE_ETHERTYPE_NONE:
+            return "no frame";
+        case WAKE_ETHERTYPE_IPV4:
+            return "IPv4";
+        case WAKE_ETHERTYPE_IPV6:
+            return "IPv6";
+        case WAKE_ETHERTYPE_ARP:
+            return "ARP";
+        case WAKE_ETHERTYPE_EAPOL:
+            return "EAPOL";
+        default:
+            return "other";
+    }
+}
+
+/*******************************************************************************
+* Function Name: wake_cast_name
+********************************************************************************
+* Summary:
+*  Returns a printable name for a destination address type.
+*
+* Parameters:
+*  uint8_t cast: Destination address type of the wake reason.
+*
+* Return:
+*  const char *: Name of the address type.
+*
+*******************************************************************************/
+const char *wake_cast_name(uint8_t cast)
+{
+    switch (cast)
+    {
+        case WAKE_CAST_BROADCAST:
+            return "bcast";
+        case WAKE_CAST_MULTICAST:
+            return "mcast";
+        default:
+            return "ucast";
+    }
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,172 @@
+/******************************************************************************
+* File Name: wake_reason.h
+*
+* Description: This file is the public interface of wake_reason.c. It contains
+* the classifier that decodes the frame that resumed the network stack and the
+* histogram that counts the wake reasons.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef WAKE_REASON_H_
+#define WAKE_REASON_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+/* This module has no device dependencies so that it can also be built for the
+ * host machine and run against recorded captures.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+/* Number of leading bytes of a frame needed to classify it. Covers an
+ * Ethernet header with one VLAN tag, an IPv6 header and the L4 ports.
+ */
+#define WAKE_FRAME_SNAPSHOT_LEN         (64U)
+
+/* Number of distinct wake reasons counted. Further reasons are counted in
+ * the overflow bin.
+ */
+#define WAKE_HISTOGRAM_BINS             (16U)
+
+/* Number of most recent wake events kept with their timestamp */
+#define WAKE_EVENT_HISTORY_LEN          (16U)
+
+/* EtherType values decoded by the classifier */
+#define WAKE_ETHERTYPE_IPV4             (0x0800U)
+#define WAKE_ETHERTYPE_ARP              (0x0806U)
+#define WAKE_ETHERTYPE_VLAN             (0x8100U)
+#define WAKE_ETHERTYPE_IPV6             (0x86DDU)
+#define WAKE_ETHERTYPE_EAPOL            (0x888EU)
+
+/* EtherType used for wakes without a received frame */
+#define WAKE_ETHERTYPE_NONE             (0x0000U)
+
+/* IP protocol numbers decoded by the classifier */
+#define WAKE_IP_PROTO_ICMP              (1U)
+#define WAKE_IP_PROTO_IGMP              (2U)
+#define WAKE_IP_PROTO_TCP               (6U)
+#define WAKE_IP_PROTO_UDP               (17U)
+#define WAKE_IP_PROTO_ICMPV6            (58U)
+
+/*******************************************************************************
+* Enumerations
+*******************************************************************************/
+/* Destination address type of a frame */
+typedef enum
+{
+    WAKE_CAST_UNICAST = 0,
+    WAKE_CAST_MULTICAST,
+    WAKE_CAST_BROADCAST
+} wake_cast_t;
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Key identifying a wake reason. For ICMP and ICMPv6 the port holds the
+ * message type, and for ARP it holds the operation.
+ */
+typedef struct
+{
+    uint16_t ethertype;
+    uint8_t  cast;
+    uint8_t  ip_proto;
+    uint16_t port;
+} wake_key_t;
+
+/* Fields decoded from a frame */
+typedef struct
+{
+    wake_key_t key;
+    uint16_t   src_port;
+    uint16_t   dst_port;
+    bool       truncated;
+} wake_frame_info_t;
+
+/* Count of one wake reason */
+typedef struct
+{
+    wake_key_t key;
+    uint32_t   count;
+} wake_histogram_bin_t;
+
+/* Wake event kept in the history ring */
+typedef struct
+{
+    uint32_t   timestamp_ms;
+    wake_key_t key;
+} wake_event_t;
+
+/* Histogram of wake reasons and history of the last wake events */
+typedef struct
+{
+    wake_histogram_bin_t bins[WAKE_HISTOGRAM_BINS];
+    uint32_t             used_bins;
+    uint32_t             overflow;
+    uint32_t             total;
+    wake_event_t         history[WAKE_EVENT_HISTORY_LEN];
+    uint32_t             history_next;
+} wake_histogram_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool wake_classify_frame(const uint8_t *frame, size_t len,
+        wake_frame_info_t *info);
+void wake_classify_none(wake_frame_info_t *info);
+void wake_histogram_init(wake_histogram_t *histogram);
+void wake_histogram_add(wake_histogram_t *histogram, const wake_key_t *key,
+        uint32_t timestamp_ms);
+const char *wake_ethertype_name(uint16_t ethertype);
+const char *wake_cast_name(uint8_t cast);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* WAKE_REASON_H_ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,385 @@
+/*******************************************************************************
+* File Name:   wlan_pm.c
+*
+* Description: This file contains the WLAN power-save control. The power-save
+* mode and the listen interval are derived from the downlink latency budget and
+* the beacon interval and DTIM period of the AP, and the WLAN device is switched
+* to PM2 during bursts of traffic and back to PM1 afterwards.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "wlan_pm.h"
+#include "wlan_pm_policy.h"
+
+#include "lowpower_task.h"
+
+/* Wi-Fi connection manager header files */
+#include "cy_wcm.h"
+
+/* Wi-Fi Host Driver (WHD) header files */
+#include "whd_wifi_api.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static wlan_pm_policy_t policy;
+static TaskHandle_t wlan_pm_task_handle;
+
+/* Set when the AP must be read again */
+static volatile bool link_changed;
+
+/* Setting applied to the WLAN device */
+static wlan_pm_setting_t applied;
+static bool applied_valid;
+static uint32_t apply_count;
+static uint32_t apply_errors;
+
+static const wlan_pm_config_t wlan_pm_config =
+{
+    .latency_budget_ms      = WLAN_PM_LATENCY_BUDGET_MS,
+    .burst_frames           = WLAN_PM_BURST_FRAMES,
+    .burst_window_ms        = WLAN_PM_BURST_WINDOW_MS,
+    .burst_exit_ms          = WLAN_PM_BURST_EXIT_MS,
+    .return_to_sleep_ms     = WLAN_PM_RETURN_TO_SLEEP_MS,
+    .max_listen_interval    = WLAN_PM_MAX_LISTEN_INTERVAL
+};
+
+static const char * const mode_names[] = { "PM0", "PM1", "PM2" };
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: now_ms
+********************************************************************************
+* Summary:
+*  Returns the RTOS time in milliseconds.
+*******************************************************************************/
+static uint32_t now_ms(void)
+{
+    return (uint32_t)pdTICKS_TO_MS(xTaskGetTickCount());
+}
+
+/*******************************************************************************
+* Function Name: wlan_pm_init
+********************************************************************************
+* Summary:
+*  Initializes the policy with WLAN_PM_LATENCY_BUDGET_MS. Must be called
+*  before the scheduler is started.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wlan_pm_init(void)
+{
+    wlan_pm_policy_init(&policy, &wlan_pm_config);
+}
+
+/*******************************************************************************
+* Function Name: wlan_pm_set_latency_budget
+********************************************************************************
+* Summary:
+*  Declares the maximum downlink latency accepted by the application. The
+*  new setting is applied by the WLAN power-save task.
+*
+* Parameters:
+*  uint32_t latency_budget_ms: Maximum downlink latency, in milliseconds.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wlan_pm_set_latency_budget(uint32_t latency_budget_ms)
+{
+    taskENTER_CRITICAL();
+    wlan_pm_policy_set_budget(&policy, latency_budget_ms);
+    taskEXIT_CRITICAL();
+
+    if (NULL != wlan_pm_task_handle)
+    {
+        xTaskNotifyGive(wlan_pm_task_handle);
+    }
+}
+
+/*******************************************************************************
+* Function Name: wlan_pm_link_up
+********************************************************************************
+* Summary:
+*  Tells the WLAN power-save task that the device is connected to an AP, so
+*  that the beacon interval and DTIM period of the AP are read and the
+*  setting applied. Called after every connection.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wlan_pm_link_up(void)
+{
+    link_changed = true;
+
+    if (NULL != wlan_pm_task_handle)
+    {
+        xTaskNotifyGive(wlan_pm_task_handle);
+    }
+}
+
+/*******************************************************************************
+* Function Name: wlan_pm_frame
+********************************************************************************
+* Summary:
+*  Counts a received frame. Wakes up the WLAN power-save task only when the
+*  frame starts a burst. Runs in the context of the WHD thread.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wlan_pm_frame(void)
+{
+    bool burst;
+
+    taskENTER_CRITICAL();
+    burst = wlan_pm_policy_frame(&policy, now_ms());
+    taskEXIT_CRITICAL();
+
+    if (burst && (NULL != wlan_pm_task_handle))
+    {
+        xTaskNotifyGive(wlan_pm_task_handle);
+    }
+}
+
+/*******************************************************************************
+* Function Name: wlan_pm_report
+********************************************************************************
+* Summary:
+*  Prints the setting applied to the WLAN device.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wlan_pm_report(void)
+{
+    APP_INFO(("WLAN PM: %s, listen interval %lu %s, latency %lu ms "
+            "(budget %lu ms), %lu bursts, %lu changes, %lu errors\n",
+            mode_names[applied.mode],
+            (unsigned long)applied.listen_interval,
+            (WLAN_PM_UNIT_DTIM == applied.unit) ? "DTIM" : "beacons",
+            (unsigned long)applied.latency_ms,
+            (unsigned long)policy.config.latency_budget_ms,
+            (unsigned long)policy.bursts,
+            (unsigned long)apply_count,
+            (unsigned long)apply_errors));
+}
+
+/*******************************************************************************
+* Function Name: read_ap
+********************************************************************************
+* Summary:
+*  Reads the beacon interval and DTIM period of the AP into the policy. The
+*  defaults are kept if the AP information is not available.
+*******************************************************************************/
+static void read_ap(whd_interface_t ifp)
+{
+    whd_bss_info_t ap_info;
+    whd_security_t security;
+
+    if (WHD_SUCCESS != whd_wifi_get_ap_info(ifp, &ap_info, &security))
+    {
+        ERR_INFO(("Failed to read the beacon interval of the AP.\n"));
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    wlan_pm_policy_set_ap(&policy, ap_info.beacon_period,
+            ap_info.dtim_period);
+    taskEXIT_CRITICAL();
+
+    APP_INFO(("AP beacon interval %lu TU, DTIM %lu\n",
+            (unsigned long)ap_info.beacon_period,
+            (unsigned long)ap_info.dtim_period));
+}
+
+/*******************************************************************************
+* Function Name: setting_applied
+********************************************************************************
+* Summary:
+*  Returns true if the setting is the one applied to the WLAN device.
+*******************************************************************************/
+static bool setting_applied(const wlan_pm_setting_t *setting)
+{
+    return applied_valid && (setting->mode == applied.mode) &&
+            (setting->listen_interval == applied.listen_interval) &&
+            (setting->unit == applied.unit) &&
+            (setting->return_to_sleep_ms == applied.return_to_sleep_ms);
+}
+
+/*******************************************************************************
+* Function Name: apply_setting
+********************************************************************************
+* Summary:
+*  Applies a setting to the WLAN device. The listen interval is only set
+*  when it changes, so that a burst only costs the power-save mode change.
+*******************************************************************************/
+static void apply_setting(whd_interface_t ifp,
+        const wlan_pm_setting_t *setting)
+{
+    whd_result_t result = WHD_SUCCESS;
+
+    if ((WLAN_PM_MODE_OFF != setting->mode) && (!applied_valid ||
+            (setting->listen_interval != applied.listen_interval) ||
+            (setting->unit != applied.unit)))
+    {
+        result = whd_wifi_set_listen_interval(ifp, setting->listen_interval,
+                (WLAN_PM_UNIT_DTIM == setting->unit) ?
+                WHD_LISTEN_INTERVAL_TIME_UNIT_DTIM :
+                WHD_LISTEN_INTERVAL_TIME_UNIT_BEACON);
+    }
+
+    if (WHD_SUCCESS == result)
+    {
+        switch (setting->mode)
+        {
+            case WLAN_PM_MODE_OFF:
+                result = whd_wifi_disable_powersave(ifp);
+                break;
+
+            case WLAN_PM_MODE_PS_POLL:
+                result = whd_wifi_enable_powersave(ifp);
+                break;
+
+            default:
+                result = whd_wifi_enable_powersave_with_throughput(ifp,
+                        setting->return_to_sleep_ms);
+                break;
+        }
+    }
+
+    if (WHD_SUCCESS != result)
+    {
+        /* Try again on the next change */
+        apply_errors++;
+        applied_valid = false;
+        ERR_INFO(("Failed to set the WLAN power-save mode.\n"));
+        return;
+    }
+
+    applied = *setting;
+    applied_valid = true;
+    apply_count++;
+}
+
+/*******************************************************************************
+* Function Name: wlan_pm_task
+********************************************************************************
+* Summary:
+*  Applies the power-save setting of the policy whenever the AP, the latency
+*  budget or the burst state changes. The task only wakes up on its own to
+*  end a burst; otherwise it blocks until wlan_pm_link_up(),
+*  wlan_pm_set_latency_budget() or the first frame of a burst.
+*
+* Parameters:
+*  void *arg: Not used.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wlan_pm_task(void *arg)
+{
+    wlan_pm_setting_t setting;
+    whd_interface_t ifp = NULL;
+    uint32_t wait_ms = UINT32_MAX;
+
+    (void)arg;
+
+    wlan_pm_task_handle = xTaskGetCurrentTaskHandle();
+
+    while (true)
+    {
+        (void)ulTaskNotifyTake(pdTRUE, (UINT32_MAX == wait_ms) ?
+                portMAX_DELAY : pdMS_TO_TICKS(wait_ms));
+
+        if (link_changed)
+        {
+            link_changed = false;
+            applied_valid = false;
+
+            if (CY_RSLT_SUCCESS != cy_wcm_get_whd_interface(
+                    CY_WCM_INTERFACE_TYPE_STA, &ifp))
+            {
+                ifp = NULL;
+            }
+
+            if (NULL != ifp)
+            {
+                read_ap(ifp);
+            }
+        }
+
+        taskENTER_CRITICAL();
+        (void)wlan_pm_policy_quiet(&policy, now_ms());
+        wait_ms = wlan_pm_policy_time_to_quiet(&policy, now_ms());
+        wlan_pm_policy_setting(&policy, &setting);
+        taskEXIT_CRITICAL();
+
+        if ((NULL == ifp) || !cy_wcm_is_connected_to_ap())
+        {
+            continue;
+        }
+
+        if (!setting_applied(&setting))
+        {
+            apply_setting(ifp, &setting);
+        }
+    }
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,97 @@
+/******************************************************************************
+* File Name: wlan_pm.h
+*
+* Description: This file is the public interface of wlan_pm.c, which sets the
+* power-save mode and the listen interval of the WLAN device from the downlink
+* latency budget declared by the application.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef WLAN_PM_H_
+#define WLAN_PM_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <stdint.h>
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+#define WLAN_PM_TASK_STACK_SIZE_BYTES   (1024U)
+#define WLAN_PM_TASK_PRIORITY           (2U)
+
+/* A burst starts when WLAN_PM_BURST_FRAMES frames are received within
+ * WLAN_PM_BURST_WINDOW_MS and ends after WLAN_PM_BURST_EXIT_MS without any
+ * frame. During a burst, the WLAN device is in PM2 and returns to sleep
+ * WLAN_PM_RETURN_TO_SLEEP_MS after the last frame.
+ */
+#define WLAN_PM_BURST_FRAMES            (8U)
+#define WLAN_PM_BURST_WINDOW_MS         (100U)
+#define WLAN_PM_BURST_EXIT_MS           (1000U)
+#define WLAN_PM_RETURN_TO_SLEEP_MS      (200U)
+
+/* Largest listen interval, in beacons. The AP may disassociate a station
+ * that listens less often than the interval it advertised on association.
+ */
+#define WLAN_PM_MAX_LISTEN_INTERVAL     (10U)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void wlan_pm_init(void);
+void wlan_pm_set_latency_budget(uint32_t latency_budget_ms);
+void wlan_pm_link_up(void);
+void wlan_pm_frame(void);
+void wlan_pm_report(void);
+void wlan_pm_task(void *arg);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* WLAN_PM_H_ */
+
+
+/* [] END OF FILE */
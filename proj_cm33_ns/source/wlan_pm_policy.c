@@ -0,0 +1,286 @@
+/*******************************************************************************
+* File Name:   wlan_pm_policy.c
+*
+* Description: This file contains the power-save policy of the WLAN device. The
+* listen interval is the longest one whose worst-case downlink latency fits in
+* the latency budget, and the device is switched from PM1 to PM2 while a burst
+* of traffic is detected.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "wlan_pm_policy.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* One time unit (TU) is 1024 us */
+#define US_PER_TU                       (1024U)
+#define US_PER_MS                       (1000U)
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: wlan_pm_policy_init
+********************************************************************************
+* Summary:
+*  Initializes the policy with the default beacon interval and DTIM period.
+*
+* Parameters:
+*  wlan_pm_policy_t *policy: Policy state.
+*  const wlan_pm_config_t *config: Latency budget and burst detection.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wlan_pm_policy_init(wlan_pm_policy_t *policy,
+        const wlan_pm_config_t *config)
+{
+    memset(policy, 0, sizeof(wlan_pm_policy_t));
+    policy->config = *config;
+    policy->beacon_tu = WLAN_PM_DEFAULT_BEACON_TU;
+    policy->dtim = WLAN_PM_DEFAULT_DTIM;
+}
+
+/*******************************************************************************
+* Function Name: wlan_pm_policy_set_ap
+********************************************************************************
+* Summary:
+*  Sets the beacon interval and DTIM period of the AP.
+*
+* Parameters:
+*  wlan_pm_policy_t *policy: Policy state.
+*  uint16_t beacon_tu: Beacon interval, in TU.
+*  uint8_t dtim: DTIM period, in beacons.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wlan_pm_policy_set_ap(wlan_pm_policy_t *policy, uint16_t beacon_tu,
+        uint8_t dtim)
+{
+    policy->beacon_tu = (0U != beacon_tu) ? beacon_tu :
+            WLAN_PM_DEFAULT_BEACON_TU;
+    policy->dtim = (0U != dtim) ? dtim : WLAN_PM_DEFAULT_DTIM;
+}
+
+/*******************************************************************************
+* Function Name: wlan_pm_policy_set_budget
+********************************************************************************
+* Summary:
+*  Sets the maximum downlink latency accepted by the application.
+*
+* Parameters:
+*  wlan_pm_policy_t *policy: Policy state.
+*  uint32_t latency_budget_ms: Maximum downlink latency, in milliseconds.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wlan_pm_policy_set_budget(wlan_pm_policy_t *policy,
+        uint32_t latency_budget_ms)
+{
+    policy->config.latency_budget_ms = latency_budget_ms;
+}
+
+/*******************************************************************************
+* Function Name: wlan_pm_policy_frame
+********************************************************************************
+* Summary:
+*  Counts a frame. A burst starts when burst_frames frames are counted within
+*  burst_window_ms.
+*
+* Parameters:
+*  wlan_pm_policy_t *policy: Policy state.
+*  uint32_t now_ms: Time of the frame.
+*
+* Return:
+*  bool: true if the frame started a burst.
+*
+*******************************************************************************/
+bool wlan_pm_policy_frame(wlan_pm_policy_t *policy, uint32_t now_ms)
+{
+    if ((now_ms - policy->window_start_ms) >= policy->config.burst_window_ms)
+    {
+        policy->window_start_ms = now_ms;
+        policy->window_frames = 0U;
+    }
+
+    policy->window_frames++;
+    policy->last_frame_ms = now_ms;
+
+    if (!policy->burst &&
+            (policy->window_frames >= policy->config.burst_frames))
+    {
+        policy->burst = true;
+        policy->bursts++;
+        return true;
+    }
+
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: wlan_pm_policy_quiet
+********************************************************************************
+* Summary:
+*  Ends the burst when no frame was counted for burst_exit_ms.
+*
+* Parameters:
+*  wlan_pm_policy_t *policy: Policy state.
+*  uint32_t now_ms: Current time.
+*
+* Return:
+*  bool: true if the burst ended.
+*
+*******************************************************************************/
+bool wlan_pm_policy_quiet(wlan_pm_policy_t *policy, uint32_t now_ms)
+{
+    if (policy->burst &&
+            ((now_ms - policy->last_frame_ms) >= policy->config.burst_exit_ms))
+    {
+        policy->burst = false;
+        return true;
+    }
+
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: wlan_pm_policy_time_to_quiet
+********************************************************************************
+* Summary:
+*  Returns the time until the burst ends if no other frame is counted.
+*
+* Parameters:
+*  const wlan_pm_policy_t *policy: Policy state.
+*  uint32_t now_ms: Current time.
+*
+* Return:
+*  uint32_t: Time in milliseconds, UINT32_MAX if there is no burst.
+*
+*******************************************************************************/
+uint32_t wlan_pm_policy_time_to_quiet(const wlan_pm_policy_t *policy,
+        uint32_t now_ms)
+{
+    uint32_t quiet_ms = now_ms - policy->last_frame_ms;
+
+    if (!policy->burst)
+    {
+        return UINT32_MAX;
+    }
+
+    return (quiet_ms >= policy->config.burst_exit_ms) ?
+            0U : (policy->config.burst_exit_ms - quiet_ms);
+}
+
+/*******************************************************************************
+* Function Name: wlan_pm_policy_setting
+********************************************************************************
+* Summary:
+*  Returns the power-save setting for the latency budget. A frame buffered by
+*  the AP waits at most one listen interval before the device wakes up to
+*  receive the beacon announcing it. The device stays in PM0 if even a listen
+*  interval of one beacon exceeds the budget. Otherwise the listen interval is
+*  the largest number of beacons within the budget, rounded down to a whole
+*  number of DTIM periods when it reaches one so that the broadcast frames
+*  are still received. The device is in PM1 except during a burst, where PM2
+*  keeps it awake between the frames.
+*
+* Parameters:
+*  const wlan_pm_policy_t *policy: Policy state.
+*  wlan_pm_setting_t *setting: Filled with the setting.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wlan_pm_policy_setting(const wlan_pm_policy_t *policy,
+        wlan_pm_setting_t *setting)
+{
+    uint32_t beacon_us = (uint32_t)policy->beacon_tu * US_PER_TU;
+    uint32_t beacons = (uint32_t)(((uint64_t)policy->config.latency_budget_ms *
+            US_PER_MS) / beacon_us);
+    uint32_t return_to_sleep_ms = policy->config.return_to_sleep_ms;
+
+    memset(setting, 0, sizeof(wlan_pm_setting_t));
+
+    if (0U == beacons)
+    {
+        setting->mode = WLAN_PM_MODE_OFF;
+        return;
+    }
+
+    if (beacons > policy->config.max_listen_interval)
+    {
+        beacons = policy->config.max_listen_interval;
+    }
+
+    if (beacons >= policy->dtim)
+    {
+        setting->unit = WLAN_PM_UNIT_DTIM;
+        setting->listen_interval = (uint8_t)(beacons / policy->dtim);
+        beacons = setting->listen_interval * (uint32_t)policy->dtim;
+    }
+    else
+    {
+        setting->unit = WLAN_PM_UNIT_BEACON;
+        setting->listen_interval = (uint8_t)beacons;
+    }
+
+    return_to_sleep_ms -= return_to_sleep_ms % WLAN_PM_RETURN_TO_SLEEP_MIN_MS;
+    if (return_to_sleep_ms < WLAN_PM_RETURN_TO_SLEEP_MIN_MS)
+    {
+        return_to_sleep_ms = WLAN_PM_RETURN_TO_SLEEP_MIN_MS;
+    }
+    else if (return_to_sleep_ms > WLAN_PM_RETURN_TO_SLEEP_MAX_MS)
+    {
+        return_to_sleep_ms = WLAN_PM_RETURN_TO_SLEEP_MAX_MS;
+    }
+
+    setting->mode = policy->burst ?
+            WLAN_PM_MODE_THROUGHPUT : WLAN_PM_MODE_PS_POLL;
+    setting->return_to_sleep_ms = (uint16_t)return_to_sleep_ms;
+    setting->latency_ms = (beacons * beacon_us) / US_PER_MS;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,151 @@
+/******************************************************************************
+* File Name: wlan_pm_policy.h
+*
+* Description: This file is the public interface of wlan_pm_policy.c, which
+* derives the power-save mode and the listen interval of the WLAN device from a
+* downlink latency budget and detects traffic bursts.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef WLAN_PM_POLICY_H_
+#define WLAN_PM_POLICY_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+/* This module has no device dependencies so that it can also be built for the
+ * host machine.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+/* Limits of the return to sleep delay of PM2 accepted by the WLAN firmware.
+ * The delay must also be a multiple of the minimum.
+ */
+#define WLAN_PM_RETURN_TO_SLEEP_MIN_MS  (10U)
+#define WLAN_PM_RETURN_TO_SLEEP_MAX_MS  (2000U)
+
+/* Beacon interval and DTIM period used until the AP is known */
+#define WLAN_PM_DEFAULT_BEACON_TU       (100U)
+#define WLAN_PM_DEFAULT_DTIM            (1U)
+
+/*******************************************************************************
+* Enumerations
+*******************************************************************************/
+/* Power-save modes of the WLAN device */
+typedef enum
+{
+    WLAN_PM_MODE_OFF = 0,       /* PM0: radio always on */
+    WLAN_PM_MODE_PS_POLL,       /* PM1: sleeps between listen intervals */
+    WLAN_PM_MODE_THROUGHPUT     /* PM2: stays awake while there is traffic */
+} wlan_pm_mode_t;
+
+/* Unit of the listen interval */
+typedef enum
+{
+    WLAN_PM_UNIT_BEACON = 0,
+    WLAN_PM_UNIT_DTIM
+} wlan_pm_unit_t;
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    uint32_t latency_budget_ms;     /* Maximum downlink latency accepted */
+    uint32_t burst_frames;          /* Frames within burst_window_ms that
+                                     * start a burst */
+    uint32_t burst_window_ms;
+    uint32_t burst_exit_ms;         /* Quiet time that ends a burst */
+    uint16_t return_to_sleep_ms;    /* PM2 delay during a burst */
+    uint8_t max_listen_interval;    /* Largest listen interval, in beacons */
+} wlan_pm_config_t;
+
+/* Power-save setting of the WLAN device */
+typedef struct
+{
+    wlan_pm_mode_t mode;
+    uint8_t listen_interval;
+    wlan_pm_unit_t unit;
+    uint16_t return_to_sleep_ms;    /* Only used in WLAN_PM_MODE_THROUGHPUT */
+    uint32_t latency_ms;            /* Worst-case downlink latency */
+} wlan_pm_setting_t;
+
+/* Policy state */
+typedef struct
+{
+    wlan_pm_config_t config;
+    uint16_t beacon_tu;
+    uint8_t dtim;
+    bool burst;
+    uint32_t window_start_ms;
+    uint32_t window_frames;
+    uint32_t last_frame_ms;
+    uint32_t bursts;
+} wlan_pm_policy_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void wlan_pm_policy_init(wlan_pm_policy_t *policy,
+        const wlan_pm_config_t *config);
+void wlan_pm_policy_set_ap(wlan_pm_policy_t *policy, uint16_t beacon_tu,
+        uint8_t dtim);
+void wlan_pm_policy_set_budget(wlan_pm_policy_t *policy,
+        uint32_t latency_budget_ms);
+bool wlan_pm_policy_frame(wlan_pm_policy_t *policy, uint32_t now_ms);
+bool wlan_pm_policy_quiet(wlan_pm_policy_t *policy, uint32_t now_ms);
+uint32_t wlan_pm_policy_time_to_quiet(const wlan_pm_policy_t *policy,
+        uint32_t now_ms);
+void wlan_pm_policy_setting(const wlan_pm_policy_t *policy,
+        wlan_pm_setting_t *setting);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* WLAN_PM_POLICY_H_ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,149 @@
+/*******************************************************************************
+* File Name:   feature_extract.c
+*
+* Description: This file contains the feature extraction run by the CM55 on a
+* window of samples: minimum, maximum, mean, RMS and zero crossings. The loops
+* have no data-dependent branches so that the compiler can vectorize them for
+* the Helium extension of the CM55.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "feature_extract.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: isqrt
+********************************************************************************
+* Summary:
+*  Returns the integer square root of a value.
+*******************************************************************************/
+static uint32_t isqrt(uint64_t value)
+{
+    uint64_t root = 0U;
+    uint64_t bit = 1ULL << 62U;
+
+    while (bit > value)
+    {
+        bit >>= 2U;
+    }
+
+    while (0U != bit)
+    {
+        if (value >= (root + bit))
+        {
+            value -= root + bit;
+            root = (root >> 1U) + bit;
+        }
+        else
+        {
+            root >>= 1U;
+        }
+        bit >>= 2U;
+    }
+
+    return (uint32_t)root;
+}
+
+/*******************************************************************************
+* Function Name: feature_extract
+********************************************************************************
+* Summary:
+*  Computes the features of a window of samples. The RMS and the zero
+*  crossings are computed around the mean of the window.
+*
+* Parameters:
+*  const int16_t *samples: Samples of the window.
+*  size_t count: Number of samples, at most 65535.
+*  uint32_t window: Window number stored in the record.
+*  feature_record_t *record: Filled with the features.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void feature_extract(const int16_t *samples, size_t count, uint32_t window,
+        feature_record_t *record)
+{
+    int32_t min = INT16_MAX;
+    int32_t max = INT16_MIN;
+    int64_t sum = 0;
+    uint64_t square_sum = 0U;
+    uint32_t crossings = 0U;
+    int32_t mean;
+
+    memset(record, 0, sizeof(feature_record_t));
+    record->window = window;
+
+    if (0U == count)
+    {
+        return;
+    }
+
+    for (size_t i = 0U; i < count; i++)
+    {
+        min = (samples[i] < min) ? samples[i] : min;
+        max = (samples[i] > max) ? samples[i] : max;
+        sum += samples[i];
+    }
+
+    mean = (int32_t)(sum / (int64_t)count);
+
+    for (size_t i = 0U; i < count; i++)
+    {
+        int32_t centered = samples[i] - mean;
+
+        square_sum += (uint64_t)((int64_t)centered * centered);
+    }
+
+    for (size_t i = 1U; i < count; i++)
+    {
+        crossings += (uint32_t)(((samples[i - 1U] - mean) ^
+                (samples[i] - mean)) < 0);
+    }
+
+    record->min = (int16_t)min;
+    record->max = (int16_t)max;
+    record->mean = (int16_t)mean;
+    record->rms = (uint16_t)isqrt(square_sum / count);
+    record->zero_crossings = (uint16_t)crossings;
+}
+
+
+/* [] END OF FILE */
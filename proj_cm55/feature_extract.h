@@ -0,0 +1,88 @@
+/******************************************************************************
+* File Name: feature_extract.h
+*
+* Description: This file is the public interface of feature_extract.c. It
+* contains the record of the features extracted from a window of samples by the
+* CM55.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef FEATURE_EXTRACT_H_
+#define FEATURE_EXTRACT_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+/* This module has no device dependencies so that it can also be built for the
+ * host machine.
+ */
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Features of one window of samples, 16 bytes */
+typedef struct
+{
+    uint32_t window;            /* Window number */
+    int16_t min;
+    int16_t max;
+    int16_t mean;
+    uint16_t rms;
+    uint16_t zero_crossings;    /* Sign changes around the mean */
+    uint16_t reserved;
+} feature_record_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void feature_extract(const int16_t *samples, size_t count, uint32_t window,
+        feature_record_t *record);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* FEATURE_EXTRACT_H_ */
+
+
+/* [] END OF FILE */
@@ -40,6 +40,8 @@
 #include "cyabs_rtos.h"
 #include "cyabs_rtos_impl.h"
 #include "cy_time.h"
+#include "ipc_config.h"
+#include "pipeline_task.h"
 
 /*******************************************************************************
  * Macros
@@ -120,6 +122,7 @@ static void setup_clib_support(void)
 }
 
 
+#if (IPC_PIPELINE_ENABLE != 1U)
 /*******************************************************************************
 * Function Name: cm55_task
 ********************************************************************************
@@ -143,6 +146,7 @@ static void cm55_task(void * arg)
         vTaskSuspend(NULL);
     }
 }
+#endif /* (IPC_PIPELINE_ENABLE != 1U) */
 
 /*******************************************************************************
 * Function Name: lptimer_interrupt_handler
@@ -275,10 +279,17 @@ int main(void)
     /* Enable global interrupts */
     __enable_irq();
 
+#if (IPC_PIPELINE_ENABLE == 1U)
+    /* Create the task processing the data handed to the CM33 */
+    result = xTaskCreate(pipeline_task, TASK_NAME,
+                        TASK_STACK_SIZE, NULL,
+                        TASK_PRIORITY, NULL);
+#else
     /* Create the FreeRTOS Task */
     result = xTaskCreate(cm55_task, TASK_NAME,
                         TASK_STACK_SIZE, NULL,
                         TASK_PRIORITY, NULL);
+#endif /* (IPC_PIPELINE_ENABLE == 1U) */
     if( pdPASS == result )
     {
         /* Start the RTOS Scheduler */
@@ -0,0 +1,228 @@
+/*******************************************************************************
+* File Name:   pipeline_task.c
+*
+* Description: This file contains the CM55 side of the inter-core data pipeline.
+* Every window of samples is reduced to a feature record written directly into a
+* buffer of the shared area, and full buffers are handed to the CM33, which
+* sends them.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "pipeline_task.h"
+
+#include "cybsp.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "ipc_config.h"
+#include "ipc_doorbell.h"
+#include "ipc_pipeline.h"
+#include "feature_extract.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Parameters of the synthetic input signal */
+#define SIGNAL_PERIOD_SAMPLES           (64)
+#define SIGNAL_AMPLITUDE                (8000)
+#define SIGNAL_NOISE_MASK               (0x1FFU)
+#define SIGNAL_SEED                     (0x2545F491UL)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static ipc_pipeline_t pipeline;
+static int16_t samples[PIPELINE_WINDOW_SAMPLES];
+static uint32_t noise_state = SIGNAL_SEED;
+static uint32_t signal_phase;
+
+/* Windows dropped because the CM33 had not returned any buffer */
+static uint32_t dropped_windows;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: dcache_clean
+********************************************************************************
+* Summary:
+*  Writes the data cache lines covering an area back to SOCMEM.
+*******************************************************************************/
+static void dcache_clean(const volatile void *addr, size_t size)
+{
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    SCB_CleanDCache_by_Addr((volatile void *)addr, (int32_t)size);
+#else
+    CY_UNUSED_PARAMETER(addr);
+    CY_UNUSED_PARAMETER(size);
+#endif /* defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U) */
+}
+
+/*******************************************************************************
+* Function Name: dcache_invalidate
+********************************************************************************
+* Summary:
+*  Discards the data cache lines covering an area of SOCMEM.
+*******************************************************************************/
+static void dcache_invalidate(volatile void *addr, size_t size)
+{
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    SCB_InvalidateDCache_by_Addr(addr, (int32_t)size);
+#else
+    CY_UNUSED_PARAMETER(addr);
+    CY_UNUSED_PARAMETER(size);
+#endif /* defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U) */
+}
+
+static const ipc_cache_ops_t cache_ops =
+{
+    .clean      = dcache_clean,
+    .invalidate = dcache_invalidate
+};
+
+/*******************************************************************************
+* Function Name: now_ms
+********************************************************************************
+* Summary:
+*  Returns the RTOS time, in milliseconds.
+*******************************************************************************/
+static uint32_t now_ms(void)
+{
+    return (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+}
+
+/*******************************************************************************
+* Function Name: read_samples
+********************************************************************************
+* Summary:
+*  Fills the window with the next samples of a synthetic triangle wave with
+*  noise. Replace this function with the driver of the sensor.
+*******************************************************************************/
+static void read_samples(int16_t *window, uint32_t count)
+{
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        int32_t phase = (int32_t)(signal_phase++ % SIGNAL_PERIOD_SAMPLES);
+        int32_t triangle = (phase < (SIGNAL_PERIOD_SAMPLES / 2)) ?
+                phase : (SIGNAL_PERIOD_SAMPLES - phase);
+
+        noise_state ^= noise_state << 13U;
+        noise_state ^= noise_state >> 17U;
+        noise_state ^= noise_state << 5U;
+
+        window[i] = (int16_t)((((triangle * 4 * SIGNAL_AMPLITUDE) /
+                SIGNAL_PERIOD_SAMPLES) - SIGNAL_AMPLITUDE) +
+                (int32_t)(noise_state & SIGNAL_NOISE_MASK));
+    }
+}
+
+/*******************************************************************************
+* Function Name: pipeline_task
+********************************************************************************
+* Summary:
+*  Waits for the CM33 to initialize the shared area, then processes a window
+*  of samples every PIPELINE_WINDOW_PERIOD_MS. The feature record of each
+*  window is appended to the current shared buffer, which is submitted to the
+*  CM33 when the next record does not fit. If the CM33 has not returned any
+*  buffer, the window is dropped.
+*
+* Parameters:
+*  void *arg: Not used.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void pipeline_task(void *arg)
+{
+    ipc_pipeline_buffer_t *buffer = NULL;
+    uint32_t window = 0U;
+    TickType_t wake_time;
+    bool doorbell;
+
+    CY_UNUSED_PARAMETER(arg);
+
+    while (!ipc_pipeline_attach(&pipeline,
+            (ipc_pipeline_shared_t *)IPC_SHARED_SOCMEM_ADDR, &cache_ops))
+    {
+        vTaskDelay(pdMS_TO_TICKS(PIPELINE_ATTACH_POLL_MS));
+    }
+
+    wake_time = xTaskGetTickCount();
+
+    for (;;)
+    {
+        vTaskDelayUntil(&wake_time, pdMS_TO_TICKS(PIPELINE_WINDOW_PERIOD_MS));
+
+        read_samples(samples, PIPELINE_WINDOW_SAMPLES);
+        doorbell = false;
+
+        if (NULL == buffer)
+        {
+            buffer = ipc_pipeline_acquire(&pipeline);
+        }
+
+        if (NULL == buffer)
+        {
+            dropped_windows++;
+            window++;
+        }
+        else
+        {
+            feature_extract(samples, PIPELINE_WINDOW_SAMPLES, window++,
+                    (feature_record_t *)&buffer->data[buffer->length]);
+            buffer->length += sizeof(feature_record_t);
+
+            if ((buffer->length + sizeof(feature_record_t)) >
+                    IPC_PIPELINE_BUFFER_SIZE)
+            {
+                /* The tag carries the number of windows dropped so far */
+                buffer->tag = dropped_windows;
+                doorbell = ipc_pipeline_submit(&pipeline, buffer, now_ms());
+                buffer = NULL;
+            }
+        }
+
+        /* Honour the deadline of the CM33 even when no buffer is submitted */
+        if (doorbell || ipc_pipeline_doorbell_due(&pipeline, now_ms()))
+        {
+            ipc_doorbell_ring(IPC_DOORBELL_CM33_INTR);
+        }
+    }
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,85 @@
+/******************************************************************************
+* File Name: ipc_config.h
+*
+* Description: This file contains the configuration shared by the CM33 and CM55
+* applications for the inter-core data pipeline. Both applications must be built
+* with the same values.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef IPC_CONFIG_H_
+#define IPC_CONFIG_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+/* Set to 1 to run the payload processing on the CM55 and hand the results to
+ * the CM33 for transmission. Otherwise, the CM55 stays in deep sleep.
+ */
+#define IPC_PIPELINE_ENABLE             (0U)
+
+/* Address of the shared area, seen identically by both cores. It must point
+ * to a SOCMEM area of at least sizeof(ipc_pipeline_shared_t) bytes that is
+ * not used by any application image. SOCMEM is then retained in deep sleep
+ * instead of being powered off.
+ */
+#define IPC_SHARED_SOCMEM_ADDR          (0x26400000UL)
+
+/* IPC interrupt structure raised by the CM55 to wake the CM33, and notify
+ * channel used. They must not be used by any other IPC user of the
+ * application. IPC_DOORBELL_CM33_IRQ is the deep-sleep capable interrupt of
+ * that structure on the CM33.
+ */
+#define IPC_DOORBELL_CM33_INTR          (4U)
+#define IPC_DOORBELL_CHANNEL            (15U)
+#define IPC_DOORBELL_CM33_IRQ           ((IRQn_Type)( \
+        (uint32_t)m33syscpuss_interrupts_ipc_dpslp_0_IRQn + \
+        IPC_DOORBELL_CM33_INTR))
+#define IPC_DOORBELL_INTERRUPT_PRIORITY (3U)
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* IPC_CONFIG_H_ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,137 @@
+/*******************************************************************************
+* File Name:   ipc_doorbell.c
+*
+* Description: This file contains the doorbell interrupts between the CM33 and
+* the CM55. A doorbell is the notify event of IPC_DOORBELL_CHANNEL on an IPC
+* interrupt structure, which wakes the receiving core from deep sleep. No IPC
+* channel is locked and no message is sent: the data is in the shared rings.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "ipc_doorbell.h"
+
+#include "ipc_config.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define IPC_DOORBELL_NOTIFY_MASK        (1UL << IPC_DOORBELL_CHANNEL)
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: ipc_doorbell_init
+********************************************************************************
+* Summary:
+*  Enables the doorbell interrupt of an IPC interrupt structure on the
+*  calling core.
+*
+* Parameters:
+*  uint32_t intr: IPC interrupt structure.
+*  IRQn_Type irq: Interrupt of the structure on the calling core.
+*  uint32_t priority: Interrupt priority.
+*  cy_israddress handler: Interrupt handler, which must call
+*  ipc_doorbell_clear().
+*
+* Return:
+*  cy_en_sysint_status_t: Result of the interrupt initialization.
+*
+*******************************************************************************/
+cy_en_sysint_status_t ipc_doorbell_init(uint32_t intr, IRQn_Type irq,
+        uint32_t priority, cy_israddress handler)
+{
+    cy_stc_sysint_t intr_cfg =
+    {
+        .intrSrc = irq,
+        .intrPriority = priority
+    };
+    IPC_INTR_STRUCT_Type *base = Cy_IPC_Drv_GetIntrBaseAddr(intr);
+    cy_en_sysint_status_t status = Cy_SysInt_Init(&intr_cfg, handler);
+
+    if (CY_SYSINT_SUCCESS == status)
+    {
+        Cy_IPC_Drv_ClearInterrupt(base, 0U, IPC_DOORBELL_NOTIFY_MASK);
+        Cy_IPC_Drv_SetInterruptMask(base, 0U, IPC_DOORBELL_NOTIFY_MASK);
+        NVIC_EnableIRQ(irq);
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: ipc_doorbell_ring
+********************************************************************************
+* Summary:
+*  Raises the doorbell interrupt of an IPC interrupt structure.
+*
+* Parameters:
+*  uint32_t intr: IPC interrupt structure of the core to wake.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ipc_doorbell_ring(uint32_t intr)
+{
+    Cy_IPC_Drv_SetInterrupt(Cy_IPC_Drv_GetIntrBaseAddr(intr), 0U,
+            IPC_DOORBELL_NOTIFY_MASK);
+}
+
+/*******************************************************************************
+* Function Name: ipc_doorbell_clear
+********************************************************************************
+* Summary:
+*  Acknowledges the doorbell interrupt. The status is read back so that the
+*  interrupt is cleared before the handler returns.
+*
+* Parameters:
+*  uint32_t intr: IPC interrupt structure of the calling core.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ipc_doorbell_clear(uint32_t intr)
+{
+    IPC_INTR_STRUCT_Type *base = Cy_IPC_Drv_GetIntrBaseAddr(intr);
+
+    Cy_IPC_Drv_ClearInterrupt(base, 0U, IPC_DOORBELL_NOTIFY_MASK);
+    (void)Cy_IPC_Drv_GetInterruptStatusMasked(base);
+}
+
+
+/* [] END OF FILE */
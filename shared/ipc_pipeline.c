@@ -0,0 +1,396 @@
+/*******************************************************************************
+* File Name:   ipc_pipeline.c
+*
+* Description: This file contains the zero-copy buffer pipeline between the CM55
+* and the CM33. The CM55 takes a free buffer, fills it in place and submits it.
+* The CM33 receives the buffer, sends its payload, and returns it to the free
+* ring. Only buffer indexes move between the cores, in ipc_ring.c descriptors.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "ipc_pipeline.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Size of the buffer header, in bytes */
+#define IPC_PIPELINE_HEADER_SIZE        (offsetof(ipc_pipeline_buffer_t, data))
+
+_Static_assert(IPC_PIPELINE_BUFFER_COUNT <= IPC_RING_SIZE,
+        "The free ring must hold all the buffers");
+_Static_assert((IPC_PIPELINE_BUFFER_SIZE % IPC_CACHE_LINE_SIZE) == 0U,
+        "IPC_PIPELINE_BUFFER_SIZE must be a multiple of the cache line size");
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: open_rings
+********************************************************************************
+* Summary:
+*  Initializes the handle of the calling core.
+*******************************************************************************/
+static void open_rings(ipc_pipeline_t *pipeline, ipc_pipeline_shared_t *shared,
+        const ipc_cache_ops_t *cache)
+{
+    pipeline->shared = shared;
+    pipeline->cache = cache;
+    pipeline->next_seq = 0U;
+
+    ipc_ring_open(&pipeline->ready, &shared->ready, cache);
+    ipc_ring_open(&pipeline->free, &shared->free, cache);
+}
+
+/*******************************************************************************
+* Function Name: buffer_desc
+********************************************************************************
+* Summary:
+*  Fills the descriptor of a buffer.
+*******************************************************************************/
+static void buffer_desc(const ipc_pipeline_t *pipeline,
+        const ipc_pipeline_buffer_t *buffer, ipc_ring_desc_t *desc)
+{
+    memset(desc, 0, sizeof(ipc_ring_desc_t));
+    desc->type = IPC_PIPELINE_DESC_BUFFER;
+    desc->length = (uint16_t)buffer->length;
+    desc->arg[0] = (uint32_t)(buffer - pipeline->shared->buffers);
+    desc->arg[1] = buffer->seq;
+}
+
+/*******************************************************************************
+* Function Name: desc_buffer
+********************************************************************************
+* Summary:
+*  Returns the buffer of a descriptor, or NULL if the descriptor is invalid.
+*******************************************************************************/
+static ipc_pipeline_buffer_t *desc_buffer(const ipc_pipeline_t *pipeline,
+        const ipc_ring_desc_t *desc)
+{
+    if ((IPC_PIPELINE_DESC_BUFFER != desc->type) ||
+        (desc->arg[0] >= IPC_PIPELINE_BUFFER_COUNT))
+    {
+        return NULL;
+    }
+
+    return &pipeline->shared->buffers[desc->arg[0]];
+}
+
+/*******************************************************************************
+* Function Name: ipc_pipeline_init
+********************************************************************************
+* Summary:
+*  Initializes the shared area with all the buffers in the free ring. Called
+*  by the CM33 before the CM55 is enabled. The magic number is written last so
+*  that the CM55 does not attach to a partly initialized area.
+*
+* Parameters:
+*  ipc_pipeline_t *pipeline: Handle of the calling core.
+*  ipc_pipeline_shared_t *shared: Shared area.
+*  const ipc_cache_ops_t *cache: Cache maintenance of the calling core.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ipc_pipeline_init(ipc_pipeline_t *pipeline, ipc_pipeline_shared_t *shared,
+        const ipc_cache_ops_t *cache)
+{
+    ipc_ring_desc_t desc;
+    bool doorbell;
+
+    memset(shared, 0, IPC_CACHE_LINE_SIZE);
+    shared->version = IPC_PIPELINE_VERSION;
+    shared->buffer_count = IPC_PIPELINE_BUFFER_COUNT;
+    shared->buffer_size = IPC_PIPELINE_BUFFER_SIZE;
+
+    ipc_ring_init(&shared->ready, cache);
+    ipc_ring_init(&shared->free, cache);
+    open_rings(pipeline, shared, cache);
+
+    for (uint32_t i = 0U; i < IPC_PIPELINE_BUFFER_COUNT; i++)
+    {
+        shared->buffers[i].length = 0U;
+        buffer_desc(pipeline, &shared->buffers[i], &desc);
+        (void)ipc_ring_push(&pipeline->free, &desc, 0U, &doorbell);
+    }
+
+    if ((NULL != cache) && (NULL != cache->clean))
+    {
+        cache->clean(shared->buffers, sizeof(shared->buffers));
+    }
+
+    atomic_store_explicit(&shared->magic, IPC_PIPELINE_MAGIC,
+            memory_order_release);
+
+    if ((NULL != cache) && (NULL != cache->clean))
+    {
+        cache->clean(shared, IPC_CACHE_LINE_SIZE);
+    }
+}
+
+/*******************************************************************************
+* Function Name: ipc_pipeline_attach
+********************************************************************************
+* Summary:
+*  Attaches the CM55 to a shared area initialized by the CM33.
+*
+* Parameters:
+*  ipc_pipeline_t *pipeline: Handle of the calling core.
+*  ipc_pipeline_shared_t *shared: Shared area.
+*  const ipc_cache_ops_t *cache: Cache maintenance of the calling core.
+*
+* Return:
+*  bool: false if the area is not initialized yet or has another layout.
+*
+*******************************************************************************/
+bool ipc_pipeline_attach(ipc_pipeline_t *pipeline,
+        ipc_pipeline_shared_t *shared, const ipc_cache_ops_t *cache)
+{
+    open_rings(pipeline, shared, cache);
+
+    if ((NULL != cache) && (NULL != cache->invalidate))
+    {
+        cache->invalidate(shared, IPC_CACHE_LINE_SIZE);
+    }
+
+    return (IPC_PIPELINE_MAGIC == atomic_load_explicit(&shared->magic,
+            memory_order_acquire)) &&
+            (IPC_PIPELINE_VERSION == shared->version) &&
+            (IPC_PIPELINE_BUFFER_COUNT == shared->buffer_count) &&
+            (IPC_PIPELINE_BUFFER_SIZE == shared->buffer_size);
+}
+
+/*******************************************************************************
+* Function Name: ipc_pipeline_acquire
+********************************************************************************
+* Summary:
+*  Takes a free buffer. The caller owns it until ipc_pipeline_submit().
+*
+* Parameters:
+*  ipc_pipeline_t *pipeline: Handle of the producer.
+*
+* Return:
+*  ipc_pipeline_buffer_t *: Buffer, or NULL if all the buffers are in use.
+*
+*******************************************************************************/
+ipc_pipeline_buffer_t *ipc_pipeline_acquire(ipc_pipeline_t *pipeline)
+{
+    ipc_pipeline_buffer_t *buffer;
+    ipc_ring_desc_t desc;
+
+    if (!ipc_ring_pop(&pipeline->free, &desc))
+    {
+        return NULL;
+    }
+
+    buffer = desc_buffer(pipeline, &desc);
+    if (NULL != buffer)
+    {
+        buffer->length = 0U;
+    }
+
+    return buffer;
+}
+
+/*******************************************************************************
+* Function Name: ipc_pipeline_submit
+********************************************************************************
+* Summary:
+*  Hands a filled buffer to the consumer. The header and the payload are
+*  written back from the data cache before the buffer is queued.
+*
+* Parameters:
+*  ipc_pipeline_t *pipeline: Handle of the producer.
+*  ipc_pipeline_buffer_t *buffer: Buffer taken with ipc_pipeline_acquire(),
+*  with length set.
+*  uint32_t now_ms: Current time of the producer, in milliseconds.
+*
+* Return:
+*  bool: true if the doorbell interrupt of the consumer must be raised.
+*
+*******************************************************************************/
+bool ipc_pipeline_submit(ipc_pipeline_t *pipeline,
+        ipc_pipeline_buffer_t *buffer, uint32_t now_ms)
+{
+    ipc_ring_desc_t desc;
+    bool doorbell = false;
+
+    if (buffer->length > IPC_PIPELINE_BUFFER_SIZE)
+    {
+        buffer->length = IPC_PIPELINE_BUFFER_SIZE;
+    }
+
+    buffer->seq = pipeline->next_seq++;
+
+    if ((NULL != pipeline->cache) && (NULL != pipeline->cache->clean))
+    {
+        pipeline->cache->clean(buffer,
+                IPC_PIPELINE_HEADER_SIZE + buffer->length);
+    }
+
+    /* The ready ring holds all the buffers, so it cannot be full */
+    buffer_desc(pipeline, buffer, &desc);
+    (void)ipc_ring_push(&pipeline->ready, &desc, now_ms, &doorbell);
+
+    return doorbell;
+}
+
+/*******************************************************************************
+* Function Name: ipc_pipeline_doorbell_due
+********************************************************************************
+* Summary:
+*  Checks the deadline of the consumer when no buffer is submitted. Called by
+*  the producer whenever it is awake.
+*
+* Parameters:
+*  ipc_pipeline_t *pipeline: Handle of the producer.
+*  uint32_t now_ms: Current time of the producer, in milliseconds.
+*
+* Return:
+*  bool: true if the doorbell interrupt of the consumer must be raised.
+*
+*******************************************************************************/
+bool ipc_pipeline_doorbell_due(ipc_pipeline_t *pipeline, uint32_t now_ms)
+{
+    return ipc_ring_doorbell_due(&pipeline->ready, now_ms);
+}
+
+/*******************************************************************************
+* Function Name: ipc_pipeline_receive
+********************************************************************************
+* Summary:
+*  Takes the oldest submitted buffer. The caller owns it until
+*  ipc_pipeline_release().
+*
+* Parameters:
+*  ipc_pipeline_t *pipeline: Handle of the consumer.
+*
+* Return:
+*  ipc_pipeline_buffer_t *: Buffer, or NULL if no buffer is ready.
+*
+*******************************************************************************/
+ipc_pipeline_buffer_t *ipc_pipeline_receive(ipc_pipeline_t *pipeline)
+{
+    ipc_pipeline_buffer_t *buffer;
+    ipc_ring_desc_t desc;
+
+    if (!ipc_ring_pop(&pipeline->ready, &desc))
+    {
+        return NULL;
+    }
+
+    buffer = desc_buffer(pipeline, &desc);
+
+    if ((NULL != buffer) && (NULL != pipeline->cache) &&
+        (NULL != pipeline->cache->invalidate))
+    {
+        pipeline->cache->invalidate(buffer, sizeof(ipc_pipeline_buffer_t));
+    }
+
+    return buffer;
+}
+
+/*******************************************************************************
+* Function Name: ipc_pipeline_release
+********************************************************************************
+* Summary:
+*  Returns a received buffer to the free ring.
+*
+* Parameters:
+*  ipc_pipeline_t *pipeline: Handle of the consumer.
+*  ipc_pipeline_buffer_t *buffer: Buffer taken with ipc_pipeline_receive().
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ipc_pipeline_release(ipc_pipeline_t *pipeline,
+        ipc_pipeline_buffer_t *buffer)
+{
+    ipc_ring_desc_t desc;
+    bool doorbell;
+
+    buffer_desc(pipeline, buffer, &desc);
+
+    /* The free ring is never armed: the producer polls it */
+    (void)ipc_ring_push(&pipeline->free, &desc, 0U, &doorbell);
+}
+
+/*******************************************************************************
+* Function Name: ipc_pipeline_ready_count
+********************************************************************************
+* Summary:
+*  Returns the number of submitted buffers not yet received.
+*
+* Parameters:
+*  ipc_pipeline_t *pipeline: Handle of the consumer.
+*
+* Return:
+*  uint32_t: Number of buffers ready.
+*
+*******************************************************************************/
+uint32_t ipc_pipeline_ready_count(ipc_pipeline_t *pipeline)
+{
+    return ipc_ring_count(&pipeline->ready);
+}
+
+/*******************************************************************************
+* Function Name: ipc_pipeline_arm
+********************************************************************************
+* Summary:
+*  Asks the producer for a doorbell once threshold buffers are ready, or once
+*  a buffer has waited deadline_ms. See ipc_ring_arm().
+*
+* Parameters:
+*  ipc_pipeline_t *pipeline: Handle of the consumer.
+*  uint32_t threshold: Number of buffers ready.
+*  uint32_t deadline_ms: Longest time a buffer may wait.
+*
+* Return:
+*  bool: true if the threshold is already reached and the consumer must not
+*  wait.
+*
+*******************************************************************************/
+bool ipc_pipeline_arm(ipc_pipeline_t *pipeline, uint32_t threshold,
+        uint32_t deadline_ms)
+{
+    return ipc_ring_arm(&pipeline->ready, threshold, deadline_ms);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,152 @@
+/******************************************************************************
+* File Name: ipc_pipeline.h
+*
+* Description: This file is the public interface of ipc_pipeline.c. It contains
+* the layout of the buffer pool shared by the CM55 and the CM33 in SOCMEM, and
+* the functions used by the CM55 to hand finished buffers to the CM33 and by the
+* CM33 to return them, without copying the data.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef IPC_PIPELINE_H_
+#define IPC_PIPELINE_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+/* This module has no device dependencies so that it can also be built for the
+ * host machine, with one thread standing in for each core.
+ */
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ipc_ring.h"
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+#define IPC_PIPELINE_MAGIC              (0x50495043UL)  /* "PIPC" */
+#define IPC_PIPELINE_VERSION            (2U)
+
+/* Number of buffers and payload size of a buffer, in bytes. The payload size
+ * must be a multiple of IPC_CACHE_LINE_SIZE and IPC_PIPELINE_BUFFER_COUNT no
+ * larger than IPC_RING_SIZE.
+ */
+#define IPC_PIPELINE_BUFFER_COUNT       (8U)
+#define IPC_PIPELINE_BUFFER_SIZE        (1024U)
+
+/* Descriptor type carrying a buffer index in arg[0] */
+#define IPC_PIPELINE_DESC_BUFFER        (1U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Buffer handed between the cores. The header and the payload are written by
+ * the core owning the buffer only.
+ */
+typedef struct IPC_ALIGNED
+{
+    uint32_t length;            /* Payload bytes */
+    uint32_t seq;               /* Set by ipc_pipeline_submit() */
+    uint32_t tag;               /* Application defined */
+    uint32_t reserved[5];
+    uint8_t data[IPC_PIPELINE_BUFFER_SIZE];
+} ipc_pipeline_buffer_t;
+
+/* Shared area. The CM33 initializes it before enabling the CM55. Buffers go
+ * from the CM33 to the CM55 through the free ring and back through the ready
+ * ring.
+ */
+typedef struct IPC_ALIGNED
+{
+    atomic_uint_least32_t magic;
+    uint32_t version;
+    uint32_t buffer_count;
+    uint32_t buffer_size;
+
+    ipc_ring_shared_t ready;    /* Produced by the CM55 */
+    ipc_ring_shared_t free;     /* Produced by the CM33 */
+
+    ipc_pipeline_buffer_t buffers[IPC_PIPELINE_BUFFER_COUNT];
+} ipc_pipeline_shared_t;
+
+/* Handle of one core on the shared area, in the local memory of that core */
+typedef struct
+{
+    ipc_pipeline_shared_t *shared;
+    const ipc_cache_ops_t *cache;
+    ipc_ring_t ready;
+    ipc_ring_t free;
+    uint32_t next_seq;
+} ipc_pipeline_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void ipc_pipeline_init(ipc_pipeline_t *pipeline, ipc_pipeline_shared_t *shared,
+        const ipc_cache_ops_t *cache);
+bool ipc_pipeline_attach(ipc_pipeline_t *pipeline,
+        ipc_pipeline_shared_t *shared, const ipc_cache_ops_t *cache);
+
+/* Producer side, run by the CM55 */
+ipc_pipeline_buffer_t *ipc_pipeline_acquire(ipc_pipeline_t *pipeline);
+bool ipc_pipeline_submit(ipc_pipeline_t *pipeline,
+        ipc_pipeline_buffer_t *buffer, uint32_t now_ms);
+bool ipc_pipeline_doorbell_due(ipc_pipeline_t *pipeline, uint32_t now_ms);
+
+/* Consumer side, run by the CM33 */
+ipc_pipeline_buffer_t *ipc_pipeline_receive(ipc_pipeline_t *pipeline);
+void ipc_pipeline_release(ipc_pipeline_t *pipeline,
+        ipc_pipeline_buffer_t *buffer);
+uint32_t ipc_pipeline_ready_count(ipc_pipeline_t *pipeline);
+bool ipc_pipeline_arm(ipc_pipeline_t *pipeline, uint32_t threshold,
+        uint32_t deadline_ms);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* IPC_PIPELINE_H_ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,360 @@
+/*******************************************************************************
+* File Name:   ipc_ring.c
+*
+* Description: This file contains the single-producer single-consumer descriptor
+* ring between the CM33 and the CM55. Each index is written by one core only and
+* lives in its own cache line, as does each descriptor. The consumer arms the
+* ring with a number of pending descriptors and a delay; the producer asks for a
+* doorbell interrupt only once either is reached, so that neither core leaves
+* deep sleep for every message.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "ipc_ring.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define IPC_RING_INDEX_MASK             (IPC_RING_SIZE - 1U)
+
+_Static_assert((IPC_RING_SIZE & IPC_RING_INDEX_MASK) == 0U,
+        "IPC_RING_SIZE must be a power of two");
+_Static_assert(sizeof(ipc_ring_desc_t) == IPC_CACHE_LINE_SIZE,
+        "A descriptor must fill one cache line");
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: cache_clean
+********************************************************************************
+* Summary:
+*  Writes the data cache lines covering an area back to the shared memory.
+*******************************************************************************/
+static void cache_clean(const ipc_cache_ops_t *cache,
+        const volatile void *addr, size_t size)
+{
+    if ((NULL != cache) && (NULL != cache->clean))
+    {
+        cache->clean(addr, size);
+    }
+}
+
+/*******************************************************************************
+* Function Name: cache_invalidate
+********************************************************************************
+* Summary:
+*  Discards the data cache lines covering an area so that the next read
+*  fetches what the other core wrote.
+*******************************************************************************/
+static void cache_invalidate(const ipc_cache_ops_t *cache,
+        volatile void *addr, size_t size)
+{
+    if ((NULL != cache) && (NULL != cache->invalidate))
+    {
+        cache->invalidate(addr, size);
+    }
+}
+
+/*******************************************************************************
+* Function Name: load_remote
+********************************************************************************
+* Summary:
+*  Reads an index written by the other core.
+*******************************************************************************/
+static uint32_t load_remote(const ipc_ring_t *ring, ipc_index_t *index)
+{
+    cache_invalidate(ring->cache, index, sizeof(ipc_index_t));
+
+    return (uint32_t)atomic_load_explicit(&index->value, memory_order_acquire);
+}
+
+/*******************************************************************************
+* Function Name: store_local
+********************************************************************************
+* Summary:
+*  Publishes an index written by the calling core.
+*******************************************************************************/
+static void store_local(const ipc_ring_t *ring, ipc_index_t *index,
+        uint32_t value)
+{
+    atomic_store_explicit(&index->value, value, memory_order_release);
+    cache_clean(ring->cache, index, sizeof(ipc_index_t));
+}
+
+/*******************************************************************************
+* Function Name: ipc_ring_init
+********************************************************************************
+* Summary:
+*  Initializes an empty, unarmed ring. Called once, before the other core
+*  uses the ring.
+*
+* Parameters:
+*  ipc_ring_shared_t *shared: Shared part of the ring.
+*  const ipc_cache_ops_t *cache: Cache maintenance of the calling core.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ipc_ring_init(ipc_ring_shared_t *shared, const ipc_cache_ops_t *cache)
+{
+    memset(shared, 0, sizeof(ipc_ring_shared_t));
+    shared->wake.threshold = 1U;
+    cache_clean(cache, shared, sizeof(ipc_ring_shared_t));
+}
+
+/*******************************************************************************
+* Function Name: ipc_ring_open
+********************************************************************************
+* Summary:
+*  Initializes the handle of the calling core on a ring.
+*
+* Parameters:
+*  ipc_ring_t *ring: Handle to initialize.
+*  ipc_ring_shared_t *shared: Shared part of the ring.
+*  const ipc_cache_ops_t *cache: Cache maintenance of the calling core.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ipc_ring_open(ipc_ring_t *ring, ipc_ring_shared_t *shared,
+        const ipc_cache_ops_t *cache)
+{
+    memset(ring, 0, sizeof(ipc_ring_t));
+    ring->shared = shared;
+    ring->cache = cache;
+}
+
+/*******************************************************************************
+* Function Name: ipc_ring_doorbell_due
+********************************************************************************
+* Summary:
+*  Decides whether the consumer must be notified: it is armed, and either the
+*  number of pending descriptors has reached its threshold or the ring has
+*  not been empty for its deadline. The request is then marked as served, so
+*  that the consumer is notified once per arming. Called by ipc_ring_push()
+*  and, by a producer that stops pushing, when it wakes up for other reasons,
+*  so that the deadline is honoured.
+*
+* Parameters:
+*  ipc_ring_t *ring: Handle of the producer.
+*  uint32_t now_ms: Current time of the producer, in milliseconds.
+*
+* Return:
+*  bool: true if the doorbell interrupt must be raised.
+*
+*******************************************************************************/
+bool ipc_ring_doorbell_due(ipc_ring_t *ring, uint32_t now_ms)
+{
+    ipc_ring_shared_t *shared = ring->shared;
+    uint32_t notified = (uint32_t)atomic_load_explicit(
+            &shared->notified_seq.value, memory_order_relaxed);
+    uint32_t armed;
+    uint32_t pending;
+
+    /* Pairs with the fence of ipc_ring_arm(): either the consumer sees the
+     * new head, or the producer sees the new arming.
+     */
+    atomic_thread_fence(memory_order_seq_cst);
+
+    cache_invalidate(ring->cache, &shared->wake, sizeof(ipc_ring_wake_t));
+    armed = (uint32_t)atomic_load_explicit(&shared->wake.armed_seq,
+            memory_order_acquire);
+
+    if (armed == notified)
+    {
+        return false;
+    }
+
+    pending = (uint32_t)atomic_load_explicit(&shared->head.value,
+            memory_order_relaxed) - load_remote(ring, &shared->tail);
+
+    if ((0U == pending) || ((pending < shared->wake.threshold) &&
+            ((uint32_t)(now_ms - ring->oldest_ms) < shared->wake.deadline_ms)))
+    {
+        return false;
+    }
+
+    store_local(ring, &shared->notified_seq, armed);
+    ring->stats.doorbells++;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: ipc_ring_push
+********************************************************************************
+* Summary:
+*  Appends a descriptor. The descriptor is written back from the data cache
+*  before the head is published.
+*
+* Parameters:
+*  ipc_ring_t *ring: Handle of the producer.
+*  const ipc_ring_desc_t *desc: Descriptor to copy into the ring.
+*  uint32_t now_ms: Current time of the producer, in milliseconds.
+*  bool *doorbell: Set to true if the doorbell interrupt must be raised.
+*
+* Return:
+*  bool: false if the ring is full.
+*
+*******************************************************************************/
+bool ipc_ring_push(ipc_ring_t *ring, const ipc_ring_desc_t *desc,
+        uint32_t now_ms, bool *doorbell)
+{
+    ipc_ring_shared_t *shared = ring->shared;
+    uint32_t head = (uint32_t)atomic_load_explicit(&shared->head.value,
+            memory_order_relaxed);
+    uint32_t pending = head - load_remote(ring, &shared->tail);
+    ipc_ring_desc_t *slot = &shared->desc[head & IPC_RING_INDEX_MASK];
+
+    *doorbell = false;
+
+    if (pending >= IPC_RING_SIZE)
+    {
+        ring->stats.full++;
+        return false;
+    }
+
+    if (0U == pending)
+    {
+        ring->oldest_ms = now_ms;
+    }
+
+    *slot = *desc;
+    cache_clean(ring->cache, slot, sizeof(ipc_ring_desc_t));
+    store_local(ring, &shared->head, head + 1U);
+    ring->stats.messages++;
+
+    *doorbell = ipc_ring_doorbell_due(ring, now_ms);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: ipc_ring_pop
+********************************************************************************
+* Summary:
+*  Removes the oldest descriptor.
+*
+* Parameters:
+*  ipc_ring_t *ring: Handle of the consumer.
+*  ipc_ring_desc_t *desc: Filled with the descriptor.
+*
+* Return:
+*  bool: false if the ring is empty.
+*
+*******************************************************************************/
+bool ipc_ring_pop(ipc_ring_t *ring, ipc_ring_desc_t *desc)
+{
+    ipc_ring_shared_t *shared = ring->shared;
+    uint32_t tail = (uint32_t)atomic_load_explicit(&shared->tail.value,
+            memory_order_relaxed);
+    ipc_ring_desc_t *slot = &shared->desc[tail & IPC_RING_INDEX_MASK];
+
+    if (tail == load_remote(ring, &shared->head))
+    {
+        return false;
+    }
+
+    cache_invalidate(ring->cache, slot, sizeof(ipc_ring_desc_t));
+    *desc = *slot;
+    store_local(ring, &shared->tail, tail + 1U);
+    ring->stats.messages++;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: ipc_ring_count
+********************************************************************************
+* Summary:
+*  Returns the number of pending descriptors.
+*
+* Parameters:
+*  ipc_ring_t *ring: Handle of the consumer.
+*
+* Return:
+*  uint32_t: Number of descriptors in the ring.
+*
+*******************************************************************************/
+uint32_t ipc_ring_count(ipc_ring_t *ring)
+{
+    return load_remote(ring, &ring->shared->head) -
+            (uint32_t)atomic_load_explicit(&ring->shared->tail.value,
+            memory_order_relaxed);
+}
+
+/*******************************************************************************
+* Function Name: ipc_ring_arm
+********************************************************************************
+* Summary:
+*  Asks the producer for a doorbell once threshold descriptors are pending,
+*  or once the ring has not been empty for deadline_ms. Called by the
+*  consumer before it waits for the doorbell. If the threshold is already
+*  reached, the consumer must not wait: the producer may have pushed before
+*  it saw the arming.
+*
+* Parameters:
+*  ipc_ring_t *ring: Handle of the consumer.
+*  uint32_t threshold: Number of pending descriptors, at least 1.
+*  uint32_t deadline_ms: Longest time a descriptor may wait.
+*
+* Return:
+*  bool: true if the threshold is already reached.
+*
+*******************************************************************************/
+bool ipc_ring_arm(ipc_ring_t *ring, uint32_t threshold, uint32_t deadline_ms)
+{
+    ipc_ring_wake_t *wake = &ring->shared->wake;
+
+    wake->threshold = (0U == threshold) ? 1U : threshold;
+    wake->deadline_ms = deadline_ms;
+    atomic_store_explicit(&wake->armed_seq,
+            atomic_load_explicit(&wake->armed_seq, memory_order_relaxed) + 1U,
+            memory_order_release);
+    cache_clean(ring->cache, wake, sizeof(ipc_ring_wake_t));
+
+    atomic_thread_fence(memory_order_seq_cst);
+
+    return (ipc_ring_count(ring) >= wake->threshold);
+}
+
+
+/* [] END OF FILE */
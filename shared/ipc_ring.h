@@ -0,0 +1,168 @@
+/******************************************************************************
+* File Name: ipc_ring.h
+*
+* Description: This file is the public interface of ipc_ring.c. It contains the
+* single-producer single-consumer descriptor ring shared by the CM33 and the
+* CM55, and its doorbell policy.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef IPC_RING_H_
+#define IPC_RING_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+/* This module has no device dependencies so that it can also be built for the
+ * host machine, with one thread standing in for each core.
+ */
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Defines
+*******************************************************************************/
+/* Data cache line size of the CM55. Everything written by one core only is
+ * kept in cache lines of its own, so that a line cleaned by the CM55 never
+ * overwrites data written by the CM33.
+ */
+#define IPC_CACHE_LINE_SIZE             (32U)
+
+#define IPC_ALIGNED                     __attribute__((aligned(IPC_CACHE_LINE_SIZE)))
+
+/* Number of descriptors of a ring, a power of two */
+#define IPC_RING_SIZE                   (16U)
+
+/* Number of 32-bit arguments of a descriptor */
+#define IPC_RING_DESC_ARGS              (6U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Value written by one core, alone in its cache line */
+typedef struct IPC_ALIGNED
+{
+    atomic_uint_least32_t value;
+} ipc_index_t;
+
+/* Message, one cache line */
+typedef struct IPC_ALIGNED
+{
+    uint16_t type;
+    uint16_t length;
+    uint32_t timestamp;
+    uint32_t arg[IPC_RING_DESC_ARGS];
+} ipc_ring_desc_t;
+
+/* Wake-up request of the consumer, written by the consumer only. The
+ * consumer is armed while armed_seq differs from the notified_seq written by
+ * the producer.
+ */
+typedef struct IPC_ALIGNED
+{
+    atomic_uint_least32_t armed_seq;
+    uint32_t threshold;         /* Ring as soon as this many are pending */
+    uint32_t deadline_ms;       /* Ring when the oldest has waited this long */
+} ipc_ring_wake_t;
+
+/* Shared part of a ring */
+typedef struct IPC_ALIGNED
+{
+    ipc_index_t head;           /* Written by the producer */
+    ipc_index_t notified_seq;   /* Written by the producer */
+    ipc_index_t tail;           /* Written by the consumer */
+    ipc_ring_wake_t wake;       /* Written by the consumer */
+    ipc_ring_desc_t desc[IPC_RING_SIZE];
+} ipc_ring_shared_t;
+
+/* Data cache maintenance of the calling core. NULL functions when the core
+ * has no data cache or the shared area is not cacheable.
+ */
+typedef struct
+{
+    void (*clean)(const volatile void *addr, size_t size);
+    void (*invalidate)(volatile void *addr, size_t size);
+} ipc_cache_ops_t;
+
+/* Counters of one side of a ring */
+typedef struct
+{
+    uint32_t messages;          /* Pushed or popped */
+    uint32_t full;              /* Pushes refused because the ring was full */
+    uint32_t doorbells;         /* Doorbells requested by the producer */
+} ipc_ring_stats_t;
+
+/* Handle of one core on a ring, in the local memory of that core */
+typedef struct
+{
+    ipc_ring_shared_t *shared;
+    const ipc_cache_ops_t *cache;
+    uint32_t oldest_ms;         /* Producer: push time of the oldest pending */
+    ipc_ring_stats_t stats;
+} ipc_ring_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void ipc_ring_init(ipc_ring_shared_t *shared, const ipc_cache_ops_t *cache);
+void ipc_ring_open(ipc_ring_t *ring, ipc_ring_shared_t *shared,
+        const ipc_cache_ops_t *cache);
+
+/* Producer side */
+bool ipc_ring_push(ipc_ring_t *ring, const ipc_ring_desc_t *desc,
+        uint32_t now_ms, bool *doorbell);
+bool ipc_ring_doorbell_due(ipc_ring_t *ring, uint32_t now_ms);
+
+/* Consumer side */
+bool ipc_ring_pop(ipc_ring_t *ring, ipc_ring_desc_t *desc);
+uint32_t ipc_ring_count(ipc_ring_t *ring);
+bool ipc_ring_arm(ipc_ring_t *ring, uint32_t threshold, uint32_t deadline_ms);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* IPC_RING_H_ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,461 @@
+/*******************************************************************************
+* File Name:   assoc_cache_test.c
+*
+* Description: Linux checks of the association cache
+* (proj_cm33_ns/source/assoc_cache.c) with a file-backed store: record codec,
+* detection of empty, corrupted and foreign records, the credential checks that
+* make the fast reconnect fall back to the full connection, and the reuse of the
+* cached PMK.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+
+/*
+ * Build:
+ *  cc -O2 -Wall -I proj_cm33_ns/source -o assoc_cache_test \
+ *      tools/assoc_cache_test.c proj_cm33_ns/source/assoc_cache.c
+ *
+ * Usage:
+ *  assoc_cache_test [store_file]
+ *
+ * The store is a temporary file removed on exit unless given on the command
+ * line. Prints every failed check and exits with a non-zero status if any.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "assoc_cache.h"
+
+#include "test_check.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Security types of cy_wcm_security_t used by the checks */
+#define SECURITY_WPA2_AES_PSK           (0x00400004UL)
+#define SECURITY_WPA3_SAE               (0x01000004UL)
+
+/* Offset of the payload and of the SSID length in an encoded record */
+#define RECORD_PAYLOAD_OFFSET           (8U)
+
+#define TEST_SSID                       "WIFI_SSID"
+#define TEST_PASSPHRASE                 "WIFI_PASSWORD"
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* File-backed store. Faults are injected with the fail_* flags. */
+typedef struct
+{
+    const char *path;
+    bool fail_read;
+    bool fail_write;
+    uint32_t reads;
+    uint32_t writes;
+} file_store_t;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static bool file_read(void *context, uint8_t *buffer, size_t size)
+{
+    file_store_t *store = context;
+    FILE *file;
+
+    store->reads++;
+
+    if (store->fail_read)
+    {
+        return false;
+    }
+
+    /* A missing file reads as erased RRAM */
+    memset(buffer, 0, size);
+    file = fopen(store->path, "rb");
+    if (NULL != file)
+    {
+        (void)fread(buffer, 1U, size, file);
+        fclose(file);
+    }
+
+    return true;
+}
+
+static bool file_write(void *context, const uint8_t *buffer, size_t size)
+{
+    file_store_t *store = context;
+    FILE *file;
+    bool ok;
+
+    store->writes++;
+
+    if (store->fail_write)
+    {
+        return false;
+    }
+
+    file = fopen(store->path, "wb");
+    if (NULL == file)
+    {
+        return false;
+    }
+
+    ok = (size == fwrite(buffer, 1U, size, file));
+    ok = (0 == fclose(file)) && ok;
+
+    return ok;
+}
+
+static bool file_erase(void *context)
+{
+    file_store_t *store = context;
+    uint8_t erased[ASSOC_CACHE_RECORD_SIZE];
+
+    memset(erased, 0, sizeof(erased));
+
+    return file_write(store, erased, sizeof(erased));
+}
+
+/* Recomputes the CRC-32 of an encoded record after a change */
+static void reseal(uint8_t *buffer)
+{
+    uint32_t crc = assoc_cache_crc32(buffer, ASSOC_CACHE_RECORD_SIZE - 4U);
+
+    for (uint32_t i = 0U; i < 4U; i++)
+    {
+        buffer[ASSOC_CACHE_RECORD_SIZE - 4U + i] = (uint8_t)(crc >> (8U * i));
+    }
+}
+
+/* Replaces one byte of the stored record */
+static void poke(const file_store_t *store, size_t offset, uint8_t value)
+{
+    FILE *file = fopen(store->path, "r+b");
+
+    if (NULL != file)
+    {
+        (void)fseek(file, (long)offset, SEEK_SET);
+        (void)fputc(value, file);
+        fclose(file);
+    }
+}
+
+static void make_record(assoc_cache_record_t *record)
+{
+    static const uint8_t bssid[ASSOC_CACHE_BSSID_LEN] =
+    {
+        0x00U, 0x90U, 0x4CU, 0x12U, 0x34U, 0x56U
+    };
+
+    memset(record, 0, sizeof(assoc_cache_record_t));
+    record->ssid_len = (uint8_t)strlen(TEST_SSID);
+    memcpy(record->ssid, TEST_SSID, record->ssid_len);
+    record->security = SECURITY_WPA2_AES_PSK;
+    record->credential_check = assoc_cache_crc32(
+            (const uint8_t *)TEST_PASSPHRASE, strlen(TEST_PASSPHRASE));
+    memcpy(record->bssid, bssid, sizeof(bssid));
+    record->channel = 36U;
+    record->band = 2U;
+    record->pmk_valid = true;
+    for (uint32_t i = 0U; i < ASSOC_CACHE_PMK_LEN; i++)
+    {
+        record->pmk[i] = (uint8_t)(0xA0U + i);
+    }
+    record->ip_valid = true;
+    record->ip_address = 0x0A01A8C0UL;
+    record->netmask = 0x00FFFFFFUL;
+    record->gateway = 0x0101A8C0UL;
+}
+
+static bool matches(const assoc_cache_record_t *record, const char *ssid,
+        uint32_t security, const char *passphrase)
+{
+    return assoc_cache_matches(record, (const uint8_t *)ssid, strlen(ssid),
+            security, (const uint8_t *)passphrase, strlen(passphrase));
+}
+
+static bool reuse_pmk(const assoc_cache_storage_t *storage, const char *ssid,
+        const char *passphrase, uint8_t *pmk)
+{
+    return assoc_cache_reuse_pmk(storage, (const uint8_t *)ssid, strlen(ssid),
+            SECURITY_WPA2_AES_PSK, (const uint8_t *)passphrase,
+            strlen(passphrase), pmk);
+}
+
+static void test_codec(void)
+{
+    assoc_cache_record_t record;
+    assoc_cache_record_t decoded;
+    uint8_t buffer[ASSOC_CACHE_RECORD_SIZE];
+
+    make_record(&record);
+
+    CHECK(0U == assoc_cache_encode(&record, buffer, sizeof(buffer) - 1U));
+    CHECK(ASSOC_CACHE_RECORD_SIZE ==
+            assoc_cache_encode(&record, buffer, sizeof(buffer)));
+    CHECK(ASSOC_CACHE_OK ==
+            assoc_cache_decode(buffer, sizeof(buffer), &decoded));
+    CHECK(0 == memcmp(&record, &decoded, sizeof(record)));
+
+    /* Truncated record */
+    CHECK(ASSOC_CACHE_BAD_FORMAT ==
+            assoc_cache_decode(buffer, sizeof(buffer) - 1U, &decoded));
+
+    /* Every single-bit error is detected */
+    for (size_t i = 0U; i < (8U * sizeof(buffer)); i++)
+    {
+        assoc_cache_status_t status;
+
+        buffer[i / 8U] ^= (uint8_t)(1U << (i % 8U));
+        status = assoc_cache_decode(buffer, sizeof(buffer), &decoded);
+        buffer[i / 8U] ^= (uint8_t)(1U << (i % 8U));
+
+        if (ASSOC_CACHE_OK == status)
+        {
+            CHECK(ASSOC_CACHE_OK != status);
+            break;
+        }
+    }
+
+    /* Unknown version with a valid CRC */
+    buffer[4]++;
+    reseal(buffer);
+    CHECK(ASSOC_CACHE_BAD_FORMAT ==
+            assoc_cache_decode(buffer, sizeof(buffer), &decoded));
+
+    /* SSID length out of range with a valid CRC */
+    (void)assoc_cache_encode(&record, buffer, sizeof(buffer));
+    buffer[RECORD_PAYLOAD_OFFSET] = ASSOC_CACHE_SSID_MAX_LEN + 1U;
+    reseal(buffer);
+    CHECK(ASSOC_CACHE_BAD_FORMAT ==
+            assoc_cache_decode(buffer, sizeof(buffer), &decoded));
+
+    /* Erased flash and erased RRAM */
+    memset(buffer, 0xFF, sizeof(buffer));
+    CHECK(ASSOC_CACHE_EMPTY ==
+            assoc_cache_decode(buffer, sizeof(buffer), &decoded));
+    memset(buffer, 0x00, sizeof(buffer));
+    CHECK(ASSOC_CACHE_EMPTY ==
+            assoc_cache_decode(buffer, sizeof(buffer), &decoded));
+
+    /* Known CRC-32 check value */
+    CHECK(0xCBF43926UL == assoc_cache_crc32((const uint8_t *)"123456789", 9U));
+}
+
+static void test_store(const assoc_cache_storage_t *storage,
+        file_store_t *store)
+{
+    assoc_cache_record_t record;
+    assoc_cache_record_t loaded;
+
+    /* Nothing saved yet */
+    CHECK(ASSOC_CACHE_EMPTY == assoc_cache_load(storage, &loaded));
+
+    make_record(&record);
+    CHECK(assoc_cache_save(storage, &record));
+    CHECK(ASSOC_CACHE_OK == assoc_cache_load(storage, &loaded));
+    CHECK(0 == memcmp(&record, &loaded, sizeof(record)));
+
+    /* A corrupted record is not used */
+    poke(store, RECORD_PAYLOAD_OFFSET + 1U, 'X');
+    CHECK(ASSOC_CACHE_BAD_CRC == assoc_cache_load(storage, &loaded));
+    CHECK(!loaded.pmk_valid);
+
+    /* Invalidation leaves an empty store */
+    CHECK(assoc_cache_save(storage, &record));
+    CHECK(assoc_cache_invalidate(storage));
+    CHECK(ASSOC_CACHE_EMPTY == assoc_cache_load(storage, &loaded));
+
+    /* Storage faults */
+    store->fail_read = true;
+    CHECK(ASSOC_CACHE_STORAGE_ERROR == assoc_cache_load(storage, &loaded));
+    store->fail_read = false;
+    store->fail_write = true;
+    CHECK(!assoc_cache_save(storage, &record));
+    store->fail_write = false;
+}
+
+static void test_unchanged(const assoc_cache_storage_t *storage,
+        file_store_t *store)
+{
+    assoc_cache_record_t record;
+    assoc_cache_record_t loaded;
+    uint32_t writes;
+
+    make_record(&record);
+    CHECK(assoc_cache_save(storage, &record));
+
+    /* Saving the stored record again does not write the storage */
+    writes = store->writes;
+    CHECK(assoc_cache_save(storage, &record));
+    CHECK(writes == store->writes);
+
+    /* nor does a write fault matter then */
+    store->fail_write = true;
+    CHECK(assoc_cache_save(storage, &record));
+    store->fail_write = false;
+
+    /* Any change is written */
+    record.channel = 40U;
+    CHECK(assoc_cache_save(storage, &record));
+    CHECK((writes + 1U) == store->writes);
+    CHECK(ASSOC_CACHE_OK == assoc_cache_load(storage, &loaded));
+    CHECK(40U == loaded.channel);
+
+    /* An unreadable storage is written */
+    store->fail_read = true;
+    CHECK(assoc_cache_save(storage, &record));
+    store->fail_read = false;
+    CHECK((writes + 2U) == store->writes);
+}
+
+static void test_fallback(const assoc_cache_storage_t *storage)
+{
+    assoc_cache_record_t record;
+    assoc_cache_record_t loaded;
+
+    make_record(&record);
+    CHECK(assoc_cache_save(storage, &record));
+    CHECK(ASSOC_CACHE_OK == assoc_cache_load(storage, &loaded));
+
+    /* The fast reconnect is only taken for the credentials of the record */
+    CHECK(matches(&loaded, TEST_SSID, SECURITY_WPA2_AES_PSK,
+            TEST_PASSPHRASE));
+    CHECK(!matches(&loaded, "WIFI_SSID2", SECURITY_WPA2_AES_PSK,
+            TEST_PASSPHRASE));
+    CHECK(!matches(&loaded, "WIFI_SSI", SECURITY_WPA2_AES_PSK,
+            TEST_PASSPHRASE));
+    CHECK(!matches(&loaded, TEST_SSID, SECURITY_WPA3_SAE, TEST_PASSPHRASE));
+    CHECK(!matches(&loaded, TEST_SSID, SECURITY_WPA2_AES_PSK,
+            "WIFI_PASSWORD2"));
+    CHECK(!matches(&loaded, TEST_SSID, SECURITY_WPA2_AES_PSK, ""));
+}
+
+static void test_reuse_pmk(const assoc_cache_storage_t *storage,
+        file_store_t *store)
+{
+    assoc_cache_record_t record;
+    uint8_t pmk[ASSOC_CACHE_PMK_LEN];
+    uint32_t reads;
+
+    make_record(&record);
+    CHECK(assoc_cache_save(storage, &record));
+
+    /* Same network and passphrase: the PMK is copied from the store */
+    memset(pmk, 0, sizeof(pmk));
+    reads = store->reads;
+    CHECK(reuse_pmk(storage, TEST_SSID, TEST_PASSPHRASE, pmk));
+    CHECK(0 == memcmp(pmk, record.pmk, sizeof(pmk)));
+    CHECK((reads + 1U) == store->reads);
+
+    /* The PMK depends on the SSID and on the passphrase */
+    memset(pmk, 0, sizeof(pmk));
+    CHECK(!reuse_pmk(storage, "WIFI_SSID2", TEST_PASSPHRASE, pmk));
+    CHECK(!reuse_pmk(storage, TEST_SSID, "WIFI_PASSWORD2", pmk));
+    CHECK(0U == pmk[0]);
+
+    /* No PMK in the record, for example for WPA3-SAE */
+    record.pmk_valid = false;
+    CHECK(assoc_cache_save(storage, &record));
+    CHECK(!reuse_pmk(storage, TEST_SSID, TEST_PASSPHRASE, pmk));
+
+    /* Empty, corrupted or unreadable store */
+    record.pmk_valid = true;
+    CHECK(assoc_cache_invalidate(storage));
+    CHECK(!reuse_pmk(storage, TEST_SSID, TEST_PASSPHRASE, pmk));
+    CHECK(assoc_cache_save(storage, &record));
+    poke(store, ASSOC_CACHE_RECORD_SIZE - 1U, 0x5AU);
+    CHECK(!reuse_pmk(storage, TEST_SSID, TEST_PASSPHRASE, pmk));
+    CHECK(assoc_cache_save(storage, &record));
+    store->fail_read = true;
+    CHECK(!reuse_pmk(storage, TEST_SSID, TEST_PASSPHRASE, pmk));
+    store->fail_read = false;
+    CHECK(0U == pmk[0]);
+}
+
+int main(int argc, char *argv[])
+{
+    char path[] = "/tmp/assoc_cache_XXXXXX";
+    file_store_t store = { 0 };
+    assoc_cache_storage_t storage =
+    {
+        .read       = file_read,
+        .write      = file_write,
+        .erase      = file_erase,
+        .context    = &store
+    };
+    int fd = -1;
+
+    if (argc > 1)
+    {
+        store.path = argv[1];
+        (void)remove(store.path);
+    }
+    else
+    {
+        fd = mkstemp(path);
+        if (fd < 0)
+        {
+            perror("mkstemp");
+            return EXIT_FAILURE;
+        }
+        close(fd);
+        (void)remove(path);
+        store.path = path;
+    }
+
+    test_codec();
+    test_store(&storage, &store);
+    test_unchanged(&storage, &store);
+    test_fallback(&storage);
+    test_reuse_pmk(&storage, &store);
+
+    if (fd >= 0)
+    {
+        (void)remove(path);
+    }
+
+    return test_check_summary();
+}
+
+
+/* [] END OF FILE */
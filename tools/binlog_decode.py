@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+"""Decodes the binary log written by proj_cm33_ns/source/binlog.c.
+
+The device writes every message as a frame holding the address of its format
+string, a timestamp and the raw arguments (see binlog.h). This tool resolves
+the format strings, and the '%s' arguments that point to constant strings,
+from the ELF file of the application and prints the text. Text written to
+the UART outside of the frames is passed through unchanged.
+
+Usage:
+    binlog_decode.py proj_cm33_ns.elf capture.bin
+    binlog_decode.py proj_cm33_ns.elf - < /dev/ttyACM0
+
+Requires Python 3 only.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+FRAME_SYNC = 0xA5
+LEVEL_PREFIX = {0: "Info: ", 1: "Error: "}
+DEFAULT_TICK_HZ = 32768
+
+# printf conversion specification
+CONVERSION = re.compile(r"%([-+ #0]*)(\d+|\*)?(?:\.(\d+))?(hh|h|ll|l|z|j|t)?"
+                        r"([diouxXcspn%])")
+
+SHF_ALLOC = 0x2
+SHT_NOBITS = 8
+
+
+class ElfImage:
+    """Allocated sections of an ELF file, addressed by their load address."""
+
+    def __init__(self, path):
+        with open(path, "rb") as elf:
+            data = elf.read()
+
+        if data[:4] != b"\x7fELF":
+            raise ValueError("%s is not an ELF file" % path)
+
+        is_64 = data[4] == 2
+        endian = "<" if data[5] == 1 else ">"
+
+        if is_64:
+            shoff, = struct.unpack_from(endian + "Q", data, 0x28)
+            shentsize, shnum = struct.unpack_from(endian + "HH", data, 0x3A)
+            section = endian + "IIQQQQ"
+        else:
+            shoff, = struct.unpack_from(endian + "I", data, 0x20)
+            shentsize, shnum = struct.unpack_from(endian + "HH", data, 0x2E)
+            section = endian + "IIIIII"
+
+        self.sections = []
+
+        for index in range(shnum):
+            _, sh_type, flags, addr, offset, size = struct.unpack_from(
+                section, data, shoff + (index * shentsize))
+
+            if (flags & SHF_ALLOC) and sh_type != SHT_NOBITS and size:
+                self.sections.append((addr, data[offset:offset + size]))
+
+    def string(self, address):
+        """Returns the C string at address, or None if it is not in the file."""
+        for start, content in self.sections:
+            if start <= address < start + len(content):
+                end = content.find(b"\0", address - start)
+                if end < 0:
+                    end = len(content)
+                return content[address - start:end].decode("utf-8", "replace")
+
+        return None
+
+
+def signed(value):
+    return value - (1 << 32) if value & 0x80000000 else value
+
+
+def format_message(elf, fmt, args):
+    """Applies the arguments to the format string like printf."""
+    remaining = list(args)
+
+    def convert(match):
+        flags, width, precision, _, conversion = match.groups()
+
+        if conversion == "%":
+            return "%"
+        if not remaining:
+            return match.group(0)
+
+        value = remaining.pop(0)
+        spec = "%" + flags + (width or "") + \
+            ("." + precision if precision is not None else "")
+
+        if conversion == "s":
+            text = elf.string(value)
+            return (spec + "s") % (text if text is not None
+                                   else "<0x%08x>" % value)
+        if conversion == "p":
+            return "0x%08x" % value
+        if conversion == "c":
+            return chr(value & 0xFF)
+        if conversion in "di":
+            return (spec + "d") % signed(value)
+        if conversion == "u":
+            return (spec + "d") % value
+
+        return (spec + conversion) % value
+
+    return CONVERSION.sub(convert, fmt)
+
+
+def decode(elf, stream, out, tick_hz):
+    """Decodes the frames of the stream and passes the other bytes through."""
+    data = stream.read()
+    pos = 0
+    text = bytearray()
+
+    while pos < len(data):
+        if data[pos] != FRAME_SYNC or pos + 2 > len(data):
+            text.append(data[pos])
+            pos += 1
+            continue
+
+        length = data[pos + 1]
+        body = data[pos + 2:pos + 2 + length]
+
+        checksum = 0
+        for byte in body[:-1]:
+            checksum ^= byte
+
+        if length < 11 or len(body) != length or body[-1] != checksum or \
+                length != 11 + (4 * body[9]):
+            text.append(data[pos])
+            pos += 1
+            continue
+
+        if text:
+            out.write(text.decode("utf-8", "replace"))
+            text = bytearray()
+
+        fmt_addr, timestamp, level, nargs = struct.unpack_from("<IIBB", body)
+        args = struct.unpack_from("<%dI" % nargs, body, 10)
+        stamp = "[%10.4f] " % (timestamp / float(tick_hz))
+
+        if fmt_addr == 0:
+            message = "%u log messages dropped\n" % args[0]
+        else:
+            fmt = elf.string(fmt_addr)
+            message = format_message(elf, fmt, args) if fmt is not None \
+                else "<unknown format 0x%08x> %s\n" % (
+                    fmt_addr, " ".join("0x%08x" % arg for arg in args))
+
+        out.write(stamp + LEVEL_PREFIX.get(level, "") + message)
+        pos += 2 + length
+
+    if text:
+        out.write(text.decode("utf-8", "replace"))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("elf", help="ELF file of the CM33 non-secure project")
+    parser.add_argument("capture", help="UART capture, or - for stdin")
+    parser.add_argument("--tick-hz", type=int, default=DEFAULT_TICK_HZ,
+                        help="frequency of the timestamps (default: %(default)s)")
+    args = parser.parse_args()
+
+    elf = ElfImage(args.elf)
+    stream = sys.stdin.buffer if args.capture == "-" else \
+        open(args.capture, "rb")
+
+    with stream:
+        decode(elf, stream, sys.stdout, args.tick_hz)
+
+
+if __name__ == "__main__":
+    main()
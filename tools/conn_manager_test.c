@@ -0,0 +1,325 @@
+/*******************************************************************************
+* File Name:   conn_manager_test.c
+*
+* Description: Linux checks of the connection state machine
+* (proj_cm33_ns/source/conn_manager.c) on a simulated clock: growth of the
+* backoff delay, bounds of the jitter, cap of the delay, reset after a
+* successful connection or a link loss, and wrap of the clock.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+
+/*
+ * Build:
+ *  cc -O2 -Wall -I proj_cm33_ns/source -o conn_manager_test \
+ *      tools/conn_manager_test.c proj_cm33_ns/source/conn_manager.c
+ *
+ * Usage:
+ *  conn_manager_test
+ *
+ * Prints every failed check and exits with a non-zero status if any.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "conn_manager.h"
+#include "lowpower_config.h"
+
+#include "test_check.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Failures after which the delay is capped with the defaults: 1 s doubled
+ * 9 times is above 300 s.
+ */
+#define FAILURES_TO_CAP                 (10U)
+
+#define SEED_COUNT                      (1000U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const conn_manager_config_t default_config =
+{
+    .initial_delay_ms   = WIFI_RETRY_INITIAL_DELAY_MS,
+    .max_delay_ms       = WIFI_RETRY_MAX_DELAY_MS,
+    .jitter_percent     = WIFI_RETRY_JITTER_PERCENT
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/* Delay before jitter after the given number of consecutive failures */
+static uint32_t nominal_delay_ms(const conn_manager_config_t *config,
+        uint32_t failure)
+{
+    uint64_t delay_ms = config->initial_delay_ms;
+
+    for (uint32_t i = 1U; (i < failure) && (delay_ms < config->max_delay_ms);
+            i++)
+    {
+        delay_ms *= 2U;
+    }
+
+    return (delay_ms > config->max_delay_ms) ?
+            config->max_delay_ms : (uint32_t)delay_ms;
+}
+
+static bool within_jitter(const conn_manager_config_t *config,
+        uint32_t nominal_ms, uint32_t delay_ms)
+{
+    uint32_t jitter_ms = (uint32_t)(((uint64_t)nominal_ms *
+            config->jitter_percent) / 100U);
+
+    return (delay_ms >= (nominal_ms - jitter_ms)) &&
+           (delay_ms <= (nominal_ms + jitter_ms));
+}
+
+/* Runs one failed attempt at now_ms, waits for the retry on the simulated
+ * clock, and returns the delay.
+ */
+static uint32_t fail_once(conn_manager_t *manager, uint32_t *now_ms)
+{
+    uint32_t wait_ms;
+    uint32_t delay_ms;
+
+    CHECK(CONN_ACTION_CONNECT == conn_manager_next(manager, *now_ms,
+            &wait_ms));
+    CHECK(CONN_STATE_CONNECTING == conn_manager_state(manager));
+
+    /* Nothing to do while the attempt is in progress */
+    CHECK(CONN_ACTION_NONE == conn_manager_next(manager, *now_ms, &wait_ms));
+
+    delay_ms = conn_manager_result(manager, false, *now_ms);
+    CHECK(CONN_STATE_BACKOFF == conn_manager_state(manager));
+
+    /* Sleeping for less than the delay leaves the manager in backoff */
+    CHECK(CONN_ACTION_WAIT == conn_manager_next(manager, *now_ms, &wait_ms));
+    CHECK(delay_ms == wait_ms);
+    *now_ms += delay_ms - 1U;
+    CHECK(CONN_ACTION_WAIT == conn_manager_next(manager, *now_ms, &wait_ms));
+    CHECK(1U == wait_ms);
+    *now_ms += 1U;
+
+    return delay_ms;
+}
+
+static void test_backoff_growth(void)
+{
+    conn_manager_t manager;
+    uint32_t now_ms = 5000U;
+    uint32_t delay_ms;
+
+    conn_manager_init(&manager, &default_config, 1234U);
+    CHECK(CONN_STATE_DISCONNECTED == conn_manager_state(&manager));
+
+    for (uint32_t failure = 1U; failure <= (FAILURES_TO_CAP + 5U); failure++)
+    {
+        uint32_t nominal_ms = nominal_delay_ms(&default_config, failure);
+
+        delay_ms = fail_once(&manager, &now_ms);
+        CHECK(within_jitter(&default_config, nominal_ms, delay_ms));
+
+        if (!within_jitter(&default_config, nominal_ms, delay_ms))
+        {
+            printf("  failure %u: %u ms, expected %u ms +/- %u%%\n", failure,
+                    delay_ms, nominal_ms, default_config.jitter_percent);
+        }
+    }
+
+    /* Capped: the delay never exceeds the maximum plus its jitter */
+    CHECK(WIFI_RETRY_MAX_DELAY_MS == manager.delay_ms);
+    CHECK((FAILURES_TO_CAP + 5U) == manager.attempts);
+    CHECK((FAILURES_TO_CAP + 5U) == manager.total_attempts);
+    CHECK((FAILURES_TO_CAP + 5U) == manager.total_failures);
+}
+
+static void test_jitter_bounds(void)
+{
+    conn_manager_config_t config = default_config;
+    uint32_t low_ms = UINT32_MAX;
+    uint32_t high_ms = 0U;
+    uint32_t first_ms = 0U;
+    bool varies = false;
+
+    /* Devices with different seeds retry at different times within the
+     * jitter range, and cover most of it.
+     */
+    for (uint32_t seed = 0U; seed < SEED_COUNT; seed++)
+    {
+        conn_manager_t manager;
+        uint32_t now_ms = 0U;
+        uint32_t delay_ms;
+
+        conn_manager_init(&manager, &config, seed);
+        delay_ms = fail_once(&manager, &now_ms);
+        CHECK(within_jitter(&config, WIFI_RETRY_INITIAL_DELAY_MS, delay_ms));
+
+        low_ms = (delay_ms < low_ms) ? delay_ms : low_ms;
+        high_ms = (delay_ms > high_ms) ? delay_ms : high_ms;
+        varies = varies || ((0U != seed) && (delay_ms != first_ms));
+        first_ms = (0U == seed) ? delay_ms : first_ms;
+    }
+
+    CHECK(varies);
+    CHECK(low_ms < (WIFI_RETRY_INITIAL_DELAY_MS - 180U));
+    CHECK(high_ms > (WIFI_RETRY_INITIAL_DELAY_MS + 180U));
+
+    /* Without jitter the delays are exact */
+    config.jitter_percent = 0U;
+    {
+        conn_manager_t manager;
+        uint32_t now_ms = 0U;
+
+        conn_manager_init(&manager, &config, 7U);
+        CHECK(1000U == fail_once(&manager, &now_ms));
+        CHECK(2000U == fail_once(&manager, &now_ms));
+        CHECK(4000U == fail_once(&manager, &now_ms));
+    }
+
+    /* The jitter of the capped delay may exceed the cap, but not by more than
+     * the jitter percentage.
+     */
+    config = default_config;
+    config.max_delay_ms = 3000U;
+    {
+        conn_manager_t manager;
+        uint32_t now_ms = 0U;
+
+        conn_manager_init(&manager, &config, 99U);
+        for (uint32_t i = 0U; i < 20U; i++)
+        {
+            CHECK(fail_once(&manager, &now_ms) <= 3600U);
+        }
+        CHECK(3000U == manager.delay_ms);
+    }
+}
+
+static void test_reset(void)
+{
+    conn_manager_config_t config = default_config;
+    conn_manager_t manager;
+    uint32_t now_ms = 0U;
+    uint32_t wait_ms;
+
+    config.jitter_percent = 0U;
+    conn_manager_init(&manager, &config, 1U);
+
+    (void)fail_once(&manager, &now_ms);
+    (void)fail_once(&manager, &now_ms);
+    (void)fail_once(&manager, &now_ms);
+    CHECK(8000U == manager.delay_ms);
+
+    /* Success resets the delay */
+    CHECK(CONN_ACTION_CONNECT == conn_manager_next(&manager, now_ms,
+            &wait_ms));
+    CHECK(0U == conn_manager_result(&manager, true, now_ms));
+    CHECK(CONN_STATE_CONNECTED == conn_manager_state(&manager));
+    CHECK(1000U == manager.delay_ms);
+    CHECK(4U == manager.attempts);
+    CHECK(CONN_ACTION_NONE == conn_manager_next(&manager, now_ms, &wait_ms));
+    CHECK(0U == wait_ms);
+
+    /* A result outside an attempt is ignored */
+    CHECK(0U == conn_manager_result(&manager, false, now_ms));
+    CHECK(CONN_STATE_CONNECTED == conn_manager_state(&manager));
+    CHECK(3U == manager.total_failures);
+
+    /* A link loss allows an immediate attempt and restarts the count */
+    conn_manager_link_lost(&manager);
+    CHECK(CONN_STATE_DISCONNECTED == conn_manager_state(&manager));
+    CHECK(0U == manager.attempts);
+    CHECK(1U == manager.link_losses);
+    conn_manager_link_lost(&manager);
+    CHECK(1U == manager.link_losses);
+    CHECK(1000U == fail_once(&manager, &now_ms));
+    CHECK(2000U == fail_once(&manager, &now_ms));
+    CHECK(6U == manager.total_attempts);
+    CHECK(5U == manager.total_failures);
+}
+
+static void test_clock_wrap(void)
+{
+    conn_manager_config_t config = default_config;
+    conn_manager_t manager;
+    uint32_t now_ms = UINT32_MAX - 500U;
+    uint32_t wait_ms;
+
+    config.jitter_percent = 0U;
+    conn_manager_init(&manager, &config, 1U);
+
+    CHECK(CONN_ACTION_CONNECT == conn_manager_next(&manager, now_ms,
+            &wait_ms));
+    CHECK(1000U == conn_manager_result(&manager, false, now_ms));
+
+    /* The retry time wrapped; the manager must still wait for it */
+    now_ms += 600U;
+    CHECK(CONN_ACTION_WAIT == conn_manager_next(&manager, now_ms, &wait_ms));
+    CHECK(400U == wait_ms);
+    now_ms += 400U;
+    CHECK(CONN_ACTION_CONNECT == conn_manager_next(&manager, now_ms,
+            &wait_ms));
+}
+
+static void test_state_names(void)
+{
+    CHECK(0 == strcmp("disconnected",
+            conn_manager_state_name(CONN_STATE_DISCONNECTED)));
+    CHECK(0 == strcmp("connecting",
+            conn_manager_state_name(CONN_STATE_CONNECTING)));
+    CHECK(0 == strcmp("backoff", conn_manager_state_name(CONN_STATE_BACKOFF)));
+    CHECK(0 == strcmp("connected",
+            conn_manager_state_name(CONN_STATE_CONNECTED)));
+    CHECK(0 == strcmp("unknown", conn_manager_state_name((conn_state_t)99)));
+}
+
+int main(void)
+{
+    test_backoff_growth();
+    test_jitter_bounds();
+    test_reset();
+    test_clock_wrap();
+    test_state_names();
+
+    return test_check_summary();
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,236 @@
+/*******************************************************************************
+* File Name:   idle_trace_replay.c
+*
+* Description: Replays idle periods recorded on the device through the idle
+* governor of proj_cm33_ns/source/idle_governor.c. It compares the energy spent
+* with the energy of always entering deep sleep, of always entering CPU sleep,
+* and of an oracle that knows the length of every period in advance.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*
+ * Build:
+ *  cc -O2 -Wall -I proj_cm33_ns/source -o idle_trace_replay \
+ *      tools/idle_trace_replay.c proj_cm33_ns/source/idle_governor.c \
+ *      proj_cm33_ns/source/power_model.c
+ *
+ * Usage:
+ *  idle_trace_replay [-s sleep_overhead_us] [-d deepsleep_overhead_us] < log
+ *
+ * The input is the debug UART output of the device with IDLE_GOVERNOR_ENABLE
+ * and IDLE_TRACE_ENABLE set to 1. Every line containing
+ * "idle,<expected_us>,<idle_us>" is one idle period; the other lines are
+ * ignored. Use the overheads printed by the device in the "Idle governor"
+ * lines.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "idle_governor.h"
+#include "power_model.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define DEFAULT_SLEEP_OVERHEAD_US       (30U)
+#define DEFAULT_DEEPSLEEP_OVERHEAD_US   (1000U)
+#define NJ_PER_UJ                       (1000.0)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    const char *name;
+    uint64_t energy_nj;
+} policy_t;
+
+enum
+{
+    POLICY_GOVERNOR = 0,
+    POLICY_DEEPSLEEP,
+    POLICY_SLEEP,
+    POLICY_ORACLE,
+    POLICY_COUNT
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    idle_governor_config_t config;
+    idle_governor_t governor;
+    idle_governor_t model;
+    policy_t policies[POLICY_COUNT] =
+    {
+        [POLICY_GOVERNOR]   = { "governor", 0U },
+        [POLICY_DEEPSLEEP]  = { "always deep sleep", 0U },
+        [POLICY_SLEEP]      = { "always CPU sleep", 0U },
+        [POLICY_ORACLE]     = { "oracle", 0U }
+    };
+    uint32_t oracle_choices[POWER_MODEL_STATE_COUNT] = { 0U };
+    uint64_t prediction_error_us = 0U;
+    uint32_t periods = 0U;
+    uint64_t idle_total_us = 0U;
+    char line[256];
+    int option;
+
+    memset(&config, 0, sizeof(config));
+    config.overhead_us[POWER_MODEL_STATE_SLEEP] = DEFAULT_SLEEP_OVERHEAD_US;
+    config.overhead_us[POWER_MODEL_STATE_DEEPSLEEP] =
+            DEFAULT_DEEPSLEEP_OVERHEAD_US;
+
+    while ((option = getopt(argc, argv, "s:d:")) != -1)
+    {
+        switch (option)
+        {
+            case 's':
+                config.overhead_us[POWER_MODEL_STATE_SLEEP] =
+                        (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'd':
+                config.overhead_us[POWER_MODEL_STATE_DEEPSLEEP] =
+                        (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            default:
+                fprintf(stderr, "Usage: %s [-s sleep_overhead_us] "
+                        "[-d deepsleep_overhead_us] < log\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    for (uint32_t state = 0U; state < (uint32_t)POWER_MODEL_STATE_COUNT;
+            state++)
+    {
+        config.power_uw[state] = power_model_default_table.mcu_uw[state];
+    }
+
+    /* The governor learns from the trace; the model only prices the modes */
+    idle_governor_init(&governor, &config);
+    idle_governor_init(&model, &config);
+
+    while (NULL != fgets(line, sizeof(line), stdin))
+    {
+        const char *record = strstr(line, "idle,");
+        unsigned long expected_us;
+        unsigned long idle_us;
+        power_model_state_t chosen;
+        uint32_t predicted_us;
+        uint64_t best = UINT64_MAX;
+        power_model_state_t best_state = POWER_MODEL_STATE_ACTIVE;
+
+        if ((NULL == record) ||
+                (2 != sscanf(record, "idle,%lu,%lu", &expected_us, &idle_us)))
+        {
+            continue;
+        }
+
+        predicted_us = idle_governor_predict(&governor, (uint32_t)expected_us);
+        prediction_error_us += (predicted_us > idle_us) ?
+                (predicted_us - idle_us) : (idle_us - predicted_us);
+
+        chosen = idle_governor_select(&governor, (uint32_t)expected_us);
+        policies[POLICY_GOVERNOR].energy_nj += idle_governor_energy_nj(&model,
+                chosen, (uint32_t)idle_us);
+        policies[POLICY_DEEPSLEEP].energy_nj += idle_governor_energy_nj(
+                &model, POWER_MODEL_STATE_DEEPSLEEP, (uint32_t)idle_us);
+        policies[POLICY_SLEEP].energy_nj += idle_governor_energy_nj(&model,
+                POWER_MODEL_STATE_SLEEP, (uint32_t)idle_us);
+
+        for (uint32_t state = 0U; state < (uint32_t)POWER_MODEL_STATE_COUNT;
+                state++)
+        {
+            uint64_t energy = idle_governor_energy_nj(&model,
+                    (power_model_state_t)state, (uint32_t)idle_us);
+
+            if (energy < best)
+            {
+                best = energy;
+                best_state = (power_model_state_t)state;
+            }
+        }
+        policies[POLICY_ORACLE].energy_nj += best;
+        oracle_choices[best_state]++;
+
+        idle_governor_record_idle(&governor, (uint32_t)expected_us,
+                (uint32_t)idle_us);
+        idle_total_us += idle_us;
+        periods++;
+    }
+
+    if (0U == periods)
+    {
+        fprintf(stderr, "No idle periods in the input\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("%u idle periods, %.1f ms idle, overheads: sleep %u us, "
+            "deep sleep %u us\n", periods, (double)idle_total_us / 1000.0,
+            config.overhead_us[POWER_MODEL_STATE_SLEEP],
+            config.overhead_us[POWER_MODEL_STATE_DEEPSLEEP]);
+    printf("Mean prediction error: %.1f us\n",
+            (double)prediction_error_us / periods);
+    printf("Governor choices: %u awake, %u sleep, %u deep sleep\n",
+            governor.decisions[POWER_MODEL_STATE_ACTIVE],
+            governor.decisions[POWER_MODEL_STATE_SLEEP],
+            governor.decisions[POWER_MODEL_STATE_DEEPSLEEP]);
+    printf("Oracle choices:   %u awake, %u sleep, %u deep sleep\n\n",
+            oracle_choices[POWER_MODEL_STATE_ACTIVE],
+            oracle_choices[POWER_MODEL_STATE_SLEEP],
+            oracle_choices[POWER_MODEL_STATE_DEEPSLEEP]);
+
+    printf("%-20s %14s %12s\n", "policy", "energy (uJ)", "vs oracle");
+    for (uint32_t i = 0U; i < POLICY_COUNT; i++)
+    {
+        printf("%-20s %14.1f %11.1f%%\n", policies[i].name,
+                (double)policies[i].energy_nj / NJ_PER_UJ,
+                100.0 * ((double)policies[i].energy_nj /
+                (double)policies[POLICY_ORACLE].energy_nj - 1.0));
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/* [] END OF FILE */
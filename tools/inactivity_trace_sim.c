@@ -0,0 +1,348 @@
+/*******************************************************************************
+* File Name:   inactivity_trace_sim.c
+*
+* Description: Drives the inactivity controller of
+* proj_cm33_ns/source/inactivity_controller.c with synthetic inter-packet gap
+* traces on Linux. It prints the window selected over time for every trace and
+* compares the energy, suspend/resume cycles and delayed packets with the fixed
+* INACTIVE_WINDOW_MS window.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+
+/*
+ * Build:
+ *  cc -O2 -Wall -I proj_cm33_ns/source -o inactivity_trace_sim \
+ *      tools/inactivity_trace_sim.c proj_cm33_ns/source/inactivity_controller.c
+ *
+ * Usage:
+ *  inactivity_trace_sim [-n gaps] [-b max_added_latency_us] [-r seed] [-v]
+ *
+ * Traces:
+ *  chatty    bursts of packets 15 to 45 ms apart, separated by 1 to 3 s
+ *  sparse    one packet every 5 to 30 s
+ *  mixed     chatty and sparse periods alternating every 500 gaps
+ *
+ * The exit status is non-zero if a window outside the configured range is
+ * selected, if the default window is not kept until enough gaps have been
+ * observed, if the default window is not used when no window fits the
+ * latency budget, or if the controller spends more energy than the fixed
+ * window on the chatty trace.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "inactivity_controller.h"
+#include "lowpower_config.h"
+#include "power_model.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define US_PER_MS                       (1000U)
+#define NJ_PER_UJ                       (1000U)
+
+/* Gaps of the mixed trace between two changes of traffic */
+#define MIXED_PERIOD_GAPS               (500U)
+
+/* Packets of a burst in the chatty trace */
+#define CHATTY_BURST_LEN                (20U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef enum
+{
+    TRACE_CHATTY = 0,
+    TRACE_SPARSE,
+    TRACE_MIXED,
+    TRACE_COUNT
+} trace_t;
+
+typedef struct
+{
+    uint64_t energy_nj;
+    uint32_t cycles;            /* Suspend/resume cycles */
+    uint32_t delayed;           /* Packets received with the stack suspended */
+    uint32_t gaps;
+} result_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const char * const trace_names[TRACE_COUNT] =
+{
+    "chatty", "sparse", "mixed"
+};
+
+static inactivity_controller_config_t config =
+{
+    .default_window_ms      = INACTIVE_WINDOW_MS,
+    .min_window_ms          = ADAPTIVE_WINDOW_MIN_MS,
+    .max_window_ms          = ADAPTIVE_WINDOW_MAX_MS,
+    .awake_uw               = POWER_MODEL_MCU_SLEEP_UW,
+    .suspended_uw           = POWER_MODEL_MCU_DEEPSLEEP_UW,
+    .suspend_resume_uj      = NETWORK_SUSPEND_RESUME_UJ,
+    .resume_latency_ms      = NETWORK_RESUME_LATENCY_MS,
+    .max_added_latency_us   = MAX_ADDED_LATENCY_US
+};
+
+static uint32_t gap_count = 5000U;
+static uint64_t rng_state = 1U;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static uint32_t rand32(void)
+{
+    rng_state = (rng_state * 6364136223846793005ULL) + 1442695040888963407ULL;
+
+    return (uint32_t)(rng_state >> 33U);
+}
+
+/* Uniform in [low, high] */
+static uint32_t rand_range(uint32_t low, uint32_t high)
+{
+    return low + (rand32() % (high - low + 1U));
+}
+
+static uint32_t next_gap_ms(trace_t trace, uint32_t index)
+{
+    if (TRACE_MIXED == trace)
+    {
+        trace = (0U == ((index / MIXED_PERIOD_GAPS) % 2U)) ?
+                TRACE_CHATTY : TRACE_SPARSE;
+    }
+
+    if (TRACE_SPARSE == trace)
+    {
+        return rand_range(5000U, 30000U);
+    }
+
+    return ((CHATTY_BURST_LEN - 1U) == (index % CHATTY_BURST_LEN)) ?
+            rand_range(1000U, 3000U) : rand_range(15U, 45U);
+}
+
+/* Cost of one gap with the given window, as on the device */
+static void account_gap(result_t *result, uint32_t gap_ms, uint32_t window_ms)
+{
+    if (gap_ms < window_ms)
+    {
+        result->energy_nj += (uint64_t)gap_ms * config.awake_uw;
+    }
+    else
+    {
+        result->energy_nj += ((uint64_t)window_ms * config.awake_uw) +
+                ((uint64_t)config.suspend_resume_uj * NJ_PER_UJ) +
+                ((uint64_t)(gap_ms - window_ms) * config.suspended_uw);
+        result->cycles++;
+        result->delayed++;
+    }
+
+    result->gaps++;
+}
+
+/* Runs a trace through the controller and through the fixed window, printing
+ * every window change, and returns whether the windows selected are
+ * consistent with the configuration.
+ */
+static bool run(trace_t trace, bool verbose, result_t *adaptive,
+        result_t *fixed)
+{
+    inactivity_controller_t controller;
+    inactivity_decision_t history[INACTIVITY_HISTORY_LEN];
+    uint32_t timestamp_ms = 0U;
+    uint32_t previous_ms = 0U;
+    uint32_t window_ms = 0U;
+    uint32_t count;
+    bool ok = true;
+
+    *adaptive = (result_t){ 0 };
+    *fixed = (result_t){ 0 };
+    inactivity_controller_init(&controller, &config);
+
+    for (uint32_t i = 0U; i < gap_count; i++)
+    {
+        uint32_t gap_ms = next_gap_ms(trace, i);
+
+        /* As on the device, the window is selected before every wait for
+         * inactivity and every received packet is observed.
+         */
+        window_ms = inactivity_controller_select(&controller, timestamp_ms);
+
+        if (verbose && (window_ms != previous_ms))
+        {
+            printf("  %8.1f s  gap %5u  window %4u ms\n",
+                    (double)timestamp_ms / 1000.0, i, window_ms);
+        }
+
+        previous_ms = window_ms;
+
+        if ((i < INACTIVITY_MIN_SAMPLES) &&
+            (window_ms != config.default_window_ms))
+        {
+            printf("  window %u ms after %u gaps\n", window_ms, i);
+            ok = false;
+        }
+
+        if ((window_ms != config.default_window_ms) &&
+            ((window_ms < config.min_window_ms) ||
+             (window_ms > config.max_window_ms)))
+        {
+            printf("  window %u ms out of range\n", window_ms);
+            ok = false;
+        }
+
+        account_gap(adaptive, gap_ms, window_ms);
+        account_gap(fixed, gap_ms, config.default_window_ms);
+
+        inactivity_controller_observe(&controller, gap_ms);
+        timestamp_ms += gap_ms;
+    }
+
+    /* Report kept by the controller, as printed by the device */
+    count = inactivity_controller_history(&controller, history,
+            INACTIVITY_HISTORY_LEN);
+
+    for (uint32_t h = 0U; verbose && (h < count); h++)
+    {
+        printf("  report %8.1f s  window %4u ms  expected delay %5u us\n",
+                (double)history[h].timestamp_ms / 1000.0,
+                history[h].window_ms, history[h].expected_latency_us);
+    }
+
+    return ok;
+}
+
+static void print_result(const char *name, const char *policy,
+        const result_t *result)
+{
+    printf("%-7s %-8s %10.3f %8u %8.2f\n", name, policy,
+            (double)result->energy_nj / 1e9, result->cycles,
+            ((double)result->delayed * NETWORK_RESUME_LATENCY_MS * US_PER_MS) /
+            ((0U == result->gaps) ? 1U : result->gaps));
+}
+
+int main(int argc, char *argv[])
+{
+    result_t adaptive;
+    result_t fixed;
+    uint32_t seed = 1U;
+    bool verbose = false;
+    bool ok = true;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "n:b:r:v")))
+    {
+        switch (opt)
+        {
+            case 'n':
+                gap_count = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'b':
+                config.max_added_latency_us =
+                        (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'r':
+                seed = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'v':
+                verbose = true;
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-n gaps] "
+                        "[-b max_added_latency_us] [-r seed] [-v]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    printf("%u gaps, latency budget %u us, default window %u ms\n",
+            gap_count, config.max_added_latency_us, config.default_window_ms);
+
+    for (uint32_t t = 0U; t < (uint32_t)TRACE_COUNT; t++)
+    {
+        rng_state = seed;
+        printf("%s:\n", trace_names[t]);
+        ok = run((trace_t)t, verbose, &adaptive, &fixed) && ok;
+
+        printf("%-7s %-8s %10s %8s %8s\n", "trace", "window", "energy J",
+                "cycles", "delay us");
+        print_result(trace_names[t], "fixed", &fixed);
+        print_result(trace_names[t], "adaptive", &adaptive);
+
+        if (TRACE_CHATTY == (trace_t)t)
+        {
+            ok = ok && (adaptive.energy_nj <= fixed.energy_nj);
+        }
+    }
+
+    /* Every gap of the sparse trace is longer than the longest window, so no
+     * window fits a budget below the resume latency: the default window must
+     * be kept rather than the longest one.
+     */
+    if (config.max_added_latency_us < (NETWORK_RESUME_LATENCY_MS * US_PER_MS))
+    {
+        inactivity_controller_t controller;
+
+        inactivity_controller_init(&controller, &config);
+        rng_state = seed;
+
+        for (uint32_t i = 0U; i < gap_count; i++)
+        {
+            inactivity_controller_observe(&controller,
+                    next_gap_ms(TRACE_SPARSE, i));
+        }
+
+        if (config.default_window_ms !=
+            inactivity_controller_select(&controller, 0U))
+        {
+            printf("sparse: default window not used over budget\n");
+            ok = false;
+        }
+    }
+
+    printf("%s\n", ok ? "PASS" : "FAIL");
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,561 @@
+/*******************************************************************************
+* File Name:   ipc_pipeline_test.c
+*
+* Description: Linux checks of the buffer handoff of the inter-core pipeline
+* (shared/ipc_pipeline.c). The single-threaded checks cover the attach
+* handshake, the sequence numbers, the cache maintenance and the rejected
+* descriptors. Then one thread stands in for each core and a semaphore for the
+* doorbell interrupt, and every buffer is checked to be owned by one side at a
+* time and to arrive complete and in order.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+
+/*
+ * Build:
+ *  cc -O2 -Wall -pthread -I shared -o ipc_pipeline_test \
+ *      tools/ipc_pipeline_test.c shared/ipc_pipeline.c shared/ipc_ring.c
+ *
+ * Usage:
+ *  ipc_pipeline_test [buffers]
+ *
+ * Prints every failed check and exits with a non-zero status if any.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ipc_pipeline.h"
+
+#include "test_check.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define DEFAULT_BUFFERS                 (200000UL)
+
+/* Arming of the ready ring by the consumer thread */
+#define THRESHOLD                       (4U)
+#define DEADLINE_MS                     (1U)
+
+/* Longest wait for a doorbell before the consumer counts a stall */
+#define DOORBELL_TIMEOUT_S              (1)
+
+/* Buffers the consumer holds before releasing them, in reverse order */
+#define HELD_BUFFERS                    (3U)
+
+/*******************************************************************************
+* Enumerations
+*******************************************************************************/
+/* Owner of a buffer, tracked next to the pipeline by the threads */
+typedef enum
+{
+    OWNER_FREE,                 /* In the free ring */
+    OWNER_PRODUCER,             /* Acquired, being filled */
+    OWNER_READY,                /* In the ready ring */
+    OWNER_CONSUMER              /* Received, being sent */
+} owner_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static ipc_pipeline_shared_t shared;
+static ipc_pipeline_t producer;
+static ipc_pipeline_t consumer;
+
+/* Cache maintenance recorded by cache_ops: the first clean, which comes
+ * before the descriptor is pushed, and the last invalidate, which comes after
+ * the descriptor is popped.
+ */
+static const volatile void *clean_addr;
+static size_t clean_size;
+static uint32_t clean_calls;
+static volatile void *invalidate_addr;
+static size_t invalidate_size;
+static uint32_t invalidate_calls;
+
+/* Two-thread run */
+static atomic_uint owner[IPC_PIPELINE_BUFFER_COUNT];
+static atomic_uint owner_errors;
+static atomic_bool consumer_done;
+static sem_t doorbell;
+static uint32_t buffer_total;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static void record_clean(const volatile void *addr, size_t size)
+{
+    if (0U == clean_calls)
+    {
+        clean_addr = addr;
+        clean_size = size;
+    }
+    clean_calls++;
+}
+
+static void record_invalidate(volatile void *addr, size_t size)
+{
+    invalidate_addr = addr;
+    invalidate_size = size;
+    invalidate_calls++;
+}
+
+static const ipc_cache_ops_t cache_ops =
+{
+    .clean = record_clean,
+    .invalidate = record_invalidate
+};
+
+static uint32_t now_ms(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint32_t)(((uint64_t)ts.tv_sec * 1000U) +
+            ((uint64_t)ts.tv_nsec / 1000000U));
+}
+
+static uint32_t buffer_index(const ipc_pipeline_buffer_t *buffer)
+{
+    return (uint32_t)(buffer - shared.buffers);
+}
+
+/* Payload length and contents of the buffer submitted with a sequence number,
+ * so that the consumer can tell a torn or reused buffer.
+ */
+static uint32_t payload_length(uint32_t seq)
+{
+    return 1U + ((seq * 37U) % IPC_PIPELINE_BUFFER_SIZE);
+}
+
+static uint8_t payload_byte(uint32_t seq, uint32_t offset)
+{
+    return (uint8_t)((seq * 7U) + offset);
+}
+
+/* Moves a buffer to a new owner. Counts an error if it was not owned by the
+ * expected side, which means the same buffer was handed out twice.
+ */
+static void set_owner(const ipc_pipeline_buffer_t *buffer, owner_t from,
+        owner_t to)
+{
+    if ((unsigned int)from != atomic_exchange(&owner[buffer_index(buffer)],
+            (unsigned int)to))
+    {
+        atomic_fetch_add(&owner_errors, 1U);
+    }
+}
+
+static void test_attach(void)
+{
+    memset(&shared, 0, sizeof(shared));
+
+    /* The CM55 does not attach before the CM33 has initialized the area */
+    CHECK(!ipc_pipeline_attach(&producer, &shared, NULL));
+
+    ipc_pipeline_init(&consumer, &shared, NULL);
+    CHECK(ipc_pipeline_attach(&producer, &shared, NULL));
+    CHECK(0U == ipc_pipeline_ready_count(&consumer));
+
+    /* Nor to an area of another layout */
+    shared.version = IPC_PIPELINE_VERSION + 1U;
+    CHECK(!ipc_pipeline_attach(&producer, &shared, NULL));
+    shared.version = IPC_PIPELINE_VERSION;
+    shared.buffer_count = IPC_PIPELINE_BUFFER_COUNT - 1U;
+    CHECK(!ipc_pipeline_attach(&producer, &shared, NULL));
+    shared.buffer_count = IPC_PIPELINE_BUFFER_COUNT;
+    shared.buffer_size = IPC_PIPELINE_BUFFER_SIZE / 2U;
+    CHECK(!ipc_pipeline_attach(&producer, &shared, NULL));
+    shared.buffer_size = IPC_PIPELINE_BUFFER_SIZE;
+    CHECK(ipc_pipeline_attach(&producer, &shared, NULL));
+}
+
+static void test_handoff(void)
+{
+    ipc_pipeline_buffer_t *acquired[IPC_PIPELINE_BUFFER_COUNT];
+    ipc_pipeline_buffer_t *buffer;
+    bool seen[IPC_PIPELINE_BUFFER_COUNT];
+
+    memset(&shared, 0, sizeof(shared));
+    memset(seen, 0, sizeof(seen));
+    ipc_pipeline_init(&consumer, &shared, NULL);
+    CHECK(ipc_pipeline_attach(&producer, &shared, NULL));
+
+    /* Every buffer is handed out once, then the free ring is empty */
+    for (uint32_t i = 0U; i < IPC_PIPELINE_BUFFER_COUNT; i++)
+    {
+        acquired[i] = ipc_pipeline_acquire(&producer);
+        CHECK(NULL != acquired[i]);
+        if (NULL == acquired[i])
+        {
+            return;
+        }
+        CHECK(!seen[buffer_index(acquired[i])]);
+        seen[buffer_index(acquired[i])] = true;
+        CHECK(0U == acquired[i]->length);
+    }
+    CHECK(NULL == ipc_pipeline_acquire(&producer));
+
+    /* Submitted in order, numbered in order */
+    for (uint32_t i = 0U; i < IPC_PIPELINE_BUFFER_COUNT; i++)
+    {
+        acquired[i]->length = 10U * i;
+        acquired[i]->tag = 100U + i;
+        CHECK(!ipc_pipeline_submit(&producer, acquired[i], 0U));
+        CHECK(i == acquired[i]->seq);
+    }
+    CHECK(IPC_PIPELINE_BUFFER_COUNT == ipc_pipeline_ready_count(&consumer));
+
+    /* Received in the same order, with the header set by the producer */
+    for (uint32_t i = 0U; i < IPC_PIPELINE_BUFFER_COUNT; i++)
+    {
+        buffer = ipc_pipeline_receive(&consumer);
+        CHECK(acquired[i] == buffer);
+        if (NULL == buffer)
+        {
+            return;
+        }
+        CHECK(i == buffer->seq);
+        CHECK((10U * i) == buffer->length);
+        CHECK((100U + i) == buffer->tag);
+    }
+    CHECK(NULL == ipc_pipeline_receive(&consumer));
+    CHECK(0U == ipc_pipeline_ready_count(&consumer));
+
+    /* The producer gets a buffer back only once the consumer releases it */
+    CHECK(NULL == ipc_pipeline_acquire(&producer));
+    ipc_pipeline_release(&consumer, acquired[5]);
+    buffer = ipc_pipeline_acquire(&producer);
+    CHECK(acquired[5] == buffer);
+    CHECK(NULL == ipc_pipeline_acquire(&producer));
+
+    /* A length beyond the payload is clamped, and the numbering goes on */
+    if (NULL != buffer)
+    {
+        buffer->length = IPC_PIPELINE_BUFFER_SIZE + 1U;
+        (void)ipc_pipeline_submit(&producer, buffer, 0U);
+        CHECK(IPC_PIPELINE_BUFFER_SIZE == buffer->length);
+        CHECK(IPC_PIPELINE_BUFFER_COUNT == buffer->seq);
+        CHECK(buffer == ipc_pipeline_receive(&consumer));
+    }
+}
+
+static void test_rejected_descriptors(void)
+{
+    ipc_ring_desc_t desc;
+    bool ring;
+
+    memset(&shared, 0, sizeof(shared));
+    ipc_pipeline_init(&consumer, &shared, NULL);
+    CHECK(ipc_pipeline_attach(&producer, &shared, NULL));
+
+    /* Another descriptor type */
+    memset(&desc, 0, sizeof(desc));
+    desc.type = IPC_PIPELINE_DESC_BUFFER + 1U;
+    CHECK(ipc_ring_push(&producer.ready, &desc, 0U, &ring));
+    CHECK(NULL == ipc_pipeline_receive(&consumer));
+
+    /* A buffer index outside the pool */
+    desc.type = IPC_PIPELINE_DESC_BUFFER;
+    desc.arg[0] = IPC_PIPELINE_BUFFER_COUNT;
+    CHECK(ipc_ring_push(&producer.ready, &desc, 0U, &ring));
+    CHECK(NULL == ipc_pipeline_receive(&consumer));
+
+    /* A descriptor taken from the free ring by the producer */
+    CHECK(ipc_ring_pop(&producer.free, &desc));
+    desc.type = IPC_PIPELINE_DESC_BUFFER + 1U;
+    CHECK(ipc_ring_push(&consumer.free, &desc, 0U, &ring));
+    for (uint32_t i = 1U; i < IPC_PIPELINE_BUFFER_COUNT; i++)
+    {
+        CHECK(NULL != ipc_pipeline_acquire(&producer));
+    }
+    CHECK(NULL == ipc_pipeline_acquire(&producer));
+}
+
+static void test_cache(void)
+{
+    ipc_pipeline_buffer_t *buffer;
+
+    memset(&shared, 0, sizeof(shared));
+    ipc_pipeline_init(&consumer, &shared, &cache_ops);
+    CHECK(ipc_pipeline_attach(&producer, &shared, &cache_ops));
+
+    /* The header and the payload are written back before the handoff */
+    buffer = ipc_pipeline_acquire(&producer);
+    CHECK(NULL != buffer);
+    if (NULL == buffer)
+    {
+        return;
+    }
+    buffer->length = 100U;
+    clean_calls = 0U;
+    (void)ipc_pipeline_submit(&producer, buffer, 0U);
+    CHECK(0U != clean_calls);
+    CHECK((const volatile void *)buffer == clean_addr);
+    CHECK((offsetof(ipc_pipeline_buffer_t, data) + 100U) == clean_size);
+
+    /* and discarded from the cache of the consumer before it reads them */
+    invalidate_calls = 0U;
+    CHECK(buffer == ipc_pipeline_receive(&consumer));
+    CHECK(0U != invalidate_calls);
+    CHECK((volatile void *)buffer == invalidate_addr);
+    CHECK(sizeof(ipc_pipeline_buffer_t) == invalidate_size);
+}
+
+static void test_doorbell(void)
+{
+    ipc_pipeline_buffer_t *buffer;
+
+    memset(&shared, 0, sizeof(shared));
+    ipc_pipeline_init(&consumer, &shared, NULL);
+    CHECK(ipc_pipeline_attach(&producer, &shared, NULL));
+
+    /* Unarmed, the producer never rings */
+    buffer = ipc_pipeline_acquire(&producer);
+    CHECK(!ipc_pipeline_submit(&producer, buffer, 0U));
+    CHECK(buffer == ipc_pipeline_receive(&consumer));
+    ipc_pipeline_release(&consumer, buffer);
+
+    /* Armed for two buffers, it rings on the second one, once */
+    CHECK(!ipc_pipeline_arm(&consumer, 2U, 1000U));
+    CHECK(!ipc_pipeline_submit(&producer, ipc_pipeline_acquire(&producer),
+            0U));
+    CHECK(ipc_pipeline_submit(&producer, ipc_pipeline_acquire(&producer),
+            0U));
+    CHECK(!ipc_pipeline_submit(&producer, ipc_pipeline_acquire(&producer),
+            0U));
+
+    /* The consumer does not wait when enough buffers are already ready */
+    CHECK(ipc_pipeline_arm(&consumer, 2U, 1000U));
+
+    /* Armed with a deadline, the oldest buffer rings once it has waited */
+    while (NULL != (buffer = ipc_pipeline_receive(&consumer)))
+    {
+        ipc_pipeline_release(&consumer, buffer);
+    }
+    CHECK(!ipc_pipeline_arm(&consumer, 4U, 10U));
+    CHECK(!ipc_pipeline_submit(&producer, ipc_pipeline_acquire(&producer),
+            100U));
+    CHECK(!ipc_pipeline_doorbell_due(&producer, 105U));
+    CHECK(ipc_pipeline_doorbell_due(&producer, 110U));
+}
+
+/* Stands in for the CM55: attaches once the area is initialized, then fills
+ * and submits the buffers as fast as they are returned. Keeps honouring the
+ * deadline of the consumer until it is done.
+ */
+static void *producer_thread(void *arg)
+{
+    ipc_pipeline_t pipeline;
+    ipc_pipeline_buffer_t *buffer;
+
+    (void)arg;
+
+    while (!ipc_pipeline_attach(&pipeline, &shared, NULL))
+    {
+        sched_yield();
+    }
+
+    for (uint32_t seq = 0U; seq < buffer_total; seq++)
+    {
+        while (NULL == (buffer = ipc_pipeline_acquire(&pipeline)))
+        {
+            if (ipc_pipeline_doorbell_due(&pipeline, now_ms()))
+            {
+                sem_post(&doorbell);
+            }
+            sched_yield();
+        }
+
+        set_owner(buffer, OWNER_FREE, OWNER_PRODUCER);
+
+        buffer->length = payload_length(seq);
+        buffer->tag = seq;
+        for (uint32_t i = 0U; i < buffer->length; i++)
+        {
+            buffer->data[i] = payload_byte(seq, i);
+        }
+
+        set_owner(buffer, OWNER_PRODUCER, OWNER_READY);
+
+        if (ipc_pipeline_submit(&pipeline, buffer, now_ms()))
+        {
+            sem_post(&doorbell);
+        }
+    }
+
+    while (!atomic_load(&consumer_done))
+    {
+        if (ipc_pipeline_doorbell_due(&pipeline, now_ms()))
+        {
+            sem_post(&doorbell);
+        }
+        sched_yield();
+    }
+
+    return NULL;
+}
+
+/* Stands in for the CM33: sleeps until the doorbell rings, checks every
+ * buffer received, and returns them in batches in reverse order.
+ */
+static void test_threads(void)
+{
+    ipc_pipeline_buffer_t *held[HELD_BUFFERS];
+    ipc_pipeline_buffer_t *buffer;
+    pthread_t thread;
+    uint32_t held_count = 0U;
+    uint32_t received = 0U;
+    uint32_t out_of_order = 0U;
+    uint32_t bad_payload = 0U;
+    uint32_t stalls = 0U;
+
+    memset(&shared, 0, sizeof(shared));
+    for (uint32_t i = 0U; i < IPC_PIPELINE_BUFFER_COUNT; i++)
+    {
+        atomic_store(&owner[i], (unsigned int)OWNER_FREE);
+    }
+    atomic_store(&owner_errors, 0U);
+    atomic_store(&consumer_done, false);
+    sem_init(&doorbell, 0, 0U);
+
+    /* The producer starts first and waits for the area */
+    pthread_create(&thread, NULL, producer_thread, NULL);
+    ipc_pipeline_init(&consumer, &shared, NULL);
+
+    while (received < buffer_total)
+    {
+        if (!ipc_pipeline_arm(&consumer, THRESHOLD, DEADLINE_MS))
+        {
+            struct timespec timeout;
+
+            clock_gettime(CLOCK_REALTIME, &timeout);
+            timeout.tv_sec += DOORBELL_TIMEOUT_S;
+            if (0 != sem_timedwait(&doorbell, &timeout))
+            {
+                stalls++;
+            }
+        }
+
+        while (NULL != (buffer = ipc_pipeline_receive(&consumer)))
+        {
+            set_owner(buffer, OWNER_READY, OWNER_CONSUMER);
+
+            if ((received != buffer->seq) || (received != buffer->tag))
+            {
+                out_of_order++;
+            }
+
+            if (payload_length(received) != buffer->length)
+            {
+                bad_payload++;
+            }
+            else
+            {
+                for (uint32_t i = 0U; i < buffer->length; i++)
+                {
+                    if (payload_byte(received, i) != buffer->data[i])
+                    {
+                        bad_payload++;
+                        break;
+                    }
+                }
+            }
+
+            received++;
+            held[held_count++] = buffer;
+
+            if ((HELD_BUFFERS == held_count) || (received == buffer_total))
+            {
+                while (0U != held_count)
+                {
+                    held_count--;
+                    set_owner(held[held_count], OWNER_CONSUMER, OWNER_FREE);
+                    ipc_pipeline_release(&consumer, held[held_count]);
+                }
+            }
+        }
+    }
+
+    atomic_store(&consumer_done, true);
+    pthread_join(thread, NULL);
+    sem_destroy(&doorbell);
+
+    CHECK(buffer_total == received);
+    CHECK(0U == out_of_order);
+    CHECK(0U == bad_payload);
+    CHECK(0U == atomic_load(&owner_errors));
+    CHECK(0U == stalls);
+    CHECK(buffer_total == consumer.ready.stats.messages);
+
+    /* Every buffer is back in the free ring */
+    CHECK(ipc_pipeline_attach(&producer, &shared, NULL));
+    CHECK(0U == ipc_pipeline_ready_count(&consumer));
+    for (uint32_t i = 0U; i < IPC_PIPELINE_BUFFER_COUNT; i++)
+    {
+        CHECK(NULL != ipc_pipeline_acquire(&producer));
+    }
+    CHECK(NULL == ipc_pipeline_acquire(&producer));
+}
+
+int main(int argc, char *argv[])
+{
+    buffer_total = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) :
+            DEFAULT_BUFFERS;
+
+    test_attach();
+    test_handoff();
+    test_rejected_descriptors();
+    test_cache();
+    test_doorbell();
+    test_threads();
+
+    return test_check_summary();
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,220 @@
+/*******************************************************************************
+* File Name:   ipc_ring_bench.c
+*
+* Description: Linux benchmark of the inter-core descriptor ring
+* (shared/ipc_ring.c). One thread stands in for each core and a semaphore for
+* the doorbell interrupt. For each doorbell threshold, it prints the messages
+* per second, the doorbells raised, and the latency from push to pop.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*
+ * Build:
+ *  cc -O2 -Wall -pthread -I shared -o ipc_ring_bench tools/ipc_ring_bench.c \
+ *      shared/ipc_ring.c
+ *
+ * Usage:
+ *  ipc_ring_bench [messages]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <semaphore.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ipc_ring.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define DEFAULT_MESSAGES                (1000000UL)
+#define DEADLINE_MS                     (1U)
+#define FLUSH_POLL_NS                   (100000L)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static ipc_ring_shared_t shared;
+static ipc_ring_t producer;
+static ipc_ring_t consumer;
+static sem_t doorbell;
+static uint32_t messages;
+static atomic_bool consumer_done;
+
+static const uint32_t thresholds[] = { 1U, 2U, 4U, 8U, 16U };
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t now_ms(void)
+{
+    return (uint32_t)(now_ns() / 1000000U);
+}
+
+/* Pushes the messages as fast as the ring allows, then keeps honouring the
+ * deadline of the consumer like a producer woken up by other events.
+ */
+static void *producer_thread(void *arg)
+{
+    ipc_ring_desc_t desc;
+    bool ring;
+
+    (void)arg;
+    memset(&desc, 0, sizeof(desc));
+
+    for (uint32_t i = 0U; i < messages; i++)
+    {
+        desc.arg[0] = i;
+        desc.arg[1] = (uint32_t)(now_ns() / 1000U);
+
+        while (!ipc_ring_push(&producer, &desc, now_ms(), &ring))
+        {
+            sched_yield();
+        }
+
+        if (ring)
+        {
+            sem_post(&doorbell);
+        }
+    }
+
+    while (!atomic_load(&consumer_done))
+    {
+        struct timespec poll = { 0, FLUSH_POLL_NS };
+
+        if (ipc_ring_doorbell_due(&producer, now_ms()))
+        {
+            sem_post(&doorbell);
+        }
+        nanosleep(&poll, NULL);
+    }
+
+    return NULL;
+}
+
+static void run(uint32_t threshold)
+{
+    pthread_t thread;
+    ipc_ring_desc_t desc;
+    uint64_t latency_sum_us = 0U;
+    uint32_t latency_max_us = 0U;
+    uint32_t wakes = 0U;
+    uint32_t received = 0U;
+    uint64_t start;
+    double seconds;
+
+    ipc_ring_init(&shared, NULL);
+    ipc_ring_open(&producer, &shared, NULL);
+    ipc_ring_open(&consumer, &shared, NULL);
+    sem_init(&doorbell, 0, 0U);
+    atomic_store(&consumer_done, false);
+
+    start = now_ns();
+    pthread_create(&thread, NULL, producer_thread, NULL);
+
+    while (received < messages)
+    {
+        if (!ipc_ring_arm(&consumer, threshold, DEADLINE_MS))
+        {
+            sem_wait(&doorbell);
+            wakes++;
+        }
+
+        while (ipc_ring_pop(&consumer, &desc))
+        {
+            uint32_t latency_us = (uint32_t)(now_ns() / 1000U) - desc.arg[1];
+
+            if (desc.arg[0] != received)
+            {
+                fprintf(stderr, "Message %u received as %u\n", received,
+                        desc.arg[0]);
+                exit(EXIT_FAILURE);
+            }
+
+            latency_sum_us += latency_us;
+            latency_max_us = (latency_us > latency_max_us) ?
+                    latency_us : latency_max_us;
+            received++;
+        }
+    }
+
+    seconds = (double)(now_ns() - start) / 1e9;
+    atomic_store(&consumer_done, true);
+    pthread_join(thread, NULL);
+    sem_destroy(&doorbell);
+
+    printf("%9u %12.0f %10u %10u %12.1f %12.2f %10u\n", threshold,
+            messages / seconds, producer.stats.doorbells, wakes,
+            (double)messages / ((0U == wakes) ? 1U : wakes),
+            (double)latency_sum_us / messages, latency_max_us);
+}
+
+int main(int argc, char *argv[])
+{
+    messages = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) :
+            DEFAULT_MESSAGES;
+
+    printf("%u messages, ring of %u descriptors, deadline %u ms\n", messages,
+            IPC_RING_SIZE, DEADLINE_MS);
+    printf("%9s %12s %10s %10s %12s %12s %10s\n", "threshold", "messages/s",
+            "doorbells", "waits", "msgs/wait", "avg lat us", "max lat us");
+
+    for (size_t i = 0U; i < (sizeof(thresholds) / sizeof(thresholds[0])); i++)
+    {
+        run(thresholds[i]);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/* [] END OF FILE */
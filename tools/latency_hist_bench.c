@@ -0,0 +1,378 @@
+/*******************************************************************************
+* File Name:   latency_hist_bench.c
+*
+* Description: Linux benchmark of the wake latency histograms
+* (proj_cm33_ns/source/latency_hist.c). It checks the reported percentiles
+* against the exact ones for several latency distributions, measures the cost of
+* recording a latency from one thread and from several threads at once, standing
+* in for interrupts of different priorities, and replays wakes whose points
+* arrive out of order through the trace.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+
+/*
+ * Build:
+ *  cc -O2 -Wall -pthread -I proj_cm33_ns/source -o latency_hist_bench \
+ *      tools/latency_hist_bench.c proj_cm33_ns/source/latency_hist.c
+ *
+ * Usage:
+ *  latency_hist_bench [samples] [threads]
+ *
+ * The exit status is non-zero if a percentile is below the exact value or
+ * more than one bucket width above it, if a concurrent recording is lost, or
+ * if a traced wake is attributed to the wrong stages.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "latency_hist.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define DEFAULT_SAMPLES                 (1000000UL)
+#define DEFAULT_THREADS                 (4U)
+#define MAX_THREADS                     (16U)
+
+/* Timestamp frequency of the LPTimer on the device */
+#define TRACE_TICK_HZ                   (32768U)
+#define TRACE_GAP_MS                    (20U)
+#define TRACE_WAKES                     (10000U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static latency_hist_t hist;
+static uint32_t *values;
+static uint32_t samples;
+static uint32_t thread_count;
+static uint32_t failures;
+
+typedef struct
+{
+    const char *name;
+    uint32_t (*draw)(void);
+} distribution_t;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t rand32(void)
+{
+    static uint64_t state = 0x853C49E6748FEA9BULL;
+
+    state ^= state << 13U;
+    state ^= state >> 7U;
+    state ^= state << 17U;
+
+    return (uint32_t)(state >> 16U);
+}
+
+/* Deep sleep exit: 1.5 ms to 3 ms */
+static uint32_t draw_uniform(void)
+{
+    return 1500U + (rand32() % 1500U);
+}
+
+/* SDIO re-initialization: mostly 400 us, 2% of retries at 20 ms to 60 ms */
+static uint32_t draw_bimodal(void)
+{
+    return ((rand32() % 100U) < 2U) ? (20000U + (rand32() % 40000U)) :
+            (350U + (rand32() % 100U));
+}
+
+/* lwIP queueing: exponential with a mean of 300 us */
+static uint32_t draw_exponential(void)
+{
+    uint32_t value = 0U;
+
+    while ((rand32() % 300U) != 0U)
+    {
+        value++;
+    }
+
+    return value;
+}
+
+/* Beyond the range of the buckets */
+static uint32_t draw_overflow(void)
+{
+    return 500000U + (rand32() % 4000000U);
+}
+
+static const distribution_t distributions[] =
+{
+    { "uniform",        draw_uniform },
+    { "bimodal",        draw_bimodal },
+    { "exponential",    draw_exponential },
+    { "overflow",       draw_overflow }
+};
+
+static int compare_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/* A percentile must be at least the exact value and within the bucket of the
+ * exact value, or equal to the maximum when the value is beyond the buckets.
+ */
+static bool percentile_ok(uint32_t reported, uint32_t exact, uint32_t max)
+{
+    return (reported >= exact) && ((reported <= latency_hist_bucket_max(
+            latency_hist_bucket(exact))) || (reported == max));
+}
+
+static void check_accuracy(const distribution_t *distribution)
+{
+    latency_hist_summary_t summary;
+    uint32_t exact50;
+    uint32_t exact99;
+    uint32_t max;
+    uint64_t start;
+    double ns;
+    bool ok;
+
+    for (uint32_t i = 0U; i < samples; i++)
+    {
+        values[i] = distribution->draw();
+    }
+
+    latency_hist_reset(&hist);
+    start = now_ns();
+    for (uint32_t i = 0U; i < samples; i++)
+    {
+        latency_hist_record(&hist, values[i]);
+    }
+    ns = (double)(now_ns() - start) / samples;
+
+    latency_hist_summarize(&hist, &summary);
+
+    qsort(values, samples, sizeof(values[0]), compare_u32);
+    exact50 = values[((samples + 1U) / 2U) - 1U];
+    exact99 = values[(uint32_t)((((uint64_t)samples * 99U) + 99U) / 100U) - 1U];
+    max = values[samples - 1U];
+
+    ok = (summary.count == samples) && (summary.max_us == max) &&
+            percentile_ok(summary.p50_us, exact50, max) &&
+            percentile_ok(summary.p99_us, exact99, max);
+    failures += ok ? 0U : 1U;
+
+    printf("%-12s %8u %8u %8u %8u %8u %8u %8.1f %s\n", distribution->name,
+            exact50, summary.p50_us, exact99, summary.p99_us, max,
+            summary.max_us, ns, ok ? "ok" : "FAIL");
+}
+
+static void *record_thread(void *arg)
+{
+    uint32_t first = (uint32_t)(uintptr_t)arg;
+
+    for (uint32_t i = first; i < samples; i += thread_count)
+    {
+        latency_hist_record(&hist, values[i]);
+    }
+
+    return NULL;
+}
+
+static void check_contention(void)
+{
+    pthread_t threads[MAX_THREADS];
+    latency_hist_summary_t summary;
+    uint32_t max = 0U;
+    uint64_t start;
+    double ns;
+    bool ok;
+
+    for (uint32_t i = 0U; i < samples; i++)
+    {
+        values[i] = draw_bimodal();
+        max = (values[i] > max) ? values[i] : max;
+    }
+
+    latency_hist_reset(&hist);
+    start = now_ns();
+    for (uint32_t t = 0U; t < thread_count; t++)
+    {
+        pthread_create(&threads[t], NULL, record_thread, (void *)(uintptr_t)t);
+    }
+    for (uint32_t t = 0U; t < thread_count; t++)
+    {
+        pthread_join(threads[t], NULL);
+    }
+    ns = (double)(now_ns() - start) / samples;
+
+    latency_hist_summarize(&hist, &summary);
+    ok = (summary.count == samples) && (summary.max_us == max);
+    failures += ok ? 0U : 1U;
+
+    printf("%u threads: %u recorded of %u, max %u of %u, %.1f ns per "
+            "record %s\n", thread_count, summary.count, samples,
+            summary.max_us, max, ns, ok ? "ok" : "FAIL");
+}
+
+/* Replays wakes whose points are marked in a random order with random
+ * stage durations, and checks that every stage lands in the histogram of
+ * the point that ends it. Marks left over from the active period before each
+ * wake must be discarded by the gap.
+ */
+static void check_trace(void)
+{
+    static latency_stages_t stages;
+    latency_trace_t trace;
+    latency_hist_summary_t summary;
+    uint32_t expected[LATENCY_POINT_COUNT] = { 0U };
+    uint32_t now = 0xFFFF0000UL;
+    uint32_t recorded = 0U;
+    bool ok = true;
+
+    latency_trace_init(&trace, TRACE_GAP_MS, TRACE_TICK_HZ);
+    latency_stages_reset(&stages);
+
+    for (uint32_t wake = 0U; wake < TRACE_WAKES; wake++)
+    {
+        latency_point_t order[LATENCY_POINT_COUNT - 1U];
+        uint32_t points = 1U + (rand32() % (LATENCY_POINT_COUNT - 1U));
+
+        /* Traffic of the active period, then the inactivity window */
+        latency_trace_mark(&trace, LATENCY_POINT_SDIO_IRQ, now);
+        latency_trace_mark(&trace, LATENCY_POINT_TCPIP_RX, now + 3U);
+        now += 3U + ((TRACE_GAP_MS * 3U * TRACE_TICK_HZ) / 1000U);
+
+        for (uint32_t i = 0U; i < (LATENCY_POINT_COUNT - 1U); i++)
+        {
+            order[i] = (latency_point_t)i;
+        }
+        for (uint32_t i = (LATENCY_POINT_COUNT - 2U); i > 0U; i--)
+        {
+            uint32_t j = rand32() % (i + 1U);
+            latency_point_t swap = order[i];
+
+            order[i] = order[j];
+            order[j] = swap;
+        }
+
+        for (uint32_t i = 0U; i < points; i++)
+        {
+            now += (0U == i) ? 0U : (1U + (rand32() % 100U));
+            latency_trace_mark(&trace, order[i], now);
+            /* A repeated point must not move the first timestamp */
+            latency_trace_mark(&trace, order[i], now);
+            expected[order[i]] += (0U == i) ? 0U : 1U;
+        }
+
+        now += 1U + (rand32() % 100U);
+        recorded += latency_trace_close(&trace, &stages, now);
+        expected[LATENCY_POINT_TASK_RESUMED]++;
+        now += rand32() % 1000U;
+    }
+
+    for (uint32_t p = 0U; p < (uint32_t)LATENCY_POINT_COUNT; p++)
+    {
+        latency_hist_summarize(&stages.stage[p], &summary);
+        ok = ok && (summary.count == expected[p]);
+    }
+    latency_hist_summarize(&stages.total, &summary);
+    ok = ok && (summary.count == TRACE_WAKES) && (0U == stages.untraced);
+    failures += ok ? 0U : 1U;
+
+    printf("Trace: %u wakes, %u stages recorded, %u untraced %s\n",
+            TRACE_WAKES, recorded, stages.untraced, ok ? "ok" : "FAIL");
+}
+
+int main(int argc, char *argv[])
+{
+    samples = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) :
+            DEFAULT_SAMPLES;
+    thread_count = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) :
+            DEFAULT_THREADS;
+
+    if ((0U == samples) || (0U == thread_count) ||
+        (thread_count > MAX_THREADS))
+    {
+        fprintf(stderr, "Usage: %s [samples] [threads <= %u]\n", argv[0],
+                MAX_THREADS);
+        return EXIT_FAILURE;
+    }
+
+    values = malloc(samples * sizeof(values[0]));
+    if (NULL == values)
+    {
+        return EXIT_FAILURE;
+    }
+
+    printf("%u samples, %u buckets (%zu bytes per histogram)\n", samples,
+            (unsigned)LATENCY_HIST_BUCKETS, sizeof(latency_hist_t));
+    printf("%-12s %8s %8s %8s %8s %8s %8s %8s\n", "distribution", "p50",
+            "hist", "p99", "hist", "max", "hist", "ns/rec");
+
+    for (size_t i = 0U; i < (sizeof(distributions) / sizeof(distributions[0]));
+            i++)
+    {
+        check_accuracy(&distributions[i]);
+    }
+
+    check_contention();
+    check_trace();
+
+    free(values);
+
+    printf("%s\n", (0U == failures) ? "PASS" : "FAIL");
+
+    return (0U == failures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,518 @@
+/*******************************************************************************
+* File Name:   lowpower_sim.c
+*
+* Description: Runs the main loop of the low power task
+* (proj_cm33_ns/source/lowpower_task.c) on Linux against a received traffic
+* trace. Stand-ins for the WCM calls and for wait_net_suspend() advance a
+* virtual clock, the time spent in each power mode is charged against the energy
+* model of proj_cm33_ns/source/power_model.c, and the run prints the average
+* power and the wakeups per hour.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+
+/*
+ * Build:
+ *  cc -O2 -Wall -I proj_cm33_ns/source -o lowpower_sim tools/lowpower_sim.c \
+ *      proj_cm33_ns/source/power_model.c \
+ *      proj_cm33_ns/source/inactivity_controller.c
+ *
+ * Usage:
+ *  lowpower_sim [-i interval_ms] [-w window_ms] [-a] [-c connect_ms]
+ *               [-p period_ms -t duration_s] [< trace]
+ *
+ *  -i, -w  INACTIVE_INTERVAL_MS and INACTIVE_WINDOW_MS (300 and 200)
+ *  -a      ADAPTIVE_INACTIVE_WINDOW set to 1
+ *  -c      time spent in Active mode to join the AP (2000)
+ *  -p, -t  synthetic trace: one packet every period_ms +/- 25% for
+ *          duration_s, instead of reading the trace
+ *
+ * The trace has one received packet per line, starting with its arrival time
+ * in seconds, as printed by "tcpdump -tt -n -r capture.pcap". A line whose
+ * second field is "link-lost" drops the link to the AP at that time. Times are
+ * relative to the first line.
+ *
+ * The model of the host MCU follows the low power task: with the network
+ * stack resumed, the MCU is in CPU Sleep between packets and is Active for
+ * PACKET_ACTIVE_US for every packet; with the network stack suspended, it is
+ * in Deep Sleep until the next packet.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "inactivity_controller.h"
+#include "lowpower_config.h"
+#include "power_model.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Time the MCU is Active to receive a packet through the network stack */
+#define PACKET_ACTIVE_US                (500U)
+
+#define US_PER_MS                       (1000U)
+#define US_PER_S                        (1000000U)
+#define WAIT_FOREVER                    (0xFFFFFFFFU)
+
+#define MAX_LINE_LEN                    (512U)
+
+/* Return values of the wait_net_suspend() stand-in, as in the LPA */
+#define ST_SUCCESS                      (0)
+#define ST_WAIT_INACTIVITY_TIMEOUT      (1)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    uint64_t time_us;
+    bool link_lost;
+} trace_event_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static trace_event_t *events;
+static size_t event_count;
+static size_t next_event;
+
+/* Virtual clock and time charged to each power mode, in microseconds */
+static uint64_t now_us;
+static uint64_t state_us[POWER_MODEL_STATE_COUNT];
+
+static bool connected;
+static uint32_t connect_ms = 2000U;
+static uint32_t connects;
+static uint32_t packets;
+static uint32_t delayed_packets;
+static uint32_t lost_packets;
+static uint32_t timeouts;
+static uint32_t wakeups;
+
+static inactivity_controller_t controller;
+static uint64_t last_rx_us;
+
+static uint64_t rng_state = 1U;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static uint32_t rand32(void)
+{
+    rng_state = (rng_state * 6364136223846793005ULL) + 1442695040888963407ULL;
+
+    return (uint32_t)(rng_state >> 33U);
+}
+
+static bool add_event(uint64_t time_us, bool link_lost)
+{
+    static size_t capacity;
+
+    if (event_count == capacity)
+    {
+        trace_event_t *grown;
+
+        capacity = (0U == capacity) ? 1024U : (2U * capacity);
+        grown = realloc(events, capacity * sizeof(trace_event_t));
+        if (NULL == grown)
+        {
+            return false;
+        }
+        events = grown;
+    }
+
+    events[event_count].time_us = time_us;
+    events[event_count].link_lost = link_lost;
+    event_count++;
+
+    return true;
+}
+
+static bool read_trace(FILE *input)
+{
+    char line[MAX_LINE_LEN];
+    double first_s = 0.0;
+    uint64_t previous_us = 0U;
+
+    while (NULL != fgets(line, sizeof(line), input))
+    {
+        char field[32] = "";
+        double time_s;
+        uint64_t time_us;
+
+        if (sscanf(line, "%lf %31s", &time_s, field) < 1)
+        {
+            continue;
+        }
+
+        if (0U == event_count)
+        {
+            first_s = time_s;
+        }
+
+        /* Captures are not always in order by a few microseconds */
+        time_us = (uint64_t)((time_s - first_s) * US_PER_S);
+        if (time_us < previous_us)
+        {
+            time_us = previous_us;
+        }
+        previous_us = time_us;
+
+        if (!add_event(time_us, (0 == strcmp(field, "link-lost"))))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool make_trace(uint32_t period_ms, uint32_t duration_s)
+{
+    uint64_t time_us = 0U;
+    uint64_t end_us = (uint64_t)duration_s * US_PER_S;
+    uint32_t jitter_us = (period_ms * US_PER_MS) / 4U;
+
+    while (time_us < end_us)
+    {
+        if (!add_event(time_us, false))
+        {
+            return false;
+        }
+
+        time_us += ((uint64_t)period_ms * US_PER_MS) - jitter_us +
+                (rand32() % ((2U * jitter_us) + 1U));
+    }
+
+    return true;
+}
+
+/* Moves the virtual clock, charging the time to a power mode */
+static void advance(power_model_state_t state, uint64_t until_us)
+{
+    if (until_us > now_us)
+    {
+        state_us[state] += until_us - now_us;
+        now_us = until_us;
+    }
+}
+
+static bool trace_done(void)
+{
+    return (next_event >= event_count);
+}
+
+/* Receives the next packet with the network stack resumed */
+static void receive(bool link_event)
+{
+    trace_event_t *event = &events[next_event++];
+    uint64_t gap_ms = (event->time_us - last_rx_us) / US_PER_MS;
+
+    if (link_event || event->link_lost)
+    {
+        connected = connected && !event->link_lost;
+        return;
+    }
+
+    inactivity_controller_observe(&controller,
+            (gap_ms > UINT32_MAX) ? UINT32_MAX : (uint32_t)gap_ms);
+    last_rx_us = event->time_us;
+    packets++;
+
+    state_us[POWER_MODEL_STATE_ACTIVE] += PACKET_ACTIVE_US;
+    now_us += PACKET_ACTIVE_US;
+}
+
+/* Keeps the network stack resumed until the given time */
+static void stay_resumed(uint64_t until_us)
+{
+    while (!trace_done() && (events[next_event].time_us < until_us))
+    {
+        advance(POWER_MODEL_STATE_SLEEP, events[next_event].time_us);
+        receive(false);
+    }
+
+    advance(POWER_MODEL_STATE_SLEEP, until_us);
+}
+
+/*******************************************************************************
+* Stand-ins for the WCM and LPA calls used by the low power task
+*******************************************************************************/
+
+static int cy_wcm_connect_ap(void)
+{
+    advance(POWER_MODEL_STATE_ACTIVE, now_us + ((uint64_t)connect_ms *
+            US_PER_MS));
+
+    /* Packets sent to the device while it was not associated are lost */
+    while (!trace_done() && (events[next_event].time_us < now_us))
+    {
+        lost_packets += events[next_event].link_lost ? 0U : 1U;
+        next_event++;
+    }
+
+    connected = true;
+    connects++;
+
+    return 0;
+}
+
+static bool cy_wcm_is_connected_to_ap(void)
+{
+    return connected;
+}
+
+/* Monitors the network for window_ms of inactivity within interval_ms. Once
+ * found, suspends the network stack and stays in Deep Sleep until the next
+ * packet or for wait_ms.
+ */
+static int wait_net_suspend(uint32_t wait_ms, uint32_t interval_ms,
+        uint32_t window_ms)
+{
+    uint64_t interval_end_us = now_us + ((uint64_t)interval_ms * US_PER_MS);
+    uint64_t window_us = (uint64_t)window_ms * US_PER_MS;
+    uint64_t quiet_since_us = now_us;
+    uint64_t wake_us;
+
+    while (!trace_done() &&
+           (events[next_event].time_us < interval_end_us) &&
+           ((events[next_event].time_us - quiet_since_us) < window_us))
+    {
+        stay_resumed(events[next_event].time_us);
+        receive(false);
+        quiet_since_us = now_us;
+    }
+
+    if ((quiet_since_us + window_us) > interval_end_us)
+    {
+        stay_resumed(interval_end_us);
+        timeouts++;
+
+        return ST_WAIT_INACTIVITY_TIMEOUT;
+    }
+
+    advance(POWER_MODEL_STATE_SLEEP, quiet_since_us + window_us);
+
+    wake_us = trace_done() ? UINT64_MAX : events[next_event].time_us;
+    if ((WAIT_FOREVER != wait_ms) &&
+        ((now_us + ((uint64_t)wait_ms * US_PER_MS)) < wake_us))
+    {
+        wake_us = now_us + ((uint64_t)wait_ms * US_PER_MS);
+    }
+
+    if (UINT64_MAX == wake_us)
+    {
+        return ST_SUCCESS;
+    }
+
+    advance(POWER_MODEL_STATE_DEEPSLEEP, wake_us);
+    wakeups++;
+    state_us[POWER_MODEL_STATE_ACTIVE] += NETWORK_RESUME_LATENCY_MS *
+            US_PER_MS;
+    now_us += NETWORK_RESUME_LATENCY_MS * US_PER_MS;
+
+    if (!trace_done() && (events[next_event].time_us <= wake_us))
+    {
+        if (!events[next_event].link_lost)
+        {
+            delayed_packets++;
+        }
+        receive(events[next_event].link_lost);
+    }
+
+    return ST_SUCCESS;
+}
+
+/*******************************************************************************
+* Simulation
+*******************************************************************************/
+
+/* Main loop of the low power task. Returns the number of times
+ * wait_net_suspend() returned with the link up.
+ */
+static uint32_t run(bool adaptive, uint32_t interval_ms, uint32_t window_ms)
+{
+    static const inactivity_controller_config_t config =
+    {
+        .default_window_ms      = INACTIVE_WINDOW_MS,
+        .min_window_ms          = ADAPTIVE_WINDOW_MIN_MS,
+        .max_window_ms          = ADAPTIVE_WINDOW_MAX_MS,
+        .awake_uw               = POWER_MODEL_MCU_SLEEP_UW,
+        .suspended_uw           = POWER_MODEL_MCU_DEEPSLEEP_UW,
+        .suspend_resume_uj      = NETWORK_SUSPEND_RESUME_UJ,
+        .resume_latency_ms      = NETWORK_RESUME_LATENCY_MS,
+        .max_added_latency_us   = MAX_ADDED_LATENCY_US
+    };
+    inactivity_controller_config_t controller_config = config;
+    uint32_t net_resume_count = 0U;
+
+    controller_config.default_window_ms = window_ms;
+    inactivity_controller_init(&controller, &controller_config);
+
+    /* The trace starts once the device has joined the AP */
+    for (size_t i = 0U; i < event_count; i++)
+    {
+        events[i].time_us += (uint64_t)connect_ms * US_PER_MS;
+    }
+    last_rx_us = (uint64_t)connect_ms * US_PER_MS;
+
+    (void)cy_wcm_connect_ap();
+
+    while (!trace_done())
+    {
+        if (adaptive)
+        {
+            window_ms = inactivity_controller_select(&controller,
+                    (uint32_t)(now_us / US_PER_MS));
+            interval_ms = inactivity_controller_interval(window_ms);
+        }
+
+        (void)wait_net_suspend(WAIT_FOREVER, interval_ms, window_ms);
+
+        if (!cy_wcm_is_connected_to_ap())
+        {
+            (void)cy_wcm_connect_ap();
+            continue;
+        }
+
+        net_resume_count++;
+
+        /* The User LED blinks with the network stack resumed */
+        stay_resumed(now_us + ((uint64_t)LED_BLINK_DELAY_MS * US_PER_MS));
+    }
+
+    return net_resume_count;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t interval_ms = INACTIVE_INTERVAL_MS;
+    uint32_t window_ms = INACTIVE_WINDOW_MS;
+    uint32_t period_ms = 0U;
+    uint32_t duration_s = 3600U;
+    bool adaptive = false;
+    uint32_t returns;
+    bool ok;
+    power_model_residency_t residency;
+    power_model_estimate_t estimate;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "i:w:ac:p:t:")))
+    {
+        switch (opt)
+        {
+            case 'i':
+                interval_ms = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'w':
+                window_ms = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'a':
+                adaptive = true;
+                break;
+            case 'c':
+                connect_ms = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'p':
+                period_ms = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 't':
+                duration_s = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-i interval_ms] [-w window_ms] "
+                        "[-a] [-c connect_ms] [-p period_ms -t duration_s]\n",
+                        argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    ok = (0U != period_ms) ? make_trace(period_ms, duration_s) :
+            read_trace(stdin);
+
+    if ((!ok) || (0U == event_count) || (0U == window_ms) ||
+        (interval_ms < window_ms))
+    {
+        fprintf(stderr, "No trace, or window longer than the interval\n");
+        return EXIT_FAILURE;
+    }
+
+    returns = run(adaptive, interval_ms, window_ms);
+
+    /* Unlike the estimate printed by the device, only the exits from Deep
+     * Sleep are counted as wakeups, not the inactivity timeouts.
+     */
+    power_model_residency_reset(&residency);
+    residency.wakeups = wakeups;
+
+    for (uint32_t state = 0U; state < (uint32_t)POWER_MODEL_STATE_COUNT;
+            state++)
+    {
+        power_model_charge(&residency, (power_model_state_t)state,
+                (uint32_t)(state_us[state] / US_PER_MS));
+    }
+
+    power_model_estimate(&power_model_default_table, &residency, &estimate);
+
+    printf("Window: %s, interval %u ms, window %u ms\n",
+            adaptive ? "adaptive from" : "fixed", interval_ms, window_ms);
+    printf("Trace: %u packets over %.1f s, %u joins, %u packets lost\n",
+            packets, (double)now_us / US_PER_S, connects, lost_packets);
+    printf("Residency: active %.1f s, sleep %.1f s, deep sleep %.1f s\n",
+            (double)state_us[POWER_MODEL_STATE_ACTIVE] / US_PER_S,
+            (double)state_us[POWER_MODEL_STATE_SLEEP] / US_PER_S,
+            (double)state_us[POWER_MODEL_STATE_DEEPSLEEP] / US_PER_S);
+    printf("wait_net_suspend(): %u returns, %u inactivity timeouts, "
+            "%u wakeups, %u packets delayed\n", returns, timeouts, wakeups,
+            delayed_packets);
+    printf("Average power: MCU %.3f mW, WLAN %.3f mW, total %.3f mW\n",
+            estimate.mcu_avg_uw / 1000.0, estimate.wlan_avg_uw / 1000.0,
+            estimate.total_avg_uw / 1000.0);
+    printf("Wakeups/hour: %u\n", estimate.wakeups_per_hour);
+
+    free(events);
+
+    return EXIT_SUCCESS;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,683 @@
+/*******************************************************************************
+* File Name:   net_bench_peer.c
+*
+* Description: Host peer of the network benchmark task
+* (proj_cm33_ns/source/net_bench.c) for Linux. It serves the TCP and UDP tests
+* requested by the device on one port. With -c, it runs the same tests as the
+* device against another peer, so that it can be exercised over the loopback
+* interface or a TAP interface without a board.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*
+ * Build:
+ *  cc -O2 -Wall -I proj_cm33_ns/source -o net_bench_peer \
+ *      tools/net_bench_peer.c proj_cm33_ns/source/net_bench_proto.c
+ *
+ * Usage:
+ *  net_bench_peer [-p port]                  Serve the device
+ *  net_bench_peer -c address [-p port]       Run the tests against a peer
+ *
+ * The peer serves one device at a time.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "net_bench_proto.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CLIENT_TCP_BYTES                (1048576U)
+#define CLIENT_UDP_DATAGRAMS            (1000U)
+#define CLIENT_UDP_DATAGRAM_SIZE        (1024U)
+#define CLIENT_UDP_RATE_KBPS            (8000U)
+#define FIN_COUNT                       (3U)
+#define FIN_INTERVAL_US                 (10000U)
+#define TIMEOUT_SEC                     (2)
+#define TCP_CHUNK_SIZE                  (1460U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static uint8_t buffer[65536];
+
+/* UDP_UP session of the device being served */
+static net_bench_rx_stats_t udp_stats;
+static bool udp_reported;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/* Monotonic clock, in microseconds */
+static uint32_t now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint32_t)(((uint64_t)ts.tv_sec * 1000000U) +
+            ((uint64_t)ts.tv_nsec / 1000U));
+}
+
+/* Sleeps until the monotonic clock reaches start_us + offset_us */
+static void sleep_until(uint32_t start_us, uint32_t offset_us)
+{
+    int32_t remaining_us = (int32_t)((start_us + offset_us) - now_us());
+
+    if (remaining_us > 0)
+    {
+        struct timespec ts =
+        {
+            .tv_sec = remaining_us / 1000000,
+            .tv_nsec = (remaining_us % 1000000) * 1000L
+        };
+
+        nanosleep(&ts, NULL);
+    }
+}
+
+static uint32_t datagram_interval_us(uint32_t size, uint32_t rate_kbps)
+{
+    return (0U == rate_kbps) ? 0U :
+            (uint32_t)(((uint64_t)size * 8U * 1000U) / rate_kbps);
+}
+
+static bool send_all(int sock, const uint8_t *data, size_t size)
+{
+    while (size > 0U)
+    {
+        ssize_t sent = send(sock, data, size, MSG_NOSIGNAL);
+
+        if (sent <= 0)
+        {
+            return false;
+        }
+
+        data += sent;
+        size -= (size_t)sent;
+    }
+
+    return true;
+}
+
+static bool recv_all(int sock, uint8_t *data, size_t size)
+{
+    while (size > 0U)
+    {
+        ssize_t received = recv(sock, data, size, 0);
+
+        if (received <= 0)
+        {
+            return false;
+        }
+
+        data += received;
+        size -= (size_t)received;
+    }
+
+    return true;
+}
+
+static void set_timeout(int sock)
+{
+    struct timeval timeout = { .tv_sec = TIMEOUT_SEC, .tv_usec = 0 };
+
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+}
+
+static void print_report(const char *name, const net_bench_report_t *report,
+        bool udp)
+{
+    printf("%s: %u bytes in %u ms, %u kbps", name, report->bytes,
+            report->elapsed_us / 1000U,
+            net_bench_kbps(report->bytes, report->elapsed_us));
+
+    if (udp)
+    {
+        printf(", %u datagrams received, %u lost, %u out of order, "
+                "jitter %u us", report->received, report->lost,
+                report->out_of_order, report->jitter_us);
+    }
+
+    printf("\n");
+    fflush(stdout);
+}
+
+/* Sends a header-only FIN datagram */
+static void send_fin(int sock, uint32_t seq, uint32_t start_us,
+        const struct sockaddr *to, socklen_t to_len)
+{
+    net_bench_datagram_t datagram =
+    {
+        .seq = seq,
+        .send_us = now_us() - start_us,
+        .flags = NET_BENCH_DATAGRAM_FIN
+    };
+
+    net_bench_encode_datagram(&datagram, buffer);
+    sendto(sock, buffer, NET_BENCH_DATAGRAM_HEADER_SIZE, 0, to, to_len);
+}
+
+/* Sends a paced stream of test datagrams followed by FIN datagrams */
+static void send_datagrams(int sock, uint32_t count, uint32_t size,
+        uint32_t rate_kbps, const struct sockaddr *to, socklen_t to_len,
+        bool fin)
+{
+    net_bench_datagram_t datagram = { 0U, 0U, 0U };
+    uint32_t interval_us = datagram_interval_us(size, rate_kbps);
+    uint32_t start_us = now_us();
+
+    memset(buffer, 0x55, size);
+
+    for (datagram.seq = 0U; datagram.seq < count; datagram.seq++)
+    {
+        sleep_until(start_us, datagram.seq * interval_us);
+        datagram.send_us = now_us() - start_us;
+        net_bench_encode_datagram(&datagram, buffer);
+        sendto(sock, buffer, size, 0, to, to_len);
+    }
+
+    for (uint32_t i = 0U; fin && (i < FIN_COUNT); i++)
+    {
+        sleep_until(now_us(), FIN_INTERVAL_US);
+        send_fin(sock, count, start_us, to, to_len);
+    }
+}
+
+/*******************************************************************************
+* Server
+*******************************************************************************/
+
+/* Serves one TCP test */
+static void serve_tcp(int sock)
+{
+    uint8_t message[NET_BENCH_REPORT_SIZE];
+    net_bench_request_t request;
+    net_bench_report_t report;
+    uint32_t start_us = 0U;
+    uint32_t remaining;
+    ssize_t size;
+
+    set_timeout(sock);
+
+    if (!recv_all(sock, message, NET_BENCH_REQUEST_SIZE) ||
+        !net_bench_decode_request(message, NET_BENCH_REQUEST_SIZE, &request))
+    {
+        fprintf(stderr, "Invalid TCP request\n");
+        return;
+    }
+
+    memset(&report, 0, sizeof(report));
+
+    if (NET_BENCH_TEST_TCP_UP == request.test)
+    {
+        while (report.bytes < request.length)
+        {
+            size = recv(sock, buffer, sizeof(buffer), 0);
+            if (size <= 0)
+            {
+                break;
+            }
+
+            if (0U == report.bytes)
+            {
+                start_us = now_us();
+            }
+
+            report.bytes += (uint32_t)size;
+        }
+
+        report.elapsed_us = now_us() - start_us;
+        net_bench_encode_report(&report, message);
+        send_all(sock, message, sizeof(message));
+        print_report("TCP up", &report, false);
+    }
+    else if (NET_BENCH_TEST_TCP_DOWN == request.test)
+    {
+        memset(buffer, 0x55, TCP_CHUNK_SIZE);
+        start_us = now_us();
+
+        for (remaining = request.length; remaining > 0U; )
+        {
+            uint32_t chunk = (remaining < TCP_CHUNK_SIZE) ? remaining :
+                    TCP_CHUNK_SIZE;
+
+            if (!send_all(sock, buffer, chunk))
+            {
+                break;
+            }
+
+            remaining -= chunk;
+        }
+
+        report.bytes = request.length - remaining;
+        report.elapsed_us = now_us() - start_us;
+        print_report("TCP down", &report, false);
+    }
+}
+
+/* Serves the UDP datagrams: UDP_DOWN requests and UDP_UP streams */
+static void serve_udp(int sock)
+{
+    struct sockaddr_in from;
+    socklen_t from_len = sizeof(from);
+    net_bench_request_t request;
+    net_bench_datagram_t datagram;
+    net_bench_report_t report;
+    uint8_t message[NET_BENCH_REPORT_SIZE];
+    ssize_t size = recvfrom(sock, buffer, sizeof(buffer), 0,
+            (struct sockaddr *)&from, &from_len);
+    uint32_t recv_us = now_us();
+
+    if (size <= 0)
+    {
+        return;
+    }
+
+    if (net_bench_decode_request(buffer, (size_t)size, &request) &&
+        (NET_BENCH_TEST_UDP_DOWN == request.test))
+    {
+        printf("UDP down: sending %u datagrams of %u bytes at %u kbps\n",
+                request.length, (unsigned int)request.datagram_size,
+                request.rate_kbps);
+        fflush(stdout);
+        send_datagrams(sock, request.length, request.datagram_size,
+                request.rate_kbps, (struct sockaddr *)&from, from_len, true);
+    }
+    else if (net_bench_decode_datagram(buffer, (size_t)size, &datagram))
+    {
+        if (0U != (datagram.flags & NET_BENCH_DATAGRAM_FIN))
+        {
+            /* The FIN carries the number of datagrams sent, so datagrams
+             * missing at the end of the test are counted as lost.
+             */
+            net_bench_rx_report(&udp_stats, &report);
+            if (report.received < datagram.seq)
+            {
+                report.lost = datagram.seq - report.received;
+            }
+
+            net_bench_encode_report(&report, message);
+            sendto(sock, message, sizeof(message), 0,
+                    (struct sockaddr *)&from, from_len);
+
+            /* The FIN is repeated, print the report once */
+            if (!udp_reported)
+            {
+                udp_reported = true;
+                print_report("UDP up", &report, true);
+            }
+        }
+        else
+        {
+            if (0U == datagram.seq)
+            {
+                net_bench_rx_init(&udp_stats);
+                udp_reported = false;
+            }
+
+            net_bench_rx_update(&udp_stats, &datagram, (size_t)size, recv_us);
+        }
+    }
+}
+
+static int run_server(uint16_t port)
+{
+    struct sockaddr_in addr;
+    int one = 1;
+    int tcp = socket(AF_INET, SOCK_STREAM, 0);
+    int udp = socket(AF_INET, SOCK_DGRAM, 0);
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+
+    setsockopt(tcp, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    if ((tcp < 0) || (udp < 0) ||
+        (0 != bind(tcp, (struct sockaddr *)&addr, sizeof(addr))) ||
+        (0 != bind(udp, (struct sockaddr *)&addr, sizeof(addr))) ||
+        (0 != listen(tcp, 1)))
+    {
+        perror("net_bench_peer");
+        return EXIT_FAILURE;
+    }
+
+    net_bench_rx_init(&udp_stats);
+    printf("Listening on TCP and UDP port %u\n", (unsigned int)port);
+    fflush(stdout);
+
+    while (true)
+    {
+        fd_set fds;
+
+        FD_ZERO(&fds);
+        FD_SET(tcp, &fds);
+        FD_SET(udp, &fds);
+
+        if (select(((tcp > udp) ? tcp : udp) + 1, &fds, NULL, NULL, NULL) < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            perror("select");
+            return EXIT_FAILURE;
+        }
+
+        if (FD_ISSET(tcp, &fds))
+        {
+            int sock = accept(tcp, NULL, NULL);
+
+            if (sock >= 0)
+            {
+                serve_tcp(sock);
+                close(sock);
+            }
+        }
+
+        if (FD_ISSET(udp, &fds))
+        {
+            serve_udp(udp);
+        }
+    }
+}
+
+/*******************************************************************************
+* Client
+*******************************************************************************/
+
+static int client_tcp_start(const struct sockaddr_in *peer,
+        net_bench_test_t test)
+{
+    uint8_t message[NET_BENCH_REQUEST_SIZE];
+    net_bench_request_t request =
+    {
+        .test = (uint8_t)test,
+        .datagram_size = 0U,
+        .length = CLIENT_TCP_BYTES,
+        .rate_kbps = 0U
+    };
+    int sock = socket(AF_INET, SOCK_STREAM, 0);
+
+    net_bench_encode_request(&request, message);
+    set_timeout(sock);
+
+    if ((0 != connect(sock, (const struct sockaddr *)peer, sizeof(*peer))) ||
+        !send_all(sock, message, sizeof(message)))
+    {
+        close(sock);
+        return -1;
+    }
+
+    return sock;
+}
+
+static bool client_tcp_up(const struct sockaddr_in *peer,
+        net_bench_report_t *report)
+{
+    uint8_t message[NET_BENCH_REPORT_SIZE];
+    uint32_t remaining = CLIENT_TCP_BYTES;
+    uint32_t start_us = now_us();
+    bool success;
+    int sock = client_tcp_start(peer, NET_BENCH_TEST_TCP_UP);
+
+    if (sock < 0)
+    {
+        return false;
+    }
+
+    memset(buffer, 0x55, TCP_CHUNK_SIZE);
+
+    while (remaining > 0U)
+    {
+        uint32_t chunk = (remaining < TCP_CHUNK_SIZE) ? remaining :
+                TCP_CHUNK_SIZE;
+
+        if (!send_all(sock, buffer, chunk))
+        {
+            break;
+        }
+
+        remaining -= chunk;
+    }
+
+    success = (0U == remaining) && recv_all(sock, message, sizeof(message)) &&
+            net_bench_decode_report(message, sizeof(message), report);
+    report->elapsed_us = now_us() - start_us;
+    close(sock);
+
+    return success;
+}
+
+static bool client_tcp_down(const struct sockaddr_in *peer,
+        net_bench_report_t *report)
+{
+    uint32_t start_us = 0U;
+    int sock = client_tcp_start(peer, NET_BENCH_TEST_TCP_DOWN);
+
+    if (sock < 0)
+    {
+        return false;
+    }
+
+    memset(report, 0, sizeof(*report));
+
+    while (report->bytes < CLIENT_TCP_BYTES)
+    {
+        ssize_t size = recv(sock, buffer, sizeof(buffer), 0);
+
+        if (size <= 0)
+        {
+            break;
+        }
+
+        if (0U == report->bytes)
+        {
+            start_us = now_us();
+        }
+
+        report->bytes += (uint32_t)size;
+    }
+
+    report->elapsed_us = now_us() - start_us;
+    close(sock);
+
+    return (CLIENT_TCP_BYTES == report->bytes);
+}
+
+static bool client_udp_up(const struct sockaddr_in *peer,
+        net_bench_report_t *report)
+{
+    uint32_t start_us = now_us();
+    bool success = false;
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+
+    set_timeout(sock);
+    send_datagrams(sock, CLIENT_UDP_DATAGRAMS, CLIENT_UDP_DATAGRAM_SIZE,
+            CLIENT_UDP_RATE_KBPS, (const struct sockaddr *)peer,
+            sizeof(*peer), false);
+
+    for (uint32_t i = 0U; (i < FIN_COUNT) && !success; i++)
+    {
+        ssize_t size;
+
+        send_fin(sock, CLIENT_UDP_DATAGRAMS, start_us,
+                (const struct sockaddr *)peer, sizeof(*peer));
+        size = recv(sock, buffer, sizeof(buffer), 0);
+        success = (size > 0) &&
+                net_bench_decode_report(buffer, (size_t)size, report);
+    }
+
+    close(sock);
+
+    return success;
+}
+
+static bool client_udp_down(const struct sockaddr_in *peer,
+        net_bench_report_t *report)
+{
+    uint8_t message[NET_BENCH_REQUEST_SIZE];
+    net_bench_request_t request =
+    {
+        .test = (uint8_t)NET_BENCH_TEST_UDP_DOWN,
+        .datagram_size = CLIENT_UDP_DATAGRAM_SIZE,
+        .length = CLIENT_UDP_DATAGRAMS,
+        .rate_kbps = CLIENT_UDP_RATE_KBPS
+    };
+    net_bench_rx_stats_t stats;
+    net_bench_datagram_t datagram;
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+
+    set_timeout(sock);
+    net_bench_rx_init(&stats);
+    net_bench_encode_request(&request, message);
+    sendto(sock, message, sizeof(message), 0, (const struct sockaddr *)peer,
+            sizeof(*peer));
+
+    while (true)
+    {
+        ssize_t size = recv(sock, buffer, sizeof(buffer), 0);
+
+        if ((size <= 0) ||
+            !net_bench_decode_datagram(buffer, (size_t)size, &datagram) ||
+            (0U != (datagram.flags & NET_BENCH_DATAGRAM_FIN)))
+        {
+            break;
+        }
+
+        net_bench_rx_update(&stats, &datagram, (size_t)size, now_us());
+    }
+
+    close(sock);
+    net_bench_rx_report(&stats, report);
+
+    if (report->received < CLIENT_UDP_DATAGRAMS)
+    {
+        report->lost = CLIENT_UDP_DATAGRAMS - report->received;
+    }
+
+    return (stats.received > 0U);
+}
+
+static int run_client(const char *address, uint16_t port)
+{
+    static const struct
+    {
+        const char *name;
+        bool (*run)(const struct sockaddr_in *, net_bench_report_t *);
+        bool udp;
+    } tests[] =
+    {
+        { "TCP up", client_tcp_up, false },
+        { "TCP down", client_tcp_down, false },
+        { "UDP up", client_udp_up, true },
+        { "UDP down", client_udp_down, true }
+    };
+    struct sockaddr_in peer;
+    net_bench_report_t report;
+    int status = EXIT_SUCCESS;
+
+    memset(&peer, 0, sizeof(peer));
+    peer.sin_family = AF_INET;
+    peer.sin_port = htons(port);
+
+    if (1 != inet_pton(AF_INET, address, &peer.sin_addr))
+    {
+        fprintf(stderr, "Invalid address %s\n", address);
+        return EXIT_FAILURE;
+    }
+
+    for (size_t i = 0U; i < (sizeof(tests) / sizeof(tests[0])); i++)
+    {
+        if (tests[i].run(&peer, &report))
+        {
+            print_report(tests[i].name, &report, tests[i].udp);
+        }
+        else
+        {
+            fprintf(stderr, "%s failed\n", tests[i].name);
+            status = EXIT_FAILURE;
+        }
+    }
+
+    return status;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *client = NULL;
+    uint16_t port = NET_BENCH_DEFAULT_PORT;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "c:p:")))
+    {
+        switch (opt)
+        {
+            case 'c':
+                client = optarg;
+                break;
+
+            case 'p':
+                port = (uint16_t)strtoul(optarg, NULL, 0);
+                break;
+
+            default:
+                fprintf(stderr, "Usage: %s [-c address] [-p port]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    return (NULL != client) ? run_client(client, port) : run_server(port);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,285 @@
+/*******************************************************************************
+* File Name:   residency_counter_test.c
+*
+* Description: Linux checks of the power mode residency accounting
+* (proj_cm33_ns/source/residency_counter.c) with fake LPTimer timestamps:
+* entries and exits, wrap of the timestamp counter, failed entries, SysPm
+* callback results and the layout of the binary record.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+
+/*
+ * Build:
+ *  cc -O2 -Wall -I proj_cm33_ns/source -o residency_counter_test \
+ *      tools/residency_counter_test.c proj_cm33_ns/source/residency_counter.c
+ *
+ * Usage:
+ *  residency_counter_test
+ *
+ * Prints every failed check and exits with a non-zero status if any.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "residency_counter.h"
+
+#include "test_check.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Frequency of the LPTimer */
+#define TICK_HZ                         (32768U)
+
+#define RECORD_MAGIC                    (0x52U)
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static uint32_t get_u32(const uint8_t *buffer)
+{
+    return (uint32_t)buffer[0] | ((uint32_t)buffer[1] << 8U) |
+            ((uint32_t)buffer[2] << 16U) | ((uint32_t)buffer[3] << 24U);
+}
+
+static void test_enter_exit(void)
+{
+    residency_counter_t counter;
+    residency_snapshot_t snapshot;
+    uint32_t now = 100U;
+
+    residency_counter_init(&counter, now, TICK_HZ);
+
+    /* 1 s active, 2 s in sleep, 0.5 s active, 4 s in deep sleep */
+    now += TICK_HZ;
+    residency_counter_attempt(&counter, POWER_MODEL_STATE_SLEEP);
+    residency_counter_enter(&counter, POWER_MODEL_STATE_SLEEP, now);
+    now += 2U * TICK_HZ;
+    residency_counter_exit(&counter, now);
+    now += TICK_HZ / 2U;
+    residency_counter_attempt(&counter, POWER_MODEL_STATE_DEEPSLEEP);
+    residency_counter_enter(&counter, POWER_MODEL_STATE_DEEPSLEEP, now);
+    now += 4U * TICK_HZ;
+    residency_counter_exit(&counter, now);
+
+    residency_counter_snapshot(&counter, now, &snapshot);
+    CHECK(1500U == snapshot.residency_ms[POWER_MODEL_STATE_ACTIVE]);
+    CHECK(2000U == snapshot.residency_ms[POWER_MODEL_STATE_SLEEP]);
+    CHECK(4000U == snapshot.residency_ms[POWER_MODEL_STATE_DEEPSLEEP]);
+    CHECK(7500U == snapshot.elapsed_ms);
+    CHECK(1U == snapshot.entries[POWER_MODEL_STATE_SLEEP]);
+    CHECK(1U == snapshot.entries[POWER_MODEL_STATE_DEEPSLEEP]);
+    CHECK(0U == snapshot.failed_entries[POWER_MODEL_STATE_DEEPSLEEP]);
+
+    /* A snapshot charges the current state without leaving it */
+    residency_counter_enter(&counter, POWER_MODEL_STATE_DEEPSLEEP, now);
+    now += TICK_HZ;
+    residency_counter_snapshot(&counter, now, &snapshot);
+    CHECK(5000U == snapshot.residency_ms[POWER_MODEL_STATE_DEEPSLEEP]);
+    CHECK(POWER_MODEL_STATE_DEEPSLEEP == counter.state);
+    now += TICK_HZ;
+    residency_counter_exit(&counter, now);
+    residency_counter_snapshot(&counter, now, &snapshot);
+    CHECK(6000U == snapshot.residency_ms[POWER_MODEL_STATE_DEEPSLEEP]);
+    CHECK(1500U == snapshot.residency_ms[POWER_MODEL_STATE_ACTIVE]);
+
+    /* States outside the table are ignored */
+    residency_counter_attempt(&counter, POWER_MODEL_STATE_COUNT);
+    residency_counter_enter(&counter, POWER_MODEL_STATE_COUNT, now + 10U);
+    CHECK(POWER_MODEL_STATE_ACTIVE == counter.state);
+    CHECK(now == counter.last_ticks);
+}
+
+static void test_wrap(void)
+{
+    residency_counter_t counter;
+    residency_snapshot_t snapshot;
+    uint32_t now = UINT32_MAX - TICK_HZ + 1U;
+
+    /* Deep sleep across the wrap of the timestamp counter */
+    residency_counter_init(&counter, now, TICK_HZ);
+    residency_counter_enter(&counter, POWER_MODEL_STATE_DEEPSLEEP,
+            now + (TICK_HZ / 2U));
+    now += 3U * TICK_HZ;
+    CHECK(now < counter.last_ticks);
+    residency_counter_exit(&counter, now);
+
+    residency_counter_snapshot(&counter, now + (TICK_HZ / 4U), &snapshot);
+    CHECK(2500U == snapshot.residency_ms[POWER_MODEL_STATE_DEEPSLEEP]);
+    CHECK(750U == snapshot.residency_ms[POWER_MODEL_STATE_ACTIVE]);
+    CHECK(3250U == snapshot.elapsed_ms);
+
+    /* Residency longer than one period of the counter accumulates in 64 bits
+     * when charged at least once per period.
+     */
+    residency_counter_init(&counter, 0U, TICK_HZ);
+    residency_counter_enter(&counter, POWER_MODEL_STATE_DEEPSLEEP, 0U);
+    for (uint32_t i = 1U; i <= 3U; i++)
+    {
+        residency_counter_snapshot(&counter, i * (UINT32_MAX / 2U),
+                &snapshot);
+    }
+    CHECK(counter.state_ticks[POWER_MODEL_STATE_DEEPSLEEP] ==
+            3ULL * (UINT32_MAX / 2U));
+}
+
+static void test_failed_entries(void)
+{
+    residency_counter_t counter;
+    residency_snapshot_t snapshot;
+
+    residency_counter_init(&counter, 0U, TICK_HZ);
+
+    /* Three deep sleep attempts: the SDHC callback refuses the first one,
+     * the debug UART callback refuses the second one and the SDHC callback
+     * is rolled back, the third one succeeds.
+     */
+    residency_counter_attempt(&counter, POWER_MODEL_STATE_DEEPSLEEP);
+    residency_counter_callback(&counter, RESIDENCY_CALLBACK_SDHC,
+            RESIDENCY_CALLBACK_REFUSED);
+
+    residency_counter_attempt(&counter, POWER_MODEL_STATE_DEEPSLEEP);
+    residency_counter_callback(&counter, RESIDENCY_CALLBACK_DEBUG_UART,
+            RESIDENCY_CALLBACK_REFUSED);
+    residency_counter_callback(&counter, RESIDENCY_CALLBACK_SDHC,
+            RESIDENCY_CALLBACK_ROLLED_BACK);
+
+    residency_counter_attempt(&counter, POWER_MODEL_STATE_DEEPSLEEP);
+    residency_counter_callback(&counter, RESIDENCY_CALLBACK_SDHC,
+            RESIDENCY_CALLBACK_ENTERED);
+    residency_counter_callback(&counter, RESIDENCY_CALLBACK_DEBUG_UART,
+            RESIDENCY_CALLBACK_ENTERED);
+    residency_counter_enter(&counter, POWER_MODEL_STATE_DEEPSLEEP, 10U);
+    residency_counter_exit(&counter, 20U);
+
+    /* Callbacks outside the table are ignored */
+    residency_counter_callback(&counter, RESIDENCY_CALLBACK_COUNT,
+            RESIDENCY_CALLBACK_ENTERED);
+
+    residency_counter_snapshot(&counter, 20U, &snapshot);
+    CHECK(1U == snapshot.entries[POWER_MODEL_STATE_DEEPSLEEP]);
+    CHECK(2U == snapshot.failed_entries[POWER_MODEL_STATE_DEEPSLEEP]);
+    CHECK(0U == snapshot.failed_entries[POWER_MODEL_STATE_SLEEP]);
+    CHECK(1U == snapshot.callbacks[RESIDENCY_CALLBACK_SDHC].entries);
+    CHECK(1U == snapshot.callbacks[RESIDENCY_CALLBACK_SDHC].refused);
+    CHECK(1U == snapshot.callbacks[RESIDENCY_CALLBACK_SDHC].rolled_back);
+    CHECK(1U == snapshot.callbacks[RESIDENCY_CALLBACK_DEBUG_UART].entries);
+    CHECK(1U == snapshot.callbacks[RESIDENCY_CALLBACK_DEBUG_UART].refused);
+    CHECK(0U ==
+            snapshot.callbacks[RESIDENCY_CALLBACK_DEBUG_UART].rolled_back);
+
+    /* Entries without a counted attempt never report negative failures */
+    residency_counter_enter(&counter, POWER_MODEL_STATE_SLEEP, 30U);
+    residency_counter_snapshot(&counter, 40U, &snapshot);
+    CHECK(1U == snapshot.entries[POWER_MODEL_STATE_SLEEP]);
+    CHECK(0U == snapshot.failed_entries[POWER_MODEL_STATE_SLEEP]);
+}
+
+static void test_serialize(void)
+{
+    residency_snapshot_t snapshot;
+    uint8_t record[RESIDENCY_RECORD_SIZE + 4U];
+    const uint8_t *pos;
+
+    memset(&snapshot, 0, sizeof(snapshot));
+    snapshot.elapsed_ms = 0x1122334455ULL;
+    for (uint32_t state = 0U; state < (uint32_t)POWER_MODEL_STATE_COUNT;
+            state++)
+    {
+        snapshot.residency_ms[state] = 0x01020300U + state;
+        snapshot.entries[state] = 10U + state;
+        snapshot.failed_entries[state] = 20U + state;
+    }
+    for (uint32_t cb = 0U; cb < (uint32_t)RESIDENCY_CALLBACK_COUNT; cb++)
+    {
+        snapshot.callbacks[cb].entries = 30U + cb;
+        snapshot.callbacks[cb].refused = 40U + cb;
+        snapshot.callbacks[cb].rolled_back = 50U + cb;
+    }
+
+    /* A buffer one byte short is rejected without being written */
+    memset(record, 0xAA, sizeof(record));
+    CHECK(0U == residency_counter_serialize(&snapshot, record,
+            RESIDENCY_RECORD_SIZE - 1U));
+    CHECK(0xAAU == record[0]);
+
+    CHECK(RESIDENCY_RECORD_SIZE == residency_counter_serialize(&snapshot,
+            record, sizeof(record)));
+    CHECK(0xAAU == record[RESIDENCY_RECORD_SIZE]);
+
+    /* Header, then little-endian words; values above 32 bits saturate */
+    CHECK(RECORD_MAGIC == record[0]);
+    CHECK(RESIDENCY_RECORD_VERSION == record[1]);
+    CHECK((uint8_t)POWER_MODEL_STATE_COUNT == record[2]);
+    CHECK((uint8_t)RESIDENCY_CALLBACK_COUNT == record[3]);
+    CHECK(0xFFU == record[4]);
+    CHECK(UINT32_MAX == get_u32(&record[4]));
+
+    pos = &record[8];
+    for (uint32_t state = 0U; state < (uint32_t)POWER_MODEL_STATE_COUNT;
+            state++)
+    {
+        CHECK((0x01020300U + state) == get_u32(pos));
+        CHECK((10U + state) == get_u32(pos + 4U));
+        CHECK((20U + state) == get_u32(pos + 8U));
+        pos += 12U;
+    }
+    for (uint32_t cb = 0U; cb < (uint32_t)RESIDENCY_CALLBACK_COUNT; cb++)
+    {
+        CHECK((30U + cb) == get_u32(pos));
+        CHECK((40U + cb) == get_u32(pos + 4U));
+        CHECK((50U + cb) == get_u32(pos + 8U));
+        pos += 12U;
+    }
+    CHECK(&record[RESIDENCY_RECORD_SIZE] == pos);
+}
+
+int main(void)
+{
+    test_enter_exit();
+    test_wrap();
+    test_failed_entries();
+    test_serialize();
+
+    return test_check_summary();
+}
+
+
+/* [] END OF FILE */
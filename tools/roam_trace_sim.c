@@ -0,0 +1,393 @@
+/*******************************************************************************
+* File Name:   roam_trace_sim.c
+*
+* Description: Linux simulation of the roaming policy
+* (proj_cm33_ns/source/roam_policy.c) on synthetic RSSI traces. APs sharing one
+* SSID are placed along a warehouse aisle and the RSSI of each one follows a
+* log-distance path loss with random fading. The device wakes up periodically,
+* samples the RSSI of its link and follows the actions of the policy. Each
+* scenario is compared with a device that never leaves its first AP.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+
+/*
+ * Build:
+ *  cc -O2 -Wall -I proj_cm33_ns/source -o roam_trace_sim \
+ *      tools/roam_trace_sim.c proj_cm33_ns/source/roam_policy.c -lm
+ *
+ * Usage:
+ *  roam_trace_sim [-t duration_s] [-w wake_period_s] [-f fading_db]
+ *                 [-r seed]
+ *
+ * Scenarios:
+ *  walk      the device crosses the aisle from the first to the last AP
+ *  boundary  the device stays half-way between two APs
+ *  near      the device stays next to an AP
+ *
+ * The exit status is non-zero if the policy does not reduce the time spent
+ * on a weak link while walking, roams back and forth, roams at the boundary
+ * more than once, or scans next to an AP.
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "roam_policy.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define AP_COUNT                        (3U)
+#define AP_SPACING_M                    (60.0)
+
+/* Log-distance path loss: RSSI at 1 m and path loss exponent */
+#define RSSI_AT_1M_DBM                  (-30.0)
+#define PATH_LOSS_EXPONENT              (3.0)
+
+/* Weakest RSSI reported by a scan and accepted by a join */
+#define SCAN_SENSITIVITY_DBM            (-90)
+#define JOIN_SENSITIVITY_DBM            (-85)
+
+/* A link below this RSSI is counted as weak: rate drops and retries */
+#define WEAK_LINK_DBM                   (-80)
+
+/* A roam back to the previous AP within this time is a ping-pong */
+#define PING_PONG_MS                    (120000U)
+
+/* Defaults of the device, see roam.h */
+static const roam_config_t config =
+{
+    .scan_rssi_dbm      = -70,
+    .trigger_rssi_dbm   = -75,
+    .hysteresis_db      = 8U,
+    .scan_interval_ms   = 60000U,
+    .max_age_ms         = 120000U,
+    .min_dwell_ms       = 30000U,
+    .penalty_ms         = 300000U
+};
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef enum
+{
+    SCENARIO_WALK = 0,
+    SCENARIO_BOUNDARY,
+    SCENARIO_NEAR,
+    SCENARIO_COUNT
+} scenario_t;
+
+typedef struct
+{
+    uint32_t wakes;
+    uint32_t weak_wakes;
+    uint32_t scans;
+    uint32_t roams;
+    uint32_t failures;
+    uint32_t ping_pongs;
+} result_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const char * const scenario_names[SCENARIO_COUNT] =
+{
+    "walk", "boundary", "near"
+};
+
+static uint32_t duration_s = 1800U;
+static uint32_t wake_period_s = 10U;
+static double fading_db = 4.0;
+static uint64_t rng_state = 1U;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static uint32_t rand32(void)
+{
+    rng_state = (rng_state * 6364136223846793005ULL) + 1442695040888963407ULL;
+
+    return (uint32_t)(rng_state >> 33U);
+}
+
+/* Uniform in [-1, 1] */
+static double rand_unit(void)
+{
+    return ((double)(rand32() % 20001U) / 10000.0) - 1.0;
+}
+
+static void ap_bssid(uint32_t ap, uint8_t *bssid)
+{
+    static const uint8_t oui[3] = { 0x00U, 0x90U, 0x4CU };
+
+    memcpy(bssid, oui, sizeof(oui));
+    bssid[3] = 0x10U;
+    bssid[4] = 0x00U;
+    bssid[5] = (uint8_t)ap;
+}
+
+static uint8_t ap_channel(uint32_t ap)
+{
+    static const uint8_t channels[AP_COUNT] = { 1U, 6U, 11U };
+
+    return channels[ap];
+}
+
+static double position_m(scenario_t scenario, uint32_t t_s)
+{
+    switch (scenario)
+    {
+        case SCENARIO_WALK:
+            return 5.0 + (((AP_SPACING_M * (AP_COUNT - 1U)) - 10.0) *
+                    (double)t_s / (double)duration_s);
+        case SCENARIO_BOUNDARY:
+            return AP_SPACING_M / 2.0;
+        default:
+            return 5.0;
+    }
+}
+
+static int32_t ap_rssi(uint32_t ap, double x_m)
+{
+    double d = fabs(x_m - (AP_SPACING_M * ap));
+
+    d = (d < 1.0) ? 1.0 : d;
+
+    return (int32_t)lround(RSSI_AT_1M_DBM -
+            (10.0 * PATH_LOSS_EXPONENT * log10(d)) + (fading_db * rand_unit()));
+}
+
+static uint32_t strongest_ap(double x_m)
+{
+    uint32_t best = 0U;
+    int32_t best_rssi = INT32_MIN;
+
+    for (uint32_t ap = 0U; ap < AP_COUNT; ap++)
+    {
+        int32_t rssi = ap_rssi(ap, x_m);
+
+        if (rssi > best_rssi)
+        {
+            best = ap;
+            best_rssi = rssi;
+        }
+    }
+
+    return best;
+}
+
+static void run(scenario_t scenario, bool roaming, result_t *result)
+{
+    roam_policy_t policy;
+    roam_candidate_t target;
+    uint8_t bssid[ROAM_BSSID_LEN];
+    uint32_t current;
+    uint32_t previous = AP_COUNT;
+    uint32_t roam_ms = 0U;
+
+    memset(result, 0, sizeof(result_t));
+    roam_policy_init(&policy, &config);
+
+    current = strongest_ap(position_m(scenario, 0U));
+    ap_bssid(current, bssid);
+    roam_policy_associated(&policy, bssid, ap_channel(current),
+            ap_rssi(current, position_m(scenario, 0U)), 0U);
+
+    for (uint32_t t_s = wake_period_s; t_s <= duration_s;
+            t_s += wake_period_s)
+    {
+        uint32_t now_ms = t_s * 1000U;
+        double x_m = position_m(scenario, t_s);
+        int32_t rssi = ap_rssi(current, x_m);
+
+        result->wakes++;
+        result->weak_wakes += (rssi < WEAK_LINK_DBM) ? 1U : 0U;
+
+        if (!roaming)
+        {
+            continue;
+        }
+
+        roam_policy_link_sample(&policy, rssi);
+
+        switch (roam_policy_decide(&policy, now_ms, &target))
+        {
+            case ROAM_ACTION_SCAN:
+                roam_policy_scan_started(&policy, now_ms);
+                result->scans++;
+                for (uint32_t ap = 0U; ap < AP_COUNT; ap++)
+                {
+                    int32_t seen = ap_rssi(ap, x_m);
+
+                    if (seen >= SCAN_SENSITIVITY_DBM)
+                    {
+                        ap_bssid(ap, bssid);
+                        roam_policy_observe(&policy, bssid, ap_channel(ap),
+                                seen, now_ms);
+                    }
+                }
+                break;
+
+            case ROAM_ACTION_ROAM:
+            {
+                uint32_t ap = target.bssid[5];
+                int32_t join_rssi = ap_rssi(ap, x_m);
+
+                if (join_rssi < JOIN_SENSITIVITY_DBM)
+                {
+                    /* The device rejoins the strongest AP instead */
+                    result->failures++;
+                    roam_policy_join_failed(&policy, target.bssid, now_ms);
+                    ap = strongest_ap(x_m);
+                    join_rssi = ap_rssi(ap, x_m);
+                }
+
+                if (ap != current)
+                {
+                    if ((ap == previous) &&
+                        ((now_ms - roam_ms) < PING_PONG_MS))
+                    {
+                        result->ping_pongs++;
+                    }
+                    previous = current;
+                    roam_ms = now_ms;
+                }
+
+                current = ap;
+                ap_bssid(current, bssid);
+                roam_policy_associated(&policy, bssid, ap_channel(current),
+                        join_rssi, now_ms);
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    /* Roams are counted by the policy once the AP has changed */
+    result->roams = policy.stats.roams;
+}
+
+static void print_result(const char *name, const char *policy,
+        const result_t *result)
+{
+    printf("%-9s %-8s %6u %8.1f%% %6u %6u %8u %10u\n", name, policy,
+            result->wakes, (100.0 * result->weak_wakes) /
+            ((0U == result->wakes) ? 1U : result->wakes), result->scans,
+            result->roams, result->failures, result->ping_pongs);
+}
+
+int main(int argc, char *argv[])
+{
+    result_t fixed;
+    result_t roaming;
+    uint32_t seed = 1U;
+    bool ok = true;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "t:w:f:r:")))
+    {
+        switch (opt)
+        {
+            case 't':
+                duration_s = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'w':
+                wake_period_s = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'f':
+                fading_db = strtod(optarg, NULL);
+                break;
+            case 'r':
+                seed = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-t duration_s] [-w wake_period_s] "
+                        "[-f fading_db] [-r seed]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if ((0U == duration_s) || (0U == wake_period_s))
+    {
+        return EXIT_FAILURE;
+    }
+
+    printf("%u APs %.0f m apart, %u s, wake every %u s, fading +/-%.1f dB\n",
+            AP_COUNT, AP_SPACING_M, duration_s, wake_period_s, fading_db);
+    printf("%-9s %-8s %6s %9s %6s %6s %8s %10s\n", "scenario", "policy",
+            "wakes", "weak", "scans", "roams", "failures", "ping-pongs");
+
+    for (uint32_t s = 0U; s < (uint32_t)SCENARIO_COUNT; s++)
+    {
+        rng_state = seed;
+        run((scenario_t)s, false, &fixed);
+        rng_state = seed;
+        run((scenario_t)s, true, &roaming);
+
+        print_result(scenario_names[s], "fixed", &fixed);
+        print_result(scenario_names[s], "roaming", &roaming);
+
+        ok = ok && (0U == roaming.ping_pongs);
+
+        switch ((scenario_t)s)
+        {
+            case SCENARIO_WALK:
+                ok = ok && (roaming.roams >= (AP_COUNT - 1U)) &&
+                        ((2U * roaming.weak_wakes) < fixed.weak_wakes);
+                break;
+            case SCENARIO_BOUNDARY:
+                ok = ok && (roaming.roams <= 1U);
+                break;
+            default:
+                ok = ok && (0U == roaming.scans);
+                break;
+        }
+    }
+
+    printf("%s\n", ok ? "PASS" : "FAIL");
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+/* [] END OF FILE */
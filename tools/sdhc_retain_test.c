@@ -0,0 +1,406 @@
+/*******************************************************************************
+* File Name:   sdhc_retain_test.c
+*
+* Description: Linux checks of the SDHC retained-state fast path
+* (proj_cm33_ns/source/sdhc_retain.c) against a fake register file. The fake
+* models the read-only internal clock stable bit, registers that lose their
+* value in deep sleep and registers that ignore writes, and logs every write to
+* check the number and the order of the writes of each restore.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+
+/*
+ * Build:
+ *  cc -O2 -Wall -I proj_cm33_ns/source -o sdhc_retain_test \
+ *      tools/sdhc_retain_test.c proj_cm33_ns/source/sdhc_retain.c
+ *
+ * Usage:
+ *  sdhc_retain_test
+ *
+ * Prints every failed check and exits with a non-zero status if any.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sdhc_retain.h"
+
+#include "test_check.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define FAKE_CORE_SIZE                  (0x100U)
+#define FAKE_MAX_WRITES                 (64U)
+
+/* Reads of the clock control register before the internal clock of the fake
+ * reports stable, once enabled.
+ */
+#define FAKE_STABLE_DELAY               (5U)
+
+/* Number of registers set to a non-zero value by configure_bus() */
+#define CONFIGURED_REGS                 (9U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    uint8_t offset;
+    uint8_t width;
+    uint32_t value;
+} fake_write_t;
+
+typedef struct
+{
+    uint8_t mem[FAKE_CORE_SIZE];
+    fake_write_t writes[FAKE_MAX_WRITES];
+    uint32_t write_count;
+    uint32_t clk_reads_until_stable;
+    bool never_stable;
+    uint8_t stuck_offset;       /* Register ignoring writes, 0 for none */
+} fake_sdhc_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static fake_sdhc_t fake;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static uint32_t get(uint32_t offset, uint32_t width)
+{
+    uint32_t value = 0U;
+
+    for (uint32_t i = 0U; i < width; i++)
+    {
+        value |= (uint32_t)fake.mem[offset + i] << (8U * i);
+    }
+
+    return value;
+}
+
+static void put(uint32_t offset, uint32_t width, uint32_t value)
+{
+    for (uint32_t i = 0U; i < width; i++)
+    {
+        fake.mem[offset + i] = (uint8_t)(value >> (8U * i));
+    }
+}
+
+static uint32_t fake_read(void *regs, uint32_t offset, uint32_t width)
+{
+    uint32_t value = get(offset, width);
+
+    (void)regs;
+
+    if ((SDHC_REG_CLK_CTRL == offset) &&
+        (0U != (value & SDHC_CLK_CTRL_INTERNAL_CLK_EN)) && !fake.never_stable)
+    {
+        if (0U != fake.clk_reads_until_stable)
+        {
+            fake.clk_reads_until_stable--;
+        }
+        else
+        {
+            value |= SDHC_CLK_CTRL_INTERNAL_STABLE;
+        }
+    }
+
+    return value;
+}
+
+static void fake_write(void *regs, uint32_t offset, uint32_t width,
+        uint32_t value)
+{
+    (void)regs;
+
+    if (fake.write_count < FAKE_MAX_WRITES)
+    {
+        fake.writes[fake.write_count].offset = (uint8_t)offset;
+        fake.writes[fake.write_count].width = (uint8_t)width;
+        fake.writes[fake.write_count].value = value;
+    }
+    fake.write_count++;
+
+    if (offset == fake.stuck_offset)
+    {
+        return;
+    }
+
+    if (SDHC_REG_CLK_CTRL == offset)
+    {
+        /* Enabling the internal clock restarts its stabilization */
+        if ((0U == (get(offset, width) & SDHC_CLK_CTRL_INTERNAL_CLK_EN)) &&
+            (0U != (value & SDHC_CLK_CTRL_INTERNAL_CLK_EN)))
+        {
+            fake.clk_reads_until_stable = FAKE_STABLE_DELAY;
+        }
+        value &= ~(uint32_t)SDHC_CLK_CTRL_INTERNAL_STABLE;
+    }
+
+    put(offset, width, value);
+}
+
+static const sdhc_retain_io_t fake_io =
+{
+    .read   = fake_read,
+    .write  = fake_write,
+    .regs   = &fake
+};
+
+/* Brings the fake up the way the SDIO driver leaves it for the WLAN device:
+ * 3.3 V bus power, 4-bit bus, 25 MHz from a 100 MHz base clock, 64-byte
+ * blocks and the interrupts used by the driver.
+ */
+static void configure_bus(void)
+{
+    memset(&fake, 0, sizeof(fake));
+    put(SDHC_REG_PWR_CTRL, 1U, 0x0FU);
+    put(SDHC_REG_HOST_CTRL1, 1U, 0x02U);
+    put(SDHC_REG_HOST_CTRL2, 2U, 0x0000U);
+    put(SDHC_REG_TOUT_CTRL, 1U, 0x0EU);
+    put(SDHC_REG_WUP_CTRL, 1U, 0x01U);
+    put(SDHC_REG_BLOCKSIZE, 2U, 0x0040U);
+    put(SDHC_REG_NORMAL_INT_STAT_EN, 2U, 0x01FBU);
+    put(SDHC_REG_ERROR_INT_STAT_EN, 2U, 0x07FFU);
+    put(SDHC_REG_NORMAL_INT_SIGNAL_EN, 2U, 0x0100U);
+    put(SDHC_REG_ERROR_INT_SIGNAL_EN, 2U, 0x0000U);
+    put(SDHC_REG_CLK_CTRL, 2U, 0x0200U | SDHC_CLK_CTRL_INTERNAL_CLK_EN |
+            SDHC_CLK_CTRL_SD_CLK_EN);
+}
+
+/* Deep sleep that loses the state of the whole controller */
+static void lose_state(void)
+{
+    memset(fake.mem, 0, sizeof(fake.mem));
+}
+
+/* The restore must end with the single write starting the SD clock, and the
+ * SD clock must not be started by any earlier write.
+ */
+static void check_write_order(void)
+{
+    fake_write_t last;
+
+    CHECK(fake.write_count > 0U);
+    if ((0U == fake.write_count) || (fake.write_count > FAKE_MAX_WRITES))
+    {
+        return;
+    }
+
+    last = fake.writes[fake.write_count - 1U];
+    CHECK(SDHC_REG_CLK_CTRL == last.offset);
+    CHECK(0U != (last.value & SDHC_CLK_CTRL_SD_CLK_EN));
+
+    for (uint32_t i = 0U; (i + 1U) < fake.write_count; i++)
+    {
+        CHECK(!((SDHC_REG_CLK_CTRL == fake.writes[i].offset) &&
+                (0U != (fake.writes[i].value & SDHC_CLK_CTRL_SD_CLK_EN))));
+        CHECK((SDHC_REG_PWR_CTRL != fake.writes[i].offset) || (0U == i));
+    }
+}
+
+static void test_not_ready(void)
+{
+    sdhc_retain_t retain;
+
+    configure_bus();
+    sdhc_retain_init(&retain, &fake_io);
+
+    /* No bus configuration captured: the generic callback must be used */
+    CHECK(!sdhc_retain_save(&retain));
+    CHECK(0U == fake.write_count);
+    CHECK(!sdhc_retain_restore(&retain));
+    CHECK(0U == retain.stats.bus_changed);
+}
+
+static void test_retained(void)
+{
+    sdhc_retain_t retain;
+    uint8_t before[FAKE_CORE_SIZE];
+
+    configure_bus();
+    memcpy(before, fake.mem, sizeof(before));
+    sdhc_retain_init(&retain, &fake_io);
+    sdhc_retain_capture_bus(&retain);
+
+    for (uint32_t cycle = 0U; cycle < 3U; cycle++)
+    {
+        fake.write_count = 0U;
+        CHECK(sdhc_retain_save(&retain));
+        CHECK(1U == fake.write_count);
+        CHECK(0U == (get(SDHC_REG_CLK_CTRL, 2U) & SDHC_CLK_CTRL_SD_CLK_EN));
+
+        fake.write_count = 0U;
+        CHECK(sdhc_retain_restore(&retain));
+        CHECK(1U == fake.write_count);
+        check_write_order();
+        CHECK(0 == memcmp(before, fake.mem, sizeof(before)));
+    }
+
+    CHECK(3U == retain.stats.fast_resumes);
+    CHECK(3U == retain.stats.retained);
+    CHECK(0U == retain.stats.lost_regs);
+    CHECK(6U == retain.stats.writes);
+
+    /* A second restore without a save has nothing to restore */
+    CHECK(!sdhc_retain_restore(&retain));
+}
+
+static void test_lost(void)
+{
+    sdhc_retain_t retain;
+    uint8_t before[FAKE_CORE_SIZE];
+
+    configure_bus();
+    memcpy(before, fake.mem, sizeof(before));
+    sdhc_retain_init(&retain, &fake_io);
+    sdhc_retain_capture_bus(&retain);
+
+    CHECK(sdhc_retain_save(&retain));
+    lose_state();
+    fake.write_count = 0U;
+    CHECK(sdhc_retain_restore(&retain));
+
+    /* Every non-zero register once, then the SD clock */
+    CHECK((CONFIGURED_REGS + 1U) == fake.write_count);
+    check_write_order();
+    CHECK(0 == memcmp(before, fake.mem, sizeof(before)));
+    CHECK(1U == retain.stats.fast_resumes);
+    CHECK(0U == retain.stats.retained);
+    CHECK(CONFIGURED_REGS == retain.stats.lost_regs);
+}
+
+static void test_partially_lost(void)
+{
+    sdhc_retain_t retain;
+    uint8_t before[FAKE_CORE_SIZE];
+
+    configure_bus();
+    memcpy(before, fake.mem, sizeof(before));
+    sdhc_retain_init(&retain, &fake_io);
+    sdhc_retain_capture_bus(&retain);
+
+    CHECK(sdhc_retain_save(&retain));
+    put(SDHC_REG_NORMAL_INT_SIGNAL_EN, 2U, 0U);
+    fake.write_count = 0U;
+    CHECK(sdhc_retain_restore(&retain));
+    CHECK(2U == fake.write_count);
+    CHECK(SDHC_REG_NORMAL_INT_SIGNAL_EN == fake.writes[0].offset);
+    check_write_order();
+    CHECK(0 == memcmp(before, fake.mem, sizeof(before)));
+    CHECK(1U == retain.stats.lost_regs);
+}
+
+static void test_bus_changed(void)
+{
+    sdhc_retain_t retain;
+
+    configure_bus();
+    sdhc_retain_init(&retain, &fake_io);
+    sdhc_retain_capture_bus(&retain);
+
+    /* Bus width changed behind the fast path: card state unknown */
+    put(SDHC_REG_HOST_CTRL1, 1U, 0x00U);
+    fake.write_count = 0U;
+    CHECK(!sdhc_retain_save(&retain));
+    CHECK(0U == fake.write_count);
+    CHECK(0U != (get(SDHC_REG_CLK_CTRL, 2U) & SDHC_CLK_CTRL_SD_CLK_EN));
+    CHECK(!sdhc_retain_restore(&retain));
+    CHECK(1U == retain.stats.bus_changed);
+
+    /* Changes outside the bus configuration keep the fast path */
+    configure_bus();
+    sdhc_retain_capture_bus(&retain);
+    put(SDHC_REG_NORMAL_INT_SIGNAL_EN, 2U, 0x0000U);
+    CHECK(sdhc_retain_save(&retain));
+    CHECK(sdhc_retain_restore(&retain));
+    CHECK(0U == get(SDHC_REG_NORMAL_INT_SIGNAL_EN, 2U));
+
+    /* A new capture accepts the new configuration */
+    put(SDHC_REG_HOST_CTRL1, 1U, 0x06U);
+    sdhc_retain_capture_bus(&retain);
+    CHECK(sdhc_retain_save(&retain));
+    CHECK(sdhc_retain_restore(&retain));
+}
+
+static void test_failures(void)
+{
+    sdhc_retain_t retain;
+
+    /* Internal clock never stable: the SD clock must stay stopped */
+    configure_bus();
+    sdhc_retain_init(&retain, &fake_io);
+    sdhc_retain_capture_bus(&retain);
+    CHECK(sdhc_retain_save(&retain));
+    lose_state();
+    fake.never_stable = true;
+    CHECK(!sdhc_retain_restore(&retain));
+    CHECK(0U == (get(SDHC_REG_CLK_CTRL, 2U) & SDHC_CLK_CTRL_SD_CLK_EN));
+    CHECK(1U == retain.stats.failures);
+    CHECK(0U == retain.stats.fast_resumes);
+
+    /* A register that does not keep the restored value */
+    configure_bus();
+    sdhc_retain_init(&retain, &fake_io);
+    sdhc_retain_capture_bus(&retain);
+    CHECK(sdhc_retain_save(&retain));
+    lose_state();
+    fake.stuck_offset = SDHC_REG_TOUT_CTRL;
+    CHECK(!sdhc_retain_restore(&retain));
+    CHECK(0U == (get(SDHC_REG_CLK_CTRL, 2U) & SDHC_CLK_CTRL_SD_CLK_EN));
+    CHECK(1U == retain.stats.failures);
+}
+
+int main(void)
+{
+    test_not_ready();
+    test_retained();
+    test_lost();
+    test_partially_lost();
+    test_bus_changed();
+    test_failures();
+
+    return test_check_summary();
+}
+
+
+/* [] END OF FILE */
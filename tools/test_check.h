@@ -0,0 +1,92 @@
+/******************************************************************************
+* File Name: test_check.h
+*
+* Description: Checks shared by the Linux tests in this directory. Each test is
+* a single source file, so the counters are defined here.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef TEST_CHECK_H_
+#define TEST_CHECK_H_
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CHECK(condition) test_check((condition), #condition, __LINE__)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static uint32_t test_check_count;
+static uint32_t test_check_failures;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/* Counts a check and prints it if it failed */
+static inline void test_check(bool condition, const char *text, int line)
+{
+    test_check_count++;
+
+    if (!condition)
+    {
+        test_check_failures++;
+        printf("FAIL line %d: %s\n", line, text);
+    }
+}
+
+/* Prints the number of checks and returns the exit status of the test */
+static inline int test_check_summary(void)
+{
+    printf("%u checks, %u failed\n", test_check_count, test_check_failures);
+
+    return (0U == test_check_failures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#endif /* TEST_CHECK_H_ */
+
+
+/* [] END OF FILE */
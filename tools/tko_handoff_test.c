@@ -0,0 +1,281 @@
+/*******************************************************************************
+* File Name:   tko_handoff_test.c
+*
+* Description: Checks the TCP keep-alive offload handoff of
+* proj_cm33_ns/source/tko_handoff.c on the host machine: the sequence number
+* arithmetic across the 2^32 wrap, the keep-alive segments built for the
+* firmware, and the outcome of taking a connection back for every firmware
+* status.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+
+/*
+ * Build:
+ *  cc -O2 -Wall -I proj_cm33_ns/source -o tko_handoff_test \
+ *      tools/tko_handoff_test.c proj_cm33_ns/source/tko_handoff.c
+ *
+ * Usage:
+ *  tko_handoff_test
+ *
+ * Prints every failed check and exits with a non-zero status if any.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tko_handoff.h"
+
+#include "test_check.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const tko_conn_t base_conn =
+{
+    .local_ip       = { 192U, 168U, 1U, 50U },
+    .remote_ip      = { 203U, 0U, 113U, 7U },
+    .local_port     = 49152U,
+    .remote_port    = 443U,
+    .snd_nxt        = 0x12345678UL,
+    .rcv_nxt        = 0x9ABCDEF0UL,
+    .rcv_wnd        = 5840U
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static uint16_t get_be16(const uint8_t *p)
+{
+    return (uint16_t)(((uint16_t)p[0] << 8U) | p[1]);
+}
+
+static uint32_t get_be32(const uint8_t *p)
+{
+    return ((uint32_t)get_be16(p) << 16U) | get_be16(&p[2]);
+}
+
+/* Ones' complement sum, 0xFFFF over data holding a valid checksum */
+static uint16_t sum16(const uint8_t *data, size_t len, uint32_t sum)
+{
+    for (size_t i = 0U; (i + 1U) < len; i += 2U)
+    {
+        sum += get_be16(&data[i]);
+    }
+
+    while (0U != (sum >> 16U))
+    {
+        sum = (sum & 0xFFFFU) + (sum >> 16U);
+    }
+
+    return (uint16_t)sum;
+}
+
+static bool tcp_checksum_valid(const uint8_t *packet)
+{
+    uint8_t pseudo[12];
+
+    memcpy(pseudo, &packet[12], 8U);
+    pseudo[8] = 0U;
+    pseudo[9] = packet[9];
+    pseudo[10] = 0U;
+    pseudo[11] = 20U;
+
+    return (0xFFFFU == sum16(&packet[20], 20U, sum16(pseudo, 12U, 0U)));
+}
+
+static void test_seq_before(void)
+{
+    CHECK(tko_seq_before(1U, 2U));
+    CHECK(!tko_seq_before(2U, 1U));
+    CHECK(!tko_seq_before(5U, 5U));
+    CHECK(tko_seq_before(0xFFFFFFF0UL, 0x10U));
+    CHECK(!tko_seq_before(0x10U, 0xFFFFFFF0UL));
+    CHECK(tko_seq_before(0x7FFFFFFFUL, 0x80000000UL));
+}
+
+static void test_segments(void)
+{
+    tko_conn_t conn = base_conn;
+    uint8_t request[TKO_SEGMENT_LEN];
+    uint8_t response[TKO_SEGMENT_LEN];
+
+    CHECK(TKO_SEGMENT_LEN == tko_build_segment(&conn, true, request,
+            sizeof(request)));
+    CHECK(TKO_SEGMENT_LEN == tko_build_segment(&conn, false, response,
+            sizeof(response)));
+    CHECK(0U == tko_build_segment(&conn, true, request, 10U));
+
+    /* Keep-alive: SEG.SEQ = SND.NXT - 1, SEG.ACK = RCV.NXT */
+    CHECK(0xFFFFU == sum16(request, 20U, 0U));
+    CHECK(tcp_checksum_valid(request));
+    CHECK(0 == memcmp(&request[12], conn.local_ip, 4U));
+    CHECK(0 == memcmp(&request[16], conn.remote_ip, 4U));
+    CHECK(conn.local_port == get_be16(&request[20]));
+    CHECK(conn.remote_port == get_be16(&request[22]));
+    CHECK((conn.snd_nxt - 1U) == get_be32(&request[24]));
+    CHECK(conn.rcv_nxt == get_be32(&request[28]));
+    CHECK(0x10U == request[33]);
+    CHECK(conn.rcv_wnd == get_be16(&request[34]));
+
+    /* Expected answer: SEG.SEQ = RCV.NXT, SEG.ACK = SND.NXT */
+    CHECK(0xFFFFU == sum16(response, 20U, 0U));
+    CHECK(tcp_checksum_valid(response));
+    CHECK(0 == memcmp(&response[12], conn.remote_ip, 4U));
+    CHECK(conn.remote_port == get_be16(&response[20]));
+    CHECK(conn.rcv_nxt == get_be32(&response[24]));
+    CHECK(conn.snd_nxt == get_be32(&response[28]));
+
+    /* The keep-alive of a connection at the start of the sequence space */
+    conn.snd_nxt = 0U;
+    (void)tko_build_segment(&conn, true, request, sizeof(request));
+    CHECK(0xFFFFFFFFUL == get_be32(&request[24]));
+    CHECK(tcp_checksum_valid(request));
+}
+
+static void test_iovar(void)
+{
+    uint8_t buffer[TKO_CONNECT_IOVAR_LEN];
+    uint8_t request[TKO_SEGMENT_LEN];
+
+    CHECK(0U == tko_build_connect_iovar(&base_conn, 0U, buffer, 16U));
+    CHECK(TKO_CONNECT_IOVAR_LEN == tko_build_connect_iovar(&base_conn, 1U,
+            buffer, sizeof(buffer)));
+    CHECK(TKO_SUBCMD_CONNECT == (buffer[0] | (buffer[1] << 8U)));
+    CHECK((TKO_CONNECT_IOVAR_LEN - 4U) == (buffer[2] | (buffer[3] << 8U)));
+    CHECK(1U == buffer[4]);
+    CHECK(base_conn.local_port == get_be16(&buffer[6]));
+    CHECK(base_conn.remote_port == get_be16(&buffer[8]));
+    CHECK(base_conn.snd_nxt == get_be32(&buffer[12]));
+    CHECK(base_conn.rcv_nxt == get_be32(&buffer[16]));
+    CHECK(TKO_SEGMENT_LEN == (buffer[20] | (buffer[21] << 8U)));
+    CHECK(0 == memcmp(&buffer[24], base_conn.local_ip, 4U));
+    CHECK(0 == memcmp(&buffer[28], base_conn.remote_ip, 4U));
+
+    (void)tko_build_segment(&base_conn, true, request, sizeof(request));
+    CHECK(0 == memcmp(&buffer[32], request, sizeof(request)));
+}
+
+static tko_reclaim_t reclaim(const tko_conn_t *handed, const tko_conn_t *now,
+        uint8_t status)
+{
+    tko_handoff_t handoff;
+
+    tko_handoff_init(&handoff);
+    tko_handoff_begin(&handoff, handed);
+    return tko_handoff_reclaim(&handoff, now, status);
+}
+
+static void test_reclaim(void)
+{
+    tko_conn_t sent = base_conn;
+    tko_conn_t received = base_conn;
+    tko_conn_t backwards = base_conn;
+    tko_conn_t other = base_conn;
+    tko_conn_t wrap = base_conn;
+    tko_conn_t wrapped;
+    tko_handoff_t handoff;
+
+    sent.snd_nxt += 100U;
+    received.rcv_nxt += 1U;
+    backwards.snd_nxt -= 1U;
+    other.remote_port = 8883U;
+    wrap.snd_nxt = 0xFFFFFFF0UL;
+    wrapped = wrap;
+    wrapped.snd_nxt = 0x20U;
+
+    /* Unchanged connection */
+    CHECK(TKO_RECLAIM_OK == reclaim(&base_conn, &base_conn,
+            TKO_STATUS_NORMAL));
+    CHECK(TKO_RECLAIM_OK == reclaim(&base_conn, &base_conn,
+            TKO_STATUS_TCP_DATA));
+    CHECK(TKO_RECLAIM_OK == reclaim(&base_conn, &base_conn,
+            TKO_STATUS_UNAVAILABLE));
+    CHECK(TKO_RECLAIM_BROKEN == reclaim(&base_conn, &base_conn,
+            TKO_STATUS_NO_RESPONSE));
+    CHECK(TKO_RECLAIM_DESYNC == reclaim(&base_conn, &base_conn,
+            TKO_STATUS_SEQ_NUM_INVALID));
+    CHECK(TKO_RECLAIM_DESYNC == reclaim(&base_conn, &base_conn,
+            TKO_STATUS_REMOTE_SEQ_NUM_INVALID));
+    CHECK(TKO_RECLAIM_DESYNC == reclaim(&base_conn, &base_conn,
+            TKO_STATUS_UNEXPECT_TCP_ACK));
+
+    /* Used by the host after the handoff: its state is kept */
+    CHECK(TKO_RECLAIM_STALE == reclaim(&base_conn, &sent,
+            TKO_STATUS_NORMAL));
+    CHECK(TKO_RECLAIM_STALE == reclaim(&base_conn, &received,
+            TKO_STATUS_SEQ_NUM_INVALID));
+    CHECK(TKO_RECLAIM_BROKEN == reclaim(&base_conn, &sent,
+            TKO_STATUS_NO_RESPONSE));
+
+    /* Sequence numbers moving forward across the wrap */
+    CHECK(TKO_RECLAIM_STALE == reclaim(&wrap, &wrapped, TKO_STATUS_NORMAL));
+    CHECK(TKO_RECLAIM_DESYNC == reclaim(&wrapped, &wrap, TKO_STATUS_NORMAL));
+
+    /* Not the connection handed over */
+    CHECK(TKO_RECLAIM_DESYNC == reclaim(&base_conn, &backwards,
+            TKO_STATUS_NORMAL));
+    CHECK(TKO_RECLAIM_DESYNC == reclaim(&base_conn, &other,
+            TKO_STATUS_NORMAL));
+
+    /* Counters, and a reclaim without handoff */
+    tko_handoff_init(&handoff);
+    CHECK(TKO_RECLAIM_OK == tko_handoff_reclaim(&handoff, &base_conn,
+            TKO_STATUS_NO_RESPONSE));
+    tko_handoff_begin(&handoff, &base_conn);
+    CHECK(handoff.active);
+    (void)tko_handoff_reclaim(&handoff, &base_conn, TKO_STATUS_NO_RESPONSE);
+    CHECK(!handoff.active);
+    CHECK(1U == handoff.handoffs);
+    CHECK(1U == handoff.reclaims[TKO_RECLAIM_BROKEN]);
+    CHECK(TKO_RECLAIM_OK == tko_handoff_reclaim(&handoff, &base_conn,
+            TKO_STATUS_NO_RESPONSE));
+}
+
+int main(void)
+{
+    test_seq_before();
+    test_segments();
+    test_iovar();
+    test_reclaim();
+
+    return test_check_summary();
+}
+
+
+/* [] END OF FILE */
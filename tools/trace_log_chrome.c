@@ -0,0 +1,655 @@
+/*******************************************************************************
+* File Name:   trace_log_chrome.c
+*
+* Description: Converts the power-state timeline written to the debug UART by
+* proj_cm33_ns/source/trace_log.c to the Chrome trace event format. The low-
+* power modes, the network stack suspend windows, the connection attempts and
+* the running task are shown as slices on their own tracks, and the wake
+* interrupts and link losses as instant events. Open the result in Perfetto
+* (ui.perfetto.dev) or chrome://tracing.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+
+/*
+ * Build:
+ *  cc -O2 -Wall -I proj_cm33_ns/source -o trace_log_chrome \
+ *      tools/trace_log_chrome.c
+ *
+ * Usage:
+ *  trace_log_chrome < log > trace.json
+ *  trace_log_chrome -c expected.json < log
+ *
+ * The input is the debug UART output of the device with TRACE_LOG_ENABLE set
+ * to 1. The lines containing "trace,", "trace-dropped,", "trace-clock," or
+ * "trace-task," are described in trace_log.h; the other lines are ignored.
+ * The 32-bit LPTimer timestamps are extended to 64 bits, so captures longer
+ * than the wrap period of the LPTimer can be converted, and the events are
+ * sorted by time. The time is shown from the first event.
+ *
+ * With -c, the output is compared with a golden file instead of being
+ * printed, and the first difference is reported. Check the converter with
+ * every capture of tools/trace_golden and the trace expected for it:
+ *  trace_log_chrome -c tools/trace_golden/basic.json \
+ *      < tools/trace_golden/basic.log
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "trace_log.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define DEFAULT_TICK_HZ                 (32768U)
+#define US_PER_SEC                      (1000000U)
+#define MAX_TASKS                       (64U)
+#define MAX_TASK_NAME                   (32U)
+
+/* Events of the trace that are not recorded by the device */
+#define EVENT_DROPPED                   (TRACE_EVENT_COUNT)
+
+/* Tracks of the timeline */
+enum
+{
+    TRACK_POWER = 1,
+    TRACK_NETWORK,
+    TRACK_CONNECTION,
+    TRACK_IRQ,
+    TRACK_TASK
+};
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    uint64_t ticks;                 /* Extended to 64 bits */
+    uint32_t sequence;              /* Order in the input */
+    uint32_t event;
+    uint32_t arg;
+} event_t;
+
+typedef struct
+{
+    uint32_t number;
+    char name[MAX_TASK_NAME];
+} task_name_t;
+
+/* Slice started and not ended yet */
+typedef struct
+{
+    bool open;
+    uint64_t start;
+    uint32_t arg;
+} slice_t;
+
+typedef struct
+{
+    FILE *out;
+    uint32_t tick_hz;
+    uint64_t origin;
+    uint32_t written;
+} writer_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const char *const track_names[] =
+{
+    [TRACK_POWER]       = "Power mode",
+    [TRACK_NETWORK]     = "Network stack",
+    [TRACK_CONNECTION]  = "Wi-Fi connection",
+    [TRACK_IRQ]         = "Wake interrupts",
+    [TRACK_TASK]        = "Running task"
+};
+
+static const char *const power_names[] =
+{
+    [TRACE_POWER_SLEEP]     = "CPU Sleep",
+    [TRACE_POWER_DEEPSLEEP] = "Deep Sleep"
+};
+
+static const char *const irq_names[] =
+{
+    [TRACE_IRQ_HOST_WAKE]   = "Host wake",
+    [TRACE_IRQ_SDIO]        = "SDIO"
+};
+
+static task_name_t tasks[MAX_TASKS];
+static uint32_t task_count;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static int compare_events(const void *a, const void *b)
+{
+    const event_t *x = a;
+    const event_t *y = b;
+
+    if (x->ticks != y->ticks)
+    {
+        return (x->ticks < y->ticks) ? -1 : 1;
+    }
+
+    return (x->sequence < y->sequence) ? -1 : (x->sequence > y->sequence);
+}
+
+static void set_task_name(uint32_t number, const char *name)
+{
+    task_name_t *task = NULL;
+    size_t length = strcspn(name, "\r\n");
+
+    for (uint32_t i = 0U; i < task_count; i++)
+    {
+        if (tasks[i].number == number)
+        {
+            task = &tasks[i];
+        }
+    }
+
+    if ((NULL == task) && (task_count < MAX_TASKS))
+    {
+        task = &tasks[task_count++];
+        task->number = number;
+    }
+
+    if (NULL != task)
+    {
+        if (length >= MAX_TASK_NAME)
+        {
+            length = MAX_TASK_NAME - 1U;
+        }
+        memcpy(task->name, name, length);
+        task->name[length] = '\0';
+    }
+}
+
+/* Writes a string as a JSON string */
+static void write_string(FILE *out, const char *text)
+{
+    fputc('"', out);
+
+    for (; '\0' != *text; text++)
+    {
+        if (('"' == *text) || ('\\' == *text))
+        {
+            fputc('\\', out);
+            fputc(*text, out);
+        }
+        else if ((unsigned char)*text < 0x20U)
+        {
+            fprintf(out, "\\u%04x", (unsigned int)(unsigned char)*text);
+        }
+        else
+        {
+            fputc(*text, out);
+        }
+    }
+
+    fputc('"', out);
+}
+
+static uint64_t to_us(const writer_t *writer, uint64_t ticks)
+{
+    return ((ticks - writer->origin) * US_PER_SEC) / writer->tick_hz;
+}
+
+static void begin_record(writer_t *writer)
+{
+    fputs((0U == writer->written) ? "\n" : ",\n", writer->out);
+    writer->written++;
+}
+
+static void write_metadata(writer_t *writer, const char *kind, uint32_t tid,
+        const char *name)
+{
+    begin_record(writer);
+    fprintf(writer->out, "{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"%s\","
+            "\"args\":{\"name\":", tid, kind);
+    write_string(writer->out, name);
+    fputs("}}", writer->out);
+}
+
+/* Writes a complete event. args is a JSON object body, or NULL. */
+static void write_slice(writer_t *writer, uint32_t tid, const char *name,
+        uint64_t start, uint64_t end, const char *args)
+{
+    uint64_t start_us = to_us(writer, start);
+
+    begin_record(writer);
+    fprintf(writer->out, "{\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%llu,"
+            "\"dur\":%llu,\"name\":", tid, (unsigned long long)start_us,
+            (unsigned long long)(to_us(writer, end) - start_us));
+    write_string(writer->out, name);
+
+    if (NULL != args)
+    {
+        fprintf(writer->out, ",\"args\":{%s}", args);
+    }
+
+    fputc('}', writer->out);
+}
+
+/* Writes an instant event of a track, or of the whole trace if tid is 0 */
+static void write_instant(writer_t *writer, uint32_t tid, const char *name,
+        uint64_t time)
+{
+    begin_record(writer);
+    fprintf(writer->out, "{\"ph\":\"i\",\"pid\":1,\"tid\":%u,\"ts\":%llu,"
+            "\"s\":\"%s\",\"name\":", tid,
+            (unsigned long long)to_us(writer, time), (0U == tid) ? "g" : "t");
+    write_string(writer->out, name);
+    fputc('}', writer->out);
+}
+
+static void task_label(uint32_t number, char *label, size_t size)
+{
+    for (uint32_t i = 0U; i < task_count; i++)
+    {
+        if (tasks[i].number == number)
+        {
+            snprintf(label, size, "%s", tasks[i].name);
+            return;
+        }
+    }
+
+    snprintf(label, size, "Task %u", number);
+}
+
+/* Pairs the events into slices and writes the trace */
+static void write_trace(FILE *out, uint32_t tick_hz, const event_t *events,
+        size_t count)
+{
+    writer_t writer = { out, tick_hz, 0U, 0U };
+    slice_t power[TRACE_POWER_DEEPSLEEP + 1] = { { 0 } };
+    slice_t network = { 0 };
+    slice_t connect = { 0 };
+    slice_t task = { 0 };
+    uint64_t last = 0U;
+    char label[64];
+    char args[64];
+
+    if (0U != count)
+    {
+        writer.origin = events[0].ticks;
+        last = events[count - 1U].ticks;
+    }
+
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", out);
+
+    write_metadata(&writer, "process_name", 0U, "PSOC Edge CM33");
+    for (uint32_t tid = TRACK_POWER; tid <= TRACK_TASK; tid++)
+    {
+        write_metadata(&writer, "thread_name", tid, track_names[tid]);
+    }
+
+    for (size_t i = 0U; i < count; i++)
+    {
+        const event_t *event = &events[i];
+
+        switch (event->event)
+        {
+            case TRACE_EVENT_POWER_ENTER:
+                if (event->arg <= TRACE_POWER_DEEPSLEEP)
+                {
+                    power[event->arg].open = true;
+                    power[event->arg].start = event->ticks;
+                }
+                break;
+
+            case TRACE_EVENT_POWER_EXIT:
+                if ((event->arg <= TRACE_POWER_DEEPSLEEP) &&
+                        power[event->arg].open)
+                {
+                    write_slice(&writer, TRACK_POWER, power_names[event->arg],
+                            power[event->arg].start, event->ticks, NULL);
+                    power[event->arg].open = false;
+                }
+                break;
+
+            case TRACE_EVENT_NET_WAIT:
+                network.open = true;
+                network.start = event->ticks;
+                break;
+
+            case TRACE_EVENT_NET_RESUMED:
+                if (network.open)
+                {
+                    write_slice(&writer, TRACK_NETWORK, "wait_net_suspend",
+                            network.start, event->ticks, NULL);
+                    network.open = false;
+                }
+                break;
+
+            case TRACE_EVENT_WAKE_IRQ:
+                write_instant(&writer, TRACK_IRQ,
+                        (event->arg <= TRACE_IRQ_SDIO) ?
+                        irq_names[event->arg] : "IRQ", event->ticks);
+                break;
+
+            case TRACE_EVENT_CONNECT_START:
+                connect.open = true;
+                connect.start = event->ticks;
+                connect.arg = event->arg;
+                break;
+
+            case TRACE_EVENT_CONNECT_END:
+                if (connect.open)
+                {
+                    snprintf(args, sizeof(args),
+                            "\"attempt\":%u,\"result\":\"%s\"", connect.arg,
+                            (0U != event->arg) ? "connected" : "failed");
+                    write_slice(&writer, TRACK_CONNECTION, "Connect",
+                            connect.start, event->ticks, args);
+                    connect.open = false;
+                }
+                break;
+
+            case TRACE_EVENT_LINK_LOST:
+                write_instant(&writer, TRACK_CONNECTION, "Link lost",
+                        event->ticks);
+                break;
+
+            case TRACE_EVENT_TASK_SWITCH:
+                if (task.open)
+                {
+                    task_label(task.arg, label, sizeof(label));
+                    write_slice(&writer, TRACK_TASK, label, task.start,
+                            event->ticks, NULL);
+                }
+                task.open = true;
+                task.start = event->ticks;
+                task.arg = event->arg;
+                break;
+
+            case EVENT_DROPPED:
+                snprintf(label, sizeof(label), "%u events dropped",
+                        event->arg);
+                write_instant(&writer, 0U, label, event->ticks);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    /* Slices still open at the end of the capture end with the last event */
+    for (uint32_t mode = 0U; mode <= TRACE_POWER_DEEPSLEEP; mode++)
+    {
+        if (power[mode].open)
+        {
+            write_slice(&writer, TRACK_POWER, power_names[mode],
+                    power[mode].start, last, NULL);
+        }
+    }
+
+    if (network.open)
+    {
+        write_slice(&writer, TRACK_NETWORK, "wait_net_suspend", network.start,
+                last, NULL);
+    }
+
+    if (connect.open)
+    {
+        snprintf(args, sizeof(args), "\"attempt\":%u", connect.arg);
+        write_slice(&writer, TRACK_CONNECTION, "Connect", connect.start, last,
+                args);
+    }
+
+    if (task.open)
+    {
+        task_label(task.arg, label, sizeof(label));
+        write_slice(&writer, TRACK_TASK, label, task.start, last, NULL);
+    }
+
+    fputs("\n]}\n", out);
+}
+
+/* Compares the output with the golden file. Returns true if identical. */
+static bool check_golden(const char *path, const char *output, size_t size)
+{
+    FILE *file = fopen(path, "r");
+    char line[1024];
+    size_t offset = 0U;
+    uint32_t number = 0U;
+    bool match = true;
+
+    if (NULL == file)
+    {
+        fprintf(stderr, "Cannot open %s\n", path);
+        return false;
+    }
+
+    while (match && (NULL != fgets(line, sizeof(line), file)))
+    {
+        size_t length = strlen(line);
+
+        number++;
+        if ((length > (size - offset)) ||
+                (0 != memcmp(line, &output[offset], length)))
+        {
+            match = false;
+        }
+        offset += length;
+    }
+
+    if (match && (offset != size))
+    {
+        number++;
+        match = false;
+    }
+
+    fclose(file);
+
+    if (match)
+    {
+        printf("PASS %s\n", path);
+    }
+    else
+    {
+        printf("FAIL %s: first difference at line %u\n", path, number);
+    }
+
+    return match;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *golden = NULL;
+    event_t *events = NULL;
+    size_t count = 0U;
+    size_t capacity = 0U;
+    uint32_t tick_hz = DEFAULT_TICK_HZ;
+    uint32_t sequence = 0U;
+    uint32_t last_ticks = 0U;
+    uint64_t ticks = 0U;
+    bool have_ticks = false;
+    uint32_t ignored = 0U;
+    char *output = NULL;
+    size_t output_size = 0U;
+    FILE *out;
+    char line[256];
+    int option;
+
+    while ((option = getopt(argc, argv, "c:")) != -1)
+    {
+        switch (option)
+        {
+            case 'c':
+                golden = optarg;
+                break;
+
+            default:
+                fprintf(stderr, "Usage: %s [-c expected.json] < log\n",
+                        argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    while (NULL != fgets(line, sizeof(line), stdin))
+    {
+        const char *record;
+        unsigned long a;
+        unsigned long b;
+        unsigned long c;
+        int name_offset = 0;
+        event_t *event;
+
+        if (NULL != (record = strstr(line, "trace-clock,")))
+        {
+            if ((1 == sscanf(record, "trace-clock,%lu", &a)) && (0U != a))
+            {
+                tick_hz = (uint32_t)a;
+            }
+            continue;
+        }
+
+        if (NULL != (record = strstr(line, "trace-task,")))
+        {
+            if ((1 == sscanf(record, "trace-task,%lu,%n", &a, &name_offset)) &&
+                    (0 != name_offset))
+            {
+                set_task_name((uint32_t)a, &record[name_offset]);
+            }
+            continue;
+        }
+
+        if (count == capacity)
+        {
+            capacity = (0U == capacity) ? 1024U : (2U * capacity);
+            events = realloc(events, capacity * sizeof(event_t));
+            if (NULL == events)
+            {
+                fprintf(stderr, "Out of memory\n");
+                return EXIT_FAILURE;
+            }
+        }
+
+        event = &events[count];
+
+        if (NULL != (record = strstr(line, "trace-dropped,")))
+        {
+            if ((1 != sscanf(record, "trace-dropped,%lu", &a)) ||
+                    !have_ticks)
+            {
+                ignored++;
+                continue;
+            }
+
+            /* Reported after the last event drained */
+            event->event = EVENT_DROPPED;
+            event->arg = (uint32_t)a;
+        }
+        else if (NULL != (record = strstr(line, "trace,")))
+        {
+            if ((3 != sscanf(record, "trace,%lu,%lu,%lu", &a, &b, &c)) ||
+                    (TRACE_EVENT_NONE == b) || (b >= TRACE_EVENT_COUNT))
+            {
+                ignored++;
+                continue;
+            }
+
+            /* The difference to the previous event is read as signed, so
+             * that both a wrap of the LPTimer and an event recorded out of
+             * order by an interrupt are handled.
+             */
+            if (have_ticks)
+            {
+                ticks += (uint64_t)(int64_t)(int32_t)((uint32_t)a -
+                        last_ticks);
+            }
+            else
+            {
+                ticks = (uint64_t)a;
+                have_ticks = true;
+            }
+            last_ticks = (uint32_t)a;
+
+            event->event = (uint32_t)b;
+            event->arg = (uint32_t)c;
+        }
+        else
+        {
+            continue;
+        }
+
+        event->ticks = ticks;
+        event->sequence = sequence++;
+        count++;
+    }
+
+    if (0U != ignored)
+    {
+        fprintf(stderr, "%u malformed trace lines ignored\n", ignored);
+    }
+
+    if (0U != count)
+    {
+        qsort(events, count, sizeof(event_t), compare_events);
+    }
+
+    out = (NULL != golden) ? open_memstream(&output, &output_size) : stdout;
+    if (NULL == out)
+    {
+        fprintf(stderr, "Out of memory\n");
+        return EXIT_FAILURE;
+    }
+
+    write_trace(out, tick_hz, events, count);
+    free(events);
+
+    if (NULL == golden)
+    {
+        return EXIT_SUCCESS;
+    }
+
+    fclose(out);
+    option = check_golden(golden, output, output_size) ?
+            EXIT_SUCCESS : EXIT_FAILURE;
+    free(output);
+
+    return option;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,314 @@
+/*******************************************************************************
+* File Name:   uplink_batch_sim.c
+*
+* Description: Drives the batched uplink queue of
+* proj_cm33_ns/source/uplink_batch.c on the host machine with a fake transport
+* and a simulated clock. It checks that every record is delivered once, in order
+* and within the maximum delay, and compares the number of network stack resumes
+* with sending every record as it is produced.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+
+/*
+ * Build:
+ *  cc -O2 -Wall -I proj_cm33_ns/source -o uplink_batch_sim \
+ *      tools/uplink_batch_sim.c proj_cm33_ns/source/uplink_batch.c
+ *
+ * Usage:
+ *  uplink_batch_sim [-t duration_s] [-p record_period_ms] [-n record_bytes]
+ *                   [-w inbound_wakes_per_minute] [-b flush_bytes]
+ *                   [-d max_delay_ms] [-l loss_percent] [-r seed]
+ *
+ * One record is produced every record_period_ms and inbound traffic resumes
+ * the network stack at random times. The fake transport decodes every
+ * datagram and drops loss_percent of them. The exit status is non-zero if a
+ * record is delivered out of order, late, or not accounted for.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "uplink_batch.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define DEFAULT_DURATION_S              (3600U)
+#define DEFAULT_RECORD_PERIOD_MS        (1000U)
+#define DEFAULT_RECORD_BYTES            (40U)
+#define DEFAULT_WAKES_PER_MINUTE        (2U)
+#define DEFAULT_FLUSH_BYTES             (1024U)
+#define DEFAULT_MAX_DELAY_MS            (30000U)
+#define DATAGRAM_SIZE                   (1472U)
+
+/* Every record starts with its sequence number and production time */
+#define RECORD_MIN_BYTES                (8U)
+#define MS_PER_MINUTE                   (60000U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* State of the fake transport */
+typedef struct
+{
+    uint32_t now_ms;
+    uint32_t loss_percent;
+    uint32_t next_seq;          /* Next sequence number expected */
+    uint32_t records;
+    uint32_t skipped;           /* Records in dropped datagrams */
+    uint32_t datagrams;
+    uint64_t latency_total_ms;
+    uint32_t latency_max_ms;
+    uint32_t errors;
+} transport_t;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static uint32_t get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8U) |
+            ((uint32_t)p[2] << 16U) | ((uint32_t)p[3] << 24U);
+}
+
+static void put_u32(uint8_t *p, uint32_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8U);
+    p[2] = (uint8_t)(value >> 16U);
+    p[3] = (uint8_t)(value >> 24U);
+}
+
+/* Fake transport: decodes the records of a datagram as the sink would */
+static bool fake_send(void *context, const uint8_t *data, uint16_t length)
+{
+    transport_t *transport = (transport_t *)context;
+    bool lost = ((uint32_t)(rand() % 100) < transport->loss_percent);
+    uint16_t offset = 0U;
+
+    if (length > DATAGRAM_SIZE)
+    {
+        fprintf(stderr, "Datagram of %u bytes\n", length);
+        transport->errors++;
+    }
+
+    while (offset < length)
+    {
+        uint16_t size = (uint16_t)(data[offset] | (data[offset + 1U] << 8U));
+        const uint8_t *record = &data[offset + UPLINK_BATCH_RECORD_HEADER];
+        uint32_t seq;
+        uint32_t latency_ms;
+
+        if (((uint32_t)offset + UPLINK_BATCH_RECORD_HEADER + size > length) ||
+                (size < RECORD_MIN_BYTES))
+        {
+            fprintf(stderr, "Bad record framing at offset %u\n", offset);
+            transport->errors++;
+            return false;
+        }
+
+        seq = get_u32(record);
+        latency_ms = transport->now_ms - get_u32(&record[4]);
+
+        if (seq != transport->next_seq)
+        {
+            fprintf(stderr, "Record %u received, %u expected\n", seq,
+                    transport->next_seq);
+            transport->errors++;
+        }
+        transport->next_seq = seq + 1U;
+
+        if (lost)
+        {
+            transport->skipped++;
+        }
+        else
+        {
+            transport->records++;
+            transport->latency_total_ms += latency_ms;
+            if (latency_ms > transport->latency_max_ms)
+            {
+                transport->latency_max_ms = latency_ms;
+            }
+        }
+
+        offset = (uint16_t)(offset + UPLINK_BATCH_RECORD_HEADER + size);
+    }
+
+    if (!lost)
+    {
+        transport->datagrams++;
+    }
+
+    return !lost;
+}
+
+int main(int argc, char *argv[])
+{
+    uplink_batch_config_t config =
+    {
+        .flush_bytes    = DEFAULT_FLUSH_BYTES,
+        .max_delay_ms   = DEFAULT_MAX_DELAY_MS,
+        .datagram_size  = DATAGRAM_SIZE
+    };
+    static uplink_batch_t batch;
+    transport_t transport;
+    uint32_t duration_s = DEFAULT_DURATION_S;
+    uint32_t record_period_ms = DEFAULT_RECORD_PERIOD_MS;
+    uint32_t record_bytes = DEFAULT_RECORD_BYTES;
+    uint32_t wakes_per_minute = DEFAULT_WAKES_PER_MINUTE;
+    uint32_t inbound_wakes = 0U;
+    uint32_t produced = 0U;
+    uint32_t resumes = 0U;
+    uint8_t record[DATAGRAM_SIZE];
+    int option;
+
+    memset(&transport, 0, sizeof(transport));
+    srand(1U);
+
+    while ((option = getopt(argc, argv, "t:p:n:w:b:d:l:r:")) != -1)
+    {
+        uint32_t value = (NULL != optarg) ?
+                (uint32_t)strtoul(optarg, NULL, 0) : 0U;
+
+        switch (option)
+        {
+            case 't': duration_s = value; break;
+            case 'p': record_period_ms = value; break;
+            case 'n': record_bytes = value; break;
+            case 'w': wakes_per_minute = value; break;
+            case 'b': config.flush_bytes = value; break;
+            case 'd': config.max_delay_ms = value; break;
+            case 'l': transport.loss_percent = value; break;
+            case 'r': srand(value); break;
+
+            default:
+                fprintf(stderr, "Usage: %s [-t duration_s] "
+                        "[-p record_period_ms] [-n record_bytes] "
+                        "[-w inbound_wakes_per_minute] [-b flush_bytes] "
+                        "[-d max_delay_ms] [-l loss_percent] [-r seed]\n",
+                        argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if ((0U == record_period_ms) || (record_bytes < RECORD_MIN_BYTES) ||
+            (record_bytes + UPLINK_BATCH_RECORD_HEADER > DATAGRAM_SIZE))
+    {
+        fprintf(stderr, "Invalid record period or size\n");
+        return EXIT_FAILURE;
+    }
+
+    memset(record, 0xA5, sizeof(record));
+    uplink_batch_init(&batch, &config);
+
+    /* One step per millisecond, as the uplink task would see the clock */
+    for (transport.now_ms = 0U; transport.now_ms < duration_s * 1000U;
+            transport.now_ms++)
+    {
+        bool inbound = (wakes_per_minute > 0U) &&
+                ((uint32_t)(rand() % MS_PER_MINUTE) < wakes_per_minute);
+        uplink_flush_reason_t reason;
+
+        if (0U == (transport.now_ms % record_period_ms))
+        {
+            put_u32(&record[0], produced);
+            put_u32(&record[4], transport.now_ms);
+            if (uplink_batch_enqueue(&batch, record, (uint16_t)record_bytes,
+                    transport.now_ms))
+            {
+                produced++;
+            }
+        }
+
+        inbound_wakes += inbound ? 1U : 0U;
+        reason = uplink_batch_flush_due(&batch, transport.now_ms, inbound);
+
+        if (UPLINK_FLUSH_NONE != reason)
+        {
+            /* A piggyback flush rides on a resume that happens anyway */
+            resumes += (UPLINK_FLUSH_PIGGYBACK != reason) ? 1U : 0U;
+            uplink_batch_flush(&batch, reason, fake_send, &transport);
+        }
+    }
+
+    /* Records still queued at the end are sent in one more resume */
+    if (0U != batch.records)
+    {
+        resumes++;
+        uplink_batch_flush(&batch, UPLINK_FLUSH_DEADLINE, fake_send,
+                &transport);
+    }
+
+    if ((transport.records != batch.stats.records_sent) ||
+            (transport.skipped != batch.stats.records_lost) ||
+            (transport.records + transport.skipped != produced) ||
+            (transport.latency_max_ms > config.max_delay_ms))
+    {
+        fprintf(stderr, "Records not accounted for or late\n");
+        transport.errors++;
+    }
+
+    printf("%u records of %u bytes every %u ms for %u s, "
+            "%u inbound wakes\n", produced, record_bytes, record_period_ms,
+            duration_s, inbound_wakes);
+    printf("Policy: flush at %u bytes or %u ms, datagrams of %u bytes\n",
+            config.flush_bytes, config.max_delay_ms, config.datagram_size);
+    printf("Flushes: %u size, %u deadline, %u piggyback\n",
+            batch.stats.flushes[UPLINK_FLUSH_SIZE],
+            batch.stats.flushes[UPLINK_FLUSH_DEADLINE],
+            batch.stats.flushes[UPLINK_FLUSH_PIGGYBACK]);
+    printf("Delivered: %u records in %u datagrams, %u lost, %u dropped\n",
+            transport.records, transport.datagrams, transport.skipped,
+            batch.stats.records_dropped);
+    printf("Latency: mean %.1f ms, max %u ms\n",
+            (0U != transport.records) ?
+            (double)transport.latency_total_ms / transport.records : 0.0,
+            transport.latency_max_ms);
+    printf("Network stack resumes: %u batched, %u one per record "
+            "(%.1fx fewer)\n", resumes, produced,
+            (0U != resumes) ? (double)produced / resumes : 0.0);
+    printf("%s\n", (0U == transport.errors) ? "PASS" : "FAIL");
+
+    return (0U == transport.errors) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,416 @@
+/*******************************************************************************
+* File Name:   wake_filter_pcap.c
+*
+* Description: Runs the packet filter derivation of
+* proj_cm33_ns/source/wake_filter.c on a packet capture. It finds the frames
+* that would have resumed the suspended network stack, judges whether the host
+* would have used them, proposes the WLAN packet filters and replays the capture
+* through them to count the wakes actually avoided.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+
+/*
+ * Build:
+ *  cc -O2 -Wall -I proj_cm33_ns/source -o wake_filter_pcap \
+ *      tools/wake_filter_pcap.c proj_cm33_ns/source/wake_filter.c \
+ *      proj_cm33_ns/source/wake_reason.c
+ *
+ * Usage:
+ *  wake_filter_pcap [-i host_ipv4] [-u udp_port]... [-t tcp_port]...
+ *                   [-w inactive_window_ms] [-m min_wakes] [-n max_filters]
+ *                   capture.pcap
+ *
+ * The capture must be a classic pcap file of Ethernet frames received by the
+ * device, for example captured on the AP or with a monitor interface and
+ * converted. A frame resumes the network stack when no frame was received
+ * for inactive_window_ms before it. List the local ports the application
+ * receives on with -u and -t, and the address of the device with -i.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "lowpower_config.h"
+#include "wake_filter.h"
+#include "wake_reason.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define DEFAULT_MIN_WAKES               (5U)
+#define DEFAULT_MAX_FILTERS             (8U)
+#define MAX_PORTS                       (32U)
+
+#define PCAP_MAGIC_US                   (0xA1B2C3D4UL)
+#define PCAP_MAGIC_NS                   (0xA1B23C4DUL)
+#define PCAP_LINKTYPE_ETHERNET          (1U)
+#define PCAP_HEADER_LEN                 (24U)
+#define PCAP_RECORD_HEADER_LEN          (16U)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+/* Leading bytes of a captured frame */
+typedef struct
+{
+    uint64_t time_us;
+    uint16_t len;
+    uint8_t data[WAKE_FRAME_SNAPSHOT_LEN];
+} frame_t;
+
+/* Local endpoints given on the command line */
+typedef struct
+{
+    uint16_t udp[MAX_PORTS];
+    uint32_t udp_count;
+    uint16_t tcp[MAX_PORTS];
+    uint32_t tcp_count;
+} ports_t;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static uint32_t get_u32(const uint8_t *p, bool swap)
+{
+    return swap ?
+            (((uint32_t)p[0] << 24U) | ((uint32_t)p[1] << 16U) |
+            ((uint32_t)p[2] << 8U) | p[3]) :
+            (((uint32_t)p[3] << 24U) | ((uint32_t)p[2] << 16U) |
+            ((uint32_t)p[1] << 8U) | p[0]);
+}
+
+/* Reads all the frames of a pcap file */
+static frame_t *read_pcap(const char *path, size_t *count)
+{
+    uint8_t header[PCAP_HEADER_LEN];
+    frame_t *frames = NULL;
+    size_t capacity = 0U;
+    bool swap;
+    bool nanoseconds;
+    uint32_t magic;
+    FILE *file = fopen(path, "rb");
+
+    *count = 0U;
+
+    if (NULL == file)
+    {
+        perror(path);
+        return NULL;
+    }
+
+    if (1U != fread(header, sizeof(header), 1U, file))
+    {
+        fprintf(stderr, "%s: not a pcap file\n", path);
+        fclose(file);
+        return NULL;
+    }
+
+    magic = get_u32(header, false);
+    swap = (PCAP_MAGIC_US != magic) && (PCAP_MAGIC_NS != magic);
+    magic = get_u32(header, swap);
+    nanoseconds = (PCAP_MAGIC_NS == magic);
+
+    if (((PCAP_MAGIC_US != magic) && (PCAP_MAGIC_NS != magic)) ||
+            (PCAP_LINKTYPE_ETHERNET != get_u32(&header[20], swap)))
+    {
+        fprintf(stderr, "%s: not a pcap file of Ethernet frames\n", path);
+        fclose(file);
+        return NULL;
+    }
+
+    while (true)
+    {
+        uint8_t record[PCAP_RECORD_HEADER_LEN];
+        uint32_t captured;
+        uint32_t keep;
+        frame_t *frame;
+
+        if (1U != fread(record, sizeof(record), 1U, file))
+        {
+            break;
+        }
+
+        if (*count == capacity)
+        {
+            capacity = (0U == capacity) ? 1024U : (capacity * 2U);
+            frames = realloc(frames, capacity * sizeof(frame_t));
+            if (NULL == frames)
+            {
+                fprintf(stderr, "Out of memory\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        frame = &frames[*count];
+        captured = get_u32(&record[8], swap);
+        keep = (captured < WAKE_FRAME_SNAPSHOT_LEN) ?
+                captured : WAKE_FRAME_SNAPSHOT_LEN;
+        frame->time_us = ((uint64_t)get_u32(&record[0], swap) * 1000000U) +
+                (get_u32(&record[4], swap) / (nanoseconds ? 1000U : 1U));
+        frame->len = (uint16_t)keep;
+
+        if ((1U != fread(frame->data, keep, 1U, file) && (0U != keep)) ||
+                (0 != fseek(file, (long)(captured - keep), SEEK_CUR)))
+        {
+            fprintf(stderr, "%s: truncated record\n", path);
+            break;
+        }
+
+        (*count)++;
+    }
+
+    fclose(file);
+    return frames;
+}
+
+/* Local endpoints of the host, from the command line */
+static bool port_open(void *context, uint8_t ip_proto, uint16_t port)
+{
+    const ports_t *ports = (const ports_t *)context;
+    const uint16_t *list = (WAKE_IP_PROTO_TCP == ip_proto) ?
+            ports->tcp : ports->udp;
+    uint32_t count = (WAKE_IP_PROTO_TCP == ip_proto) ?
+            ports->tcp_count : ports->udp_count;
+
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        if (list[i] == port)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Counts the wakes, skipping the frames matched by the filters */
+static uint32_t count_wakes(const frame_t *frames, size_t count,
+        uint32_t window_ms, const wake_filter_t *filters,
+        uint32_t filter_count, const wake_filter_host_t *host,
+        wake_filter_table_t *table)
+{
+    uint64_t last_us = 0U;
+    uint32_t wakes = 0U;
+    bool first = true;
+
+    for (size_t i = 0U; i < count; i++)
+    {
+        const frame_t *frame = &frames[i];
+        bool filtered = false;
+
+        for (uint32_t f = 0U; (f < filter_count) && !filtered; f++)
+        {
+            filtered = wake_filter_match(&filters[f], frame->data,
+                    frame->len);
+        }
+
+        if (filtered)
+        {
+            continue;
+        }
+
+        if (first || ((frame->time_us - last_us) >=
+                ((uint64_t)window_ms * 1000U)))
+        {
+            wake_frame_info_t info;
+
+            wakes++;
+
+            if ((NULL != table) &&
+                    wake_classify_frame(frame->data, frame->len, &info))
+            {
+                wake_filter_table_add(table, &info.key, wake_filter_judge(
+                        &info, frame->data, frame->len, host));
+            }
+        }
+
+        first = false;
+        last_us = frame->time_us;
+    }
+
+    return wakes;
+}
+
+int main(int argc, char *argv[])
+{
+    static wake_filter_table_t table;
+    static wake_filter_t filters[WAKE_FILTER_KEYS];
+    ports_t ports;
+    wake_filter_host_t host;
+    uint32_t window_ms = INACTIVE_WINDOW_MS;
+    uint32_t min_wakes = DEFAULT_MIN_WAKES;
+    uint32_t max_filters = DEFAULT_MAX_FILTERS;
+    uint32_t filter_count;
+    uint32_t wakes;
+    uint32_t wakes_filtered;
+    uint32_t projected = 0U;
+    frame_t *frames;
+    size_t frame_count;
+    unsigned int ip[4];
+    int option;
+
+    memset(&ports, 0, sizeof(ports));
+    memset(&host, 0, sizeof(host));
+    host.port_open = port_open;
+    host.context = &ports;
+
+    while ((option = getopt(argc, argv, "i:u:t:w:m:n:")) != -1)
+    {
+        switch (option)
+        {
+            case 'i':
+                if (4 != sscanf(optarg, "%u.%u.%u.%u", &ip[0], &ip[1], &ip[2],
+                        &ip[3]))
+                {
+                    fprintf(stderr, "Invalid address %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                for (uint32_t i = 0U; i < 4U; i++)
+                {
+                    host.ipv4_addr[i] = (uint8_t)ip[i];
+                }
+                break;
+
+            case 'u':
+                if (ports.udp_count < MAX_PORTS)
+                {
+                    ports.udp[ports.udp_count++] =
+                            (uint16_t)strtoul(optarg, NULL, 0);
+                }
+                break;
+
+            case 't':
+                if (ports.tcp_count < MAX_PORTS)
+                {
+                    ports.tcp[ports.tcp_count++] =
+                            (uint16_t)strtoul(optarg, NULL, 0);
+                }
+                break;
+
+            case 'w':
+                window_ms = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'm':
+                min_wakes = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'n':
+                max_filters = (uint32_t)strtoul(optarg, NULL, 0);
+                if (max_filters > WAKE_FILTER_KEYS)
+                {
+                    max_filters = WAKE_FILTER_KEYS;
+                }
+                break;
+
+            default:
+                optind = argc;
+                break;
+        }
+    }
+
+    if (optind != (argc - 1))
+    {
+        fprintf(stderr, "Usage: %s [-i host_ipv4] [-u udp_port]... "
+                "[-t tcp_port]... [-w inactive_window_ms] [-m min_wakes] "
+                "[-n max_filters] capture.pcap\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    frames = read_pcap(argv[optind], &frame_count);
+    if (NULL == frames)
+    {
+        return EXIT_FAILURE;
+    }
+
+    wake_filter_table_init(&table);
+    wakes = count_wakes(frames, frame_count, window_ms, NULL, 0U, &host,
+            &table);
+    filter_count = wake_filter_propose(&table, min_wakes, filters,
+            max_filters);
+
+    printf("%zu frames, %u wakes with a %u ms window, %u not used by the "
+            "host\n", frame_count, wakes, window_ms, table.useless);
+    printf("\n%-6s %-6s %-6s %-6s %8s %8s\n", "type", "cast", "proto",
+            "port", "useful", "useless");
+    for (uint32_t i = 0U; i < table.used_entries; i++)
+    {
+        const wake_filter_entry_t *entry = &table.entries[i];
+
+        printf("%-6s %-6s %-6u %-6u %8u %8u\n",
+                wake_ethertype_name(entry->key.ethertype),
+                wake_cast_name(entry->key.cast), entry->key.ip_proto,
+                entry->key.port, entry->useful, entry->useless);
+    }
+
+    printf("\nProposed filters:\n");
+    for (uint32_t i = 0U; i < filter_count; i++)
+    {
+        printf("  %s %s proto %u port %u: %u wakes, pattern ",
+                wake_ethertype_name(filters[i].key.ethertype),
+                wake_cast_name(filters[i].key.cast), filters[i].key.ip_proto,
+                filters[i].key.port, filters[i].wakes);
+        for (uint16_t b = 0U; b < filters[i].size; b++)
+        {
+            if (0U != filters[i].mask[b])
+            {
+                printf("%u:%02x/%02x ", b, filters[i].pattern[b],
+                        filters[i].mask[b]);
+            }
+        }
+        printf("\n");
+        projected += filters[i].wakes;
+    }
+
+    wakes_filtered = count_wakes(frames, frame_count, window_ms, filters,
+            filter_count, &host, NULL);
+
+    printf("\nProjected: %u wakes avoided (%.1f%%)\n", projected,
+            (0U != wakes) ? (100.0 * projected / wakes) : 0.0);
+    printf("Replayed:  %u wakes with the filters, %u avoided (%.1f%%)\n",
+            wakes_filtered, wakes - wakes_filtered,
+            (0U != wakes) ? (100.0 * (wakes - wakes_filtered) / wakes) : 0.0);
+
+    free(frames);
+    return EXIT_SUCCESS;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,573 @@
+/*******************************************************************************
+* File Name:   wake_reason_test.c
+*
+* Description: Linux checks and benchmark of the wake reason classifier
+* (proj_cm33_ns/source/wake_reason.c): destination address type, ARP, IPv4 and
+* IPv6 with VLAN tags, IPv6 extension headers and fragments, truncated frames,
+* the histogram, and the number of frames classified per second.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+ * (c) 2024-2025, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+
+
+/*
+ * Build:
+ *  cc -O2 -Wall -I proj_cm33_ns/source -o wake_reason_test \
+ *      tools/wake_reason_test.c proj_cm33_ns/source/wake_reason.c
+ *
+ * Usage:
+ *  wake_reason_test [frames]
+ *
+ * Prints every failed check and exits with a non-zero status if any.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "wake_reason.h"
+
+#include "test_check.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define FRAME_BUFFER_LEN                (128U)
+
+#define ETH_HEADER_LEN                  (14U)
+#define IPV4_HEADER_LEN                 (20U)
+#define IPV6_HEADER_LEN                 (40U)
+
+#define ARP_OPER_REQUEST                (1U)
+#define ICMP_ECHO_REQUEST               (8U)
+#define ICMPV6_NEIGHBOR_SOLICIT         (135U)
+#define ICMPV6_MLD_REPORT               (143U)
+
+#define IPV6_EXT_HOP_BY_HOP             (0U)
+#define IPV6_EXT_ROUTING                (43U)
+#define IPV6_EXT_FRAGMENT               (44U)
+#define IPV6_EXT_DEST_OPTIONS           (60U)
+
+/* Number of frames classified by the benchmark by default */
+#define BENCH_DEFAULT_FRAMES            (10000000U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const uint8_t unicast_addr[6] =
+        { 0x00U, 0x03U, 0x19U, 0x12U, 0x34U, 0x56U };
+static const uint8_t multicast_addr[6] =
+        { 0x01U, 0x00U, 0x5EU, 0x00U, 0x00U, 0xFBU };
+static const uint8_t broadcast_addr[6] =
+        { 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU };
+
+static uint8_t frame[FRAME_BUFFER_LEN];
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static void put_u16(uint8_t *data, uint16_t value)
+{
+    data[0] = (uint8_t)(value >> 8U);
+    data[1] = (uint8_t)value;
+}
+
+/* Clears the frame and writes the Ethernet header */
+static size_t put_eth(const uint8_t *dst, uint16_t ethertype)
+{
+    memset(frame, 0, sizeof(frame));
+    memcpy(frame, dst, 6U);
+    memcpy(&frame[6], unicast_addr, 6U);
+    put_u16(&frame[12], ethertype);
+
+    return ETH_HEADER_LEN;
+}
+
+/* Writes a VLAN tag carrying the given EtherType */
+static size_t put_vlan(size_t offset, uint16_t ethertype)
+{
+    put_u16(&frame[offset], 100U);
+    put_u16(&frame[offset + 2U], ethertype);
+
+    return offset + 4U;
+}
+
+static size_t put_ipv4(size_t offset, uint8_t proto, uint16_t frag_offset)
+{
+    frame[offset] = 0x45U;
+    put_u16(&frame[offset + 6U], frag_offset);
+    frame[offset + 9U] = proto;
+
+    return offset + IPV4_HEADER_LEN;
+}
+
+static size_t put_ipv6(size_t offset, uint8_t next_header)
+{
+    frame[offset] = 0x60U;
+    frame[offset + 6U] = next_header;
+
+    return offset + IPV6_HEADER_LEN;
+}
+
+/* Writes an IPv6 extension header of eight bytes */
+static size_t put_ipv6_ext(size_t offset, uint8_t next_header)
+{
+    frame[offset] = next_header;
+    frame[offset + 1U] = 0U;
+
+    return offset + 8U;
+}
+
+/* Writes the ports of a TCP or UDP header */
+static size_t put_ports(size_t offset, uint16_t src_port, uint16_t dst_port)
+{
+    put_u16(&frame[offset], src_port);
+    put_u16(&frame[offset + 2U], dst_port);
+
+    return offset + 8U;
+}
+
+static bool classify(size_t len, wake_frame_info_t *info)
+{
+    return wake_classify_frame(frame, len, info);
+}
+
+static void test_cast(void)
+{
+    wake_frame_info_t info;
+    size_t len;
+
+    len = put_eth(unicast_addr, WAKE_ETHERTYPE_EAPOL);
+    CHECK(classify(len, &info));
+    CHECK(WAKE_CAST_UNICAST == info.key.cast);
+    CHECK(WAKE_ETHERTYPE_EAPOL == info.key.ethertype);
+    CHECK(0U == info.key.ip_proto);
+    CHECK(!info.truncated);
+
+    len = put_eth(multicast_addr, WAKE_ETHERTYPE_EAPOL);
+    CHECK(classify(len, &info));
+    CHECK(WAKE_CAST_MULTICAST == info.key.cast);
+
+    len = put_eth(broadcast_addr, WAKE_ETHERTYPE_EAPOL);
+    CHECK(classify(len, &info));
+    CHECK(WAKE_CAST_BROADCAST == info.key.cast);
+
+    CHECK(0 == strcmp("bcast", wake_cast_name(info.key.cast)));
+    CHECK(0 == strcmp("EAPOL", wake_ethertype_name(info.key.ethertype)));
+    CHECK(0 == strcmp("other", wake_ethertype_name(0x88CCU)));
+}
+
+static void test_arp(void)
+{
+    wake_frame_info_t info;
+    size_t len = put_eth(broadcast_addr, WAKE_ETHERTYPE_ARP);
+
+    put_u16(&frame[len + 6U], ARP_OPER_REQUEST);
+    CHECK(classify(len + 28U, &info));
+    CHECK(WAKE_ETHERTYPE_ARP == info.key.ethertype);
+    CHECK(WAKE_CAST_BROADCAST == info.key.cast);
+    CHECK(ARP_OPER_REQUEST == info.key.port);
+    CHECK(!info.truncated);
+
+    /* The operation is past the end of the buffer */
+    CHECK(classify(len + 7U, &info));
+    CHECK(WAKE_ETHERTYPE_ARP == info.key.ethertype);
+    CHECK(0U == info.key.port);
+    CHECK(info.truncated);
+}
+
+static void test_ipv4(void)
+{
+    wake_frame_info_t info;
+    size_t len;
+
+    /* mDNS */
+    len = put_ports(put_ipv4(put_eth(multicast_addr, WAKE_ETHERTYPE_IPV4),
+            WAKE_IP_PROTO_UDP, 0U), 5353U, 5353U);
+    CHECK(classify(len, &info));
+    CHECK(WAKE_ETHERTYPE_IPV4 == info.key.ethertype);
+    CHECK(WAKE_CAST_MULTICAST == info.key.cast);
+    CHECK(WAKE_IP_PROTO_UDP == info.key.ip_proto);
+    CHECK(5353U == info.key.port);
+    CHECK(5353U == info.src_port);
+    CHECK(!info.truncated);
+
+    len = put_ports(put_ipv4(put_eth(unicast_addr, WAKE_ETHERTYPE_IPV4),
+            WAKE_IP_PROTO_TCP, 0U), 49152U, 443U);
+    CHECK(classify(len, &info));
+    CHECK(WAKE_IP_PROTO_TCP == info.key.ip_proto);
+    CHECK(443U == info.key.port);
+    CHECK(443U == info.dst_port);
+    CHECK(49152U == info.src_port);
+
+    len = put_ipv4(put_eth(unicast_addr, WAKE_ETHERTYPE_IPV4),
+            WAKE_IP_PROTO_ICMP, 0U);
+    frame[len] = ICMP_ECHO_REQUEST;
+    CHECK(classify(len + 8U, &info));
+    CHECK(WAKE_IP_PROTO_ICMP == info.key.ip_proto);
+    CHECK(ICMP_ECHO_REQUEST == info.key.port);
+
+    /* Header with options: the ports follow the 24-byte header */
+    len = put_ipv4(put_eth(unicast_addr, WAKE_ETHERTYPE_IPV4),
+            WAKE_IP_PROTO_UDP, 0U);
+    frame[ETH_HEADER_LEN] = 0x46U;
+    len = put_ports(len + 4U, 68U, 67U);
+    CHECK(classify(len, &info));
+    CHECK(67U == info.key.port);
+    CHECK(68U == info.src_port);
+
+    /* The first fragment carries the ports, the next ones do not */
+    len = put_ports(put_ipv4(put_eth(unicast_addr, WAKE_ETHERTYPE_IPV4),
+            WAKE_IP_PROTO_UDP, 0x2000U), 1000U, 2000U);
+    CHECK(classify(len, &info));
+    CHECK(2000U == info.key.port);
+
+    len = put_ports(put_ipv4(put_eth(unicast_addr, WAKE_ETHERTYPE_IPV4),
+            WAKE_IP_PROTO_UDP, 185U), 1000U, 2000U);
+    CHECK(classify(len, &info));
+    CHECK(WAKE_IP_PROTO_UDP == info.key.ip_proto);
+    CHECK(0U == info.key.port);
+    CHECK(0U == info.src_port);
+    CHECK(!info.truncated);
+}
+
+static void test_ipv6(void)
+{
+    wake_frame_info_t info;
+    size_t len;
+
+    len = put_ipv6(put_eth(multicast_addr, WAKE_ETHERTYPE_IPV6),
+            WAKE_IP_PROTO_ICMPV6);
+    frame[len] = ICMPV6_NEIGHBOR_SOLICIT;
+    CHECK(classify(len + 24U, &info));
+    CHECK(WAKE_ETHERTYPE_IPV6 == info.key.ethertype);
+    CHECK(WAKE_CAST_MULTICAST == info.key.cast);
+    CHECK(WAKE_IP_PROTO_ICMPV6 == info.key.ip_proto);
+    CHECK(ICMPV6_NEIGHBOR_SOLICIT == info.key.port);
+    CHECK(!info.truncated);
+
+    len = put_ports(put_ipv6(put_eth(unicast_addr, WAKE_ETHERTYPE_IPV6),
+            WAKE_IP_PROTO_UDP), 547U, 546U);
+    CHECK(classify(len, &info));
+    CHECK(WAKE_IP_PROTO_UDP == info.key.ip_proto);
+    CHECK(546U == info.key.port);
+}
+
+static void test_ipv6_ext(void)
+{
+    wake_frame_info_t info;
+    size_t len;
+
+    /* MLD report behind a hop-by-hop options header */
+    len = put_ipv6(put_eth(multicast_addr, WAKE_ETHERTYPE_IPV6),
+            IPV6_EXT_HOP_BY_HOP);
+    len = put_ipv6_ext(len, WAKE_IP_PROTO_ICMPV6);
+    frame[len] = ICMPV6_MLD_REPORT;
+    CHECK(classify(len + 8U, &info));
+    CHECK(WAKE_IP_PROTO_ICMPV6 == info.key.ip_proto);
+    CHECK(ICMPV6_MLD_REPORT == info.key.port);
+
+    /* Routing and destination options headers, the latter of 16 bytes */
+    len = put_ipv6(put_eth(unicast_addr, WAKE_ETHERTYPE_IPV6),
+            IPV6_EXT_ROUTING);
+    len = put_ipv6_ext(len, IPV6_EXT_DEST_OPTIONS);
+    frame[len] = WAKE_IP_PROTO_TCP;
+    frame[len + 1U] = 1U;
+    len = put_ports(len + 16U, 50000U, 8883U);
+    CHECK(classify(len, &info));
+    CHECK(WAKE_IP_PROTO_TCP == info.key.ip_proto);
+    CHECK(8883U == info.key.port);
+    CHECK(!info.truncated);
+
+    /* The first fragment carries the ports */
+    len = put_ipv6(put_eth(unicast_addr, WAKE_ETHERTYPE_IPV6),
+            IPV6_EXT_FRAGMENT);
+    len = put_ipv6_ext(len, WAKE_IP_PROTO_UDP);
+    frame[len - 5U] = 0x01U;
+    len = put_ports(len, 1000U, 2000U);
+    CHECK(classify(len, &info));
+    CHECK(WAKE_IP_PROTO_UDP == info.key.ip_proto);
+    CHECK(2000U == info.key.port);
+
+    /* The next fragments do not */
+    len = put_ipv6(put_eth(unicast_addr, WAKE_ETHERTYPE_IPV6),
+            IPV6_EXT_FRAGMENT);
+    len = put_ipv6_ext(len, WAKE_IP_PROTO_UDP);
+    put_u16(&frame[len - 6U], 0x05A8U);
+    len = put_ports(len, 1000U, 2000U);
+    CHECK(classify(len, &info));
+    CHECK(WAKE_IP_PROTO_UDP == info.key.ip_proto);
+    CHECK(0U == info.key.port);
+    CHECK(!info.truncated);
+
+    /* Too many extension headers: the classifier stops at the fifth */
+    len = put_ipv6(put_eth(unicast_addr, WAKE_ETHERTYPE_IPV6),
+            IPV6_EXT_DEST_OPTIONS);
+    for (uint32_t ext = 0U; ext < 4U; ext++)
+    {
+        len = put_ipv6_ext(len, IPV6_EXT_DEST_OPTIONS);
+    }
+    CHECK(classify(len + 8U, &info));
+    CHECK(IPV6_EXT_DEST_OPTIONS == info.key.ip_proto);
+    CHECK(0U == info.key.port);
+}
+
+static void test_vlan(void)
+{
+    wake_frame_info_t info;
+    size_t len;
+
+    len = put_vlan(put_eth(unicast_addr, WAKE_ETHERTYPE_VLAN),
+            WAKE_ETHERTYPE_IPV4);
+    len = put_ports(put_ipv4(len, WAKE_IP_PROTO_UDP, 0U), 1234U, 5683U);
+    CHECK(classify(len, &info));
+    CHECK(WAKE_ETHERTYPE_IPV4 == info.key.ethertype);
+    CHECK(5683U == info.key.port);
+    CHECK(!info.truncated);
+
+    /* Two tags */
+    len = put_vlan(put_eth(broadcast_addr, WAKE_ETHERTYPE_VLAN),
+            WAKE_ETHERTYPE_VLAN);
+    len = put_vlan(len, WAKE_ETHERTYPE_ARP);
+    put_u16(&frame[len + 6U], ARP_OPER_REQUEST);
+    CHECK(classify(len + 28U, &info));
+    CHECK(WAKE_ETHERTYPE_ARP == info.key.ethertype);
+    CHECK(ARP_OPER_REQUEST == info.key.port);
+
+    /* A third tag is not decoded */
+    len = put_vlan(put_eth(unicast_addr, WAKE_ETHERTYPE_VLAN),
+            WAKE_ETHERTYPE_VLAN);
+    len = put_vlan(len, WAKE_ETHERTYPE_VLAN);
+    len = put_vlan(len, WAKE_ETHERTYPE_IPV4);
+    CHECK(classify(len + 28U, &info));
+    CHECK(WAKE_ETHERTYPE_VLAN == info.key.ethertype);
+    CHECK(0U == info.key.ip_proto);
+
+    /* The tag is past the end of the buffer */
+    len = put_vlan(put_eth(unicast_addr, WAKE_ETHERTYPE_VLAN),
+            WAKE_ETHERTYPE_IPV4);
+    CHECK(classify(len - 2U, &info));
+    CHECK(WAKE_ETHERTYPE_VLAN == info.key.ethertype);
+    CHECK(info.truncated);
+}
+
+static void test_truncated(void)
+{
+    wake_frame_info_t info;
+    size_t len;
+
+    len = put_eth(unicast_addr, WAKE_ETHERTYPE_IPV4);
+    CHECK(!classify(len - 1U, &info));
+    CHECK(info.truncated);
+    CHECK(!wake_classify_frame(NULL, len, &info));
+    CHECK(info.truncated);
+
+    /* Ethernet header only */
+    CHECK(classify(len, &info));
+    CHECK(WAKE_ETHERTYPE_IPV4 == info.key.ethertype);
+    CHECK(0U == info.key.ip_proto);
+    CHECK(info.truncated);
+
+    /* IPv4 header without ports */
+    len = put_ipv4(put_eth(unicast_addr, WAKE_ETHERTYPE_IPV4),
+            WAKE_IP_PROTO_TCP, 0U);
+    CHECK(classify(len + 3U, &info));
+    CHECK(WAKE_IP_PROTO_TCP == info.key.ip_proto);
+    CHECK(0U == info.key.port);
+    CHECK(info.truncated);
+
+    /* ICMP header missing */
+    len = put_ipv4(put_eth(unicast_addr, WAKE_ETHERTYPE_IPV4),
+            WAKE_IP_PROTO_ICMP, 0U);
+    CHECK(classify(len, &info));
+    CHECK(WAKE_IP_PROTO_ICMP == info.key.ip_proto);
+    CHECK(info.truncated);
+
+    /* IPv6 header cut short */
+    len = put_ipv6(put_eth(unicast_addr, WAKE_ETHERTYPE_IPV6),
+            WAKE_IP_PROTO_UDP);
+    CHECK(classify(len - 1U, &info));
+    CHECK(0U == info.key.ip_proto);
+    CHECK(info.truncated);
+
+    /* Extension header cut short */
+    len = put_ipv6(put_eth(unicast_addr, WAKE_ETHERTYPE_IPV6),
+            IPV6_EXT_HOP_BY_HOP);
+    CHECK(classify(len + 1U, &info));
+    CHECK(IPV6_EXT_HOP_BY_HOP == info.key.ip_proto);
+    CHECK(info.truncated);
+
+    /* The snapshot kept by the low power task holds the ports of a tagged
+     * IPv6 frame
+     */
+    len = put_vlan(put_eth(unicast_addr, WAKE_ETHERTYPE_VLAN),
+            WAKE_ETHERTYPE_IPV6);
+    (void)put_ports(put_ipv6(len, WAKE_IP_PROTO_UDP), 1000U, 2000U);
+    CHECK(classify(WAKE_FRAME_SNAPSHOT_LEN, &info));
+    CHECK(2000U == info.key.port);
+    CHECK(!info.truncated);
+}
+
+static void test_none(void)
+{
+    wake_frame_info_t info;
+
+    wake_classify_none(&info);
+    CHECK(WAKE_ETHERTYPE_NONE == info.key.ethertype);
+    CHECK(0U == info.key.port);
+    CHECK(!info.truncated);
+    CHECK(0 == strcmp("no frame", wake_ethertype_name(info.key.ethertype)));
+}
+
+static void test_histogram(void)
+{
+    static wake_histogram_t histogram;
+    wake_key_t key = { WAKE_ETHERTYPE_IPV4, WAKE_CAST_UNICAST,
+            WAKE_IP_PROTO_UDP, 0U };
+
+    wake_histogram_init(&histogram);
+
+    /* Same key counted in one bin */
+    wake_histogram_add(&histogram, &key, 10U);
+    wake_histogram_add(&histogram, &key, 20U);
+    CHECK(1U == histogram.used_bins);
+    CHECK(2U == histogram.bins[0].count);
+
+    /* Keys differing by one field take new bins until they run out */
+    for (uint32_t port = 1U; port <= WAKE_HISTOGRAM_BINS; port++)
+    {
+        key.port = (uint16_t)port;
+        wake_histogram_add(&histogram, &key, 100U + port);
+    }
+    CHECK(WAKE_HISTOGRAM_BINS == histogram.used_bins);
+    CHECK(1U == histogram.overflow);
+    CHECK((WAKE_HISTOGRAM_BINS + 2U) == histogram.total);
+
+    /* The history keeps the last events */
+    CHECK((2U % WAKE_EVENT_HISTORY_LEN) == histogram.history_next);
+    CHECK((100U + WAKE_HISTOGRAM_BINS) ==
+            histogram.history[1].timestamp_ms);
+    CHECK(WAKE_HISTOGRAM_BINS == histogram.history[1].key.port);
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+/* Classifies a mix of frames and prints the number of frames per second */
+static void bench(uint32_t frames)
+{
+    static uint8_t mix[4][FRAME_BUFFER_LEN];
+    size_t mix_len[4];
+    wake_frame_info_t info;
+    uint32_t ports = 0U;
+    uint64_t start;
+    uint64_t elapsed;
+
+    mix_len[0] = put_ports(put_ipv4(put_eth(multicast_addr,
+            WAKE_ETHERTYPE_IPV4), WAKE_IP_PROTO_UDP, 0U), 5353U, 5353U);
+    memcpy(mix[0], frame, sizeof(frame));
+    put_u16(&frame[put_eth(broadcast_addr, WAKE_ETHERTYPE_ARP) + 6U],
+            ARP_OPER_REQUEST);
+    mix_len[1] = ETH_HEADER_LEN + 28U;
+    memcpy(mix[1], frame, sizeof(frame));
+    mix_len[2] = put_ipv6(put_eth(multicast_addr, WAKE_ETHERTYPE_IPV6),
+            IPV6_EXT_HOP_BY_HOP);
+    mix_len[2] = put_ipv6_ext(mix_len[2], WAKE_IP_PROTO_ICMPV6) + 8U;
+    frame[mix_len[2] - 8U] = ICMPV6_MLD_REPORT;
+    memcpy(mix[2], frame, sizeof(frame));
+    mix_len[3] = put_vlan(put_eth(unicast_addr, WAKE_ETHERTYPE_VLAN),
+            WAKE_ETHERTYPE_IPV4);
+    mix_len[3] = put_ports(put_ipv4(mix_len[3], WAKE_IP_PROTO_TCP, 0U),
+            443U, 49152U);
+    memcpy(mix[3], frame, sizeof(frame));
+
+    start = now_ns();
+    for (uint32_t i = 0U; i < frames; i++)
+    {
+        (void)wake_classify_frame(mix[i & 3U], mix_len[i & 3U], &info);
+        ports += info.key.port;
+    }
+    elapsed = now_ns() - start;
+
+    if (0U == elapsed)
+    {
+        elapsed = 1U;
+    }
+
+    printf("%u frames in %.3f ms: %.1f ns per frame, %.0f frames/s "
+           "(checksum %u)\n", frames, (double)elapsed / 1e6,
+           (double)elapsed / frames, (double)frames * 1e9 / (double)elapsed,
+           ports);
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t frames = BENCH_DEFAULT_FRAMES;
+
+    if (argc > 1)
+    {
+        frames = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+
+    test_cast();
+    test_arp();
+    test_ipv4();
+    test_ipv6();
+    test_ipv6_ext();
+    test_vlan();
+    test_truncated();
+    test_none();
+    test_histogram();
+
+    if (frames > 0U)
+    {
+        bench(frames);
+    }
+
+    return test_check_summary();
+}
+
+
+/* [] END OF FILE */